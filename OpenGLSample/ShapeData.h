@@ -1,28 +1,29 @@
-#pragma once
-#include "Vertex.h"
-#include <glad/glad.h>
-
-struct ShapeData
-{
-	ShapeData() :
-		vertices(0), numVertices(0),
-		indices(0), numIndices(0) {}
-	Vertex* vertices;
-	GLuint numVertices;
-	GLushort* indices;
-	GLuint numIndices;
-	GLsizeiptr vertexBufferSize() const
-	{
-		return numVertices * sizeof(Vertex);
-	}
-	GLsizeiptr indexBufferSize() const
-	{
-		return numIndices * sizeof(GLushort);
-	}
-	void cleanup()
-	{
-		delete[] vertices;
-		delete[] indices;
-		numVertices = numIndices = 0;
-	}
+#pragma once
+#include "Vertex.h"
+#include <glad/glad.h>
+#include <vector>
+
+struct ShapeData
+{
+	ShapeData() :
+		numVertices(0), indexType(GL_UNSIGNED_SHORT), numIndices(0) {}
+	std::vector<Vertex> vertices;
+	GLuint numVertices;
+	std::vector<unsigned char> indices; // packed by IndexBufferBuilder, indexType tells the width
+	GLenum indexType;
+	GLuint numIndices;
+	GLsizeiptr vertexBufferSize() const
+	{
+		return numVertices * sizeof(Vertex);
+	}
+	GLsizeiptr indexBufferSize() const
+	{
+		return indices.size();
+	}
+	void cleanup()
+	{
+		std::vector<Vertex>().swap(vertices);
+		std::vector<unsigned char>().swap(indices);
+		numVertices = numIndices = 0;
+	}
 };
\ No newline at end of file
@@ -1,102 +1,119 @@
-#include "ShapeGenerator.h"
-//#include <glm\glm.hpp>
-//#include <glm\gtc\matrix_transform.hpp>
-#include "Vertex.h"
-
-#define PI 3.14159265359
-using glm::vec3;
-using glm::mat4;
-using glm::mat3;
-#define NUM_ARRAY_ELEMENTS(a) sizeof(a) / sizeof(*a)
-
-glm::vec3 randomColor()
-{
-	glm::vec3 ret;
-	ret.x = rand() / (float)RAND_MAX;
-	ret.y = rand() / (float)RAND_MAX;
-	ret.z = rand() / (float)RAND_MAX;
-	return ret;
-}
-
-
-ShapeData ShapeGenerator::makePlaneVerts(uint dimensions)
-{
-	ShapeData ret;
-	ret.numVertices = dimensions * dimensions;
-	int half = dimensions / 2;
-	ret.vertices = new Vertex[ret.numVertices];
-	for (int i = 0; i < dimensions; i++)
-	{
-		for (int j = 0; j < dimensions; j++)
-		{
-			Vertex& thisVert = ret.vertices[i * dimensions + j];
-			thisVert.position.x = j - half;
-			thisVert.position.z = i - half;
-			thisVert.position.y = 0;
-			thisVert.normal = glm::vec3(0.0f, 1.0f, 0.0f);
-			thisVert.color = randomColor();
-		}
-	}
-	return ret;
-}
-
-ShapeData ShapeGenerator::makePlaneIndices(uint dimensions)
-{
-	ShapeData ret;
-	ret.numIndices = (dimensions - 1) * (dimensions - 1) * 2 * 3; // 2 triangles per square, 3 indices per triangle
-	ret.indices = new unsigned short[ret.numIndices];
-	int runner = 0;
-	for (int row = 0; row < dimensions - 1; row++)
-	{
-		for (int col = 0; col < dimensions - 1; col++)
-		{
-			ret.indices[runner++] = dimensions * row + col;
-			ret.indices[runner++] = dimensions * row + col + dimensions;
-			ret.indices[runner++] = dimensions * row + col + dimensions + 1;
-
-			ret.indices[runner++] = dimensions * row + col;
-			ret.indices[runner++] = dimensions * row + col + dimensions + 1;
-			ret.indices[runner++] = dimensions * row + col + 1;
-		}
-	}
-	assert(runner = ret.numIndices);
-	return ret;
-}
-
-
-ShapeData ShapeGenerator::makePlane(uint dimensions)
-{
-	ShapeData ret = makePlaneVerts(dimensions);
-	ShapeData ret2 = makePlaneIndices(dimensions);
-	ret.numIndices = ret2.numIndices;
-	ret.indices = ret2.indices;
-	return ret;
-}
-
-ShapeData ShapeGenerator::makeSphere(uint tesselation)
-{
-	ShapeData ret = makePlaneVerts(tesselation);
-	ShapeData ret2 = makePlaneIndices(tesselation);
-	ret.indices = ret2.indices;
-	ret.numIndices = ret2.numIndices;
-
-	uint dimensions = tesselation;
-	const float RADIUS = 1.0f;
-	const double CIRCLE = PI * 2;
-	const double SLICE_ANGLE = CIRCLE / (dimensions - 1);
-	for (size_t col = 0; col < dimensions; col++)
-	{
-		double phi = -SLICE_ANGLE * col;
-		for (size_t row = 0; row < dimensions; row++)
-		{
-			double theta = -(SLICE_ANGLE / 2.0) * row;
-			size_t vertIndex = col * dimensions + row;
-			Vertex& v = ret.vertices[vertIndex];
-			v.position.x = RADIUS * cos(phi) * sin(theta);
-			v.position.y = RADIUS * sin(phi) * sin(theta);
-			v.position.z = RADIUS * cos(theta);
-			v.normal = glm::normalize(v.position);
-		}
-	}
-	return ret;
+#include <cstddef>
+#include "ShapeGenerator.h"
+//#include <glm\glm.hpp>
+//#include <glm\gtc\matrix_transform.hpp>
+#include "Vertex.h"
+#include "common/parametricSurface.h"
+#include "common/indexBufferBuilder.h"
+#include "common/meshOptimizer.h"
+
+#define PI 3.14159265359
+using glm::vec3;
+using glm::mat4;
+using glm::mat3;
+#define NUM_ARRAY_ELEMENTS(a) sizeof(a) / sizeof(*a)
+
+// dimensions x dimensions vertices, row i being outer line i
+ParametricGrid makeGrid(uint dimensions)
+{
+	ParametricGrid grid;
+	grid.outerSegments = dimensions - 1;
+	grid.innerSegments = dimensions - 1;
+	return grid;
+}
+
+// positions and normals written straight into the Vertex array, colors are left alone
+VertexStreams vertexStreams(ShapeData& shape)
+{
+	const auto floatsPerVertex = sizeof(Vertex) / sizeof(float);
+	return VertexStreams::interleaved(&shape.vertices[0].position.x, floatsPerVertex,
+		(int)(offsetof(Vertex, position) / sizeof(float)), (int)(offsetof(Vertex, normal) / sizeof(float)), -1);
+}
+
+glm::vec3 randomColor()
+{
+	glm::vec3 ret;
+	ret.x = rand() / (float)RAND_MAX;
+	ret.y = rand() / (float)RAND_MAX;
+	ret.z = rand() / (float)RAND_MAX;
+	return ret;
+}
+
+
+ShapeData ShapeGenerator::makePlaneVerts(uint dimensions)
+{
+	ShapeData ret;
+	ret.numVertices = dimensions * dimensions;
+	ret.vertices.resize(ret.numVertices);
+	for (auto& vertex : ret.vertices)
+		vertex.color = randomColor();
+
+	int half = dimensions / 2;
+	FlatGridSurface surface;
+	surface.origin = glm::vec3(-half, 0.0f, -half);
+	parametric_surface::generateVertices(surface, makeGrid(dimensions), vertexStreams(ret));
+	return ret;
+}
+
+std::vector<GLuint> ShapeGenerator::makePlaneIndices(uint dimensions)
+{
+	const auto grid = makeGrid(dimensions);
+	std::vector<GLuint> triangles(parametric_surface::getIndexCount(grid, GridTriangulation::QUADS)); // 2 triangles per square, 3 indices per triangle
+	parametric_surface::generateIndices(grid, GridTriangulation::QUADS, triangles.data());
+	return triangles;
+}
+
+void ShapeGenerator::setIndices(ShapeData& shape, std::vector<GLuint>& triangles)
+{
+	// triangles for the vertex cache, then vertices in the order they are fetched
+	mesh_optimizer::optimizeVertexCache(triangles.data(), triangles.size(), shape.numVertices);
+	std::vector<GLuint> remap;
+	mesh_optimizer::buildVertexFetchRemap(triangles.data(), triangles.size(), shape.numVertices, remap);
+	mesh_optimizer::remapIndices(triangles.data(), triangles.size(), remap);
+	mesh_optimizer::remapVertices(shape.vertices.data(), shape.numVertices, sizeof(Vertex), remap);
+
+	// 16-bit indices up to 255x255, 32-bit ones above
+	IndexBufferBuilder indexBuffer;
+	indexBuffer.addTriangles(triangles.data(), triangles.size());
+	indexBuffer.finish();
+	const auto* data = static_cast<const unsigned char*>(indexBuffer.getData());
+	shape.indices.assign(data, data + indexBuffer.getByteSize());
+	shape.indexType = indexBuffer.getIndexType();
+	shape.numIndices = (GLuint)indexBuffer.getIndexCount();
+}
+
+
+ShapeData ShapeGenerator::makePlane(uint dimensions)
+{
+	ShapeData ret = makePlaneVerts(dimensions);
+	std::vector<GLuint> triangles = makePlaneIndices(dimensions);
+	setIndices(ret, triangles);
+	return ret;
+}
+
+ShapeData ShapeGenerator::makeSphere(uint tesselation)
+{
+	ShapeData ret;
+	ret.numVertices = tesselation * tesselation;
+	ret.vertices.resize(ret.numVertices);
+	for (auto& vertex : ret.vertices)
+		vertex.color = randomColor();
+
+	// outer lines are meridians at phi = -SLICE_ANGLE * col, inner lines run along them
+	// from the pole at theta = 0 down to theta = -pi (the latitude is pi/2 - theta)
+	uint dimensions = tesselation;
+	const float SLICE_ANGLE = (float)(PI * 2 / (dimensions - 1));
+	auto grid = makeGrid(dimensions);
+	grid.outerStep = -SLICE_ANGLE;
+	grid.innerStart = (float)(PI / 2);
+	grid.innerStep = SLICE_ANGLE / 2.0f;
+
+	SphereSurface surface;
+	surface.radius = 1.0f;
+	surface.longitudeOuter = true;
+	parametric_surface::generateVertices(surface, grid, vertexStreams(ret));
+
+	std::vector<GLuint> triangles = makePlaneIndices(tesselation);
+	setIndices(ret, triangles);
+	return ret;
 }
\ No newline at end of file
@@ -1,16 +1,18 @@
-#pragma once
-#include "ShapeData.h"
-typedef unsigned int uint;
-
-class ShapeGenerator
-{
-	static ShapeData makePlaneVerts(uint dimensions);
-	static ShapeData makePlaneIndices(uint dimensions);
-
-	
-public:
-
-	static ShapeData makePlane(uint dimensions = 10);
-	static ShapeData makeSphere(uint tesselation = 20);
-	
-};
+#pragma once
+#include "ShapeData.h"
+#include <vector>
+typedef unsigned int uint;
+
+class ShapeGenerator
+{
+	static ShapeData makePlaneVerts(uint dimensions);
+	static std::vector<GLuint> makePlaneIndices(uint dimensions);
+	static void setIndices(ShapeData& shape, std::vector<GLuint>& triangles);
+
+	
+public:
+
+	static ShapeData makePlane(uint dimensions = 10);
+	static ShapeData makeSphere(uint tesselation = 20);
+	
+};
@@ -1,845 +1,1609 @@
-﻿/*
-	Francis Naughton
-	SNHU CS-330
-	10/14/2022
-
-	You can scroll up and down to increase and decrease the camera's speed.
-
-	Light Object Controls
-	Y- light up
-	H- light down
-	G- light neg on x axis
-	J- light pos on x axis
-	N- light neg on z axis
-	M- light pos on z axis
-
-	Camera Movement
-	w forward
-	s backward
-	a left
-	d right
-	q up
-	e down
-
-	Modes
-	//reset camera with 'F' before switching modes
-	L- turn on orbit mode
-	O- turn on ortho mode
-
-	F- resets camera
-
-*/
-
-
-#include <glad/glad.h>
-#include <GLFW/glfw3.h >
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
-
-#include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
-
-#include "Sphere.h"
-
-#include "shader.h"
-#include "camera.h"
-#include <iostream>
-
-#include "cylinder.h"
-
-/*Shader program Macro*/
-#ifndef GLSL
-#define GLSL(Version, Source) "#version " #Version " core \n" #Source
-#endif
-
-
-
-void framebuffer_size_callback(GLFWwindow* window, int width, int height);
-void mouse_callback(GLFWwindow* window, double xpos, double ypos);
-void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
-void processInput(GLFWwindow* window);
-unsigned int loadTexture(const char* path);
-static void resetCamera();
-void TransformCamera(GLFWwindow* window);
-
-float xlight = -1.2f, ylight = 1.0f, zlight = 2.0f;
-
-// settings
-const unsigned int SCR_WIDTH = 800;
-const unsigned int SCR_HEIGHT = 600;
-
-// camera
-Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
-glm::vec3 orgin = glm::vec3(0.0f, 1.5f, 0.0f);
-glm::vec3 cameraPos = glm::vec3(0.0f, 3.0f, 4.0f);
-glm::vec3 cameraFront = glm::vec3(0.0f, 0.0f, -1.0f);
-glm::vec3 worldUp = glm::vec3(0.0f, 1.0f, 0.0f);
-glm::vec3 cameraDir = glm::normalize(cameraPos - orgin);
-glm::vec3 cameraRight = glm::normalize(glm::cross(worldUp, cameraDir));
-glm::vec3 cameraUp = glm::normalize(glm::cross(cameraDir, cameraRight));
-
-glm::vec3 getOrgin();
-
-const float MAX_CAMERA_SPEED = 25.0f;
-const float MIN_CAMERA_SPEED = 1.0;
-
-bool firstMouse = true;
-float yaw = -90.0f;	// yaw is initialized to -90.0 degrees since a yaw of 0.0 results in a direction vector pointing to the right so we initially rotate a bit to the left.
-float pitch = 0.0f;
-float lastX = SCR_WIDTH / 2.0;
-float lastY = SCR_HEIGHT / 2.0;
-float fov = 45.0f;
-float xoffset, yoffset;
-
-//obiting
-float orbitRadius = 10.0f;
-float camX = sin(glfwGetTime()) * orbitRadius;
-float camZ = cos(glfwGetTime()) * orbitRadius;
-
-//booleans for varius modes
-bool ortho = false;
-bool isOrbiting = false;
-
-// timing
-float deltaTime = 0.0f;	// time between current frame and last frame
-float lastFrame = 0.0f;
-
-//camera speed
-float cameraSpeed = 1.5;
-float cameraOffset = cameraSpeed * deltaTime;
-
-//lighting 
-glm::vec3 lightPos(-1.2f, 2.0f, 2.0f);
-
-
-int main()
-{
-	// glfw: initialize and configure
-	// ------------------------------
-	glfwInit();
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-#ifdef __APPLE__
-	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-#endif
-
-	// glfw window creation
-	// --------------------
-	GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Francis Naughton Final Scene", NULL, NULL);
-	if (window == NULL)
-	{
-		std::cout << "Failed to create GLFW window" << std::endl;
-		glfwTerminate();
-		return -1;
-	}
-	glfwMakeContextCurrent(window);
-	glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
-	glfwSetCursorPosCallback(window, mouse_callback);
-	glfwSetScrollCallback(window, scroll_callback);
-
-	// tell GLFW to capture our mouse
-	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-
-	// glad: load all OpenGL function pointers
-	// ---------------------------------------
-	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
-	{
-		std::cout << "Failed to initialize GLAD" << std::endl;
-		return -1;
-	}
-
-	// configure global opengl state
-	// -----------------------------
-	glEnable(GL_DEPTH_TEST);
-
-	Shader lightingShader("shaderfiles/5.4.light_casters.vs", "shaderfiles/5.4.light_casters.fs");
-	Shader lightCubeShader("shaderfiles/5.4.light_cube.vs", "shaderfiles/5.4.light_cube.fs");
-	// set up vertex data (and buffer(s)) and configure vertex attributes
-	// ------------------------------------------------------------------
-	float planeV[] = {
-
-		//negative  z normals	      text cord
-		-0.5f, -0.5f, -0.5f,  0.0f, 0.0f, -1.0f,  0.0f, 0.0f,
-		 0.5f, -0.5f, -0.5f,  0.0f, 0.0f, -1.0f,  1.0f, 0.0f,
-		 0.5f,  0.5f, -0.5f,  0.0f, 0.0f, -1.0f,  1.0f, 1.0f,	//side
-		 0.5f,  0.5f, -0.5f,  0.0f, 0.0f, -1.0f,  1.0f, 1.0f,
-		-0.5f,  0.5f, -0.5f,  0.0f, 0.0f, -1.0f,  0.0f, 1.0f,
-		-0.5f, -0.5f, -0.5f,  0.0f, 0.0f, -1.0f,  0.0f, 0.0f,
-		//positive z normals	text cord
-		-0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
-		 0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,
-		 0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,	//side
-		 0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
-		-0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 1.0f,
-		-0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
-		//negative x normals	text cord
-		-0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-		-0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
-		-0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,	//side
-		-0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-		-0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
-		-0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-		//positive x normals	text cord
-		0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-		0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
-		0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-		0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-		0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
-		0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-		//Negative Y Normals	text cord
-		-0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
-		 0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 1.0f,
-		 0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f, 1.0f, 0.0f,	//bottom
-		 0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
-		-0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 0.0f,
-		-0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
-		//Positive Y Normals	text cord
-		-0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
-		 0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
-		 0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
-		 0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,	//top
-		-0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
-		-0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f
-	};
-
-	//pyramid vertices
-	float pyramidV[] = {
-		//verts					//normals			//texture
-		-0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
-		 0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
-		 0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,	 //bottom
-		 0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
-		-0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
-		-0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
-
-		-0.5f,  0.5f, -0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,	//back bottom left
-		-0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,	//front bottom left
-		 0.0f,  1.5f,  0.0f,  0.0f,  0.0f,  1.0f,  0.5f, 1.0f,
-		-0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,	//front bottom left
-		 0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,	//front bottom right
-		 0.0f,  1.5f,  0.0f,  0.0f,  0.0f,  1.0f,  0.5f, 1.0f,
-
-		 0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,	//front bottom right
-		 0.5f,	0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,	//back bottom right
-		 0.0f,  1.5f,  0.0f,  1.0f,  0.0f,  0.0f,  0.5f, 1.0f,
-		 0.5f,	0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
-		-0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-		 0.0f,  1.5f,  0.0f,  1.0f,  0.0f,  0.0f,  0.5f, 1.0f
-	};
-
-	//milk carton vertices
-	float milkV[] = {
-		-0.5f,  -0.5f, -0.5f,	 0.0f, -1.0f,  0.0f,	 0.0f, 1.0f,
-		 0.5f,  -0.5f, -0.5f,	 0.0f, -1.0f,  0.0f,     1.0f, 1.0f,
-		 0.5f,  -0.5f,  0.5f,	 0.0f, -1.0f,  0.0f,	1.0f, 0.0f,	 //bottom
-		 0.5f,  -0.5f,  0.5f,	 0.0f, -1.0f,  0.0f,	1.0f, 0.0f,
-		-0.5f,  -0.5f,  0.5f,	 0.0f, -1.0f,  0.0f,	0.0f, 0.0f,
-		-0.5f,  -0.5f, -0.5f,	 0.0f, -1.0f,  0.0f,	0.0f, 1.0f,
-
-		-0.5f,  0.5f, -0.5f,	 1.0f,  0.0f,  0.0f,	0.0f, 1.0f,
-		 0.5f,  0.5f, -0.5f,	 1.0f,  0.0f,  0.0f,	1.0f, 1.0f,
-		 0.5f,  0.5f,  0.5f,	 1.0f,  0.0f,  0.0f,	1.0f, 0.0f,	 //top
-		 0.5f,  0.5f,  0.5f,	 1.0f,  0.0f,  0.0f,	1.0f, 0.0f,
-		-0.5f,  0.5f,  0.5f,	 1.0f,  0.0f,  0.0f,	0.0f, 0.0f,
-		-0.5f,  0.5f, -0.5f,	 1.0f,  0.0f,  0.0f,	0.0f, 1.0f,
-
-		-0.5f, -0.5f, -0.5f,	 0.0f, 0.0f, -1.0f,		0.0f, 0.0f,
-		 0.5f, -0.5f, -0.5f,	 0.0f, 0.0f, -1.0f,		1.0f, 0.0f,
-		 0.5f,  0.5f, -0.5f,	 0.0f, 0.0f, -1.0f,		1.0f, 1.0f,	//leftside
-		 0.5f,  0.5f, -0.5f,	 0.0f, 0.0f, -1.0f,		1.0f, 1.0f,
-		-0.5f,  0.5f, -0.5f,	 0.0f, 0.0f, -1.0f,		0.0f, 1.0f,
-		-0.5f, -0.5f, -0.5f,	 0.0f, 0.0f, -1.0f,		0.0f, 0.0f,
-
-		-0.5f, -0.5f,  0.5f,	0.0f,  0.0f,  1.0f,		0.0f, 0.0f,
-		 0.5f, -0.5f,  0.5f,	0.0f,  0.0f,  1.0f,		1.0f, 0.0f,
-		 0.5f,  0.5f,  0.5f,	0.0f,  0.0f,  1.0f,		1.0f, 1.0f,	//rightside
-		 0.5f,  0.5f,  0.5f,	0.0f,  0.0f,  1.0f,		1.0f, 1.0f,
-		-0.5f,  0.5f,  0.5f,	0.0f,  0.0f,  1.0f,		0.0f, 1.0f,
-		-0.5f, -0.5f,  0.5f,	0.0f,  0.0f,  1.0f,		0.0f, 0.0f,
-
-		-0.5f,  0.5f,  0.5f,	-1.0f,  0.0f,  0.0f,	1.0f, 1.0f,
-		-0.5f,  0.5f, -0.5f,	-1.0f,  0.0f,  0.0f,	0.0f, 1.0f,
-		-0.5f, -0.5f, -0.5f,	-1.0f,  0.0f,  0.0f,	0.0f, 0.0f,	//front side
-		-0.5f, -0.5f, -0.5f,	-1.0f,  0.0f,  0.0f,	0.0f, 0.0f,
-		-0.5f, -0.5f,  0.5f,	-1.0f,  0.0f,  0.0f,	1.0f, 0.0f,
-		-0.5f,  0.5f,  0.5f,	-1.0f,  0.0f,  0.0f,	1.0f, 1.0f,
-
-		 0.5f,  0.5f,  0.5f,	1.0f,  0.0f,  0.0f,		1.0f, 1.0f,
-		 0.5f,  0.5f, -0.5f,	1.0f,  0.0f,  0.0f,		0.0f, 1.0f,
-		 0.5f, -0.5f, -0.5f,	1.0f,  0.0f,  0.0f,		0.0f, 0.0f,	//back side
-		 0.5f, -0.5f, -0.5f,	1.0f,  0.0f,  0.0f,		0.0f, 0.0f,
-		 0.5f, -0.5f,  0.5f,	1.0f,  0.0f,  0.0f,		1.0f, 0.0f,
-		 0.5f,  0.5f,  0.5f,	1.0f,  0.0f,  0.0f,		1.0f, 1.0f,
-
-		 0.5f,  0.5f, -0.5f,	0.0f, 0.0f, -1.0f,		0.0f, 0.0f,
-		-0.5f,  0.5f, -0.5f,	0.0f, 0.0f, -1.0f,		1.0f, 0.0f,	//left top triangle
-		 0.0f,  1.0f, -0.5f,	0.0f, 0.0f, -1.0f,		0.5f, 1.0f,
-
-		-0.5f,  0.5f, 0.5f,		0.0f,  0.0f,  1.0f,		0.0f, 0.0f,
-		 0.5f,  0.5f, 0.5f,		0.0f,  1.0f,  0.5f,		1.0f, 0.0f,	//right top triangle
-		 0.0f,  1.0f, 0.5f,		0.0f,  1.0f,  0.5f,		0.5f, 1.0f,
-
-		-0.5f,  0.5f, -0.5f,	-1.0f,  0.0f,  0.0f,	0.0f, 0.0f,
-		-0.5f,  0.5f,  0.5f,	-1.0f,  0.0f,  0.0f,	1.0f, 0.0f,
-		 0.0f,  1.0f,  0.5f,	-1.0f,  0.0f,  0.0f,	1.0f, 1.0f,
-		-0.5f,  0.5f, -0.5f,	-1.0f,  0.0f,  0.0f,	0.0f, 0.0f,
-		 0.0f,  1.0f, -0.5f,	-1.0f,  0.0f,  0.0f,	0.0f, 1.0f,
-		 0.0f,  1.0f,  0.5f,	-1.0f,  0.0f,  0.0f,	1.0f, 1.0f,
-
-		 0.5f,  0.5f,  0.5f,	1.0f,  0.0f,  0.0f,		0.0f, 0.0f,
-		 0.5f,  0.5f, -0.5f,	1.0f,  0.0f,  0.0f,		1.0f, 0.0f,
-		 0.0f,  1.0f, -0.5f,	1.0f,  0.0f,  0.0f,		1.0f, 1.0f,
-		 0.5f,  0.5f,  0.5f,	1.0f,  0.0f,  0.0f,		0.0f, 0.0f,
-		 0.0f,  1.0f,  0.5f,	1.0f,  0.0f,  0.0f,		0.0f, 1.0f,
-		 0.0f,  1.0f, -0.5f,	1.0f,  0.0f,  0.0f,		1.0f, 1.0f
-	};
-
-	float lightCubeV[] = {
-		//negative z normals	text cord
-			-0.5f, -0.5f, -0.5f, 0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
-			 0.5f, -0.5f, -0.5f, 0.0f,  0.0f, -1.0f,  1.0f, 0.0f,
-			 0.5f,  0.5f, -0.5f, 0.0f,  0.0f, -1.0f,  1.0f, 1.0f,	//side
-			 0.5f,  0.5f, -0.5f, 0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
-			-0.5f,  0.5f, -0.5f, 0.0f,  0.0f, -1.0f,  0.0f, 1.0f,
-			-0.5f, -0.5f, -0.5f, 0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
-			//positive z normals	text cord
-					-0.5f, -0.5f,  0.5f, 0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
-					 0.5f, -0.5f,  0.5f, 0.0f,  0.0f,  1.0f,  1.0f, 0.0f,
-					 0.5f,  0.5f,  0.5f, 0.0f,  0.0f,  1.0f,  1.0f, 1.0f,	//side
-					 0.5f,  0.5f,  0.5f, 0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
-					-0.5f,  0.5f,  0.5f, 0.0f,  0.0f,  1.0f,  0.0f, 1.0f,
-					-0.5f, -0.5f,  0.5f, 0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
-					//negative x normals	text cord
-							-0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-							-0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
-							-0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,	//side
-							-0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-							-0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
-							-0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-							//positive x normals	text cord
-									0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-									0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
-									0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-									0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-									0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
-									0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-									//Negative Y Normals	text cord
-											-0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
-											 0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 1.0f,
-											 0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f, 1.0f, 0.0f,	//bottom
-											 0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
-											-0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 0.0f,
-											-0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
-											//Positive Y Normals	text cord
-												-0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
-												 0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
-												 0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
-												 0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,	//top
-												-0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
-												-0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f
-	};
-
-
-	unsigned int planeVBO, planeVAO;
-	unsigned int pyramidVAO, pyramidVBO;
-	unsigned int milkVAO, milkVBO;
-	unsigned int lightingVAO;
-	unsigned int ballVAO, ballVBO;
-
-	//plane
-	//-----------------------------
-	glGenVertexArrays(1, &planeVAO);
-	glGenBuffers(1, &planeVBO);
-	glBindBuffer(GL_ARRAY_BUFFER, planeVBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(planeV), planeV, GL_STATIC_DRAW);
-
-	glBindVertexArray(planeVAO);
-
-	// position attribute
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
-	// normals attribute
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-	glEnableVertexAttribArray(1);
-	// texture chord attribute
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-	glEnableVertexAttribArray(2);
-
-	//pyramid
-	//-------------------------------
-	glGenVertexArrays(1, &pyramidVAO);
-	glGenBuffers(1, &pyramidVBO);
-	glBindBuffer(GL_ARRAY_BUFFER, pyramidVBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(pyramidV), pyramidV, GL_STATIC_DRAW);
-
-	glBindVertexArray(pyramidVAO);
-
-	// position attribute
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
-	// normals attribute
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-	glEnableVertexAttribArray(1);
-	// texture chord attribute
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-	glEnableVertexAttribArray(2);
-
-	//milk carton
-	//----------------------------
-	glGenVertexArrays(1, &milkVAO);
-	glGenBuffers(1, &milkVBO);
-	glBindBuffer(GL_ARRAY_BUFFER, milkVBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(milkV), milkV, GL_STATIC_DRAW);
-
-	glBindVertexArray(milkVAO);
-
-	// position attribute
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
-	// normals attribute
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-	glEnableVertexAttribArray(1);
-	// texture chord attribute
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-	glEnableVertexAttribArray(2);
-
-	//Sphere
-	//----------
-	glGenVertexArrays(1, &ballVAO);
-	glBindVertexArray(ballVAO);
-	glGenBuffers(1, &ballVBO);
-	glBindBuffer(GL_ARRAY_BUFFER, ballVBO);
-
-
-	//lighting cube VAOVBO
-	glGenVertexArrays(1, &lightingVAO);
-	glBindVertexArray(lightingVAO);
-
-	glBindBuffer(GL_ARRAY_BUFFER, planeVBO);
-	//glBufferData(GL_ARRAY_BUFFER, sizeof(lightCubeV), lightCubeV, GL_STATIC_DRAW);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
-
-	//plane Textures
-	unsigned int planeDiffuseMap = loadTexture("images/texWood.jpg");
-	unsigned int planeSpecularMap = loadTexture("images/texWood_specular.jpg");
-
-	//Pyramid Textures
-	unsigned int pyramidDiffuseMap = loadTexture("images/texPyramid.jpg");
-	unsigned int pyramidSpecularMap = loadTexture("images/texPyramid_specular.jpg");
-
-	//Milk textures
-	unsigned int milkDiffuseMap = loadTexture("images/texMilk.jpg");
-	unsigned int milkSpecularMap = loadTexture("images/texMilk_specular.jpg");
-
-	//CrystalBall Textures
-	unsigned int ballDiffuseMap = loadTexture("images/texCrystal.jpg");
-	unsigned int ballSpecularMap = loadTexture("images/texBall.jpg");
-
-
-
-	//activate shader and set diffuse and specular maps
-	lightingShader.use();
-	lightingShader.setInt("material.diffuse", 0);
-	lightingShader.setInt("material.specular", 1);
-
-	//creates sphere object from Sphere.h 
-	Sphere S(1, 60, 60);
-	float angle = 0.0f;
-
-	// render loop
-	// -----------
-	while (!glfwWindowShouldClose(window))
-	{
-		// per-frame time logic
-		// --------------------
-		float currentFrame = glfwGetTime();
-		deltaTime = currentFrame - lastFrame;
-		lastFrame = currentFrame;
-
-		// input
-		// -----
-		processInput(window);
-
-		lightPos[0] = xlight;
-		lightPos[1] = ylight;
-		lightPos[2] = zlight;
-
-		// render
-		// ------
-		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-		// activate shader
-		lightingShader.use();
-		lightingShader.setVec3("light.position", lightPos);
-		lightingShader.setVec3("light.direction", glm::vec3(0.5f, -1.0f, 0.5f));
-		lightingShader.setFloat("light.cutOff", glm::cos(glm::radians(12.5f)));
-		lightingShader.setVec3("viewPos", cameraPos);
-
-		//light properties
-		lightingShader.setVec3("light.ambient", 0.5f, 0.5f, 0.5f);
-		lightingShader.setVec3("light.diffuse", 1.3f, 1.3f, 1.3f);
-		lightingShader.setVec3("light.specular", 1.5f, 1.5f, 1.5f);
-		//Light math set for a distance of 100
-		lightingShader.setFloat("light.constant", 1.0f);
-		lightingShader.setFloat("light.linear", 0.045f);
-		lightingShader.setFloat("light.quadratic", 0.0075f);
-
-		//material properties
-		lightingShader.setFloat("material.shininess", 32.0f);
-		int width, height;
-		// pass projection matrix to shader (note that in this case it could change every frame)
-		glfwGetFramebufferSize(window, &width, &height);
-		glm::mat4 view = glm::lookAt(cameraPos, cameraPos + cameraFront, worldUp);
-		glm::mat4 projection = glm::perspective(glm::radians(fov), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
-
-		//change view and perspective depending on the selected mode
-		if (ortho) {
-			GLfloat oWidth = (GLfloat)width * 0.01f; // 10% the width
-			GLfloat oHeight = (GLfloat)height * 0.01f; //10% the height
-			view = glm::lookAt(cameraPos, getOrgin(), worldUp);
-			projection = glm::ortho(-oWidth, oWidth, -oHeight, oHeight, 0.1f, 150.0f);
-		}
-		else if (isOrbiting) {
-
-			camX = sinf(glfwGetTime()) * orbitRadius;
-			camZ = cosf(glfwGetTime()) * orbitRadius;
-
-			view = glm::lookAt(glm::vec3(camX, 2.5, camZ), glm::vec3(0.0, 0.0, 0.0), worldUp);
-			projection = glm::perspective(glm::radians(fov), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
-		}
-		else if (!ortho && !isOrbiting) {
-			view = glm::lookAt(cameraPos, cameraPos + cameraFront, worldUp);
-			projection = glm::perspective(glm::radians(fov), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
-		}
-
-		// camera/view transformation
-		lightingShader.setMat4("projection", projection);
-		lightingShader.setMat4("view", view);
-		glm::mat4 model = glm::mat4(1.0f);
-		lightingShader.setMat4("model", model);
-
-
-		//render PLANE
-		// -------------------------
-		//bind diffuse map
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, planeDiffuseMap);
-		//bind specular map
-		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, planeSpecularMap);
-		//set model to identity matrix
-		model = glm::mat4(1.0f);
-		model = glm::translate(model, glm::vec3(0.0f, 0.0f, -1.0f));
-		model = glm::scale(model, glm::vec3(7.0f, 1.0f, 7.0f));
-		//model = glm::rotate(model, glm::radians(angle), glm::vec3(1.0f, 0.3f, 0.5f));
-		lightingShader.setMat4("model", model);
-		glBindVertexArray(planeVAO);
-		glDrawArrays(GL_TRIANGLES, 0, 36);
-
-
-		//render PYRAMID
-		//---------------------
-		//bind diffuse map
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, pyramidDiffuseMap);
-		//bind specular map
-		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, pyramidSpecularMap);
-		//set model to identity matrix
-		model = glm::mat4(1.0f);
-		model = glm::translate(model, glm::vec3(-1.75f, -0.25f, -1.0f));
-		model = glm::scale(model, glm::vec3(1.5f, 1.5f, 1.5f));
-		angle = 45.00f;
-		model = glm::rotate(model, glm::radians(angle), glm::vec3(0.0f, 1.0f, 0.0f));
-		lightingShader.setMat4("model", model);
-		glBindVertexArray(pyramidVAO);
-		glDrawArrays(GL_TRIANGLES, 0, 24);
-
-
-		//render MILK CARTON
-		//---------------------
-		//bind diffuse map
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, milkDiffuseMap);
-		//bind specular map
-		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, milkSpecularMap);
-		//set model to identity matrix
-		model = glm::mat4(1.0f);
-		model = glm::translate(model, glm::vec3(0.0f, 1.75f, -1.5f));
-		angle = 45.0f;
-		model = glm::scale(model, glm::vec3(1.25f, 2.5f, 1.25f));
-		model = glm::rotate(model, glm::radians(angle), glm::vec3(0.0f, 1.0f, 0.0f));
-		lightingShader.setMat4("model", model);
-		glBindVertexArray(milkVAO);
-		glDrawArrays(GL_TRIANGLES, 0, 64);
-
-
-		//render CRYSTAL BALL
-		//--------------------
-		//bind diffuse map
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, ballDiffuseMap);
-		//bind specular map
-		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, ballSpecularMap);
-		glBindVertexArray(ballVAO);
-		//set model to identity matrix
-		model = glm::mat4(1.0f);
-		model = glm::translate(model, glm::vec3(1.0f, 1.15f, 0.00f));
-		model = glm::scale(model, glm::vec3(0.60f));
-		lightingShader.setFloat("material.shininess", 128.0f);
-		lightingShader.setMat4("model", model);
-		glBindVertexArray(lightingVAO);
-		S.Draw();
-
-
-		//activate the cube light shader
-		lightCubeShader.use();
-		lightCubeShader.setMat4("projection", projection);
-		lightCubeShader.setMat4("view", view);
-
-		//render cube light
-		model = glm::mat4(1.0f);
-		model = glm::translate(model, lightPos);
-		model = glm::scale(model, glm::vec3(0.3f));
-		lightCubeShader.setMat4("model", model);
-		glBindVertexArray(lightingVAO);
-		glDrawArrays(GL_TRIANGLES, 0, 36);
-
-		// glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
-		// -------------------------------------------------------------------------------
-		glfwSwapBuffers(window);
-		glfwPollEvents();
-		//checks for user mode switches
-		TransformCamera(window);
-	}
-
-	// optional: de-allocate all resources once they've outlived their purpose:
-	// ------------------------------------------------------------------------
-	glDeleteVertexArrays(1, &planeVAO);
-	glDeleteBuffers(1, &planeVBO);
-	glDeleteVertexArrays(1, &pyramidVAO);
-	glDeleteBuffers(1, &pyramidVBO);
-	glDeleteVertexArrays(1, &milkVAO);
-	glDeleteBuffers(1, &milkVBO);
-	glDeleteVertexArrays(1, &lightingVAO);
-
-
-	//delete textures
-	glDeleteTextures(1, &planeDiffuseMap);
-	glDeleteTextures(1, &planeSpecularMap);
-	glDeleteTextures(1, &pyramidDiffuseMap);
-	glDeleteTextures(1, &pyramidSpecularMap);
-	glDeleteTextures(1, &milkDiffuseMap);
-	glDeleteTextures(1, &milkSpecularMap);
-	glDeleteTextures(1, &ballDiffuseMap);
-	glDeleteTextures(1, &ballSpecularMap);
-	// glfw: terminate, clearing all previously allocated GLFW resources.
-	// ------------------------------------------------------------------
-	glfwTerminate();
-	return 0;
-}
-
-// process all input: query GLFW whether relevant keys are pressed/released this frame and react accordingly
-// ---------------------------------------------------------------------------------------------------------
-void processInput(GLFWwindow* window)
-{
-
-	float cameraOffset = cameraSpeed * deltaTime;
-
-	if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-		glfwSetWindowShouldClose(window, true);
-
-	//Light controls
-	if (glfwGetKey(window, GLFW_KEY_Y) == GLFW_PRESS)
-		ylight += 0.01;
-	if (glfwGetKey(window, GLFW_KEY_H) == GLFW_PRESS)
-		ylight -= 0.01;
-	if (glfwGetKey(window, GLFW_KEY_G) == GLFW_PRESS)
-		xlight -= 0.01;
-	if (glfwGetKey(window, GLFW_KEY_J) == GLFW_PRESS)
-		xlight += 0.01;
-	if (glfwGetKey(window, GLFW_KEY_M) == GLFW_PRESS)
-		zlight += 0.01;
-	if (glfwGetKey(window, GLFW_KEY_N) == GLFW_PRESS)
-		zlight -= 0.01;
-
-
-
-
-	//camera controls
-	if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-		cameraPos += cameraOffset * cameraFront;
-	if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-		cameraPos -= cameraOffset * cameraFront;
-	if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-		cameraPos -= glm::normalize(glm::cross(cameraFront, cameraUp)) * cameraOffset;
-	if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-		cameraPos += glm::normalize(glm::cross(cameraFront, cameraUp)) * cameraOffset;
-
-
-	//up and down movement
-	if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS)
-		cameraPos += cameraOffset * cameraUp;
-	if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS)
-		cameraPos -= cameraOffset * cameraUp;
-
-}
-
-// glfw: whenever the window size changed (by OS or user resize) this callback function executes
-// ---------------------------------------------------------------------------------------------
-void framebuffer_size_callback(GLFWwindow* window, int width, int height)
-{
-	// make sure the viewport matches the new window dimensions; note that width and 
-	// height will be significantly larger than specified on retina displays.
-	glViewport(0, 0, width, height);
-}
-
-void TransformCamera(GLFWwindow* window) {
-	//ortho perspective controls
-	if (glfwGetKey(window, GLFW_KEY_O) == GLFW_PRESS)
-		ortho = true;
-
-	//orbiting controls
-	if (glfwGetKey(window, GLFW_KEY_L) == GLFW_PRESS)
-		isOrbiting = true;
-
-	//resets the camera and app booleans
-	if (glfwGetKey(window, GLFW_KEY_F) == GLFW_PRESS)
-	{
-		resetCamera();
-		ortho = false;
-		isOrbiting = false;
-	}
-
-}
-
-// glfw: whenever the mouse moves, this callback is called
-// -------------------------------------------------------
-void mouse_callback(GLFWwindow* window, double xpos, double ypos)
-{
-
-	if (firstMouse)
-	{
-		lastX = xpos;
-		lastY = ypos;
-		firstMouse = false;
-	}
-
-	float xoffset = xpos - lastX;
-	float yoffset = lastY - ypos; // reversed since y-coordinates go from bottom to top
-	lastX = xpos;
-	lastY = ypos;
-
-	float sensitivity = 0.1f; // change this value to your liking
-	xoffset *= sensitivity;
-	yoffset *= sensitivity;
-
-	yaw += xoffset;
-	pitch += yoffset;
-
-	// make sure that when pitch is out of bounds, screen doesn't get flipped
-	if (pitch > 89.0f)
-		pitch = 89.0f;
-	if (pitch < -89.0f)
-		pitch = -89.0f;
-
-	glm::vec3 front = glm::vec3(1.0);
-	front.x = cos(glm::radians(yaw)) * cos(glm::radians(pitch));
-	front.y = sin(glm::radians(pitch));
-	front.z = sin(glm::radians(yaw)) * cos(glm::radians(pitch));
-	cameraFront = glm::normalize(front);
-}
-
-
-// glfw: whenever the mouse scroll wheel scrolls, this callback is called
-// ----------------------------------------------------------------------
-void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
-{
-	//restricts the camera speed between the min and max set global value
-	if (cameraSpeed <= MIN_CAMERA_SPEED) {
-		cameraSpeed = MIN_CAMERA_SPEED + 0.5f;
-	}
-	else if (cameraSpeed >= MAX_CAMERA_SPEED) {
-		cameraSpeed = MAX_CAMERA_SPEED - 0.5f;
-	}
-	else if ((cameraSpeed <= MAX_CAMERA_SPEED) && (cameraSpeed >= MIN_CAMERA_SPEED)) {
-
-		cameraSpeed += (float)yoffset;
-		cameraSpeed += (float)xoffset;
-	}
-
-	cameraOffset = cameraSpeed * deltaTime;
-
-	if (cameraSpeed > MAX_CAMERA_SPEED)
-		cameraSpeed--;
-	else if (cameraSpeed < MIN_CAMERA_SPEED)
-		cameraSpeed++;
-
-}
-
-static void resetCamera() {
-	//resets all basic lighting values
-	orgin = glm::vec3(0.0f, 1.5f, 0.0f);
-	cameraPos = glm::vec3(-5.5f, 4.0f, 5.0f);
-	cameraFront = glm::normalize(glm::vec3(1.0f, -0.75f, -1.0f));
-	worldUp = glm::vec3(0.0f, 3.0f, 0.0f);
-	cameraDir = glm::normalize(cameraPos - orgin);
-	cameraRight = glm::normalize(glm::cross(worldUp, cameraDir));
-	cameraUp = glm::normalize(glm::cross(cameraDir, cameraRight));
-	cameraSpeed = 1.5f;
-	firstMouse = true;
-	fov = 45.0f;
-}
-glm::vec3 getOrgin() {
-
-	orgin = cameraPos + cameraFront;
-	return orgin;
-}
-
-
-// utility function for loading a 2D texture from file
-// ---------------------------------------------------
-unsigned int loadTexture(char const* path)
-{
-	unsigned int textureID;
-	glGenTextures(1, &textureID);
-
-	int width, height, nrComponents;
-	unsigned char* data = stbi_load(path, &width, &height, &nrComponents, 0);
-	if (data)
-	{
-		GLenum format{};
-		if (nrComponents == 1)
-			format = GL_RED;
-		else if (nrComponents == 3)
-			format = GL_RGB;
-		else if (nrComponents == 4)
-			format = GL_RGBA;
-		stbi_set_flip_vertically_on_load(true);
-		glBindTexture(GL_TEXTURE_2D, textureID);
-		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-		glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-		glGenerateMipmap(GL_TEXTURE_2D);
-
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		stbi_image_free(data);
-	}
-	else
-	{
-		std::cout << "Texture failed to load at path: " << path << std::endl;
-		stbi_image_free(data);
-	}
-
-	return textureID;
-}
+﻿/*
+	Francis Naughton
+	SNHU CS-330
+	10/14/2022
+
+	You can scroll up and down to increase and decrease the camera's speed.
+
+	Light Object Controls
+	Y- light up
+	H- light down
+	G- light neg on x axis
+	J- light pos on x axis
+	N- light neg on z axis
+	M- light pos on z axis
+
+	Camera Movement
+	w forward
+	s backward
+	a left
+	d right
+	q up
+	e down
+
+	Modes
+	//reset camera with 'F' before switching modes
+	L- turn on orbit mode
+	O- turn on ortho mode
+
+	F- resets camera
+
+	Headless benchmark
+	OpenGLSample --headless [--frames N] [--size WxH]
+	renders the scene offscreen (no window needed) and prints CPU/GPU frame times
+
+	Instanced crystal balls
+	OpenGLSample [--headless] --balls N
+	adds a grid of N small crystal balls on the plane, all rendered with one instanced draw call
+
+	GPU-driven rendering (OpenGL 4.3)
+	OpenGLSample [--headless] --gpu-driven [--cpu-culling]
+	packs the static geometry into one buffer, culls it in a compute shader (or on the CPU)
+	and draws it with glMultiDrawElementsIndirect
+
+	Profiling
+	OpenGLSample [--headless] --profile trace.json
+	records CPU and GPU time of every PROFILE_SCOPE and writes them as a Chrome trace
+	(open in chrome://tracing or ui.perfetto.dev) when the program ends
+
+	Mesh generation benchmark
+	OpenGLSample --surface-benchmark [--vertices N]
+	generates spheres, cylinders and grids with N (default 10 million) vertices with the old
+	generators and the parametric surface engine and prints the timings, needs no OpenGL
+
+	Vertex layout benchmark
+	OpenGLSample --layout-benchmark [--frames N] [--size WxH]
+	draws many small cylinders and cubes offscreen with planar, interleaved and split position
+	vertex layouts, once with all attributes and once depth-only, and prints the GPU times
+
+	Compressed vertices
+	OpenGLSample [--headless] --compressed-vertices
+	draws the plane, pyramid and milk carton from 16-byte vertices (16-bit positions, 10_10_10_2
+	normals, half float texture coordinates) and prints bytes per vertex and reconstruction error
+
+	OBJ models
+	OpenGLSample [--headless] --model a.obj [--model b.obj ...]
+	places the models in a row on the plane, simplifies every one into a chain of levels of detail
+	(all models in parallel) and draws the level matching its size on screen
+
+	OpenGLSample [--headless] --model a.obj --cluster-culling
+	splits every level into meshlets of at most 64 vertices and 124 triangles and only draws the
+	meshlets inside the frustum that face the camera, prints how many were culled in the last frame
+
+	Mesh cache
+	OpenGLSample [--headless] [--mesh-cache DIR | --no-mesh-cache]
+	generated meshes (the crystal ball and its levels of detail) are shared between everyone using
+	the same parameters and stored in DIR (default meshcache), so later startups load instead of
+	generating them
+
+	Persistent mapping
+	OpenGLSample [--headless] [--no-persistent-mapping]
+	uniform blocks and culled meshlet indices are streamed through buffers that stay mapped
+	(OpenGL 4.4 or ARB_buffer_storage), this option maps and orphans them like on OpenGL 3.3 instead
+
+	Asynchronous meshes
+	OpenGLSample [--headless] --async-meshes [--upload-budget KB] [--upload-time US]
+	the crystal ball is always built on a worker thread while the scene loads; with this option the
+	render loop doesn't wait for it, but uploads at most KB (default 1024) kilobytes of it per frame,
+	or stops after US microseconds, and draws the ball from the frame its upload is complete
+
+	GPU memory
+	OpenGLSample --headless [--list-resources]
+	every buffer, texture, renderbuffer and shader program is accounted for with its size and owner,
+	the headless benchmark prints the memory of every owner, this option also lists every object
+	with the place it was created at; objects still alive after the scene is gone are printed as leaks
+
+	OBJ loading benchmark
+	OpenGLSample --obj-benchmark [--obj-file FILE] [--obj-size MB]
+	loads FILE (or a generated model of MB megabytes, default 128) with the old fscanf loader and the
+	memory mapped parser on one and on all cores, prints the timings and checks the outputs match,
+	needs no OpenGL
+
+*/
+
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h >
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "Sphere.h"
+
+#include "shader.h"
+#include "camera.h"
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <algorithm>
+#include <string>
+
+#include "cylinder.h"
+
+#include "common/headlessContext.h"
+#include "common/offscreenFramebuffer.h"
+#include "common/frameBenchmark.h"
+#include "common/uniformBlocks.h"
+#include "common/uniformRingBuffer.h"
+#include "common/renderQueue.h"
+#include "common/frustumCuller.h"
+#include "common/geometryPool.h"
+#include "common/glHandle.h"
+#include "common/indirectDrawList.h"
+#include "common/materialLibrary.h"
+#include "common/profiler.h"
+#include "common/fixedStepSimulation.h"
+#include "common/surfaceBenchmark.h"
+#include "common/objBenchmark.h"
+#include "common/layoutBenchmark.h"
+#include "common/vertexCompression.h"
+#include "common/lodMesh.h"
+#include "common/meshRegistry.h"
+#include "common/meshUploadQueue.h"
+#include "common/resourceTracker.h"
+#include "common/streamBuffer.h"
+
+/*Shader program Macro*/
+#ifndef GLSL
+#define GLSL(Version, Source) "#version " #Version " core \n" #Source
+#endif
+
+
+
+void framebuffer_size_callback(GLFWwindow* window, int width, int height);
+void mouse_callback(GLFWwindow* window, double xpos, double ypos);
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
+void processInput(GLFWwindow* window, SimulationInput& input);
+static void resetCamera();
+void TransformCamera(GLFWwindow* window);
+
+struct LaunchOptions;
+static bool parseLaunchOptions(int argc, char** argv, LaunchOptions& options);
+static int runHeadlessBenchmark(const LaunchOptions& options);
+static void runRenderLoop(GLFWwindow* window, const LaunchOptions& options);
+
+float xlight = -1.2f, ylight = 1.0f, zlight = 2.0f;
+
+// settings
+const unsigned int SCR_WIDTH = 800;
+const unsigned int SCR_HEIGHT = 600;
+const int HEADLESS_WARMUP_FRAMES = 10;
+const float RENDER_QUEUE_DEPTH_RANGE = 150.0f; // view depth range used for front-to-back sorting
+const int INDIRECT_MAX_OBJECTS = 64; // capacity of the GPU-driven draw list
+const size_t UNIFORM_RING_REGION_SIZE = 16 * 1024; // uniform block bytes available per frame
+
+// camera
+Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
+glm::vec3 orgin = glm::vec3(0.0f, 1.5f, 0.0f);
+glm::vec3 cameraPos = glm::vec3(0.0f, 3.0f, 4.0f);
+glm::vec3 cameraFront = glm::vec3(0.0f, 0.0f, -1.0f);
+glm::vec3 worldUp = glm::vec3(0.0f, 1.0f, 0.0f);
+glm::vec3 cameraDir = glm::normalize(cameraPos - orgin);
+glm::vec3 cameraRight = glm::normalize(glm::cross(worldUp, cameraDir));
+glm::vec3 cameraUp = glm::normalize(glm::cross(cameraDir, cameraRight));
+
+glm::vec3 getOrgin();
+
+const float MAX_CAMERA_SPEED = 25.0f;
+const float MIN_CAMERA_SPEED = 1.0;
+
+bool firstMouse = true;
+float yaw = -90.0f;	// yaw is initialized to -90.0 degrees since a yaw of 0.0 results in a direction vector pointing to the right so we initially rotate a bit to the left.
+float pitch = 0.0f;
+float lastX = SCR_WIDTH / 2.0;
+float lastY = SCR_HEIGHT / 2.0;
+float fov = 45.0f;
+float xoffset, yoffset;
+
+//obiting
+float orbitRadius = 10.0f;
+float camX = sin(glfwGetTime()) * orbitRadius;
+float camZ = cos(glfwGetTime()) * orbitRadius;
+
+//camera position after pressing F, the simulation thread is told about every reset
+const glm::vec3 RESET_CAMERA_POS = glm::vec3(-5.5f, 4.0f, 5.0f);
+int cameraResetCount = 0;
+
+//booleans for varius modes
+bool ortho = false;
+bool isOrbiting = false;
+
+// timing
+float deltaTime = 0.0f;	// time between current frame and last frame
+float lastFrame = 0.0f;
+
+//camera speed
+float cameraSpeed = 1.5;
+float cameraOffset = cameraSpeed * deltaTime;
+
+//lighting 
+glm::vec3 lightPos(-1.2f, 2.0f, 2.0f);
+
+
+
+// command line options, e.g. "--headless --frames 1000 --size 1280x720"
+struct LaunchOptions
+{
+	bool headless = false;	// render offscreen into a framebuffer object and print frame timings
+	int frames = 500;		// number of frames rendered in headless mode
+	int width = SCR_WIDTH;	// size of the offscreen framebuffer in headless mode
+	int height = SCR_HEIGHT;
+	int balls = 0;			// number of extra crystal balls rendered with instancing
+	bool gpuDriven = false;	// cull and draw the static geometry with compute + multi-draw-indirect (OpenGL 4.3)
+	bool cpuCulling = false;	// with gpuDriven, write the indirect commands on the CPU instead
+	std::string profilePath;	// write a Chrome trace of the rendered frames to this file
+	bool surfaceBenchmark = false;	// only compare the mesh generators and exit
+	int vertices = surface_benchmark::DEFAULT_VERTICES;	// vertices per mesh for the surface benchmark
+	bool layoutBenchmark = false;	// only compare the StaticMesh3D vertex layouts offscreen and exit
+	bool objBenchmark = false;	// only compare the OBJ loaders and exit
+	std::string objBenchmarkPath;	// OBJ file for the OBJ benchmark, empty to generate one
+	int objBenchmarkMegabytes = obj_benchmark::DEFAULT_MEGABYTES;	// size of the generated OBJ file
+	bool compressedVertices = false;	// pack the plane, pyramid and milk carton vertices into 16 bytes
+	std::vector<std::string> modelPaths;	// OBJ files drawn with levels of detail
+	bool clusterCulling = false;	// cull the models per meshlet instead of per object
+	std::string meshCacheDirectory = "meshcache";	// generated meshes are stored here, empty to always generate
+	bool persistentMapping = true;	// stream per-frame data through persistently mapped buffers where supported
+	bool asyncMeshes = false;	// don't wait for the crystal ball, upload it over several frames instead
+	size_t uploadBudget = MeshUploadQueue::DEFAULT_BUDGET_BYTES;	// bytes of built meshes uploaded per frame
+	double uploadMicroseconds = 0.0;	// time per frame for uploading built meshes, 0 for no limit
+	bool listResources = false;	// list every OpenGL object in the GPU memory report, not only the owners
+};
+
+// Everything needed to draw the plane, pyramid, milk carton, crystal ball and light cube.
+// Shared by the windowed render loop and the headless benchmark, so both render the exact same scene.
+// Needs a current OpenGL context for its whole lifetime.
+class Scene
+{
+public:
+	// options.balls extra crystal balls are placed in a grid on the plane,
+	// options.gpuDriven moves the static geometry into one pool drawn with multi-draw-indirect
+	Scene(const LaunchOptions& options);
+	~Scene();
+
+	// clears the bound framebuffer and draws the whole scene, viewportHeight (pixels) drives the sphere LOD
+	void render(const glm::mat4& view, const glm::mat4& projection, int viewportHeight);
+
+	// level of detail the crystal ball was drawn with in the last frame, 0 is the finest
+	int getBallLod() const { return ballLod; }
+	const Sphere& getCrystalBall() const { return crystalBall; }
+	const MeshRegistry& getMeshRegistry() const { return meshRegistry; }
+	const MeshUploadQueue& getUploadQueue() const { return uploadQueue; }
+
+	// waits for all meshes still being built and uploads them at once, returns how many became drawable
+	int finishUploads() { return uploadQueue.finish(); }
+	// frames rendered before the crystal ball could be drawn, 0 unless it is uploaded asynchronously
+	int getBallWaitFrames() const { return ballWaitFrames; }
+	const UniformRingBuffer& getUniformRing() const { return uniformRing; }
+
+	// draw packet queue, holds the state change counters of the last rendered frame
+	const RenderQueue& getRenderQueue() const { return renderQueue; }
+
+	// frustum culling results of the last rendered frame
+	const FrustumCuller& getFrustumCuller() const { return frustumCuller; }
+
+	// OBJ models and the level of detail each was drawn with in the last frame
+	const std::vector<LodMesh>& getModels() const { return models; }
+	int getModelLod(int model) const { return modelLods[model]; }
+
+	// compares the GPU-written indirect commands of the last frame with the CPU fallback
+	void printIndirectDrawReport(const glm::mat4& viewProjection, std::ostream& os);
+
+private:
+	Shader lightingShader;
+	Shader lightCubeShader;
+	Shader instancedLightingShader;
+	MeshRegistry meshRegistry;	// before the meshes using it, so it outlives them
+	MeshUploadQueue uploadQueue;	// after the registry, so its workers stop before the registry goes away
+	MeshUploadQueue::Budget uploadBudget;
+	Sphere crystalBall;
+	int ballWaitFrames = 0;
+	InstanceBuffer ballInstances;
+	std::vector<glm::vec3> ballInstanceCenters;	// the nearest instanced ball picks the LOD of all of them
+	float ballInstanceScale = 0.0f;	// radius of the instanced balls relative to the crystal ball
+	int ballLod = 0, instancedBallsLod = 0;
+	UniformRingBuffer uniformRing;
+	RenderQueue renderQueue;
+	FrustumCuller frustumCuller;
+	std::vector<DrawPacket> culledDraws;	// draws of the current frame waiting for the culling result
+
+	GLBuffer planeVBO, pyramidVBO, milkVBO;
+	GLVertexArray planeVAO, pyramidVAO, milkVAO;
+	GLVertexArray lightingVAO;
+
+	// model space bounds of the vertex arrays (the light cube uses the plane's vertices)
+	BoundingVolume planeBounds, pyramidBounds, milkBounds;
+	int planeVertexCount, pyramidVertexCount, milkVertexCount;
+
+	// objects that never move
+	glm::mat4 planeModel, pyramidModel, milkModel, ballModel;
+
+	// maps 16-bit positions back to model space, identity for float vertices
+	glm::mat4 planeDecode, pyramidDecode, milkDecode;
+
+	// OBJ models with levels of detail, standing in a row on the plane
+	std::vector<LodMesh> models;
+	std::vector<glm::mat4> modelTransforms;
+	std::vector<int> modelLods;
+	bool useClusterCulling = false;
+
+	// GPU-driven path: plane, pyramid, milk carton and light cube in one geometry pool
+	bool useIndirectDraws = false;
+	std::unique_ptr<Shader> indirectLightingShader;
+	std::unique_ptr<Shader> indirectLightCubeShader;
+	GeometryPool geometryPool;
+	IndirectDrawList indirectDraws;
+	int litBatch, lightCubeBatch;
+	int lightCubeObject;
+
+	// diffuse and specular maps of every object, one texture array layer per material
+	MaterialLibrary materials;
+	int planeMaterial, pyramidMaterial, milkMaterial, ballMaterial;
+};
+
+
+int main(int argc, char** argv)
+{
+	LaunchOptions options;
+	if (!parseLaunchOptions(argc, argv, options))
+		return -1;
+
+	if (options.surfaceBenchmark)
+		return surface_benchmark::run(options.vertices, std::cout);
+
+	if (options.objBenchmark)
+		return obj_benchmark::run(options.objBenchmarkPath, options.objBenchmarkMegabytes, std::cout);
+
+	if (options.headless || options.layoutBenchmark)
+		return runHeadlessBenchmark(options);
+
+	// glfw: initialize and configure
+	// ------------------------------
+	glfwInit();
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+#ifdef __APPLE__
+	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+
+	// glfw window creation
+	// --------------------
+	GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Francis Naughton Final Scene", NULL, NULL);
+	if (window == NULL)
+	{
+		std::cout << "Failed to create GLFW window" << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+	glfwMakeContextCurrent(window);
+	glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+	glfwSetCursorPosCallback(window, mouse_callback);
+	glfwSetScrollCallback(window, scroll_callback);
+
+	// tell GLFW to capture our mouse
+	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+
+	// glad: load all OpenGL function pointers
+	// ---------------------------------------
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+	{
+		std::cout << "Failed to initialize GLAD" << std::endl;
+		return -1;
+	}
+	if (options.persistentMapping) {
+		StreamBuffer::loadPersistentMapping((GLADloadproc)glfwGetProcAddress);
+	}
+
+	// configure global opengl state
+	// -----------------------------
+	glEnable(GL_DEPTH_TEST);
+
+	runRenderLoop(window, options);
+
+	// the scene is gone, whatever is still tracked after deleting the queued objects leaked
+	GLDeletionQueue::get().flush();
+	if (ResourceTracker::get().getUsage().getTotalCount() > 0)
+		ResourceTracker::get().printReport("Leaked GPU objects", true, std::cout);
+
+	// glfw: terminate, clearing all previously allocated GLFW resources.
+	// ------------------------------------------------------------------
+	glfwTerminate();
+	return 0;
+}
+
+// window render loop; the scene lives in here so it is destroyed before the context goes away
+// ----------------------------------------------------------------------------------------------
+static void runRenderLoop(GLFWwindow* window, const LaunchOptions& options)
+{
+	Scene scene(options);
+
+	// light, camera position and orbit angle are simulated with a fixed tick on their own thread,
+	// the loop below only samples input and renders the interpolated state
+	FixedStepSimulation simulation;
+	SimulationState initialState;
+	initialState.lightPosition = glm::vec3(xlight, ylight, zlight);
+	initialState.cameraPosition = cameraPos;
+	simulation.start(initialState);
+
+	// without --profile the profiler is never created and all scopes do nothing
+	Profiler& profiler = Profiler::get();
+	if (!options.profilePath.empty())
+	{
+		profiler.create();
+		profiler.startCapture();
+	}
+
+	// render loop
+	// -----------
+	while (!glfwWindowShouldClose(window))
+	{
+		profiler.beginFrame();
+
+		// per-frame time logic
+		// --------------------
+		float currentFrame = glfwGetTime();
+		deltaTime = currentFrame - lastFrame;
+		lastFrame = currentFrame;
+
+		// input
+		// -----
+		{
+			PROFILE_SCOPE("input");
+			SimulationInput input;
+			processInput(window, input);
+			simulation.setInput(input);
+		}
+
+		const SimulationState state = simulation.getInterpolatedState();
+		lightPos = state.lightPosition;
+		cameraPos = state.cameraPosition;
+
+		int width, height;
+		// pass projection matrix to shader (note that in this case it could change every frame)
+		glfwGetFramebufferSize(window, &width, &height);
+		glm::mat4 view = glm::lookAt(cameraPos, cameraPos + cameraFront, worldUp);
+		glm::mat4 projection = glm::perspective(glm::radians(fov), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+
+		//change view and perspective depending on the selected mode
+		if (ortho) {
+			GLfloat oWidth = (GLfloat)width * 0.01f; // 10% the width
+			GLfloat oHeight = (GLfloat)height * 0.01f; //10% the height
+			view = glm::lookAt(cameraPos, getOrgin(), worldUp);
+			projection = glm::ortho(-oWidth, oWidth, -oHeight, oHeight, 0.1f, 150.0f);
+		}
+		else if (isOrbiting) {
+
+			camX = sinf(state.orbitAngle) * orbitRadius;
+			camZ = cosf(state.orbitAngle) * orbitRadius;
+
+			view = glm::lookAt(glm::vec3(camX, 2.5, camZ), glm::vec3(0.0, 0.0, 0.0), worldUp);
+			projection = glm::perspective(glm::radians(fov), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+		}
+		else if (!ortho && !isOrbiting) {
+			view = glm::lookAt(cameraPos, cameraPos + cameraFront, worldUp);
+			projection = glm::perspective(glm::radians(fov), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+		}
+
+		scene.render(view, projection, height);
+
+		// glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
+		// -------------------------------------------------------------------------------
+		{
+			PROFILE_SCOPE("glfwSwapBuffers");
+			glfwSwapBuffers(window);
+		}
+		glfwPollEvents();
+		//checks for user mode switches
+		TransformCamera(window);
+
+		profiler.endFrame();
+	}
+	simulation.stop();
+
+	if (!options.profilePath.empty())
+	{
+		profiler.stopCapture();
+		if (profiler.writeChromeTrace(options.profilePath))
+			std::cout << "Wrote " << profiler.getNumCapturedFrames() << " profiled frames to " << options.profilePath << std::endl;
+	}
+	profiler.deleteProfiler();
+}
+
+// radius in pixels of a sphere on screen, used to pick the sphere LOD
+// -------------------------------------------------------------------
+static float projectedRadius(const glm::vec3& center, float radius, const glm::mat4& view, const glm::mat4& projection, int viewportHeight)
+{
+	const float halfHeight = 0.5f * viewportHeight * projection[1][1];
+
+	// orthographic projections keep the size at any distance
+	if (projection[2][3] == 0.0f)
+		return radius * halfHeight;
+
+	// a camera inside or right next to the sphere gets the finest level
+	const float viewDepth = -(view * glm::vec4(center, 1.0f)).z;
+	return radius * halfHeight / std::max(viewDepth, 0.001f);
+}
+
+// spotlight at the light cube position; light math set for a distance of 100
+// ---------------------------------------------------------------------------
+static LightBlock makeLightBlock(const glm::vec3& position)
+{
+	LightBlock block = {};
+	block.position = glm::vec4(position, 1.0f);
+	block.direction = glm::vec4(0.5f, -1.0f, 0.5f, 0.0f);
+	block.cutOff = glm::cos(glm::radians(12.5f));
+
+	//light properties
+	block.ambient = glm::vec4(0.5f, 0.5f, 0.5f, 0.0f);
+	block.diffuse = glm::vec4(1.3f, 1.3f, 1.3f, 0.0f);
+	block.specular = glm::vec4(1.5f, 1.5f, 1.5f, 0.0f);
+	block.constant = 1.0f;
+	block.linear = 0.045f;
+	block.quadratic = 0.0075f;
+	return block;
+}
+
+Scene::Scene(const LaunchOptions& options)
+	: lightingShader("shaderfiles/5.4.light_casters.vs", "shaderfiles/5.4.light_casters.fs")
+	, lightCubeShader("shaderfiles/5.4.light_cube.vs", "shaderfiles/5.4.light_cube.fs")
+	, instancedLightingShader("shaderfiles/5.4.light_casters_instanced.vs", "shaderfiles/5.4.light_casters.fs")
+	, meshRegistry(options.meshCacheDirectory)
+	//creates sphere object from Sphere.h, built on a worker while the rest of the scene loads
+	, crystalBall(meshRegistry, uploadQueue, 1, 60, 60)
+{
+	uploadBudget.maxBytes = options.uploadBudget;
+	uploadBudget.maxMicroseconds = options.uploadMicroseconds;
+
+	// set up vertex data (and buffer(s)) and configure vertex attributes
+	// ------------------------------------------------------------------
+	float planeV[] = {
+
+		//negative  z normals	      text cord
+		-0.5f, -0.5f, -0.5f,  0.0f, 0.0f, -1.0f,  0.0f, 0.0f,
+		 0.5f, -0.5f, -0.5f,  0.0f, 0.0f, -1.0f,  1.0f, 0.0f,
+		 0.5f,  0.5f, -0.5f,  0.0f, 0.0f, -1.0f,  1.0f, 1.0f,	//side
+		 0.5f,  0.5f, -0.5f,  0.0f, 0.0f, -1.0f,  1.0f, 1.0f,
+		-0.5f,  0.5f, -0.5f,  0.0f, 0.0f, -1.0f,  0.0f, 1.0f,
+		-0.5f, -0.5f, -0.5f,  0.0f, 0.0f, -1.0f,  0.0f, 0.0f,
+		//positive z normals	text cord
+		-0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
+		 0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,
+		 0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,	//side
+		 0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
+		-0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 1.0f,
+		-0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
+		//negative x normals	text cord
+		-0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+		-0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
+		-0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,	//side
+		-0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+		-0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+		-0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+		//positive x normals	text cord
+		0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+		0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
+		0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+		0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+		0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+		0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+		//Negative Y Normals	text cord
+		-0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
+		 0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 1.0f,
+		 0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f, 1.0f, 0.0f,	//bottom
+		 0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
+		-0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 0.0f,
+		-0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
+		//Positive Y Normals	text cord
+		-0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
+		 0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
+		 0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
+		 0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,	//top
+		-0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
+		-0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f
+	};
+
+	//pyramid vertices
+	float pyramidV[] = {
+		//verts					//normals			//texture
+		-0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
+		 0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
+		 0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,	 //bottom
+		 0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
+		-0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
+		-0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
+
+		-0.5f,  0.5f, -0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,	//back bottom left
+		-0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,	//front bottom left
+		 0.0f,  1.5f,  0.0f,  0.0f,  0.0f,  1.0f,  0.5f, 1.0f,
+		-0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,	//front bottom left
+		 0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,	//front bottom right
+		 0.0f,  1.5f,  0.0f,  0.0f,  0.0f,  1.0f,  0.5f, 1.0f,
+
+		 0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,	//front bottom right
+		 0.5f,	0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,	//back bottom right
+		 0.0f,  1.5f,  0.0f,  1.0f,  0.0f,  0.0f,  0.5f, 1.0f,
+		 0.5f,	0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+		-0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+		 0.0f,  1.5f,  0.0f,  1.0f,  0.0f,  0.0f,  0.5f, 1.0f
+	};
+
+	//milk carton vertices
+	float milkV[] = {
+		-0.5f,  -0.5f, -0.5f,	 0.0f, -1.0f,  0.0f,	 0.0f, 1.0f,
+		 0.5f,  -0.5f, -0.5f,	 0.0f, -1.0f,  0.0f,     1.0f, 1.0f,
+		 0.5f,  -0.5f,  0.5f,	 0.0f, -1.0f,  0.0f,	1.0f, 0.0f,	 //bottom
+		 0.5f,  -0.5f,  0.5f,	 0.0f, -1.0f,  0.0f,	1.0f, 0.0f,
+		-0.5f,  -0.5f,  0.5f,	 0.0f, -1.0f,  0.0f,	0.0f, 0.0f,
+		-0.5f,  -0.5f, -0.5f,	 0.0f, -1.0f,  0.0f,	0.0f, 1.0f,
+
+		-0.5f,  0.5f, -0.5f,	 1.0f,  0.0f,  0.0f,	0.0f, 1.0f,
+		 0.5f,  0.5f, -0.5f,	 1.0f,  0.0f,  0.0f,	1.0f, 1.0f,
+		 0.5f,  0.5f,  0.5f,	 1.0f,  0.0f,  0.0f,	1.0f, 0.0f,	 //top
+		 0.5f,  0.5f,  0.5f,	 1.0f,  0.0f,  0.0f,	1.0f, 0.0f,
+		-0.5f,  0.5f,  0.5f,	 1.0f,  0.0f,  0.0f,	0.0f, 0.0f,
+		-0.5f,  0.5f, -0.5f,	 1.0f,  0.0f,  0.0f,	0.0f, 1.0f,
+
+		-0.5f, -0.5f, -0.5f,	 0.0f, 0.0f, -1.0f,		0.0f, 0.0f,
+		 0.5f, -0.5f, -0.5f,	 0.0f, 0.0f, -1.0f,		1.0f, 0.0f,
+		 0.5f,  0.5f, -0.5f,	 0.0f, 0.0f, -1.0f,		1.0f, 1.0f,	//leftside
+		 0.5f,  0.5f, -0.5f,	 0.0f, 0.0f, -1.0f,		1.0f, 1.0f,
+		-0.5f,  0.5f, -0.5f,	 0.0f, 0.0f, -1.0f,		0.0f, 1.0f,
+		-0.5f, -0.5f, -0.5f,	 0.0f, 0.0f, -1.0f,		0.0f, 0.0f,
+
+		-0.5f, -0.5f,  0.5f,	0.0f,  0.0f,  1.0f,		0.0f, 0.0f,
+		 0.5f, -0.5f,  0.5f,	0.0f,  0.0f,  1.0f,		1.0f, 0.0f,
+		 0.5f,  0.5f,  0.5f,	0.0f,  0.0f,  1.0f,		1.0f, 1.0f,	//rightside
+		 0.5f,  0.5f,  0.5f,	0.0f,  0.0f,  1.0f,		1.0f, 1.0f,
+		-0.5f,  0.5f,  0.5f,	0.0f,  0.0f,  1.0f,		0.0f, 1.0f,
+		-0.5f, -0.5f,  0.5f,	0.0f,  0.0f,  1.0f,		0.0f, 0.0f,
+
+		-0.5f,  0.5f,  0.5f,	-1.0f,  0.0f,  0.0f,	1.0f, 1.0f,
+		-0.5f,  0.5f, -0.5f,	-1.0f,  0.0f,  0.0f,	0.0f, 1.0f,
+		-0.5f, -0.5f, -0.5f,	-1.0f,  0.0f,  0.0f,	0.0f, 0.0f,	//front side
+		-0.5f, -0.5f, -0.5f,	-1.0f,  0.0f,  0.0f,	0.0f, 0.0f,
+		-0.5f, -0.5f,  0.5f,	-1.0f,  0.0f,  0.0f,	1.0f, 0.0f,
+		-0.5f,  0.5f,  0.5f,	-1.0f,  0.0f,  0.0f,	1.0f, 1.0f,
+
+		 0.5f,  0.5f,  0.5f,	1.0f,  0.0f,  0.0f,		1.0f, 1.0f,
+		 0.5f,  0.5f, -0.5f,	1.0f,  0.0f,  0.0f,		0.0f, 1.0f,
+		 0.5f, -0.5f, -0.5f,	1.0f,  0.0f,  0.0f,		0.0f, 0.0f,	//back side
+		 0.5f, -0.5f, -0.5f,	1.0f,  0.0f,  0.0f,		0.0f, 0.0f,
+		 0.5f, -0.5f,  0.5f,	1.0f,  0.0f,  0.0f,		1.0f, 0.0f,
+		 0.5f,  0.5f,  0.5f,	1.0f,  0.0f,  0.0f,		1.0f, 1.0f,
+
+		 0.5f,  0.5f, -0.5f,	0.0f, 0.0f, -1.0f,		0.0f, 0.0f,
+		-0.5f,  0.5f, -0.5f,	0.0f, 0.0f, -1.0f,		1.0f, 0.0f,	//left top triangle
+		 0.0f,  1.0f, -0.5f,	0.0f, 0.0f, -1.0f,		0.5f, 1.0f,
+
+		-0.5f,  0.5f, 0.5f,		0.0f,  0.0f,  1.0f,		0.0f, 0.0f,
+		 0.5f,  0.5f, 0.5f,		0.0f,  1.0f,  0.5f,		1.0f, 0.0f,	//right top triangle
+		 0.0f,  1.0f, 0.5f,		0.0f,  1.0f,  0.5f,		0.5f, 1.0f,
+
+		-0.5f,  0.5f, -0.5f,	-1.0f,  0.0f,  0.0f,	0.0f, 0.0f,
+		-0.5f,  0.5f,  0.5f,	-1.0f,  0.0f,  0.0f,	1.0f, 0.0f,
+		 0.0f,  1.0f,  0.5f,	-1.0f,  0.0f,  0.0f,	1.0f, 1.0f,
+		-0.5f,  0.5f, -0.5f,	-1.0f,  0.0f,  0.0f,	0.0f, 0.0f,
+		 0.0f,  1.0f, -0.5f,	-1.0f,  0.0f,  0.0f,	0.0f, 1.0f,
+		 0.0f,  1.0f,  0.5f,	-1.0f,  0.0f,  0.0f,	1.0f, 1.0f,
+
+		 0.5f,  0.5f,  0.5f,	1.0f,  0.0f,  0.0f,		0.0f, 0.0f,
+		 0.5f,  0.5f, -0.5f,	1.0f,  0.0f,  0.0f,		1.0f, 0.0f,
+		 0.0f,  1.0f, -0.5f,	1.0f,  0.0f,  0.0f,		1.0f, 1.0f,
+		 0.5f,  0.5f,  0.5f,	1.0f,  0.0f,  0.0f,		0.0f, 0.0f,
+		 0.0f,  1.0f,  0.5f,	1.0f,  0.0f,  0.0f,		0.0f, 1.0f,
+		 0.0f,  1.0f, -0.5f,	1.0f,  0.0f,  0.0f,		1.0f, 1.0f
+	};
+
+	float lightCubeV[] = {
+		//negative z normals	text cord
+			-0.5f, -0.5f, -0.5f, 0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
+			 0.5f, -0.5f, -0.5f, 0.0f,  0.0f, -1.0f,  1.0f, 0.0f,
+			 0.5f,  0.5f, -0.5f, 0.0f,  0.0f, -1.0f,  1.0f, 1.0f,	//side
+			 0.5f,  0.5f, -0.5f, 0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
+			-0.5f,  0.5f, -0.5f, 0.0f,  0.0f, -1.0f,  0.0f, 1.0f,
+			-0.5f, -0.5f, -0.5f, 0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
+			//positive z normals	text cord
+					-0.5f, -0.5f,  0.5f, 0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
+					 0.5f, -0.5f,  0.5f, 0.0f,  0.0f,  1.0f,  1.0f, 0.0f,
+					 0.5f,  0.5f,  0.5f, 0.0f,  0.0f,  1.0f,  1.0f, 1.0f,	//side
+					 0.5f,  0.5f,  0.5f, 0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
+					-0.5f,  0.5f,  0.5f, 0.0f,  0.0f,  1.0f,  0.0f, 1.0f,
+					-0.5f, -0.5f,  0.5f, 0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
+					//negative x normals	text cord
+							-0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+							-0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
+							-0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,	//side
+							-0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+							-0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+							-0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+							//positive x normals	text cord
+									0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+									0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
+									0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+									0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+									0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+									0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+									//Negative Y Normals	text cord
+											-0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
+											 0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 1.0f,
+											 0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f, 1.0f, 0.0f,	//bottom
+											 0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
+											-0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 0.0f,
+											-0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
+											//Positive Y Normals	text cord
+												-0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
+												 0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
+												 0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
+												 0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,	//top
+												-0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
+												-0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f
+	};
+
+
+
+	// bounds for frustum culling, 8 floats per vertex
+	planeVertexCount = sizeof(planeV) / (8 * sizeof(float));
+	pyramidVertexCount = sizeof(pyramidV) / (8 * sizeof(float));
+	milkVertexCount = sizeof(milkV) / (8 * sizeof(float));
+	planeBounds = BoundingVolume::fromPositions(planeV, planeVertexCount, 8 * sizeof(float));
+	pyramidBounds = BoundingVolume::fromPositions(pyramidV, pyramidVertexCount, 8 * sizeof(float));
+	milkBounds = BoundingVolume::fromPositions(milkV, milkVertexCount, 8 * sizeof(float));
+
+	//plane
+	planeModel = glm::mat4(1.0f);
+	planeModel = glm::translate(planeModel, glm::vec3(0.0f, 0.0f, -1.0f));
+	planeModel = glm::scale(planeModel, glm::vec3(7.0f, 1.0f, 7.0f));
+
+	//pyramid
+	pyramidModel = glm::mat4(1.0f);
+	pyramidModel = glm::translate(pyramidModel, glm::vec3(-1.75f, -0.25f, -1.0f));
+	pyramidModel = glm::scale(pyramidModel, glm::vec3(1.5f, 1.5f, 1.5f));
+	pyramidModel = glm::rotate(pyramidModel, glm::radians(45.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+	//milk carton
+	milkModel = glm::mat4(1.0f);
+	milkModel = glm::translate(milkModel, glm::vec3(0.0f, 1.75f, -1.5f));
+	milkModel = glm::scale(milkModel, glm::vec3(1.25f, 2.5f, 1.25f));
+	milkModel = glm::rotate(milkModel, glm::radians(45.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+	//crystal ball
+	ballModel = glm::mat4(1.0f);
+	ballModel = glm::translate(ballModel, glm::vec3(1.0f, 1.15f, 0.00f));
+	ballModel = glm::scale(ballModel, glm::vec3(0.60f));
+
+	//materials, maps of different sizes are resampled to one common size
+	planeMaterial = materials.addMaterial("images/texWood.jpg", "images/texWood_specular.jpg");
+	pyramidMaterial = materials.addMaterial("images/texPyramid.jpg", "images/texPyramid_specular.jpg");
+	milkMaterial = materials.addMaterial("images/texMilk.jpg", "images/texMilk_specular.jpg");
+	ballMaterial = materials.addMaterial("images/texCrystal.jpg", "images/texBall.jpg");
+	materials.build();
+
+	// GPU-driven path, light cube reuses the plane's vertices like lightingVAO does
+	if (options.gpuDriven && !GLAD_GL_VERSION_4_3)
+		std::cout << "GPU-driven rendering needs OpenGL 4.3, falling back to the render queue" << std::endl;
+	else if (options.gpuDriven)
+	{
+		useIndirectDraws = true;
+		indirectLightingShader.reset(new Shader("shaderfiles/5.4.light_casters_indirect.vs", "shaderfiles/5.4.light_casters.fs"));
+		indirectLightCubeShader.reset(new Shader("shaderfiles/5.4.light_cube_indirect.vs", "shaderfiles/5.4.light_cube.fs"));
+
+		const int planeMesh = geometryPool.addMesh(planeV, planeVertexCount);
+		const int pyramidMesh = geometryPool.addMesh(pyramidV, pyramidVertexCount);
+		const int milkMesh = geometryPool.addMesh(milkV, milkVertexCount);
+		geometryPool.uploadToGPU();
+
+		indirectDraws.createDrawList(geometryPool, INDIRECT_MAX_OBJECTS, !options.cpuCulling);
+		// materials differ only by texture array layer, so all lit objects share one batch
+		litBatch = indirectDraws.addBatch();
+		indirectDraws.addObject(planeMesh, planeBounds, planeModel, 32.0f, planeMaterial);
+		indirectDraws.addObject(pyramidMesh, pyramidBounds, pyramidModel, 32.0f, pyramidMaterial);
+		indirectDraws.addObject(milkMesh, milkBounds, milkModel, 32.0f, milkMaterial);
+		lightCubeBatch = indirectDraws.addBatch();
+		lightCubeObject = indirectDraws.addObject(planeMesh, planeBounds, glm::mat4(1.0f), 0.0f);
+	}
+
+	// plane, pyramid and milk carton share one vertex layout, either the 8 floats above or packed into 16 bytes
+	// ---------------------------------------------------------------------------------------------------------
+	auto createVertexArray = [&](const char* name, const float* vertices, int vertexCount, GLVertexArray& vao, GLBuffer& vbo, glm::mat4& positionDecode)
+	{
+		vao = GLVertexArray::create();
+		vbo = GLBuffer::create();
+		glBindBuffer(GL_ARRAY_BUFFER, vbo.get());
+		glBindVertexArray(vao.get());
+		positionDecode = glm::mat4(1.0f);
+		TRACK_RESOURCE(BUFFER, vbo.get(), 0, "scene");
+
+		CompressedMesh compressed;
+		if (options.compressedVertices && compressed.compress(vertices, vertexCount, CompressedMesh::SourceLayout()))
+		{
+			glBufferData(GL_ARRAY_BUFFER, compressed.getByteSize(), compressed.getData(), GL_STATIC_DRAW);
+			ResourceTracker::get().resize(ResourceTracker::BUFFER, vbo.get(), compressed.getByteSize());
+			compressed.setupAttributes(0, 1, 2);
+			compressed.printStats(name, std::cout);
+			positionDecode = compressed.getPositionDecode();
+			return;
+		}
+
+		glBufferData(GL_ARRAY_BUFFER, vertexCount * 8 * sizeof(float), vertices, GL_STATIC_DRAW);
+		ResourceTracker::get().resize(ResourceTracker::BUFFER, vbo.get(), vertexCount * 8 * sizeof(float));
+		// position attribute
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+		glEnableVertexAttribArray(0);
+		// normals attribute
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
+		glEnableVertexAttribArray(1);
+		// texture chord attribute
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
+		glEnableVertexAttribArray(2);
+	};
+
+	createVertexArray("plane", planeV, planeVertexCount, planeVAO, planeVBO, planeDecode);
+	createVertexArray("pyramid", pyramidV, pyramidVertexCount, pyramidVAO, pyramidVBO, pyramidDecode);
+	createVertexArray("milk carton", milkV, milkVertexCount, milkVAO, milkVBO, milkDecode);
+
+	//lighting cube VAOVBO
+	lightingVAO = GLVertexArray::create();
+	glBindVertexArray(lightingVAO.get());
+
+	glBindBuffer(GL_ARRAY_BUFFER, planeVBO.get());
+	//glBufferData(GL_ARRAY_BUFFER, sizeof(lightCubeV), lightCubeV, GL_STATIC_DRAW);
+	if (options.compressedVertices)
+	{
+		// same packing as the plane's VAO, only the position is read
+		CompressedMesh compressed;
+		compressed.compress(planeV, planeVertexCount, CompressedMesh::SourceLayout());
+		compressed.setupAttributes(0);
+	}
+	else
+	{
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+		glEnableVertexAttribArray(0);
+	}
+
+	//activate shader and set diffuse and specular maps
+	lightingShader.use();
+	lightingShader.setInt("material.diffuse", MaterialLibrary::DIFFUSE_TEXTURE_UNIT);
+	lightingShader.setInt("material.specular", MaterialLibrary::SPECULAR_TEXTURE_UNIT);
+
+	// both shaders read camera and object state from uniform blocks
+	lightingShader.bindUniformBlock("Camera", CAMERA_BLOCK_BINDING);
+	lightingShader.bindUniformBlock("Light", LIGHT_BLOCK_BINDING);
+	lightingShader.bindUniformBlock("Object", OBJECT_BLOCK_BINDING);
+	lightCubeShader.bindUniformBlock("Camera", CAMERA_BLOCK_BINDING);
+	lightCubeShader.bindUniformBlock("Object", OBJECT_BLOCK_BINDING);
+	uniformRing.createRingBuffer(UNIFORM_RING_REGION_SIZE);
+
+	//instanced crystal balls, same material as the big one
+	instancedLightingShader.use();
+	instancedLightingShader.setInt("material.diffuse", MaterialLibrary::DIFFUSE_TEXTURE_UNIT);
+	instancedLightingShader.setInt("material.specular", MaterialLibrary::SPECULAR_TEXTURE_UNIT);
+	instancedLightingShader.bindUniformBlock("Camera", CAMERA_BLOCK_BINDING);
+	instancedLightingShader.bindUniformBlock("Light", LIGHT_BLOCK_BINDING);
+	instancedLightingShader.bindUniformBlock("Object", OBJECT_BLOCK_BINDING);
+
+	if (useIndirectDraws)
+	{
+		indirectLightingShader->use();
+		indirectLightingShader->setInt("material.diffuse", MaterialLibrary::DIFFUSE_TEXTURE_UNIT);
+		indirectLightingShader->setInt("material.specular", MaterialLibrary::SPECULAR_TEXTURE_UNIT);
+		indirectLightingShader->bindUniformBlock("Camera", CAMERA_BLOCK_BINDING);
+		indirectLightingShader->bindUniformBlock("Light", LIGHT_BLOCK_BINDING);
+		indirectLightCubeShader->bindUniformBlock("Camera", CAMERA_BLOCK_BINDING);
+	}
+
+	// models are simplified and split into meshlets on all cores, then uploaded on this thread
+	useClusterCulling = options.clusterCulling;
+	for (const auto& path : options.modelPaths)
+	{
+		LodMesh model;
+		if (model.loadOBJ(path.c_str()))
+			models.push_back(std::move(model));
+	}
+	LodMesh::generateLods(models);
+	for (size_t i = 0; i < models.size(); i++)
+	{
+		models[i].uploadToGPU();
+		models[i].printStats(std::cout);
+
+		// scaled to a bounding sphere of radius 0.5, standing on the plane (top at y = 0.5) in front of the pyramid
+		const BoundingVolume& bounds = models[i].getBounds();
+		const float scale = 0.5f / std::max(bounds.sphereRadius, 0.000001f);
+		glm::mat4 model = glm::mat4(1.0f);
+		model = glm::translate(model, glm::vec3(-2.5f + 1.25f * i, 0.5f, 1.5f));
+		model = glm::scale(model, glm::vec3(scale));
+		model = glm::translate(model, glm::vec3(-bounds.sphereCenter.x, -bounds.aabbMin.y, -bounds.sphereCenter.z));
+		modelTransforms.push_back(model);
+		modelLods.push_back(0);
+	}
+
+	const int numInstancedBalls = options.balls;
+	if (numInstancedBalls > 0)
+	{
+		// square grid covering the plane (top at y = 0.5), balls shrink as the grid gets denser
+		const int gridSize = (int)ceil(sqrt((float)numInstancedBalls));
+		const float spacing = 6.0f / gridSize;
+		const float ballRadius = spacing * 0.3f;
+		ballInstances.createInstanceBuffer(numInstancedBalls);
+		ballInstanceScale = ballRadius;
+		for (int i = 0; i < numInstancedBalls; i++)
+		{
+			const glm::vec3 center(-3.0f + spacing * (i % gridSize + 0.5f), 0.5f + ballRadius, -4.0f + spacing * (i / gridSize + 0.5f));
+			glm::mat4 model = glm::mat4(1.0f);
+			model = glm::translate(model, center);
+			model = glm::scale(model, glm::vec3(ballRadius));
+			ballInstances.setInstance(i, model);
+			ballInstanceCenters.push_back(center);
+		}
+		ballInstances.setInstanceCount(numInstancedBalls);
+		ballInstances.updateGPU();
+	}
+
+	// without asynchronous meshes the first frame already has everything
+	if (!options.asyncMeshes)
+	{
+		uploadQueue.finish();
+		crystalBall.checkReady();
+	}
+}
+
+void Scene::render(const glm::mat4& view, const glm::mat4& projection, int viewportHeight)
+{
+	PROFILE_SCOPE("render scene");
+
+	// meshes built since the last frame go to the GPU, as much as the budget allows
+	{
+		PROFILE_SCOPE("mesh uploads");
+		uploadQueue.processUploads(uploadBudget);
+	}
+	const bool isBallReady = crystalBall.checkReady();
+	if (!isBallReady)
+		ballWaitFrames++;
+
+	// render
+	// ------
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	// write this frame's uniform blocks into the ring buffer, draws below only bind ranges of it
+	size_t cameraBlockOffset, lightBlockOffset;
+	{
+		PROFILE_SCOPE("uniform setup");
+		uniformRing.beginFrame();
+
+		// camera/view transformation
+		CameraBlock cameraBlock;
+		cameraBlock.view = view;
+		cameraBlock.projection = projection;
+		cameraBlock.viewPos = glm::vec4(cameraPos, 1.0f);
+		cameraBlockOffset = uniformRing.push(cameraBlock);
+		lightBlockOffset = uniformRing.push(makeLightBlock(lightPos));
+	}
+
+	// every object becomes a draw packet, packets of objects outside the view frustum are dropped
+	// and the render queue decides the order of the rest and skips redundant binds
+	frustumCuller.setViewProjection(projection * view);
+	frustumCuller.clear();
+	culledDraws.clear();
+	// the material texture arrays stay bound for the whole frame, packets only carry the layer
+	// in their object block and leave the queue's texture units alone (texture 0)
+	// positionDecode maps compressed positions to model space, bounds stay in model space
+	auto submitDraw = [&](const char* name, const Shader& shader, int material, unsigned int vao, const glm::mat4& model, const glm::mat4& positionDecode,
+		float shininess, GLenum primitiveType, GLsizei count, GLint first, GLenum indexType, const BoundingVolume& bounds)
+	{
+		DrawPacket packet;
+		packet.name = name;
+		packet.program = shader.program.get();
+		packet.diffuseMap = 0;
+		packet.specularMap = 0;
+		packet.vao = vao;
+		packet.objectBlockOffset = uniformRing.push(makeObjectBlock(model, shininess, material, positionDecode));
+		packet.primitiveType = primitiveType;
+		packet.count = count;
+		packet.first = first;
+		packet.indexType = indexType;
+
+		const float viewDepth = -(view * model[3]).z;
+		packet.sortKey = RenderQueue::makeSortKey(packet.program, 0, 0, vao, viewDepth, RENDER_QUEUE_DEPTH_RANGE);
+
+		// culler and packet indices stay in sync, one object per packet
+		frustumCuller.addObject(bounds.transformed(model));
+		culledDraws.push_back(packet);
+	};
+
+	{
+		PROFILE_SCOPE("submit draws");
+
+		//cube light follows the light position
+		glm::mat4 lightCubeModel = glm::mat4(1.0f);
+		lightCubeModel = glm::translate(lightCubeModel, lightPos);
+		lightCubeModel = glm::scale(lightCubeModel, glm::vec3(0.3f));
+
+		if (useIndirectDraws)
+		{
+			// plane, pyramid, milk carton and light cube are culled and drawn from the geometry pool
+			indirectDraws.setObjectTransform(lightCubeObject, lightCubeModel);
+		}
+		else
+		{
+			submitDraw("render PLANE", lightingShader, planeMaterial, planeVAO.get(), planeModel, planeDecode, 32.0f, GL_TRIANGLES, planeVertexCount, 0, 0, planeBounds);
+			submitDraw("render PYRAMID", lightingShader, pyramidMaterial, pyramidVAO.get(), pyramidModel, pyramidDecode, 32.0f, GL_TRIANGLES, pyramidVertexCount, 0, 0, pyramidBounds);
+			submitDraw("render MILK CARTON", lightingShader, milkMaterial, milkVAO.get(), milkModel, milkDecode, 32.0f, GL_TRIANGLES, milkVertexCount, 0, 0, milkBounds);
+			//cube light, its shader samples no textures
+			submitDraw("render LIGHT CUBE", lightCubeShader, 0, lightingVAO.get(), lightCubeModel, planeDecode, 0.0f, GL_TRIANGLES, planeVertexCount, 0, 0, planeBounds);
+		}
+
+		//crystal ball, tessellation follows its size on screen, left out until its upload is complete
+		if (isBallReady)
+		{
+			const BoundingVolume ballWorldBounds = crystalBall.getBounds().transformed(ballModel);
+			ballLod = crystalBall.selectLod(projectedRadius(ballWorldBounds.sphereCenter, ballWorldBounds.sphereRadius, view, projection, viewportHeight), ballLod);
+			submitDraw("render CRYSTAL BALL", lightingShader, ballMaterial, crystalBall.getVAO(), ballModel, glm::mat4(1.0f), 128.0f, crystalBall.getPrimitiveType(),
+				crystalBall.getIndexCount(ballLod), crystalBall.getFirstIndex(ballLod), crystalBall.getIndexType(), crystalBall.getBounds());
+		}
+
+		//OBJ models, same material as the milk carton
+		for (size_t i = 0; i < models.size(); i++)
+		{
+			const BoundingVolume modelWorldBounds = models[i].getBounds().transformed(modelTransforms[i]);
+			modelLods[i] = models[i].selectLod(projectedRadius(modelWorldBounds.sphereCenter, modelWorldBounds.sphereRadius, view, projection, viewportHeight), modelLods[i]);
+			if (useClusterCulling)
+			{
+				// only meshlets facing the camera inside the frustum, compacted into one index range
+				const GLsizei indexCount = models[i].cullClusters(modelLods[i], modelTransforms[i], projection * view, glm::vec3(glm::inverse(view)[3]));
+				if (indexCount > 0)
+					submitDraw("render MODEL", lightingShader, milkMaterial, models[i].getClusterVAO(), modelTransforms[i], glm::mat4(1.0f), 32.0f, GL_TRIANGLES,
+						indexCount, models[i].getClusterFirstIndex(), models[i].getIndexType(), models[i].getBounds());
+				continue;
+			}
+			const LodMesh::Level& level = models[i].getLevel(modelLods[i]);
+			submitDraw("render MODEL", lightingShader, milkMaterial, models[i].getVAO(), modelTransforms[i], glm::mat4(1.0f), 32.0f, GL_TRIANGLES,
+				level.indexCount, level.firstIndex, models[i].getIndexType(), models[i].getBounds());
+		}
+
+		frustumCuller.cull();
+		renderQueue.clear();
+		for (size_t i = 0; i < culledDraws.size(); i++)
+		{
+			if (frustumCuller.isVisible((int)i))
+				renderQueue.submit(culledDraws[i]);
+		}
+	}
+
+	// all instanced balls share one object block, their transforms come from the instance buffer
+	size_t instancedBallsBlockOffset;
+	{
+		PROFILE_SCOPE("uniform upload");
+		instancedBallsBlockOffset = uniformRing.push(makeObjectBlock(glm::mat4(1.0f), 128.0f, ballMaterial));
+
+		uniformRing.flush();
+
+		// per-frame blocks are bound once and shared by both shaders
+		uniformRing.bindRange(CAMERA_BLOCK_BINDING, cameraBlockOffset, sizeof(CameraBlock));
+		uniformRing.bindRange(LIGHT_BLOCK_BINDING, lightBlockOffset, sizeof(LightBlock));
+	}
+
+	if (useIndirectDraws)
+	{
+		PROFILE_SCOPE("cull GEOMETRY POOL");
+		indirectDraws.cull(projection * view);
+	}
+
+	// one texture binding for all lit objects
+	{
+		PROFILE_SCOPE("render queue");
+		materials.bind();
+		renderQueue.execute(uniformRing);
+	}
+
+	//render GEOMETRY POOL, one multi-draw-indirect for all materials
+	//----------------------------------------------------------------
+	if (useIndirectDraws)
+	{
+		PROFILE_SCOPE("render GEOMETRY POOL");
+		indirectLightingShader->use();
+		indirectDraws.drawBatch(litBatch);
+
+		indirectLightCubeShader->use();
+		indirectDraws.drawBatch(lightCubeBatch);
+	}
+
+	//render INSTANCED CRYSTAL BALLS
+	//------------------------------
+	if (ballInstances.getInstanceCount() > 0 && isBallReady)
+	{
+		PROFILE_SCOPE("render INSTANCED CRYSTAL BALLS");
+		instancedLightingShader.use();
+		uniformRing.bindRange(OBJECT_BLOCK_BINDING, instancedBallsBlockOffset, sizeof(ObjectBlock));
+		const float ballInstanceRadius = crystalBall.getBounds().sphereRadius * ballInstanceScale;
+		float nearestRadius = 0.0f;
+		for (const auto& center : ballInstanceCenters)
+			nearestRadius = std::max(nearestRadius, projectedRadius(center, ballInstanceRadius, view, projection, viewportHeight));
+		instancedBallsLod = crystalBall.selectLod(nearestRadius, instancedBallsLod);
+		crystalBall.renderInstanced(ballInstances, instancedBallsLod);
+	}
+	uniformRing.endFrame();
+
+	// objects released during this frame are deleted once the GPU has finished it
+	GLDeletionQueue::get().endFrame();
+}
+
+void Scene::printIndirectDrawReport(const glm::mat4& viewProjection, std::ostream& os)
+{
+	if (!useIndirectDraws)
+		return;
+
+	std::vector<DrawElementsIndirectCommand> gpuCommands, cpuCommands;
+	indirectDraws.readBackCommands(gpuCommands);
+	indirectDraws.buildCommandsOnCPU(viewProjection, cpuCommands);
+
+	int visible = 0;
+	bool identical = gpuCommands.size() == cpuCommands.size();
+	for (size_t i = 0; i < gpuCommands.size() && identical; i++)
+	{
+		identical = memcmp(&gpuCommands[i], &cpuCommands[i], sizeof(DrawElementsIndirectCommand)) == 0;
+		visible += gpuCommands[i].instanceCount;
+	}
+
+	os << "Indirect draws (last frame): " << visible << " of " << indirectDraws.getNumObjects() << " objects visible, commands written by "
+		<< (indirectDraws.isUsingComputeCulling() ? "compute shader" : "CPU") << ", "
+		<< (identical ? "identical to" : "DIFFERENT from") << " the CPU fallback" << std::endl;
+}
+
+Scene::~Scene()
+{
+	// vertex arrays, buffers and shader programs are released by their handles,
+	// the rest is de-allocated explicitly:
+	// ------------------------------------------------------------------------
+
+	//delete textures
+	materials.deleteLibrary();
+
+	uniformRing.deleteRingBuffer();
+	ballInstances.deleteInstanceBuffer();
+	for (auto& model : models)
+		model.deleteMesh();
+	indirectDraws.deleteDrawList();
+	geometryPool.deletePool();
+}
+
+// parses "--headless", "--frames N", "--size WxH", "--balls N", "--gpu-driven", "--cpu-culling", "--profile FILE",
+// "--surface-benchmark", "--vertices N", "--layout-benchmark", "--compressed-vertices", "--model FILE", "--cluster-culling",
+// "--mesh-cache DIR", "--no-mesh-cache", "--no-persistent-mapping", "--async-meshes",
+// "--upload-budget KB", "--upload-time US", "--list-resources", "--obj-benchmark", "--obj-file FILE" and "--obj-size MB"
+// ---------------------------------------------------
+static bool parseLaunchOptions(int argc, char** argv, LaunchOptions& options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--headless") == 0)
+		{
+			options.headless = true;
+		}
+		else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+		{
+			options.frames = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--balls") == 0 && i + 1 < argc)
+		{
+			options.balls = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--gpu-driven") == 0)
+		{
+			options.gpuDriven = true;
+		}
+		else if (strcmp(argv[i], "--cpu-culling") == 0)
+		{
+			options.cpuCulling = true;
+		}
+		else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc)
+		{
+			options.profilePath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--surface-benchmark") == 0)
+		{
+			options.surfaceBenchmark = true;
+		}
+		else if (strcmp(argv[i], "--layout-benchmark") == 0)
+		{
+			options.layoutBenchmark = true;
+		}
+		else if (strcmp(argv[i], "--obj-benchmark") == 0)
+		{
+			options.objBenchmark = true;
+		}
+		else if (strcmp(argv[i], "--obj-file") == 0 && i + 1 < argc)
+		{
+			options.objBenchmarkPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--obj-size") == 0 && i + 1 < argc)
+		{
+			options.objBenchmarkMegabytes = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--vertices") == 0 && i + 1 < argc)
+		{
+			options.vertices = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--compressed-vertices") == 0)
+		{
+			options.compressedVertices = true;
+		}
+		else if (strcmp(argv[i], "--model") == 0 && i + 1 < argc)
+		{
+			options.modelPaths.push_back(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--cluster-culling") == 0)
+		{
+			options.clusterCulling = true;
+		}
+		else if (strcmp(argv[i], "--mesh-cache") == 0 && i + 1 < argc)
+		{
+			options.meshCacheDirectory = argv[++i];
+		}
+		else if (strcmp(argv[i], "--no-mesh-cache") == 0)
+		{
+			options.meshCacheDirectory.clear();
+		}
+		else if (strcmp(argv[i], "--no-persistent-mapping") == 0)
+		{
+			options.persistentMapping = false;
+		}
+		else if (strcmp(argv[i], "--async-meshes") == 0)
+		{
+			options.asyncMeshes = true;
+		}
+		else if (strcmp(argv[i], "--upload-budget") == 0 && i + 1 < argc)
+		{
+			options.uploadBudget = (size_t)std::max(1, atoi(argv[++i])) * 1024;
+		}
+		else if (strcmp(argv[i], "--upload-time") == 0 && i + 1 < argc)
+		{
+			options.uploadMicroseconds = std::max(0.0, atof(argv[++i]));
+		}
+		else if (strcmp(argv[i], "--list-resources") == 0)
+		{
+			options.listResources = true;
+		}
+		else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc)
+		{
+			if (sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2)
+			{
+				std::cout << "Invalid size '" << argv[i] << "', expected WxH (e.g. 800x600)" << std::endl;
+				return false;
+			}
+		}
+		else
+		{
+			std::cout << "Unknown option '" << argv[i] << "'" << std::endl;
+			std::cout << "Usage: OpenGLSample [--headless] [--frames N] [--size WxH] [--balls N] [--gpu-driven [--cpu-culling]] [--profile FILE] [--compressed-vertices] [--model FILE]... [--cluster-culling] [--mesh-cache DIR | --no-mesh-cache] [--no-persistent-mapping] [--async-meshes [--upload-budget KB] [--upload-time US]] [--list-resources]" << std::endl;
+			std::cout << "       OpenGLSample --surface-benchmark [--vertices N]" << std::endl;
+			std::cout << "       OpenGLSample --layout-benchmark [--frames N] [--size WxH]" << std::endl;
+			std::cout << "       OpenGLSample --obj-benchmark [--obj-file FILE] [--obj-size MB]" << std::endl;
+			return false;
+		}
+	}
+
+	if (options.balls < 0)
+	{
+		std::cout << "Number of balls can't be negative" << std::endl;
+		return false;
+	}
+
+	if (options.vertices <= 0)
+	{
+		std::cout << "Number of vertices must be positive" << std::endl;
+		return false;
+	}
+
+	if (options.objBenchmarkMegabytes <= 0)
+	{
+		std::cout << "Size of the OBJ file must be positive" << std::endl;
+		return false;
+	}
+
+	if (options.frames <= 0 || options.width <= 0 || options.height <= 0)
+	{
+		std::cout << "Frame count and size must be positive" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+// renders the scene into an offscreen framebuffer for a fixed number of frames and prints frame timings
+// -----------------------------------------------------------------------------------------------------
+static int runHeadlessBenchmark(const LaunchOptions& options)
+{
+	HeadlessContext context;
+	if (!context.create(3, 3))
+	{
+		std::cout << "Failed to create headless OpenGL context" << std::endl;
+		return -1;
+	}
+
+	if (!gladLoadGLLoader((GLADloadproc)HeadlessContext::getProcAddress))
+	{
+		std::cout << "Failed to initialize GLAD" << std::endl;
+		context.destroy();
+		return -1;
+	}
+	if (options.persistentMapping) {
+		StreamBuffer::loadPersistentMapping((GLADloadproc)HeadlessContext::getProcAddress);
+	}
+	std::cout << "Renderer: " << glGetString(GL_RENDERER) << ", OpenGL " << glGetString(GL_VERSION) << std::endl;
+
+	OffscreenFramebuffer framebuffer;
+	if (!framebuffer.create(options.width, options.height))
+	{
+		context.destroy();
+		return -1;
+	}
+	framebuffer.bind();
+	glViewport(0, 0, options.width, options.height);
+	glEnable(GL_DEPTH_TEST);
+
+	if (options.layoutBenchmark)
+	{
+		const int result = layout_benchmark::run(options.frames, options.width, options.height, std::cout);
+		framebuffer.deleteFramebuffer();
+		GLDeletionQueue::get().flush();
+		context.destroy();
+		return result;
+	}
+
+	{
+		Scene scene(options);
+
+		// same default camera as the windowed mode, with the aspect ratio of the framebuffer
+		lightPos = glm::vec3(xlight, ylight, zlight);
+		glm::mat4 view = glm::lookAt(cameraPos, cameraPos + cameraFront, worldUp);
+		glm::mat4 projection = glm::perspective(glm::radians(fov), (float)options.width / (float)options.height, 0.1f, 100.0f);
+
+		// warm up first, so that lazy driver work (shader compilation, texture uploads) is not measured
+		for (int frame = 0; frame < HEADLESS_WARMUP_FRAMES; frame++) {
+			scene.render(view, projection, options.height);
+		}
+		// asynchronous meshes must not make the measured frames depend on the build time of the workers
+		scene.finishUploads();
+		glFinish();
+
+		// only the measured frames are profiled
+		Profiler& profiler = Profiler::get();
+		if (!options.profilePath.empty())
+		{
+			profiler.create();
+			profiler.startCapture();
+		}
+
+		FrameBenchmark benchmark;
+		benchmark.create(options.frames);
+		for (int frame = 0; frame < options.frames; frame++)
+		{
+			benchmark.beginFrame();
+			profiler.beginFrame();
+			scene.render(view, projection, options.height);
+			// there is no swap in headless mode, flush instead so the frame gets submitted
+			{
+				PROFILE_SCOPE("glFlush");
+				glFlush();
+			}
+			profiler.endFrame();
+			benchmark.endFrame();
+		}
+		benchmark.finish();
+
+		std::cout << "Rendered " << options.frames << " frames at " << options.width << "x" << options.height << std::endl;
+		benchmark.printReport(std::cout);
+		scene.getRenderQueue().printStats(std::cout);
+		std::cout << "Frustum culling (last frame): " << scene.getFrustumCuller().getVisibleCount() << " visible, "
+			<< scene.getFrustumCuller().getCulledCount() << " culled" << std::endl;
+		scene.printIndirectDrawReport(projection * view, std::cout);
+		const Sphere& ball = scene.getCrystalBall();
+		std::cout << "Crystal ball LOD (last frame): level " << scene.getBallLod() << " of " << ball.getLodCount()
+			<< ", " << ball.getTriangleCount(scene.getBallLod()) << " triangles (finest " << ball.getTriangleCount(0) << ")" << std::endl;
+		ball.printIndexBufferStats("crystal ball, all levels", std::cout);
+		mesh_optimizer::printVertexCacheStats("crystal ball level 0", ball.getGeneratedCacheStats(0), ball.getOptimizedCacheStats(0), std::cout);
+		scene.getMeshRegistry().printStats(std::cout);
+		scene.getUploadQueue().printStats(std::cout);
+		if (options.asyncMeshes)
+			std::cout << "Crystal ball drawable after " << scene.getBallWaitFrames() << " warm-up frames" << std::endl;
+		const StreamBuffer& uniformStream = scene.getUniformRing().getStreamBuffer();
+		std::cout << "Uniform stream buffer: " << (uniformStream.isPersistent() ? "persistently mapped" : "mapped and orphaned") << ", "
+			<< uniformStream.getStallCount() << " stalls, " << uniformStream.getOrphanCount() << " orphans" << std::endl;
+		for (size_t i = 0; i < scene.getModels().size(); i++)
+		{
+			const LodMesh& model = scene.getModels()[i];
+			const int lod = scene.getModelLod((int)i);
+			std::cout << "Model LOD (last frame, " << model.getName() << "): level " << lod << " of " << model.getLodCount()
+				<< ", " << model.getLevel(lod).triangleCount << " triangles (finest " << model.getLevel(0).triangleCount << ")" << std::endl;
+			if (options.clusterCulling)
+			{
+				const LodMesh::ClusterStats& clusters = model.getClusterStats();
+				std::cout << "Cluster culling (last frame, " << model.getName() << "): " << clusters.visible << " of " << model.getLevel(lod).meshletCount
+					<< " meshlets drawn (" << clusters.backFacing << " back-facing, " << clusters.outsideFrustum << " outside the frustum), "
+					<< clusters.triangleCount << " of " << model.getLevel(lod).triangleCount << " triangles" << std::endl;
+				const StreamBuffer& indexStream = model.getClusterIndexStream();
+				std::cout << "Cluster index stream buffer (" << model.getName() << "): " << indexStream.getStallCount() << " stalls, "
+					<< indexStream.getOrphanCount() << " orphans" << std::endl;
+			}
+		}
+		ResourceTracker::get().printReport("GPU memory", options.listResources, std::cout);
+		GLDeletionQueue::get().printStats(std::cout);
+		benchmark.deleteBenchmark();
+
+		if (!options.profilePath.empty())
+		{
+			profiler.stopCapture();
+			profiler.printReport(std::cout);
+			if (profiler.writeChromeTrace(options.profilePath))
+				std::cout << "Wrote " << profiler.getNumCapturedFrames() << " profiled frames to " << options.profilePath << std::endl;
+		}
+		profiler.deleteProfiler();
+	}
+
+	framebuffer.deleteFramebuffer();
+
+	// everything is released by now, whatever is still tracked after deleting the queued objects leaked
+	GLDeletionQueue::get().flush();
+	if (ResourceTracker::get().getUsage().getTotalCount() > 0)
+		ResourceTracker::get().printReport("Leaked GPU objects", true, std::cout);
+	context.destroy();
+	return 0;
+}
+
+
+// process all input: query GLFW whether relevant keys are pressed/released this frame and react accordingly
+// ---------------------------------------------------------------------------------------------------------
+void processInput(GLFWwindow* window, SimulationInput& input)
+{
+	if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+		glfwSetWindowShouldClose(window, true);
+
+	// held keys are applied by every simulation tick until the next frame samples them again
+	const struct { int key; SimulationInput::Action action; } bindings[] = {
+		//Light controls
+		{ GLFW_KEY_Y, SimulationInput::LIGHT_UP },
+		{ GLFW_KEY_H, SimulationInput::LIGHT_DOWN },
+		{ GLFW_KEY_G, SimulationInput::LIGHT_LEFT },
+		{ GLFW_KEY_J, SimulationInput::LIGHT_RIGHT },
+		{ GLFW_KEY_M, SimulationInput::LIGHT_BACKWARD },
+		{ GLFW_KEY_N, SimulationInput::LIGHT_FORWARD },
+		//camera controls
+		{ GLFW_KEY_W, SimulationInput::CAMERA_FORWARD },
+		{ GLFW_KEY_S, SimulationInput::CAMERA_BACKWARD },
+		{ GLFW_KEY_A, SimulationInput::CAMERA_LEFT },
+		{ GLFW_KEY_D, SimulationInput::CAMERA_RIGHT },
+		//up and down movement
+		{ GLFW_KEY_Q, SimulationInput::CAMERA_UP },
+		{ GLFW_KEY_E, SimulationInput::CAMERA_DOWN },
+	};
+	for (const auto& binding : bindings)
+	{
+		if (glfwGetKey(window, binding.key) == GLFW_PRESS)
+			input.actions |= binding.action;
+	}
+
+	// looking around stays on this thread, movement follows the current view direction
+	input.cameraFront = cameraFront;
+	input.cameraUp = cameraUp;
+	input.cameraSpeed = cameraSpeed;
+	input.cameraResetCount = cameraResetCount;
+	input.cameraResetPosition = RESET_CAMERA_POS;
+}
+
+// glfw: whenever the window size changed (by OS or user resize) this callback function executes
+// ---------------------------------------------------------------------------------------------
+void framebuffer_size_callback(GLFWwindow* window, int width, int height)
+{
+	// make sure the viewport matches the new window dimensions; note that width and 
+	// height will be significantly larger than specified on retina displays.
+	glViewport(0, 0, width, height);
+}
+
+void TransformCamera(GLFWwindow* window) {
+	//ortho perspective controls
+	if (glfwGetKey(window, GLFW_KEY_O) == GLFW_PRESS)
+		ortho = true;
+
+	//orbiting controls
+	if (glfwGetKey(window, GLFW_KEY_L) == GLFW_PRESS)
+		isOrbiting = true;
+
+	//resets the camera and app booleans
+	if (glfwGetKey(window, GLFW_KEY_F) == GLFW_PRESS)
+	{
+		resetCamera();
+		ortho = false;
+		isOrbiting = false;
+	}
+
+}
+
+// glfw: whenever the mouse moves, this callback is called
+// -------------------------------------------------------
+void mouse_callback(GLFWwindow* window, double xpos, double ypos)
+{
+
+	if (firstMouse)
+	{
+		lastX = xpos;
+		lastY = ypos;
+		firstMouse = false;
+	}
+
+	float xoffset = xpos - lastX;
+	float yoffset = lastY - ypos; // reversed since y-coordinates go from bottom to top
+	lastX = xpos;
+	lastY = ypos;
+
+	float sensitivity = 0.1f; // change this value to your liking
+	xoffset *= sensitivity;
+	yoffset *= sensitivity;
+
+	yaw += xoffset;
+	pitch += yoffset;
+
+	// make sure that when pitch is out of bounds, screen doesn't get flipped
+	if (pitch > 89.0f)
+		pitch = 89.0f;
+	if (pitch < -89.0f)
+		pitch = -89.0f;
+
+	glm::vec3 front = glm::vec3(1.0);
+	front.x = cos(glm::radians(yaw)) * cos(glm::radians(pitch));
+	front.y = sin(glm::radians(pitch));
+	front.z = sin(glm::radians(yaw)) * cos(glm::radians(pitch));
+	cameraFront = glm::normalize(front);
+}
+
+
+// glfw: whenever the mouse scroll wheel scrolls, this callback is called
+// ----------------------------------------------------------------------
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
+{
+	//restricts the camera speed between the min and max set global value
+	if (cameraSpeed <= MIN_CAMERA_SPEED) {
+		cameraSpeed = MIN_CAMERA_SPEED + 0.5f;
+	}
+	else if (cameraSpeed >= MAX_CAMERA_SPEED) {
+		cameraSpeed = MAX_CAMERA_SPEED - 0.5f;
+	}
+	else if ((cameraSpeed <= MAX_CAMERA_SPEED) && (cameraSpeed >= MIN_CAMERA_SPEED)) {
+
+		cameraSpeed += (float)yoffset;
+		cameraSpeed += (float)xoffset;
+	}
+
+	cameraOffset = cameraSpeed * deltaTime;
+
+	if (cameraSpeed > MAX_CAMERA_SPEED)
+		cameraSpeed--;
+	else if (cameraSpeed < MIN_CAMERA_SPEED)
+		cameraSpeed++;
+
+}
+
+static void resetCamera() {
+	//resets all basic lighting values
+	orgin = glm::vec3(0.0f, 1.5f, 0.0f);
+	cameraPos = RESET_CAMERA_POS;
+	cameraResetCount++;
+	cameraFront = glm::normalize(glm::vec3(1.0f, -0.75f, -1.0f));
+	worldUp = glm::vec3(0.0f, 3.0f, 0.0f);
+	cameraDir = glm::normalize(cameraPos - orgin);
+	cameraRight = glm::normalize(glm::cross(worldUp, cameraDir));
+	cameraUp = glm::normalize(glm::cross(cameraDir, cameraRight));
+	cameraSpeed = 1.5f;
+	firstMouse = true;
+	fov = 45.0f;
+}
+glm::vec3 getOrgin() {
+
+	orgin = cameraPos + cameraFront;
+	return orgin;
+}
+
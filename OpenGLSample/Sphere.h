@@ -1,143 +1,421 @@
-#ifndef SPHERE_H
-#define SPHERE_H
-#include <cstdlib>
-#include <iostream>
-#include <vector>
-#include <string>
-#define _USE_MATH_DEFINES
-#include <math.h>
-
-class Sphere
-{
-private:
-	std::vector<float> sphere_vertices;
-	std::vector<float> sphere_texcoord;
-	std::vector<int> sphere_indices;
-	GLuint VBO, VAO, EBO;
-	float radius = 1.0f;
-	int sectorCount = 36;
-	int stackCount = 18;
-
-public:
-
-	~Sphere()
-	{
-		glDeleteVertexArrays(1, &VAO);
-		glDeleteBuffers(1, &VBO);
-		glDeleteBuffers(1, &EBO);
-	}
-	Sphere(float r, int sectors, int stacks)
-	{
-		radius = r;
-		sectorCount = sectors;
-		stackCount = stacks;
-
-
-		/* GENERATE VERTEX ARRAY */
-		float x, y, z, xy;                              // vertex position
-		float lengthInv = 1.0f / radius;    // vertex normal
-		float s, t;                                     // vertex texCoord
-
-		float sectorStep = (float)(2 * M_PI / sectorCount);
-		float stackStep = (float)(M_PI / stackCount);
-		float sectorAngle, stackAngle;
-
-		for (int i = 0; i <= stackCount; ++i)
-		{
-			stackAngle = (float)(M_PI / 2 - i * stackStep);        // starting from pi/2 to -pi/2
-			xy = 1.02f * radius * cosf(stackAngle);             // r * cos(u)
-			z = radius * sinf(stackAngle);              // r * sin(u)
-
-														// add (sectorCount+1) vertices per stack
-														// the first and last vertices have same position and normal, but different tex coords
-			for (int j = 0; j <= sectorCount; ++j)
-			{
-				sectorAngle = j * sectorStep;           // starting from 0 to 2pi
-
-														// vertex position (x, y, z)
-				x = xy * cosf(sectorAngle);             // r * cos(u) * cos(v)
-				y = xy * sinf(sectorAngle);				// r * cos(u) * sin(v)
-				sphere_vertices.push_back(x);
-				sphere_vertices.push_back(y);
-				sphere_vertices.push_back(z);
-
-
-				// vertex tex coord (s, t) range between [0, 1]
-				s = (float)j / sectorCount;
-				t = (float)i / stackCount;
-				sphere_vertices.push_back(s);
-				sphere_vertices.push_back(t);
-
-			}
-		}
-		/* GENERATE VERTEX ARRAY */
-
-
-		/* GENERATE INDEX ARRAY */
-		int k1, k2;
-		for (int i = 0; i < stackCount; ++i)
-		{
-			k1 = i * (sectorCount + 1);     // beginning of current stack
-			k2 = k1 + sectorCount + 1;      // beginning of next stack
-
-			for (int j = 0; j < sectorCount; ++j, ++k1, ++k2)
-			{
-				// 2 triangles per sector excluding first and last stacks
-				// k1 => k2 => k1+1
-				if (i != 0)
-				{
-					sphere_indices.push_back(k1);
-					sphere_indices.push_back(k2);
-					sphere_indices.push_back(k1 + 1);
-				}
-
-				// k1+1 => k2 => k2+1
-				if (i != (stackCount - 1))
-				{
-					sphere_indices.push_back(k1 + 1);
-					sphere_indices.push_back(k2);
-					sphere_indices.push_back(k2 + 1);
-				}
-			}
-		}
-		/* GENERATE INDEX ARRAY */
-
-
-		/* GENERATE VAO-EBO */
-		//GLuint VBO, VAO, EBO;
-		glGenVertexArrays(1, &VAO);
-		glGenBuffers(1, &VBO);
-		glGenBuffers(1, &EBO);
-		// Bind the Vertex Array Object first, then bind and set vertex buffer(s) and attribute pointer(s).
-		glBindVertexArray(VAO);
-
-		glBindBuffer(GL_ARRAY_BUFFER, VBO);
-		glBufferData(GL_ARRAY_BUFFER, (unsigned int)sphere_vertices.size() * sizeof(float), sphere_vertices.data(), GL_DYNAMIC_DRAW);
-
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, (unsigned int)sphere_indices.size() * sizeof(unsigned int), sphere_indices.data(), GL_DYNAMIC_DRAW);
-
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*)0);
-		glEnableVertexAttribArray(0);
-
-		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
-		glEnableVertexAttribArray(1);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		glBindVertexArray(0);
-		/* GENERATE VAO-EBO */
-
-
-	}
-	void Draw()
-	{
-		glBindVertexArray(VAO);
-		glDrawElements(GL_TRIANGLES,
-			(unsigned int)sphere_indices.size(),
-			GL_UNSIGNED_INT,
-			(void*)0);
-		glBindVertexArray(0);
-	}
-};
-
-
-#endif
+#ifndef SPHERE_H
+#define SPHERE_H
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <utility>
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include "common/instanceBuffer.h"
+#include "common/parametricSurface.h"
+#include "common/indexBufferBuilder.h"
+#include "common/meshOptimizer.h"
+#include "common/boundingVolume.h"
+#include "common/glHandle.h"
+#include "common/meshRegistry.h"
+#include "common/meshUploadQueue.h"
+#include "common/resourceTracker.h"
+
+class Sphere
+{
+private:
+	// one level of detail, all levels share the vertex and index buffers
+	struct LodLevel
+	{
+		int sectorCount;
+		int stackCount;
+		GLsizei firstIndex;	// offset of the level's first index in the shared index buffer
+		GLsizei indexCount;
+		GLsizei triangleCount;
+		float angleStep;	// largest angle between neighbouring vertices, decides the level's error
+		mesh_optimizer::VertexCacheStats generatedCache;	// simulated vertex cache in generation order
+		mesh_optimizer::VertexCacheStats optimizedCache;	// simulated vertex cache of the index buffer as drawn
+	};
+
+	std::vector<LodLevel> lods;	// finest level first
+	GLBuffer ownVBO, ownEBO;	// buffers of a sphere not sharing them through the registry
+	GLuint VBO = 0, EBO = 0;	// buffers the VAO reads, our own or the registry's
+	GLVertexArray VAO;
+	GLenum indexType = GL_UNSIGNED_SHORT;	// of the index buffer, GL_UNSIGNED_SHORT unless the levels need 32 bits
+	GLenum primitiveType = GL_TRIANGLE_STRIP;	// GL_TRIANGLE_STRIP (drawn with primitive restart) or GL_TRIANGLES
+	size_t indexCount = 0;	// indices of all levels, restart indices included
+	BoundingVolume bounds;	// computed from the generated vertices (the sphere is slightly wider than radius)
+	MeshRegistry* registry = nullptr;	// owner of the buffers if they are shared, VBO and EBO are then not ours
+	const MeshRegistry::SharedMesh* sharedMesh = nullptr;
+	float radius = 1.0f;
+	int sectorCount = 36;
+	int stackCount = 18;
+
+	// generates the geometry of all levels, touches nothing but its own members and OpenGL not at all,
+	// so spheres built by the upload queue's workers use it off the render thread
+	struct Builder
+	{
+		float radius;
+		int sectorCount;
+		int stackCount;
+		std::vector<float> sphere_vertices;	// vertices of all levels while they are generated
+		std::vector<GLuint> sphere_indices;	// triangle list of the level being added
+		std::vector<GLuint> fetchRemap;	// new position of every vertex of the level being added
+		std::vector<LodLevel> lods;	// finest level first
+		BoundingVolume bounds;
+
+		Builder(float r, int sectors, int stacks) : radius(r), sectorCount(sectors), stackCount(stacks) {}
+
+		// appends vertices and indices of one sector/stack tessellation to the shared arrays,
+		// both arrays grow by the exact size of the level and are written in place
+		void addLod(int sectors, int stacks, IndexBufferBuilder& indexBuffer)
+		{
+			LodLevel lod;
+			lod.sectorCount = sectors;
+			lod.stackCount = stacks;
+			const size_t baseVertex = sphere_vertices.size() / 5;
+
+			// stacks go from pi/2 down to -pi/2, sectors from 0 to 2pi
+			// (sectors+1) vertices per stack, the first and last have same position and normal, but different tex coords
+			ParametricGrid grid;
+			grid.outerSegments = stacks;
+			grid.innerSegments = sectors;
+			grid.outerStart = (float)(M_PI / 2);
+			grid.outerStep = -(float)(M_PI / stacks);
+			grid.innerStep = (float)(2 * M_PI / sectors);
+			lod.angleStep = grid.innerStep > -grid.outerStep ? grid.innerStep : -grid.outerStep;
+
+			SphereSurface surface;
+			surface.radius = radius;
+			surface.equatorScale = 1.02f;
+
+			/* GENERATE VERTEX ARRAY */
+			sphere_vertices.resize(sphere_vertices.size() + grid.getVertexCount() * 5);
+			// vertex position (x, y, z) followed by tex coord (s, t) in [0, 1]
+			parametric_surface::generateVertices(surface, grid, VertexStreams::interleaved(sphere_vertices.data(), 5, 0, -1, 3).skip(baseVertex));
+
+			/* GENERATE INDEX ARRAY */
+			// 2 triangles per sector excluding first and last stacks: k1 => k2 => k1+1 and k1+1 => k2 => k2+1
+			// indices are relative to the level's first vertex until the level is optimized
+			const size_t numVertices = grid.getVertexCount();
+			sphere_indices.resize(parametric_surface::getIndexCount(grid, GridTriangulation::SPHERE));
+			parametric_surface::generateIndices(grid, GridTriangulation::SPHERE, sphere_indices.data());
+			lod.generatedCache = mesh_optimizer::analyzeVertexCache(sphere_indices.data(), sphere_indices.size(), numVertices);
+
+			/* OPTIMIZE */
+			// triangles for the vertex cache, clustered against overdraw, then vertices in the order they are fetched
+			float* levelVertices = sphere_vertices.data() + baseVertex * 5;
+			mesh_optimizer::optimizeOverdraw(sphere_indices.data(), sphere_indices.size(), levelVertices, 5, numVertices);
+			mesh_optimizer::buildVertexFetchRemap(sphere_indices.data(), sphere_indices.size(), numVertices, fetchRemap);
+			mesh_optimizer::remapIndices(sphere_indices.data(), sphere_indices.size(), fetchRemap);
+			mesh_optimizer::remapVertices(levelVertices, numVertices, 5 * sizeof(float), fetchRemap);
+			for (auto& index : sphere_indices)
+				index += (GLuint)baseVertex;
+
+			const IndexBufferBuilder::Range range = indexBuffer.addTriangles(sphere_indices.data(), sphere_indices.size());
+			lod.firstIndex = range.first;
+			lod.indexCount = range.count;
+			lod.triangleCount = range.numTriangles;
+			lod.optimizedCache = mesh_optimizer::analyzeVertexCache(indexBuffer.getIndices().data() + range.first, range.count,
+				baseVertex + numVertices, indexBuffer.getPrimitiveType());
+			lods.push_back(lod);
+		}
+
+		// generates all levels into the blob: 5-float vertices (position, tex coord), packed indices,
+		// and the bounds and level table as metadata
+		void generate(MeshBlob& blob, bool useStrips)
+		{
+			// level 0 is the requested tessellation, every next level halves it
+			std::vector<std::pair<int, int>> levels(1, std::make_pair(sectorCount, stackCount));
+			while ((levels.back().first + 1) / 2 >= MIN_LOD_SECTORS && (levels.back().second + 1) / 2 >= MIN_LOD_STACKS)
+				levels.push_back(std::make_pair((levels.back().first + 1) / 2, (levels.back().second + 1) / 2));
+
+			// sizes of all levels are known up front, so the vertex array is allocated once
+			size_t totalVertices = 0;
+			for (const auto& level : levels)
+				totalVertices += (size_t)(level.first + 1) * (level.second + 1);
+			sphere_vertices.reserve(totalVertices * 5);
+			sphere_indices.reserve((size_t)sectorCount * (stackCount - 1) * 6);
+
+			IndexBufferBuilder indexBuffer(useStrips, mesh_optimizer::FIFO_CACHE_SIZE);
+			lods.clear();
+			for (const auto& level : levels)
+				addLod(level.first, level.second, indexBuffer);
+			indexBuffer.finish();
+			std::vector<GLuint>().swap(sphere_indices);
+			std::vector<GLuint>().swap(fetchRemap);
+			bounds = BoundingVolume::fromPositions(sphere_vertices.data(), (lods[0].sectorCount + 1) * (lods[0].stackCount + 1), 5 * sizeof(float));
+
+			blob.vertices.swap(sphere_vertices);
+			blob.floatsPerVertex = 5;
+			const auto* indexData = static_cast<const unsigned char*>(indexBuffer.getData());
+			blob.indices.assign(indexData, indexData + indexBuffer.getByteSize());
+			blob.indexType = indexBuffer.getIndexType();
+			blob.primitiveType = indexBuffer.getPrimitiveType();
+
+			const size_t lodCount = lods.size();
+			blob.writeMetadata(&bounds, 1);
+			blob.writeMetadata(&lodCount, 1);
+			blob.writeMetadata(lods.data(), lodCount);
+		}
+	};
+
+	// takes bounds and level table from the metadata written by generate
+	bool readMetadata(const MeshBlob& blob)
+	{
+		size_t offset = 0, lodCount = 0;
+		if (!blob.readMetadata(offset, &bounds, 1) || !blob.readMetadata(offset, &lodCount, 1) || lodCount == 0)
+			return false;
+		lods.resize(lodCount);
+		return blob.readMetadata(offset, lods.data(), lodCount);
+	}
+	// VAO over VBO and EBO: position at location 0, tex coord at location 1
+	void createVAO()
+	{
+		VAO = GLVertexArray::create();
+		glBindVertexArray(VAO.get());
+
+		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*)0);
+		glEnableVertexAttribArray(0);
+
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
+		glEnableVertexAttribArray(1);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glBindVertexArray(0);
+	}
+
+	// byte offset of a level's first index in the index buffer
+	const void* getIndexOffset(int lod) const
+	{
+		return (void*)(lods[lod].firstIndex * (size_t)(getIndexType() == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint)));
+	}
+	// strips of a level are separated by the restart index, lists need nothing
+	void beginPrimitiveRestart() const
+	{
+		if (getPrimitiveType() == GL_TRIANGLE_STRIP)
+			IndexBufferBuilder::enablePrimitiveRestart(getIndexType());
+	}
+	void endPrimitiveRestart() const
+	{
+		if (getPrimitiveType() == GL_TRIANGLE_STRIP)
+			glDisable(GL_PRIMITIVE_RESTART);
+	}
+
+public:
+	// coarser levels halve sectors and stacks until they would drop below these
+	static const int MIN_LOD_SECTORS = 8;
+	static const int MIN_LOD_STACKS = 4;
+
+	// a level is used while its silhouette is off by at most this many pixels
+	static constexpr float MAX_LOD_PIXEL_ERROR = 0.5f;
+	// a coarser level is taken only once its error drops below this fraction of the maximum,
+	// so a ball hovering around a threshold does not flip levels every frame
+	static constexpr float LOD_HYSTERESIS = 0.8f;
+
+	// the handles release the VAO and our own buffers, shared buffers go back to the registry
+	~Sphere()
+	{
+		if (registry)
+			registry->release(sharedMesh);
+	}
+	// the registry counts every user of a shared mesh, a copy would release it twice
+	Sphere(const Sphere&) = delete;
+	Sphere& operator=(const Sphere&) = delete;
+	// useStrips draws triangle strips joined by primitive restart instead of a triangle list,
+	// strips only follow triangles about one vertex cache ahead, so they keep the optimized order
+	Sphere(float r, int sectors, int stacks, bool useStrips = true)
+	{
+		radius = r;
+		sectorCount = sectors;
+		stackCount = stacks;
+
+		MeshBlob blob;
+		Builder(r, sectors, stacks).generate(blob, useStrips);
+		readMetadata(blob);
+		indexType = blob.indexType;
+		primitiveType = blob.primitiveType;
+		indexCount = blob.indices.size() / (indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint));
+
+		ownVBO = GLBuffer::create();
+		VBO = ownVBO.get();
+		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+		glBufferData(GL_ARRAY_BUFFER, blob.vertices.size() * sizeof(float), blob.vertices.data(), GL_STATIC_DRAW);
+		ownEBO = GLBuffer::create();
+		EBO = ownEBO.get();
+		glBindBuffer(GL_COPY_WRITE_BUFFER, EBO);
+		glBufferData(GL_COPY_WRITE_BUFFER, blob.indices.size(), blob.indices.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		TRACK_RESOURCE(BUFFER, VBO, blob.vertices.size() * sizeof(float), "spheres");
+		TRACK_RESOURCE(BUFFER, EBO, blob.indices.size(), "spheres");
+		createVAO();
+	}
+	// same sphere with the buffers shared through the registry: spheres of equal parameters use the
+	// same geometry, and the registry's disk cache skips generating it on later startups
+	Sphere(MeshRegistry& meshRegistry, float r, int sectors, int stacks, bool useStrips = true)
+	{
+		radius = r;
+		sectorCount = sectors;
+		stackCount = stacks;
+		registry = &meshRegistry;
+
+		sharedMesh = registry->acquire(getMeshKey(r, sectors, stacks, useStrips), [&](MeshBlob& blob) { Builder(r, sectors, stacks).generate(blob, useStrips); });
+		if (!sharedMesh || !readMetadata(sharedMesh->metadata))
+		{
+			std::cout << "Sphere geometry '" << getMeshKey(r, sectors, stacks, useStrips) << "' is invalid!" << std::endl;
+			return;
+		}
+		VBO = sharedMesh->vertexBuffer.get();
+		EBO = sharedMesh->indexBuffer.get();
+		indexType = sharedMesh->indexType;
+		primitiveType = sharedMesh->primitiveType;
+		indexCount = sharedMesh->numIndices;
+		createVAO();
+	}
+	// same shared sphere, but loaded or generated on a worker of the upload queue and uploaded over
+	// the next frames, so it can be spawned mid-session; it can't be drawn before checkReady says so
+	Sphere(MeshRegistry& meshRegistry, MeshUploadQueue& uploadQueue, float r, int sectors, int stacks, bool useStrips = true)
+	{
+		radius = r;
+		sectorCount = sectors;
+		stackCount = stacks;
+		registry = &meshRegistry;
+
+		// the generator runs on a worker, so it gets copies of the parameters and nothing of this sphere
+		sharedMesh = registry->acquireAsync(getMeshKey(r, sectors, stacks, useStrips),
+			[r, sectors, stacks, useStrips](MeshBlob& blob) { Builder(r, sectors, stacks).generate(blob, useStrips); }, uploadQueue);
+		checkReady();
+	}
+	// true once the geometry is on the GPU, the first call after that takes the level table and creates the VAO,
+	// the getters below need it to be true
+	bool checkReady()
+	{
+		if (VAO.get() != 0)
+			return true;
+		if (!sharedMesh || !sharedMesh->isReady)
+			return false;
+		if (!readMetadata(sharedMesh->metadata))
+		{
+			std::cout << "Sphere geometry '" << sharedMesh->key << "' is invalid!" << std::endl;
+			registry->release(sharedMesh);
+			sharedMesh = nullptr;
+			return false;
+		}
+		VBO = sharedMesh->vertexBuffer.get();
+		EBO = sharedMesh->indexBuffer.get();
+		indexType = sharedMesh->indexType;
+		primitiveType = sharedMesh->primitiveType;
+		indexCount = sharedMesh->numIndices;
+		createVAO();
+		return true;
+	}
+	// registry key of a sphere, the version changes whenever the generated geometry does
+	static std::string getMeshKey(float r, int sectors, int stacks, bool useStrips)
+	{
+		std::ostringstream key;
+		key << "sphere v1 r=" << r << " " << sectors << "x" << stacks << (useStrips ? " strips" : " list");
+		return key.str();
+	}
+	// bounding sphere and box in model space, for culling
+	const BoundingVolume& getBounds() const
+	{
+		return bounds;
+	}
+	// VAO and index range of a level, for callers that issue the draw themselves (e.g. the render queue)
+	GLuint getVAO() const
+	{
+		return VAO.get();
+	}
+	int getLodCount() const
+	{
+		return (int)lods.size();
+	}
+	GLsizei getIndexCount(int lod = 0) const
+	{
+		return lods[lod].indexCount;
+	}
+	GLsizei getFirstIndex(int lod = 0) const
+	{
+		return lods[lod].firstIndex;
+	}
+	GLsizei getTriangleCount(int lod = 0) const
+	{
+		return lods[lod].triangleCount;
+	}
+	// GL_UNSIGNED_SHORT unless the levels need more vertices than 16-bit indices can address
+	GLenum getIndexType() const
+	{
+		return indexType;
+	}
+	// GL_TRIANGLE_STRIP (drawn with primitive restart) or GL_TRIANGLES
+	GLenum getPrimitiveType() const
+	{
+		return primitiveType;
+	}
+	// index type, primitive type and size of the index buffer of all levels
+	void printIndexBufferStats(const char* name, std::ostream& os) const
+	{
+		size_t numTriangles = 0;
+		for (const auto& lod : lods)
+			numTriangles += lod.triangleCount;
+		IndexBufferBuilder::printStats(name, indexType, primitiveType, indexCount, numTriangles, os);
+	}
+	// simulated post-transform cache of a level before and after optimizing
+	const mesh_optimizer::VertexCacheStats& getGeneratedCacheStats(int lod = 0) const
+	{
+		return lods[lod].generatedCache;
+	}
+	const mesh_optimizer::VertexCacheStats& getOptimizedCacheStats(int lod = 0) const
+	{
+		return lods[lod].optimizedCache;
+	}
+	// largest distance of a level's surface from the true sphere, in pixels, for a sphere
+	// covering projectedRadius pixels on screen (chord sagitta r * (1 - cos(step / 2)))
+	float getScreenSpaceError(int lod, float projectedRadius) const
+	{
+		return projectedRadius * (1.0f - cosf(lods[lod].angleStep * 0.5f));
+	}
+	// coarsest level whose error stays below MAX_LOD_PIXEL_ERROR, with hysteresis around currentLod
+	int selectLod(float projectedRadius, int currentLod) const
+	{
+		int lod = (int)lods.size() - 1;
+		while (lod > 0 && getScreenSpaceError(lod, projectedRadius) > MAX_LOD_PIXEL_ERROR)
+			lod--;
+
+		// going coarser needs a clear margin, going finer happens right away
+		while (lod > currentLod && getScreenSpaceError(lod, projectedRadius) > MAX_LOD_PIXEL_ERROR * LOD_HYSTERESIS)
+			lod--;
+		return lod;
+	}
+	void Draw(int lod = 0)
+	{
+		glBindVertexArray(VAO.get());
+		beginPrimitiveRestart();
+		glDrawElements(getPrimitiveType(),
+			lods[lod].indexCount,
+			getIndexType(),
+			getIndexOffset(lod));
+		endPrimitiveRestart();
+		glBindVertexArray(0);
+	}
+	// all instances stored in the instance buffer with one draw call
+	void renderInstanced(const InstanceBuffer& instanceBuffer, int lod = 0)
+	{
+		if (instanceBuffer.getInstanceCount() == 0)
+			return;
+
+		glBindVertexArray(VAO.get());
+		instanceBuffer.setVertexAttributesPointers();
+		beginPrimitiveRestart();
+		glDrawElementsInstanced(getPrimitiveType(),
+			lods[lod].indexCount,
+			getIndexType(),
+			getIndexOffset(lod),
+			instanceBuffer.getInstanceCount());
+		endPrimitiveRestart();
+		glBindVertexArray(0);
+	}
+};
+
+
+#endif
@@ -1,9 +1,9 @@
-#pragma once
-#include <glm\glm.hpp>
-
-struct Vertex
-{
-	glm::vec3 position;
-	glm::vec3 color;
-	glm::vec3 normal;
+#pragma once
+#include <glm\glm.hpp>
+
+struct Vertex
+{
+	glm::vec3 position;
+	glm::vec3 color;
+	glm::vec3 normal;
 };
\ No newline at end of file
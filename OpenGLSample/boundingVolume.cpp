@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <cmath>
+
+#include "common/boundingVolume.h"
+
+BoundingVolume BoundingVolume::fromPositions(const void* ptrPositions, size_t numVertices, size_t strideBytes)
+{
+	if (numVertices == 0) {
+		return BoundingVolume();
+	}
+
+	const auto* bytes = static_cast<const unsigned char*>(ptrPositions);
+	auto positionAt = [bytes, strideBytes](size_t i) {
+		const auto* p = reinterpret_cast<const float*>(bytes + i * strideBytes);
+		return glm::vec3(p[0], p[1], p[2]);
+	};
+
+	auto result = BoundingVolume();
+	result.aabbMin = result.aabbMax = positionAt(0);
+	for (size_t i = 1; i < numVertices; i++)
+	{
+		const auto position = positionAt(i);
+		result.aabbMin = glm::min(result.aabbMin, position);
+		result.aabbMax = glm::max(result.aabbMax, position);
+	}
+
+	// Sphere around the box center, but with the radius of the farthest actual vertex,
+	// which is tighter than the sphere circumscribing the box for round meshes
+	result.sphereCenter = (result.aabbMin + result.aabbMax) * 0.5f;
+	auto maxDistanceSquared = 0.0f;
+	for (size_t i = 0; i < numVertices; i++)
+	{
+		const auto offset = positionAt(i) - result.sphereCenter;
+		maxDistanceSquared = std::max(maxDistanceSquared, glm::dot(offset, offset));
+	}
+	result.sphereRadius = std::sqrt(maxDistanceSquared);
+
+	return result;
+}
+
+BoundingVolume BoundingVolume::fromAABB(const glm::vec3& aabbMin, const glm::vec3& aabbMax)
+{
+	auto result = BoundingVolume();
+	result.aabbMin = aabbMin;
+	result.aabbMax = aabbMax;
+	result.sphereCenter = (aabbMin + aabbMax) * 0.5f;
+	result.sphereRadius = glm::length(aabbMax - aabbMin) * 0.5f;
+	return result;
+}
+
+BoundingVolume BoundingVolume::transformed(const glm::mat4& matrix) const
+{
+	auto result = BoundingVolume();
+
+	// Box: transform the center, extents are projected onto the new axes (Arvo's method)
+	const auto center = (aabbMin + aabbMax) * 0.5f;
+	const auto extents = (aabbMax - aabbMin) * 0.5f;
+	const auto newCenter = glm::vec3(matrix * glm::vec4(center, 1.0f));
+	auto newExtents = glm::vec3(0.0f);
+	for (int column = 0; column < 3; column++) {
+		newExtents += glm::abs(glm::vec3(matrix[column])) * extents[column];
+	}
+	result.aabbMin = newCenter - newExtents;
+	result.aabbMax = newCenter + newExtents;
+
+	// Sphere: radius grows with the largest scale of the matrix
+	const auto maxScaleSquared = std::max(std::max(
+		glm::dot(glm::vec3(matrix[0]), glm::vec3(matrix[0])),
+		glm::dot(glm::vec3(matrix[1]), glm::vec3(matrix[1]))),
+		glm::dot(glm::vec3(matrix[2]), glm::vec3(matrix[2])));
+	result.sphereCenter = glm::vec3(matrix * glm::vec4(sphereCenter, 1.0f));
+	result.sphereRadius = sphereRadius * std::sqrt(maxScaleSquared);
+
+	return result;
+}
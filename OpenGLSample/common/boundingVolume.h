@@ -0,0 +1,41 @@
+#pragma once
+
+// STL
+#include <cstddef>
+
+// GLM
+#include <glm/glm.hpp>
+
+/**
+  Bounding sphere and axis aligned bounding box of a mesh, computed once when the mesh is built.
+  Both are kept, because the sphere is cheaper to transform and test, while the box is tighter
+  for flat or elongated meshes like the plane or the milk carton.
+*/
+struct BoundingVolume
+{
+	glm::vec3 aabbMin = glm::vec3(0.0f); //!< Minimal corner of the bounding box
+	glm::vec3 aabbMax = glm::vec3(0.0f); //!< Maximal corner of the bounding box
+	glm::vec3 sphereCenter = glm::vec3(0.0f); //!< Center of the bounding sphere
+	float sphereRadius = 0.0f; //!< Radius of the bounding sphere
+
+	/** \brief Computes bounding volume of vertex positions stored in an (interleaved) array.
+	*   \param ptrPositions  Pointer to the first position (3 floats)
+	*   \param numVertices   Number of vertices
+	*   \param strideBytes   Distance between two positions (in bytes)
+	*   \return Bounding volume enclosing all positions.
+	*/
+	static BoundingVolume fromPositions(const void* ptrPositions, size_t numVertices, size_t strideBytes);
+
+	/** \brief Creates bounding volume from a box, sphere is the one circumscribing the box.
+	*   \param aabbMin Minimal corner of the box
+	*   \param aabbMax Maximal corner of the box
+	*   \return Bounding volume of the box.
+	*/
+	static BoundingVolume fromAABB(const glm::vec3& aabbMin, const glm::vec3& aabbMax);
+
+	/** \brief Transforms bounding volume into another space (e.g. from model to world space).
+	*   \param matrix Affine transformation matrix
+	*   \return Bounding volume enclosing the transformed volume.
+	*/
+	BoundingVolume transformed(const glm::mat4& matrix) const;
+};
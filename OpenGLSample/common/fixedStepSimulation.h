@@ -0,0 +1,116 @@
+#pragma once
+
+// STL
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+// GLM
+#include <glm/glm.hpp>
+
+#include "tripleBuffer.h"
+
+//* \brief Input sampled by the render thread, applied by every simulation tick until the next sample.
+struct SimulationInput
+{
+	//* \brief Held keys, one bit per action.
+	enum Action : unsigned int
+	{
+		LIGHT_UP = 1 << 0,
+		LIGHT_DOWN = 1 << 1,
+		LIGHT_LEFT = 1 << 2,
+		LIGHT_RIGHT = 1 << 3,
+		LIGHT_FORWARD = 1 << 4, //!< Towards negative z
+		LIGHT_BACKWARD = 1 << 5, //!< Towards positive z
+		CAMERA_FORWARD = 1 << 6,
+		CAMERA_BACKWARD = 1 << 7,
+		CAMERA_LEFT = 1 << 8,
+		CAMERA_RIGHT = 1 << 9,
+		CAMERA_UP = 1 << 10,
+		CAMERA_DOWN = 1 << 11,
+	};
+
+	unsigned int actions = 0; //!< Combination of Action bits
+	glm::vec3 cameraFront = glm::vec3(0.0f, 0.0f, -1.0f); //!< Movement direction for forward / backward
+	glm::vec3 cameraUp = glm::vec3(0.0f, 1.0f, 0.0f); //!< Movement direction for up / down
+	float cameraSpeed = 1.5f; //!< Camera movement in units per second
+
+	int cameraResetCount = 0; //!< Incremented by the render thread for every camera reset
+	glm::vec3 cameraResetPosition = glm::vec3(0.0f); //!< Camera position set by the last reset
+};
+
+//* \brief Everything the simulation owns, interpolated by the render thread.
+struct SimulationState
+{
+	glm::vec3 lightPosition = glm::vec3(0.0f);
+	glm::vec3 cameraPosition = glm::vec3(0.0f);
+	float orbitAngle = 0.0f; //!< Angle of the orbit camera in radians, one radian per second
+	uint64_t tick = 0; //!< Number of ticks simulated so far
+};
+
+/**
+  Runs the simulation on its own thread with a fixed tick, so simulation results depend neither on
+  the frame rate nor on how long rendering takes.
+
+  Every tick publishes an immutable snapshot holding the previous and the current state through
+  a lock-free triple buffer. The render thread interpolates between the two by how far the clock
+  has advanced into the tick, so motion stays smooth at any frame rate (rendering is one tick behind).
+*/
+class FixedStepSimulation
+{
+public:
+	static const double TICK_SECONDS; //!< Length of one tick (1/60 s)
+	static const int MAX_CATCH_UP_TICKS; //!< Ticks simulated at once after a stall, older ones are dropped (10)
+	static const float LIGHT_STEP; //!< Light movement per tick (0.01, the old per-frame step at 60 fps)
+
+	~FixedStepSimulation();
+
+	/** \brief Starts the simulation thread.
+	*   \param initialState State shown until the first tick
+	*/
+	void start(const SimulationState& initialState);
+
+	//* \brief Stops and joins the simulation thread.
+	void stop();
+
+	/** \brief Publishes new input for the next ticks, called by the render thread.
+	*   \param input Sampled input
+	*/
+	void setInput(const SimulationInput& input);
+
+	/** \brief Gets state interpolated to the current time, called by the render thread.
+	*   \return Interpolated state.
+	*/
+	SimulationState getInterpolatedState();
+
+	/** \brief Advances state by one tick. Deterministic, depends only on its arguments.
+	*   \param state Current state
+	*   \param input Input held during the tick
+	*   \return State after the tick.
+	*/
+	static SimulationState step(const SimulationState& state, const SimulationInput& input);
+
+private:
+	//* \brief Snapshot published after every tick.
+	struct Snapshot
+	{
+		SimulationState previous; //!< State before the last tick
+		SimulationState current; //!< State after the last tick
+		double tickSeconds = 0.0; //!< Time the last tick was scheduled for, since start
+	};
+
+	TripleBuffer<SimulationInput> _input; //!< Render thread -> simulation thread
+	TripleBuffer<Snapshot> _snapshots; //!< Simulation thread -> render thread
+	std::thread _thread; //!< Simulation thread
+	std::atomic<bool> _isRunning{ false }; //!< Cleared to stop the thread
+	std::chrono::steady_clock::time_point _startTime; //!< Both threads measure time from here
+
+	/** \brief Gets time since the simulation has started.
+	*   \return Time in seconds.
+	*/
+	double secondsSinceStart() const;
+
+	//* \brief Body of the simulation thread.
+	void run(SimulationState state);
+};
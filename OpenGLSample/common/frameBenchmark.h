@@ -0,0 +1,68 @@
+#pragma once
+
+// STL
+#include <ostream>
+#include <vector>
+
+#include <glad/glad.h>
+
+/**
+  Measures CPU and GPU time of every rendered frame and reports min / median / p99.
+
+  CPU time is the time spent issuing the frame's commands, measured with a high resolution clock.
+  GPU time is measured with GL_TIME_ELAPSED queries. Queries are kept in a small ring and read back
+  a few frames later, so measuring does not stall the pipeline.
+*/
+class FrameBenchmark
+{
+public:
+	static const int QUERY_RING_SIZE; //!< Number of frames in flight before a query result is read back (4)
+
+	/** \brief Creates timer queries and reserves space for results.
+	*   \param expectedFrames Number of frames that are going to be measured
+	*/
+	void create(int expectedFrames);
+
+	//* \brief Starts measuring a frame. Must be paired with endFrame.
+	void beginFrame();
+
+	//* \brief Stops measuring the current frame.
+	void endFrame();
+
+	//* \brief Waits for all outstanding GPU results. Call after the last frame, before reporting.
+	void finish();
+
+	/** \brief Prints frame time statistics.
+	*   \param out Stream to print to
+	*/
+	void printReport(std::ostream& out) const;
+
+	/** \brief Gets measured CPU frame times, in milliseconds.
+	*   \return CPU time of each measured frame.
+	*/
+	const std::vector<double>& getCpuTimes() const;
+
+	/** \brief Gets measured GPU frame times, in milliseconds (complete only after finish).
+	*   \return GPU time of each measured frame.
+	*/
+	const std::vector<double>& getGpuTimes() const;
+
+	//* \brief Deletes timer queries.
+	void deleteBenchmark();
+
+private:
+	std::vector<GLuint> _queries; //!< Ring of GL_TIME_ELAPSED queries
+	std::vector<double> _cpuTimes; //!< CPU time of each frame (ms)
+	std::vector<double> _gpuTimes; //!< GPU time of each frame (ms)
+	int _framesBegun = 0; //!< Number of frames started so far
+	int _gpuResultsRead = 0; //!< Number of GPU results read back so far
+	double _frameStartSeconds = 0.0; //!< CPU timestamp of current frame start
+
+	bool _isCreated = false; //!< Flag telling if the queries have been created
+
+	/** \brief Reads back result of the oldest pending query.
+	*   \param wait If true, blocks until the result is available
+	*   \return True if a result has been read.
+	*/
+	bool readOldestResult(bool wait);
+};
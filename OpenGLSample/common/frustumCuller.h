@@ -0,0 +1,79 @@
+#pragma once
+
+// STL
+#include <vector>
+
+// GLM
+#include <glm/glm.hpp>
+
+#include "boundingVolume.h"
+
+/**
+  Tests world space bounding volumes against the six planes of the view frustum.
+
+  Planes are extracted straight from the combined projection * view matrix, so perspective and
+  orthographic projections are handled the same way. Objects are stored as structure of arrays
+  and tested in batches of 8 (AVX) or 4 (SSE) objects at once, with a scalar path for the rest.
+  An object is culled when either its sphere or its box is completely outside any plane.
+
+  Usage per frame: setViewProjection -> clear -> addObject... -> cull -> isVisible...
+*/
+class FrustumCuller
+{
+public:
+	/** \brief Extracts frustum planes from the matrix.
+	*   \param viewProjection Combined projection * view matrix
+	*/
+	void setViewProjection(const glm::mat4& viewProjection);
+
+	/** \brief Gets one of the planes extracted by setViewProjection.
+	*   \param index Plane index (left, right, bottom, top, near, far)
+	*   \return Normalized plane, xyz = normal pointing inside, w = distance.
+	*/
+	const glm::vec4& getPlane(int index) const;
+
+	//* \brief Removes all objects added so far.
+	void clear();
+
+	/** \brief Adds object to be tested.
+	*   \param worldBounds Bounding volume of the object in world space
+	*   \return Index of the object, used with isVisible.
+	*/
+	int addObject(const BoundingVolume& worldBounds);
+
+	//* \brief Tests all added objects against the frustum.
+	void cull();
+
+	/** \brief Checks result of the last cull call.
+	*   \param index Index returned by addObject
+	*   \return True if object is (at least partially) inside the frustum or false otherwise.
+	*/
+	bool isVisible(int index) const;
+
+	/** \brief Gets number of objects that passed the last cull call.
+	*   \return Number of visible objects.
+	*/
+	int getVisibleCount() const;
+
+	/** \brief Gets number of objects rejected by the last cull call.
+	*   \return Number of culled objects.
+	*/
+	int getCulledCount() const;
+
+private:
+	glm::vec4 _planes[6]; //!< Normalized frustum planes (xyz = normal pointing inside, w = distance)
+
+	// Bounding volumes of all objects, structure of arrays for SIMD loads
+	std::vector<float> _sphereX, _sphereY, _sphereZ, _sphereRadius;
+	std::vector<float> _boxCenterX, _boxCenterY, _boxCenterZ;
+	std::vector<float> _boxExtentX, _boxExtentY, _boxExtentZ;
+
+	std::vector<unsigned char> _isVisible; //!< Result of the last cull call, one flag per object
+	int _visibleCount = 0; //!< Number of visible objects in the last cull call
+
+	/** \brief Tests objects one by one without SIMD.
+	*   \param first First object to be tested
+	*   \param last  One past the last object to be tested
+	*/
+	void cullScalar(size_t first, size_t last);
+};
@@ -0,0 +1,155 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "glHandle.h"
+
+/**
+  Sub-allocates static geometry (vertices and indices of many meshes) from a few large buffers, so
+  a scene of thousands of small meshes doesn't create thousands of OpenGL buffer objects.
+
+  Every buffer is a block of blockSize bytes (bigger only for a single allocation that doesn't fit)
+  with a best-fit free list: free ranges are looked up by size and merged with their neighbours by
+  offset when allocations are freed. Meshes get a handle and ask for the buffer and byte offset of
+  their range when they bind it, then draw with a base vertex (or attribute offsets) into the block.
+
+  Freed ranges in between live allocations can't be merged, so after many meshes come and go the
+  free space splits into small pieces. defragment packs all live allocations into new, tightly
+  filled blocks with glCopyBufferSubData and bumps the generation; meshes notice the new generation
+  and point their VAOs at the moved ranges again.
+
+  Needs a current OpenGL context for all calls except the getters.
+*/
+class GeometryHeap
+{
+public:
+	static const size_t DEFAULT_BLOCK_SIZE; //!< Size of one buffer when not specified (4 MiB)
+	static const int INVALID_HANDLE; //!< Handle of a failed allocation (-1)
+
+	//* \brief Usage of the heap, for printStats.
+	struct Stats
+	{
+		int numBuffers = 0; //!< OpenGL buffers (blocks)
+		int numAllocations = 0; //!< Live allocations
+		size_t reservedBytes = 0; //!< Bytes of all blocks
+		size_t liveBytes = 0; //!< Bytes of live allocations, without alignment padding
+		size_t freeBytes = 0; //!< Bytes in free ranges
+		size_t largestFreeRange = 0; //!< Largest allocation possible without a new block
+		int numFreeRanges = 0; //!< Pieces the free space is split into
+		float fragmentation = 0.0f; //!< 1 - largestFreeRange / freeBytes, 0 when all free space is in one piece
+		int numDefragmentations = 0; //!< Calls of defragment that moved anything
+		size_t movedBytes = 0; //!< Bytes copied by defragment so far
+	};
+
+	/** \brief Creates heap without any buffer yet, they are created by the first allocations.
+	*   \param blockSizeBytes Size of one buffer
+	*/
+	void createHeap(size_t blockSizeBytes = DEFAULT_BLOCK_SIZE);
+
+	/** \brief Takes a range from the best fitting free range, or from a new block.
+	*   \param sizeBytes Size of the range
+	*   \param alignment Byte offset of the range is a multiple of it, e.g. the vertex size for base vertex draws
+	*   \return Handle of the allocation, INVALID_HANDLE if the heap isn't created.
+	*/
+	int allocate(size_t sizeBytes, size_t alignment);
+
+	/** \brief Gives the range of an allocation back, merged with free neighbours.
+	*   \param handle Handle returned by allocate, invalid afterwards
+	*/
+	void free(int handle);
+
+	/** \brief Maps the range of an allocation for writing, waiting if the GPU still reads an earlier owner of it.
+	*   \param handle Handle returned by allocate
+	*   \return Pointer to write the whole range to, nullptr if mapping failed.
+	*/
+	void* map(int handle);
+
+	/** \brief Ends writing a range mapped by map.
+	*   \param handle Handle returned by allocate
+	*   \return False if the contents got lost while mapped.
+	*/
+	bool unmap(int handle);
+
+	/** \brief Copies data into the range of an allocation.
+	*   \param handle    Handle returned by allocate
+	*   \param offset    Byte offset in the range
+	*   \param ptrData   Data to copy
+	*   \param sizeBytes Number of bytes
+	*/
+	void upload(int handle, size_t offset, const void* ptrData, size_t sizeBytes);
+
+	/** \brief Packs all live allocations into new blocks without gaps. No range may be mapped.
+	*   \return True if anything was moved.
+	*/
+	bool defragment();
+
+	GLuint getBufferID(int handle) const; //!< Buffer holding the allocation, may change with defragment
+	size_t getOffset(int handle) const; //!< Byte offset of the allocation in its buffer, may change with defragment
+	size_t getSize(int handle) const; //!< Size of the allocation, as requested
+	unsigned int getGeneration() const; //!< Increased by every defragment that moved allocations
+
+	/** \brief Gets usage of the heap.
+	*   \return Current statistics.
+	*/
+	Stats getStats() const;
+
+	/** \brief Prints number of buffers, live and free bytes and fragmentation.
+	*   \param name Name printed with the statistics
+	*   \param os   Stream to print to
+	*/
+	void printStats(const char* name, std::ostream& os) const;
+
+	//* \brief Deletes all buffers, every handle becomes invalid.
+	void deleteHeap();
+
+private:
+	//* \brief One OpenGL buffer with its free ranges.
+	struct Block
+	{
+		GLBuffer buffer; //!< OpenGL buffer
+		size_t size = 0; //!< Size of the buffer
+		std::map<size_t, size_t> freeByOffset; //!< Free ranges, offset -> size, to merge neighbours
+		std::multimap<size_t, size_t> freeBySize; //!< Same ranges, size -> offset, for best fit
+	};
+
+	//* \brief Range handed out by allocate.
+	struct Allocation
+	{
+		int block = -1; //!< Index of the block, -1 if the handle is free
+		size_t offset = 0; //!< Byte offset in the block
+		size_t size = 0; //!< Requested size
+		size_t alignment = 1; //!< Requested alignment, kept for defragment
+		bool isMapped = false; //!< Flag telling, if the range is mapped
+	};
+
+	size_t _blockSize = DEFAULT_BLOCK_SIZE; //!< Size of new blocks
+	std::vector<Block> _blocks; //!< All buffers
+	std::vector<Allocation> _allocations; //!< Allocations indexed by handle
+	std::vector<int> _freeHandles; //!< Handles of freed allocations, reused first
+	unsigned int _generation = 0; //!< Increased by defragment
+	int _numDefragmentations = 0; //!< Calls of defragment that moved anything
+	size_t _movedBytes = 0; //!< Bytes copied by defragment
+
+	bool _isHeapCreated = false; //!< Flag telling if the heap has been created
+
+	/** \brief Adds a new buffer with one free range covering it.
+	*   \param sizeBytes Size of the buffer
+	*   \return Index of the block.
+	*/
+	int addBlock(size_t sizeBytes);
+
+	//* \brief Adds free range to both lookups of a block.
+	static void insertFreeRange(Block& block, size_t offset, size_t size);
+
+	//* \brief Removes free range starting at offset from both lookups of a block.
+	static void eraseFreeRange(Block& block, size_t offset);
+
+	//* \brief Tells, if a handle refers to a live allocation, and prints a message if not.
+	bool isValidHandle(int handle) const;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+// STL
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "glHandle.h"
+
+/**
+  Packs the geometry of many static meshes into one shared vertex buffer and one shared index
+  buffer, so that all of them can be rendered with a single VAO (e.g. by multi-draw-indirect).
+
+  Every vertex has the same 8-float layout as the scene's vertex arrays:
+  position (location 0), normal (location 1) and texture coordinate (location 2).
+*/
+class GeometryPool
+{
+public:
+	static const int FLOATS_PER_VERTEX; //!< Number of floats of one vertex (8)
+
+	//* \brief Location of one mesh inside the shared buffers, matches DrawElementsIndirectCommand fields.
+	struct MeshRange
+	{
+		GLuint indexCount; //!< Number of indices of the mesh
+		GLuint firstIndex; //!< Offset of the first index in the index buffer (in indices)
+		GLint baseVertex; //!< Offset of the first vertex in the vertex buffer (in vertices)
+	};
+
+	/** \brief Adds non-indexed mesh (triangle list), indices 0..numVertices-1 are generated for it.
+	*   \param ptrVertices Interleaved vertex data, FLOATS_PER_VERTEX floats per vertex
+	*   \param numVertices Number of vertices
+	*   \return Index of the mesh in the pool.
+	*/
+	int addMesh(const float* ptrVertices, int numVertices);
+
+	/** \brief Adds indexed mesh (triangle list).
+	*   \param ptrVertices Interleaved vertex data, FLOATS_PER_VERTEX floats per vertex
+	*   \param numVertices Number of vertices
+	*   \param ptrIndices  Indices relative to the first vertex of this mesh
+	*   \param numIndices  Number of indices
+	*   \return Index of the mesh in the pool.
+	*/
+	int addIndexedMesh(const float* ptrVertices, int numVertices, const GLuint* ptrIndices, int numIndices);
+
+	/** \brief Uploads all added meshes to the GPU and creates the VAO. No more meshes can be added after this.
+	*/
+	void uploadToGPU();
+
+	/** \brief Gets location of a mesh in the shared buffers.
+	*   \param meshIndex Index returned by addMesh / addIndexedMesh
+	*   \return Range of the mesh.
+	*/
+	const MeshRange& getMeshRange(int meshIndex) const;
+
+	/** \brief Gets number of meshes in the pool.
+	*   \return Number of meshes.
+	*/
+	int getNumMeshes() const;
+
+	/** \brief Gets VAO with the shared vertex and index buffers bound.
+	*   \return VAO ID.
+	*/
+	GLuint getVAO() const;
+
+	//* \brief Deletes all buffers and meshes.
+	void deletePool();
+
+private:
+	std::vector<float> _vertices; //!< Vertex data gathered before the upload
+	std::vector<GLuint> _indices; //!< Index data gathered before the upload
+	std::vector<MeshRange> _meshRanges; //!< Location of every added mesh
+
+	GLVertexArray _vao; //!< VAO over both buffers
+	GLBuffer _vertexBuffer; //!< Shared vertex buffer
+	GLBuffer _indexBuffer; //!< Shared index buffer
+
+	bool _isUploaded = false; //!< Flag telling, if the pool has been uploaded to GPU
+};
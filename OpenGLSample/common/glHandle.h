@@ -0,0 +1,191 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <deque>
+#include <ostream>
+#include <vector>
+
+#include <glad/glad.h>
+
+/**
+  Deletes OpenGL objects only once the GPU is done with them.
+
+  Handles give their objects to release instead of deleting them. Everything released during a
+  frame waits in one batch, which endFrame closes with a fence; the batch is deleted by a later
+  endFrame that finds its fence signaled. A handle is released at the earliest in the frame that
+  used it last, so the fence of that frame guards every use, and destroying a mesh, a texture or
+  a shader in the middle of a frame never makes the driver wait for the GPU.
+
+  endFrame never waits either, batches whose fence hasn't signaled yet simply stay for the next
+  frame. flush deletes everything right away, for shutting down. Objects known to ResourceTracker
+  are untracked when they are actually deleted, so memory still waiting for its fence is reported.
+
+  Must be used from the thread owning the OpenGL context, as must the handles.
+*/
+class GLDeletionQueue
+{
+public:
+	//* \brief Kind of OpenGL object, decides how it is created and deleted.
+	enum Type
+	{
+		BUFFER,
+		VERTEX_ARRAY,
+		TEXTURE,
+		RENDERBUFFER,
+		FRAMEBUFFER,
+		PROGRAM,
+		NUM_TYPES
+	};
+
+	//* \brief Objects passing through the queue, for printStats.
+	struct Stats
+	{
+		int numReleased = 0; //!< Objects handed to release
+		int numDeleted = 0; //!< Objects deleted, by endFrame or flush
+		int maxPending = 0; //!< Most objects released but not deleted at once
+		int numFlushed = 0; //!< Objects deleted by flush without waiting for their fence
+	};
+
+	/** \brief Gets the queue all handles release their objects to.
+	*   \return Global queue.
+	*/
+	static GLDeletionQueue& get();
+
+	/** \brief Creates an object of a kind (glGen* or glCreateProgram).
+	*   \param type Kind of object
+	*   \return OpenGL assigned name.
+	*/
+	static GLuint generate(Type type);
+
+	/** \brief Queues an object for deletion once the GPU has finished the current frame.
+	*   \param type Kind of object
+	*   \param name OpenGL assigned name, 0 is ignored
+	*/
+	void release(Type type, GLuint name);
+
+	/** \brief Fences the objects released during this frame and deletes the batches whose fence has signaled.
+	*          Call once per frame, after the frame's commands are issued.
+	*/
+	void endFrame();
+
+	//* \brief Deletes all queued objects without waiting for their fences, e.g. before the context goes away.
+	void flush();
+
+	/** \brief Gets number of objects released but not deleted yet.
+	*   \return Queued objects.
+	*/
+	int getNumPending() const;
+
+	/** \brief Gets counters of released and deleted objects.
+	*   \return Statistics since the program started.
+	*/
+	const Stats& getStats() const;
+
+	/** \brief Prints number of released and deleted objects and the longest the queue has been.
+	*   \param os Stream to print to
+	*/
+	void printStats(std::ostream& os) const;
+
+private:
+	//* \brief One released object.
+	struct Object
+	{
+		Type type; //!< Kind of object
+		GLuint name; //!< OpenGL assigned name
+	};
+
+	//* \brief Objects released during one frame.
+	struct Batch
+	{
+		GLsync fence = nullptr; //!< Signaled once the GPU has finished the frame
+		std::vector<Object> objects; //!< Released during the frame
+	};
+
+	std::vector<Object> _released; //!< Released during the current frame, not fenced yet
+	std::deque<Batch> _batches; //!< Fenced frames, oldest first
+	int _numPending = 0; //!< Objects in _released and _batches
+	Stats _stats; //!< Counters for printStats
+
+	//* \brief Deletes objects, one call per kind where OpenGL allows it.
+	void deleteObjects(const std::vector<Object>& objects);
+};
+
+/**
+  Move-only owner of one OpenGL object. Destroying or resetting the handle releases the object to
+  GLDeletionQueue, which deletes it once the GPU is done with it; moving hands the object over.
+
+  Classes holding handles can't be copied by accident, so no two owners ever delete the same name.
+  A default constructed handle owns nothing, get returns 0 then.
+*/
+template <GLDeletionQueue::Type TYPE>
+class GLHandle
+{
+public:
+	GLHandle() = default;
+
+	/** \brief Takes over an existing object.
+	*   \param name OpenGL assigned name, 0 for none
+	*/
+	explicit GLHandle(GLuint name) : _name(name) {}
+
+	GLHandle(GLHandle&& other) noexcept : _name(other._name)
+	{
+		other._name = 0;
+	}
+
+	GLHandle& operator=(GLHandle&& other) noexcept
+	{
+		if (this != &other)
+		{
+			reset();
+			_name = other._name;
+			other._name = 0;
+		}
+		return *this;
+	}
+
+	GLHandle(const GLHandle&) = delete;
+	GLHandle& operator=(const GLHandle&) = delete;
+
+	~GLHandle()
+	{
+		reset();
+	}
+
+	/** \brief Creates a new object of the handle's kind.
+	*   \return Handle owning the object.
+	*/
+	static GLHandle create()
+	{
+		return GLHandle(GLDeletionQueue::generate(TYPE));
+	}
+
+	/** \brief Gets the OpenGL name, for binding.
+	*   \return Name of the object, 0 if the handle owns none.
+	*/
+	GLuint get() const
+	{
+		return _name;
+	}
+
+	//* \brief Releases the object to the deletion queue, the handle owns nothing afterwards.
+	void reset()
+	{
+		if (_name != 0)
+		{
+			GLDeletionQueue::get().release(TYPE, _name);
+			_name = 0;
+		}
+	}
+
+private:
+	GLuint _name = 0; //!< Owned object, 0 for none
+};
+
+typedef GLHandle<GLDeletionQueue::BUFFER> GLBuffer;
+typedef GLHandle<GLDeletionQueue::VERTEX_ARRAY> GLVertexArray;
+typedef GLHandle<GLDeletionQueue::TEXTURE> GLTexture;
+typedef GLHandle<GLDeletionQueue::RENDERBUFFER> GLRenderbuffer;
+typedef GLHandle<GLDeletionQueue::FRAMEBUFFER> GLFramebuffer;
+typedef GLHandle<GLDeletionQueue::PROGRAM> GLProgram;
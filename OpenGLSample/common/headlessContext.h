@@ -0,0 +1,34 @@
+#pragma once
+
+/**
+  Creates an OpenGL context without a visible window, so the scene can be rendered into
+  a framebuffer object on machines that have no display (e.g. GPU-less Linux boxes running
+  a software rasterizer like Mesa's llvmpipe).
+
+  On Linux the context is created through EGL on the surfaceless platform, so neither an
+  X server nor a GPU is needed. Everywhere else a hidden GLFW window provides the context.
+*/
+class HeadlessContext
+{
+public:
+	/** \brief Creates a core profile context and makes it current.
+	*   \param majorVersion Requested OpenGL major version
+	*   \param minorVersion Requested OpenGL minor version
+	*   \return True if the context has been created, false otherwise.
+	*/
+	bool create(int majorVersion, int minorVersion);
+
+	//* \brief Destroys the context (and terminates GLFW, if it was used).
+	void destroy();
+
+	/** \brief Looks up OpenGL function pointers, meant to be passed to gladLoadGLLoader.
+	*   \param name Name of the OpenGL function
+	*   \return Function pointer, or nullptr if the function is not available.
+	*/
+	static void* getProcAddress(const char* name);
+
+private:
+	void* _display = nullptr; //!< EGLDisplay (Linux only)
+	void* _context = nullptr; //!< EGLContext on Linux, GLFWwindow elsewhere
+	bool _isCreated = false; //!< Flag telling if the context has been created
+};
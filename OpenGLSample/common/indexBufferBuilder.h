@@ -0,0 +1,132 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+#include <glad/glad.h>
+
+/**
+  Builds index buffers with the narrowest index type that fits the mesh. Meshes with fewer than
+  MAX_SHORT_VERTICES vertices get 16-bit indices, all others 32-bit ones.
+
+  Triangle lists can optionally be turned into triangle strips joined by primitive restart, which
+  takes about one index per triangle instead of three. The largest value of the index type is always
+  reserved as the restart index, so a buffer can be drawn with primitive restart enabled either way.
+
+  Several meshes (e.g. levels of detail) can share one buffer, every addTriangles call returns where
+  its indices ended up. The index type is decided in finish, once all meshes are known.
+*/
+class IndexBufferBuilder
+{
+public:
+	static const size_t MAX_SHORT_VERTICES; //!< Meshes with more vertices need 32-bit indices (65535, 0xFFFF is the restart index)
+
+	//* \brief Location of one added mesh in the built buffer, in indices.
+	struct Range
+	{
+		GLsizei first; //!< Offset of the first index
+		GLsizei count; //!< Number of indices
+		GLsizei numTriangles; //!< Number of triangles drawn by the range
+	};
+
+	/** \brief Creates empty builder.
+	*   \param useStrips If true, triangles are stripified and the buffer is drawn as GL_TRIANGLE_STRIP
+	*   \param stripLookahead If not 0, strips only follow triangles this close in the input order, which keeps
+	*          the order of a cache optimized list at the cost of shorter strips (see stripify)
+	*/
+	explicit IndexBufferBuilder(bool useStrips = false, size_t stripLookahead = 0);
+
+	/** \brief Adds triangle list of one mesh, degenerate triangles are dropped.
+	*   \param ptrIndices Indices, three per triangle, counterclockwise
+	*   \param numIndices Number of indices
+	*   \return Where the mesh is in the built buffer.
+	*/
+	Range addTriangles(const GLuint* ptrIndices, size_t numIndices);
+
+	//* \brief Picks the index type and packs all added indices, no more triangles can be added after this.
+	void finish();
+
+	/** \brief Gets type of indices for glDrawElements, valid after finish.
+	*   \return GL_UNSIGNED_SHORT or GL_UNSIGNED_INT.
+	*/
+	GLenum getIndexType() const;
+
+	/** \brief Gets primitive type to draw the buffer with.
+	*   \return GL_TRIANGLE_STRIP if stripified, GL_TRIANGLES otherwise.
+	*/
+	GLenum getPrimitiveType() const;
+
+	/** \brief Gets indices gathered so far, before they are packed. Valid until finish.
+	*   \return 32-bit indices, strips are separated by 0xFFFFFFFF.
+	*/
+	const std::vector<GLuint>& getIndices() const;
+
+	/** \brief Gets packed indices, valid after finish.
+	*   \return Pointer to getByteSize() bytes.
+	*/
+	const void* getData() const;
+
+	/** \brief Gets number of indices in the buffer, restart indices included.
+	*   \return Number of indices.
+	*/
+	size_t getIndexCount() const;
+
+	/** \brief Gets size of the packed buffer, valid after finish.
+	*   \return Size in bytes.
+	*/
+	size_t getByteSize() const;
+
+	/** \brief Gets size the added triangles would take as a 32-bit triangle list, to compare with getByteSize.
+	*   \return Size in bytes.
+	*/
+	size_t getTriangleListByteSize() const;
+
+	/** \brief Prints index type, primitive type and size compared to a 32-bit triangle list.
+	*   \param name Name of the mesh
+	*   \param os Stream to print to
+	*/
+	void printStats(const char* name, std::ostream& os) const;
+
+	/** \brief Prints the same for a buffer built earlier, e.g. one loaded from a cache.
+	*   \param name Name of the mesh
+	*   \param indexType GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+	*   \param primitiveType GL_TRIANGLE_STRIP or GL_TRIANGLES
+	*   \param indexCount Number of indices, restart indices included
+	*   \param numTriangles Number of triangles drawn by the whole buffer
+	*   \param os Stream to print to
+	*/
+	static void printStats(const char* name, GLenum indexType, GLenum primitiveType, size_t indexCount, size_t numTriangles, std::ostream& os);
+
+	/** \brief Gets restart index reserved in buffers of given index type.
+	*   \param indexType GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+	*   \return Largest value of the type.
+	*/
+	static GLuint getPrimitiveRestartIndex(GLenum indexType);
+
+	/** \brief Enables primitive restart with the restart index of given index type (OpenGL 3.1).
+	*   \param indexType GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+	*/
+	static void enablePrimitiveRestart(GLenum indexType);
+
+	/** \brief Turns triangle list into strips, greedily following shared edges. Strips are separated by restartIndex.
+	*   \param ptrIndices Indices, three per triangle, counterclockwise
+	*   \param numIndices Number of indices
+	*   \param restartIndex Value written between strips
+	*   \param strips Output, strips are appended
+	*   \param lookahead If not 0, strips only grow into triangles less than this many triangles after their first one
+	*   \return Number of triangles in the strips (degenerate input triangles are dropped).
+	*/
+	static size_t stripify(const GLuint* ptrIndices, size_t numIndices, GLuint restartIndex, std::vector<GLuint>& strips, size_t lookahead = 0);
+
+private:
+	std::vector<GLuint> _indices; //!< All added indices, 32-bit until finish packs them
+	std::vector<unsigned char> _packed; //!< Indices of the picked type
+	GLuint _maxIndex = 0; //!< Largest vertex index added
+	size_t _numTriangles = 0; //!< Number of triangles added
+	GLenum _indexType = GL_UNSIGNED_INT; //!< Index type picked by finish
+	bool _useStrips = false; //!< Flag telling, if triangles are stripified
+	size_t _stripLookahead = 0; //!< Passed to stripify
+	bool _isFinished = false; //!< Flag telling, if finish has been called
+};
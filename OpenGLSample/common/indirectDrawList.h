@@ -0,0 +1,154 @@
+#pragma once
+
+// STL
+#include <vector>
+
+#include <glad/glad.h>
+
+// GLM
+#include <glm/glm.hpp>
+
+#include "boundingVolume.h"
+#include "frustumCuller.h"
+#include "geometryPool.h"
+#include "glHandle.h"
+
+//* \brief Layout of one command in GL_DRAW_INDIRECT_BUFFER, as defined by glMultiDrawElementsIndirect.
+struct DrawElementsIndirectCommand
+{
+	GLuint count;
+	GLuint instanceCount;
+	GLuint firstIndex;
+	GLint baseVertex;
+	GLuint baseInstance;
+};
+
+/**
+  GPU-driven rendering of objects whose meshes live in one GeometryPool (needs OpenGL 4.3).
+
+  Every object owns one command slot. Each frame, cull writes a DrawElementsIndirectCommand for
+  every object, with instanceCount 0 for objects outside the view frustum. Commands are written
+  either by a compute shader (shaderfiles/cull_objects.comp) or, as a fallback, on the CPU by
+  FrustumCuller with the same test, so both paths produce the same command list.
+
+  Objects are grouped into batches (e.g. by material), one glMultiDrawElementsIndirect per batch.
+  The command's baseInstance is the object index, the vertex shader reads it through the
+  per-instance attribute OBJECT_INDEX_ATTRIBUTE_INDEX and looks up the object's transform in
+  the storage buffer at OBJECT_BUFFER_BINDING.
+*/
+class IndirectDrawList
+{
+public:
+	static const int OBJECT_BUFFER_BINDING; //!< Shader storage binding of per-object data (3)
+	static const int COMMAND_BUFFER_BINDING; //!< Shader storage binding of commands in the compute shader (4)
+	static const int OBJECT_INDEX_ATTRIBUTE_INDEX; //!< Vertex attribute index of object index (3)
+
+	/** \brief Creates the buffers and adds object index attribute to the pool's VAO.
+	*   \param pool              Uploaded geometry pool holding all meshes, must outlive the draw list
+	*   \param maxObjects        Maximal number of objects
+	*   \param useComputeCulling True to cull with the compute shader, false to cull on CPU
+	*/
+	void createDrawList(const GeometryPool& pool, int maxObjects, bool useComputeCulling);
+
+	/** \brief Starts a new batch, objects added from now on belong to it.
+	*   \return Index of the batch.
+	*/
+	int addBatch();
+
+	/** \brief Adds object to the current batch.
+	*   \param meshIndex   Index of the mesh in the geometry pool
+	*   \param localBounds Bounding volume of the mesh in model space
+	*   \param model       Model matrix of the object
+	*   \param shininess   Specular shininess of the object's material
+	*   \param materialLayer Layer of the object's material in the MaterialLibrary arrays
+	*   \return Index of the object.
+	*/
+	int addObject(int meshIndex, const BoundingVolume& localBounds, const glm::mat4& model, float shininess, int materialLayer = 0);
+
+	/** \brief Moves object, new transform is uploaded with the next cull call.
+	*   \param objectIndex Index returned by addObject
+	*   \param model       New model matrix of the object
+	*/
+	void setObjectTransform(int objectIndex, const glm::mat4& model);
+
+	/** \brief Culls all objects and writes the command buffer.
+	*   \param viewProjection Combined projection * view matrix
+	*/
+	void cull(const glm::mat4& viewProjection);
+
+	/** \brief Renders all visible objects of one batch with a single multi-draw call. Shader must be bound.
+	*   \param batchIndex Index returned by addBatch
+	*/
+	void drawBatch(int batchIndex) const;
+
+	/** \brief Builds command list on the CPU, exactly like the fallback path of cull does.
+	*   \param viewProjection Combined projection * view matrix
+	*   \param commands       Filled with one command per object
+	*/
+	void buildCommandsOnCPU(const glm::mat4& viewProjection, std::vector<DrawElementsIndirectCommand>& commands);
+
+	/** \brief Reads the command buffer written by the last cull call (stalls until the GPU is done).
+	*   \param commands Filled with one command per object
+	*/
+	void readBackCommands(std::vector<DrawElementsIndirectCommand>& commands) const;
+
+	/** \brief Checks, if the compute shader is used for culling.
+	*   \return True if commands are written on the GPU or false otherwise.
+	*/
+	bool isUsingComputeCulling() const;
+
+	/** \brief Gets number of added objects.
+	*   \return Number of objects.
+	*/
+	int getNumObjects() const;
+
+	//* \brief Deletes all buffers and objects.
+	void deleteDrawList();
+
+private:
+	//* \brief C++ mirror of ObjectData (std430) in the shaders.
+	struct ObjectData
+	{
+		glm::mat4 model;
+		glm::mat4 normalMatrix;
+		glm::vec4 sphere; //!< xyz = world space center, w = radius
+		glm::vec4 boxCenter; //!< xyz = world space box center
+		glm::vec4 boxExtents; //!< xyz = world space box half size
+		float shininess;
+		GLuint indexCount;
+		GLuint firstIndex;
+		GLint baseVertex;
+		float materialLayer; //!< Layer of the object's material in the MaterialLibrary arrays
+		float padding[3]; //!< std430 rounds the struct size up to 16 bytes
+	};
+
+	//* \brief Range of objects (and commands) rendered by one multi-draw call.
+	struct Batch
+	{
+		int firstObject;
+		int numObjects;
+	};
+
+	const GeometryPool* _pool = nullptr; //!< Pool with the geometry of all objects
+	std::vector<ObjectData> _objects; //!< In-memory copy of all objects
+	std::vector<BoundingVolume> _localBounds; //!< Model space bounds of every object
+	std::vector<Batch> _batches; //!< All batches
+	int _maxObjects = 0; //!< Capacity of the buffers
+	bool _areObjectsDirty = false; //!< Flag telling, if objects have to be uploaded before culling
+
+	GLBuffer _objectBuffer; //!< Storage buffer with per-object data
+	GLBuffer _commandBuffer; //!< Indirect command buffer
+	GLBuffer _objectIndexBuffer; //!< Buffer with 0, 1, 2... used as per-instance object index
+
+	GLProgram _cullProgram; //!< Culling compute program, only when compute culling is used
+	FrustumCuller _cpuCuller; //!< Culler used by the CPU path
+	std::vector<DrawElementsIndirectCommand> _cpuCommands; //!< Commands written by the CPU path
+
+	bool _useComputeCulling = false; //!< Flag telling, if commands are written by the compute shader
+	bool _isCreated = false; //!< Flag telling, if the draw list has been created
+
+	/** \brief Updates world space bounds of an object from its model matrix.
+	*   \param objectIndex Index of the object
+	*/
+	void updateWorldBounds(int objectIndex);
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+// STL
+#include <vector>
+
+#include <glad/glad.h>
+
+// GLM
+#include <glm/glm.hpp>
+
+#include "glHandle.h"
+
+/**
+  Holds per-instance model and normal matrices for instanced rendering. The matrices are read by
+  the vertex shader as instanced vertex attributes (divisor 1), so any number of instances of one
+  mesh can be rendered with a single draw call.
+
+  Transforms are kept in memory as well, only instances changed since the last upload are sent
+  to the GPU by updateGPU.
+*/
+class InstanceBuffer
+{
+public:
+	static const int MODEL_MATRIX_ATTRIBUTE_INDEX; //!< First vertex attribute index of model matrix (3), uses 4 consecutive indices
+	static const int NORMAL_MATRIX_ATTRIBUTE_INDEX; //!< First vertex attribute index of normal matrix (7), uses 3 consecutive indices
+
+	/** \brief Creates the instance buffer.
+	*   \param maxInstances Maximal number of instances the buffer can hold
+	*/
+	void createInstanceBuffer(int maxInstances);
+
+	/** \brief Sets transform of one instance, normal matrix is calculated from it.
+	*   \param index Instance index, must be lower than maximal number of instances
+	*   \param model Model matrix of the instance
+	*/
+	void setInstance(int index, const glm::mat4& model);
+
+	/** \brief Sets how many instances (starting from the first one) are rendered.
+	*   \param numInstances Number of rendered instances
+	*/
+	void setInstanceCount(int numInstances);
+
+	/** \brief Gets number of rendered instances.
+	*   \return Number of rendered instances.
+	*/
+	int getInstanceCount() const;
+
+	/** \brief Uploads transforms changed since the last call to the GPU, one upload per run of changed instances.
+	*   \return Number of bytes uploaded.
+	*/
+	size_t updateGPU();
+
+	//* \brief Sets instanced vertex attribute pointers of the currently bound VAO to this buffer.
+	void setVertexAttributesPointers() const;
+
+	//* \brief Deletes the instance buffer and the in-memory transforms.
+	void deleteInstanceBuffer();
+
+private:
+	//* \brief Layout of one instance in the buffer.
+	struct InstanceData
+	{
+		glm::mat4 modelMatrix;
+		glm::mat3 normalMatrix;
+	};
+
+	GLBuffer _buffer; //!< Buffer of all instances
+	std::vector<InstanceData> _instances; //!< In-memory copy of all instances
+	std::vector<bool> _isInstanceDirty; //!< Flags telling, which instances changed since the last upload
+	int _numDirtyInstances = 0; //!< Number of changed instances since the last upload
+	int _instanceCount = 0; //!< Number of rendered instances
+
+	bool _isBufferCreated = false; //!< Flag telling if the buffer has been created
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+// STL
+#include <ostream>
+
+/**
+  Compares the vertex layouts of StaticMesh3D (planar, interleaved, split positions) on scenes bound
+  by vertex fetch: many instances of a finely sliced cylinder and of the cube, each only a few pixels
+  on screen. Every layout is drawn with a shader reading all attributes and with a depth-only shader
+  reading positions only, and the median GPU time of each pass is reported.
+
+  Planar and interleaved layouts are measured once more from a GeometryHeap. Before the benchmark
+  meshes are allocated, every other of HEAP_FILLER_MESHES small meshes is deleted, then the rest
+  is deleted too and the heap defragmented, so the meshes are drawn from ranges that have moved.
+
+  The final images of all layouts are compared to the planar one, so a layout writing its vertices
+  or attribute pointers wrong shows up as a mismatch.
+
+  Needs a current OpenGL context with a framebuffer of the given size bound.
+*/
+namespace layout_benchmark {
+
+extern const int CYLINDER_SLICES; //!< Slices of the benchmark cylinder (20000, about 80000 vertices)
+extern const int CYLINDER_INSTANCES; //!< Cylinder instances per frame (16)
+extern const int CUBE_INSTANCES; //!< Cube instances per frame (32768)
+extern const int HEAP_FILLER_MESHES; //!< Cubes allocated around the benchmark meshes in the heap rows (64)
+
+/** \brief Runs the benchmark and prints a table of timings.
+*   \param numFrames Frames measured for every layout and pass
+*   \param width Width of the bound framebuffer
+*   \param height Height of the bound framebuffer
+*   \param out Stream to print to
+*   \return 0 if all layouts rendered the same image, 1 otherwise.
+*/
+int run(int numFrames, int width, int height, std::ostream& out);
+
+} // namespace layout_benchmark
@@ -0,0 +1,148 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// GLM
+#include <glm/glm.hpp>
+
+#include <glad/glad.h>
+
+#include "boundingVolume.h"
+#include "indexBufferBuilder.h"
+#include "meshletBuilder.h"
+#include "glHandle.h"
+#include "streamBuffer.h"
+
+/**
+  OBJ mesh with a chain of simplified levels of detail sharing one vertex buffer.
+
+  The mesh is loaded with loadOBJ and welded with indexVBO, then every level is simplified from the
+  previous one by mesh_simplifier to a ratio of the full triangle count. Loading and simplifying need
+  no OpenGL, so many meshes can be prepared on worker threads (generateLods) and uploaded afterwards.
+
+  Vertices have the scene's 8-float layout: position (location 0), normal (location 1) and texture
+  coordinate (location 2). At runtime the coarsest level whose simplification error covers at most
+  MAX_LOD_PIXEL_ERROR pixels is picked, like the crystal ball does with its tessellations.
+
+  Every level is split into meshlets by meshlet_builder and its indices are stored in meshlet order.
+  Besides drawing a whole level, cullClusters drops the meshlets outside the frustum or facing away
+  from the camera and writes the indices of the rest into a StreamBuffer, a new range every frame.
+*/
+class LodMesh
+{
+public:
+	static const std::vector<float> DEFAULT_LOD_RATIOS; //!< Triangle ratios of the levels (1, 1/2, 1/4, 1/8, 1/16)
+	static const float MAX_LOD_PIXEL_ERROR; //!< A level is used while its error is at most this many pixels (0.5)
+	static const float LOD_HYSTERESIS; //!< A coarser level is taken once its error drops below this fraction of the maximum (0.8)
+	static const float MAX_SIMPLIFICATION_ERROR; //!< Levels stop once their error would exceed this fraction of the bounding sphere radius (0.1)
+
+	//* \brief One level of detail, a range of the shared index buffer.
+	struct Level
+	{
+		GLsizei firstIndex; //!< Offset of the level's first index
+		GLsizei indexCount; //!< Number of indices
+		GLsizei triangleCount; //!< Number of triangles
+		float error; //!< Largest distance from the full resolution surface, in model space units
+		size_t firstMeshlet; //!< Offset of the level's first meshlet
+		size_t meshletCount; //!< Number of meshlets
+	};
+
+	//* \brief Result of the last cullClusters call.
+	struct ClusterStats
+	{
+		int visible = 0; //!< Meshlets copied into the cluster index buffer
+		int outsideFrustum = 0; //!< Meshlets rejected by their bounding sphere
+		int backFacing = 0; //!< Meshlets rejected by their normal cone
+		GLsizei triangleCount = 0; //!< Triangles of the visible meshlets
+	};
+
+	/** \brief Loads OBJ file and welds its vertices, only the full resolution level exists afterwards.
+	*   \param path Path to the OBJ file
+	*   \return True if the file could be loaded.
+	*/
+	bool loadOBJ(const char* path);
+
+	/** \brief Replaces coarser levels by ones simplified to the given triangle ratios, needs no OpenGL.
+	*          The chain ends early where MAX_SIMPLIFICATION_ERROR doesn't allow to simplify any further.
+	*   \param ratios Ratios of the full triangle count, decreasing, the first one should be 1
+	*/
+	void generateLods(const std::vector<float>& ratios = DEFAULT_LOD_RATIOS);
+
+	/** \brief Generates levels of several meshes in parallel, one mesh per thread at a time.
+	*   \param meshes Loaded meshes
+	*   \param ratios Ratios of the full triangle count, decreasing, the first one should be 1
+	*   \param numThreads Number of threads, 0 uses all hardware threads
+	*/
+	static void generateLods(std::vector<LodMesh>& meshes, const std::vector<float>& ratios = DEFAULT_LOD_RATIOS, int numThreads = 0);
+
+	/** \brief Uploads vertices and all levels to the GPU and creates the VAO. CPU copies are freed.
+	*/
+	void uploadToGPU();
+
+	/** \brief Culls the meshlets of a level and writes the indices of the visible ones into the cluster index buffer.
+	*   \param lod Level to draw
+	*   \param model Model matrix of the mesh
+	*   \param viewProjection Combined projection * view matrix
+	*   \param cameraPosition Camera position in world space
+	*   \return Number of indices to draw with the cluster VAO, starting at getClusterFirstIndex.
+	*/
+	GLsizei cullClusters(int lod, const glm::mat4& model, const glm::mat4& viewProjection, const glm::vec3& cameraPosition);
+
+	/** \brief Gets coarsest level whose error stays below MAX_LOD_PIXEL_ERROR, with hysteresis around currentLod.
+	*   \param projectedRadius Radius of the bounding sphere on screen, in pixels
+	*   \param currentLod Level used in the last frame
+	*   \return Level to draw.
+	*/
+	int selectLod(float projectedRadius, int currentLod) const;
+
+	/** \brief Gets error of a level in pixels.
+	*   \param lod Level
+	*   \param projectedRadius Radius of the bounding sphere on screen, in pixels
+	*   \return Error in pixels.
+	*/
+	float getScreenSpaceError(int lod, float projectedRadius) const;
+
+	/** \brief Prints triangle count and error of every level.
+	*   \param os Stream to print to
+	*/
+	void printStats(std::ostream& os) const;
+
+	const std::string& getName() const; //!< File the mesh was loaded from
+	const BoundingVolume& getBounds() const; //!< Bounds in model space, for culling and LOD selection
+	const Level& getLevel(int lod) const; //!< Index range and error of a level, 0 is the full resolution
+	int getLodCount() const; //!< Number of levels
+	GLenum getIndexType() const; //!< GL_UNSIGNED_SHORT unless the mesh has too many vertices for it
+	GLuint getVAO() const; //!< VAO with the vertex and index buffers bound
+	GLuint getClusterVAO() const; //!< VAO with the vertex buffer and the indices written by cullClusters bound
+	GLsizei getClusterFirstIndex() const; //!< Offset of the first index written by the last cullClusters call
+	const StreamBuffer& getClusterIndexStream() const; //!< Stream buffer of the cluster indices, for its stall and orphan counts
+	const ClusterStats& getClusterStats() const; //!< Counters of the last cullClusters call
+
+	//* \brief Deletes buffers and all levels.
+	void deleteMesh();
+
+private:
+	std::string _name; //!< File the mesh was loaded from
+	std::vector<float> _vertices; //!< Welded vertices, 8 floats each, until uploaded
+	std::vector<GLuint> _indices; //!< Full resolution triangle list, until uploaded
+	IndexBufferBuilder _indexBuffer; //!< All levels, until uploaded
+	std::vector<Level> _levels; //!< Finest level first
+	std::vector<Meshlet> _meshlets; //!< Meshlets of all levels, their first indices refer to the whole index buffer
+	std::vector<unsigned char> _packedIndices; //!< Copy of the uploaded index buffer, visible meshlets are copied out of it
+	std::vector<size_t> _visibleMeshlets; //!< Meshlets that passed culling, kept to avoid reallocations
+	ClusterStats _clusterStats; //!< Counters of the last cullClusters call
+	BoundingVolume _bounds; //!< Bounds of the vertices
+	GLenum _indexType = GL_UNSIGNED_SHORT; //!< Index type picked by the index buffer builder
+
+	GLVertexArray _vao; //!< VAO over the vertex and element buffers
+	GLBuffer _vertexBuffer; //!< Vertex buffer
+	GLBuffer _elementBuffer; //!< Index buffer of all levels, built by _indexBuffer
+	GLVertexArray _clusterVAO; //!< VAO drawing the visible meshlets
+	StreamBuffer _clusterIndices; //!< Index buffer of the cluster VAO, cullClusters writes a new range every frame
+	GLsizei _clusterFirstIndex = 0; //!< Offset of the indices written by the last cullClusters call
+	bool _isUploaded = false; //!< Flag telling, if the mesh has been uploaded to GPU
+};
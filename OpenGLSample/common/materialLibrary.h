@@ -0,0 +1,74 @@
+#pragma once
+
+// STL
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "glHandle.h"
+
+/**
+  Keeps diffuse and specular maps of all materials in two GL_TEXTURE_2D_ARRAY textures, one layer
+  per material, so objects with different materials can be rendered without rebinding textures.
+  Shaders select the material by its layer index (per draw or per instance).
+
+  Maps of different sizes are resampled to one common resolution when the library is built.
+*/
+class MaterialLibrary
+{
+public:
+	static const int DIFFUSE_TEXTURE_UNIT; //!< Texture unit of the diffuse map array (0)
+	static const int SPECULAR_TEXTURE_UNIT; //!< Texture unit of the specular map array (1)
+
+	/** \brief Adds material, its maps are loaded when the library is built.
+	*   \param diffusePath  Path to the diffuse map image
+	*   \param specularPath Path to the specular map image
+	*   \return Layer index of the material.
+	*/
+	int addMaterial(const std::string& diffusePath, const std::string& specularPath);
+
+	/** \brief Loads maps of all materials, resamples them and uploads them to the texture arrays.
+	*   \param width  Width of every layer, 0 means the largest width of all maps
+	*   \param height Height of every layer, 0 means the largest height of all maps
+	*   \return True if all maps have been loaded or false otherwise (missing maps stay black).
+	*/
+	bool build(int width = 0, int height = 0);
+
+	//* \brief Binds the diffuse and specular map arrays to their texture units.
+	void bind() const;
+
+	/** \brief Gets number of materials (layers).
+	*   \return Number of materials.
+	*/
+	int getNumMaterials() const;
+
+	/** \brief Gets width of the layers.
+	*   \return Width in texels.
+	*/
+	int getWidth() const;
+
+	/** \brief Gets height of the layers.
+	*   \return Height in texels.
+	*/
+	int getHeight() const;
+
+	//* \brief Deletes both texture arrays and all materials.
+	void deleteLibrary();
+
+private:
+	//* \brief Image files of one material.
+	struct MaterialPaths
+	{
+		std::string diffusePath;
+		std::string specularPath;
+	};
+
+	std::vector<MaterialPaths> _materials; //!< Materials in layer order
+	GLTexture _diffuseArray; //!< Texture array with diffuse maps
+	GLTexture _specularArray; //!< Texture array with specular maps
+	int _width = 0; //!< Width of every layer
+	int _height = 0; //!< Height of every layer
+
+	bool _isBuilt = false; //!< Flag telling, if the texture arrays have been created
+};
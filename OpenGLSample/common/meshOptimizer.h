@@ -0,0 +1,103 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+#include <glad/glad.h>
+
+/**
+  Reorders indexed triangle meshes for the GPU, without changing what is rendered.
+
+  - optimizeVertexCache reorders triangles with Tipsify (Sander et al. 2007), so vertices are reused
+    while they are still in the post-transform cache.
+  - optimizeOverdraw runs Tipsify, splits its output into clusters that keep the cache efficiency
+    and sorts the clusters so outward facing ones are drawn first, which lets the depth test reject
+    more of the hidden fragments.
+  - buildVertexFetchRemap / remapVertices renumber vertices in the order they are first used, so
+    vertex fetch walks memory forward.
+
+  analyzeVertexCache simulates a FIFO cache and reports ACMR (cache misses per triangle, 0.5 is the
+  ideal for large grids, 3 the worst) and ATVR (misses per vertex, 1 is the ideal), so the effect can
+  be measured without a GPU.
+*/
+namespace mesh_optimizer {
+
+extern const int FIFO_CACHE_SIZE; //!< Entries of the simulated and optimized for post-transform cache (16)
+extern const float OVERDRAW_THRESHOLD; //!< Clusters may be this much worse in ACMR than the whole mesh (1.05)
+
+//* \brief Result of the FIFO cache simulation.
+struct VertexCacheStats
+{
+	size_t numTriangles = 0; //!< Triangles drawn
+	size_t numVertices = 0; //!< Distinct vertices referenced
+	size_t numMisses = 0; //!< Vertices transformed (cache misses)
+	float acmr = 0.0f; //!< Average cache miss ratio, misses per triangle
+	float atvr = 0.0f; //!< Average transformed vertex ratio, misses per referenced vertex
+};
+
+/** \brief Simulates a FIFO post-transform cache over an index buffer.
+*   \param ptrIndices Indices, a triangle list or strips separated by restartIndex
+*   \param numIndices Number of indices
+*   \param numVertices Number of vertices the indices refer to
+*   \param primitiveType GL_TRIANGLES or GL_TRIANGLE_STRIP
+*   \param restartIndex Primitive restart index of strips
+*   \param cacheSize Number of cache entries
+*   \return Cache statistics.
+*/
+VertexCacheStats analyzeVertexCache(const GLuint* ptrIndices, size_t numIndices, size_t numVertices,
+	GLenum primitiveType = GL_TRIANGLES, GLuint restartIndex = 0xFFFFFFFF, int cacheSize = FIFO_CACHE_SIZE);
+
+/** \brief Reorders triangles of a triangle list for the post-transform cache (Tipsify), winding is kept.
+*   \param ptrIndices Indices, three per triangle, reordered in place
+*   \param numIndices Number of indices
+*   \param numVertices Number of vertices the indices refer to
+*   \param cacheSize Number of cache entries to optimize for
+*/
+void optimizeVertexCache(GLuint* ptrIndices, size_t numIndices, size_t numVertices, int cacheSize = FIFO_CACHE_SIZE);
+
+/** \brief Reorders triangles for the post-transform cache and then orders clusters of them against overdraw.
+*   \param ptrIndices Indices, three per triangle, reordered in place
+*   \param numIndices Number of indices
+*   \param ptrPositions First vertex position (x, y, z floats)
+*   \param positionStride Floats between two positions
+*   \param numVertices Number of vertices the indices refer to
+*   \param threshold How much worse than the whole mesh the ACMR of a cluster may get, OVERDRAW_THRESHOLD by default
+*/
+void optimizeOverdraw(GLuint* ptrIndices, size_t numIndices, const float* ptrPositions, size_t positionStride,
+	size_t numVertices, float threshold = OVERDRAW_THRESHOLD);
+
+/** \brief Numbers vertices in the order the indices first use them, unreferenced vertices follow in their old order.
+*   \param ptrIndices Indices
+*   \param numIndices Number of indices
+*   \param numVertices Number of vertices the indices refer to
+*   \param remap Gets new index of every old vertex (a permutation)
+*   \return Number of referenced vertices.
+*/
+size_t buildVertexFetchRemap(const GLuint* ptrIndices, size_t numIndices, size_t numVertices, std::vector<GLuint>& remap);
+
+/** \brief Replaces every index by its remap entry.
+*   \param ptrIndices Indices, changed in place
+*   \param numIndices Number of indices
+*   \param remap Remap built by buildVertexFetchRemap
+*/
+void remapIndices(GLuint* ptrIndices, size_t numIndices, const std::vector<GLuint>& remap);
+
+/** \brief Moves vertices to their remapped positions.
+*   \param ptrVertices Vertex data, changed in place
+*   \param numVertices Number of vertices
+*   \param vertexSize Size of one vertex in bytes
+*   \param remap Remap built by buildVertexFetchRemap
+*/
+void remapVertices(void* ptrVertices, size_t numVertices, size_t vertexSize, const std::vector<GLuint>& remap);
+
+/** \brief Prints ACMR and ATVR before and after optimizing.
+*   \param name Name of the mesh
+*   \param before Statistics of the original order
+*   \param after Statistics of the optimized order
+*   \param os Stream to print to
+*/
+void printVertexCacheStats(const char* name, const VertexCacheStats& before, const VertexCacheStats& after, std::ostream& os);
+
+} // namespace mesh_optimizer
@@ -0,0 +1,224 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "glHandle.h"
+
+class MeshUploadQueue;
+
+/**
+  Generated geometry of one mesh as it goes to the GPU and into the disk cache: interleaved
+  float vertices, packed indices and generator specific metadata (e.g. a table of levels of detail).
+*/
+struct MeshBlob
+{
+	std::vector<float> vertices; //!< Interleaved vertices, floatsPerVertex floats each
+	GLuint floatsPerVertex = 0; //!< Floats of one vertex
+	std::vector<unsigned char> indices; //!< Indices packed to indexType
+	GLenum indexType = GL_UNSIGNED_INT; //!< GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+	GLenum primitiveType = GL_TRIANGLES; //!< Primitive type to draw the indices with
+	std::vector<unsigned char> metadata; //!< Anything else the generator needs back, written with writeMetadata
+
+	/** \brief Appends plain values to the metadata.
+	*   \param ptrValues First value, must be trivially copyable (no pointers, they don't survive the disk cache)
+	*   \param count Number of values
+	*/
+	template <typename T>
+	void writeMetadata(const T* ptrValues, size_t count)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Metadata must be trivially copyable!");
+		const auto* bytes = reinterpret_cast<const unsigned char*>(ptrValues);
+		metadata.insert(metadata.end(), bytes, bytes + count * sizeof(T));
+	}
+
+	/** \brief Reads plain values written by writeMetadata, in the same order.
+	*   \param offset Byte offset to read at, advanced past the values
+	*   \param ptrValues Output, count values
+	*   \param count Number of values
+	*   \return False if the metadata is too short.
+	*/
+	template <typename T>
+	bool readMetadata(size_t& offset, T* ptrValues, size_t count) const
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Metadata must be trivially copyable!");
+		if (offset + count * sizeof(T) > metadata.size()) {
+			return false;
+		}
+		memcpy(ptrValues, metadata.data() + offset, count * sizeof(T));
+		offset += count * sizeof(T);
+		return true;
+	}
+};
+
+/**
+  Shares generated meshes between everyone asking for the same geometry. Meshes are keyed by their
+  generator and its parameters (e.g. "sphere v1 r=1 60x60 strips"): the first acquire of a key gets
+  the geometry onto the GPU, every further one returns the same buffers and increases their reference
+  count, and the buffers are deleted when the last user releases them.
+
+  With a cache directory, generated blobs are also written to disk, named after a 64-bit FNV-1a hash
+  of the key, so later startups load them instead of generating again. Files carry the full key, the
+  format version and a checksum of the data; anything that doesn't match is generated again and the
+  file rewritten. A generator whose output changes must change its key (e.g. bump its version).
+
+  acquireAsync does the same without stalling the render thread: loading or generating runs on a
+  worker of a MeshUploadQueue, the upload is spread over frames, and the mesh turns ready once its
+  buffers are complete. A mesh released before that is dropped when its upload arrives.
+
+  Users set up their own VAOs over the shared buffers, so they can differ in attribute locations
+  and instance attributes. Needs a current OpenGL context for acquire, release and deleteRegistry.
+*/
+class MeshRegistry
+{
+public:
+	static const uint32_t CACHE_FORMAT_VERSION; //!< Version of the cache file layout, older files are regenerated
+	static const char* CACHE_FILE_EXTENSION; //!< Extension of the cache files (".mesh")
+
+	//* \brief Geometry on the GPU shared by all users of one key.
+	struct SharedMesh
+	{
+		std::string key; //!< Generator and parameters
+		GLBuffer vertexBuffer; //!< Vertex buffer, GL_STATIC_DRAW
+		GLBuffer indexBuffer; //!< Index buffer, GL_STATIC_DRAW
+		GLuint floatsPerVertex = 0; //!< Floats of one vertex
+		GLsizei numVertices = 0; //!< Number of vertices
+		GLenum indexType = GL_UNSIGNED_INT; //!< GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+		GLenum primitiveType = GL_TRIANGLES; //!< Primitive type to draw the indices with
+		GLsizei numIndices = 0; //!< Number of indices
+		MeshBlob metadata; //!< Blob without vertices and indices, only the generator's metadata is kept
+		int referenceCount = 0; //!< Users that acquired and haven't released the mesh
+		bool isReady = true; //!< False while the upload of acquireAsync is pending, buffers and sizes are 0 until then
+		unsigned int uploadTicket = 0; //!< Identifies the pending upload, so a stale one can't fill a re-acquired mesh
+	};
+
+	//* \brief Where acquired meshes came from, since the registry was created.
+	struct Stats
+	{
+		int numAcquires = 0; //!< All acquire calls
+		int numShared = 0; //!< Acquires served by a mesh already on the GPU
+		int numLoaded = 0; //!< Meshes loaded from the disk cache
+		int numGenerated = 0; //!< Meshes generated, because no valid cache file existed
+		int numWritten = 0; //!< Cache files written
+		double loadMilliseconds = 0.0; //!< Time spent reading and checking cache files
+		double generateMilliseconds = 0.0; //!< Time spent in generators
+	};
+
+	//* \brief Fills the blob with the geometry of the key, on a worker thread when used with acquireAsync.
+	typedef std::function<void(MeshBlob&)> Generator;
+
+	/** \brief Creates empty registry.
+	*   \param cacheDirectory Directory of the disk cache (must exist), empty to keep meshes in memory only
+	*/
+	explicit MeshRegistry(const std::string& cacheDirectory = "");
+	~MeshRegistry();
+
+	/** \brief Gets mesh of the key onto the GPU if it isn't there yet and adds a reference to it.
+	*   \param key Generator and all its parameters, equal keys must describe equal geometry
+	*   \param generator Called only if neither the GPU nor the disk cache have the mesh
+	*   \return Shared mesh, valid until its last release. Null if the generator produced no vertices.
+	*           A mesh still pending from acquireAsync is returned as it is, check isReady.
+	*/
+	const SharedMesh* acquire(const std::string& key, const Generator& generator);
+
+	/** \brief Like acquire, but loads or generates the mesh on a worker of the queue and uploads it over the next frames.
+	*   \param key Generator and all its parameters, equal keys must describe equal geometry
+	*   \param generator Called on a worker thread only if neither the GPU nor the disk cache have the mesh,
+	*                    must not touch OpenGL or anything of the caller that may change meanwhile
+	*   \param uploadQueue Queue building and uploading the mesh, its processUploads makes the mesh ready
+	*   \return Shared mesh, valid until its last release. Not drawable before isReady is set.
+	*/
+	const SharedMesh* acquireAsync(const std::string& key, const Generator& generator, MeshUploadQueue& uploadQueue);
+
+	/** \brief Drops one reference, deletes the buffers with the last one.
+	*   \param mesh Mesh returned by acquire
+	*/
+	void release(const SharedMesh* mesh);
+
+	/** \brief Gets number of meshes on the GPU.
+	*   \return Number of meshes with references.
+	*/
+	int getNumMeshes() const;
+
+	/** \brief Gets counters of acquires, loads and generations.
+	*   \return Statistics since the registry was created.
+	*/
+	const Stats& getStats() const;
+
+	/** \brief Prints meshes on the GPU with their references and sizes, and where acquires were served from.
+	*   \param os Stream to print to
+	*/
+	void printStats(std::ostream& os) const;
+
+	/** \brief Gets path of the cache file of a key.
+	*   \param key Generator and parameters
+	*   \return Path in the cache directory, empty without one.
+	*/
+	std::string getCachePath(const std::string& key) const;
+
+	/** \brief Computes 64-bit FNV-1a hash.
+	*   \param ptrData Bytes to hash
+	*   \param numBytes Number of bytes
+	*   \param hash Hash of the preceding bytes, to hash data in pieces
+	*   \return Hash of all bytes so far.
+	*/
+	static uint64_t hashBytes(const void* ptrData, size_t numBytes, uint64_t hash = 14695981039346656037ull);
+
+	//* \brief Deletes all meshes, even those still referenced.
+	void deleteRegistry();
+
+private:
+	std::string _cacheDirectory; //!< Directory of the cache files, empty if disabled
+	std::unordered_map<std::string, SharedMesh> _meshes; //!< Meshes on the GPU by key, nodes don't move so pointers stay valid
+	Stats _stats; //!< Counters for printStats
+	unsigned int _nextUploadTicket = 0; //!< Ticket of the last acquireAsync
+
+	//* \brief Where the blob of buildBlob came from, recorded in the stats by the render thread.
+	struct BuildResult
+	{
+		bool isLoaded = false; //!< True if read from the disk cache, false if generated
+		bool isWritten = false; //!< True if a cache file was written
+		double milliseconds = 0.0; //!< Time spent loading or generating
+	};
+
+	/** \brief Loads the blob of a key from the disk cache or generates and caches it. Safe on any thread.
+	*   \param key Generator and parameters
+	*   \param generator Called if the cache has no valid file
+	*   \param blob Output
+	*   \return Where the blob came from.
+	*/
+	BuildResult buildBlob(const std::string& key, const Generator& generator, MeshBlob& blob) const;
+
+	//* \brief Adds a build to the load and generate counters.
+	void recordBuild(const BuildResult& result);
+
+	/** \brief Takes sizes and metadata of a blob into a mesh whose buffers hold its vertices and indices.
+	*   \param mesh Mesh to fill
+	*   \param blob Uploaded geometry, its metadata is moved into the mesh
+	*/
+	static void fillMesh(SharedMesh& mesh, MeshBlob& blob);
+
+	/** \brief Reads and checks cache file of a key.
+	*   \param key Generator and parameters
+	*   \param blob Output
+	*   \return True if the file exists and is valid for the key.
+	*/
+	bool loadBlob(const std::string& key, MeshBlob& blob) const;
+
+	/** \brief Writes cache file of a key.
+	*   \param key Generator and parameters
+	*   \param blob Generated geometry
+	*   \return True if written.
+	*/
+	bool saveBlob(const std::string& key, const MeshBlob& blob) const;
+};
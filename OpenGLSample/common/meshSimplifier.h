@@ -0,0 +1,38 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <vector>
+
+#include <glad/glad.h>
+
+/**
+  Simplifies indexed triangle meshes by edge collapses ordered by the quadric error metric
+  (Garland and Heckbert 1997). A vertex is always collapsed onto one of its neighbours, so no new
+  vertices are made and the simplified indices still refer to the input vertex buffer.
+
+  Welded meshes (e.g. from indexVBO) split vertices wherever the UV or the normal differs. All
+  vertices at one position are collapsed together, each one onto the neighbour on its own side of
+  the seam, and vertices on seams or open borders only slide along them. Seam and border edges add
+  constraint planes to the quadrics, so sliding along them is not free either.
+*/
+namespace mesh_simplifier {
+
+extern const float BORDER_WEIGHT; //!< Weight of seam and border constraint planes relative to the surface ones (10)
+extern const float MAX_FLIP_COS; //!< Collapses turning a triangle's normal further than acos of this are rejected (0.25)
+
+/** \brief Collapses edges until at most targetIndexCount indices are left, or no collapse stays within maxError.
+*   \param ptrIndices Indices, three per triangle
+*   \param numIndices Number of indices
+*   \param ptrPositions First vertex position (x, y, z floats)
+*   \param positionStride Floats between two positions
+*   \param numVertices Number of vertices the indices refer to
+*   \param targetIndexCount Number of indices to reach
+*   \param maxError Largest error allowed for a collapse, in model space units
+*   \param outIndices Gets indices of the simplified mesh, referring to the same vertices
+*   \return Largest distance of the simplified surface from the input one, in model space units (estimated by the quadrics).
+*/
+float simplify(const GLuint* ptrIndices, size_t numIndices, const float* ptrPositions, size_t positionStride,
+	size_t numVertices, size_t targetIndexCount, float maxError, std::vector<GLuint>& outIndices);
+
+} // namespace mesh_simplifier
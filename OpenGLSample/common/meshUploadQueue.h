@@ -0,0 +1,143 @@
+#pragma once
+
+// STL
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "glHandle.h"
+#include "meshRegistry.h"
+
+/**
+  Builds meshes on worker threads and uploads them on the render thread, a little every frame.
+
+  Generating geometry (or loading it from the disk cache) needs no OpenGL, so submitted builders run
+  on a small pool of worker threads and fill a MeshBlob each. Finished blobs wait in a ready list
+  until the render thread calls processUploads, which creates the buffers and copies the blobs into
+  them with glBufferSubData in chunks, until the frame's budget of bytes or microseconds is spent.
+  A mesh larger than the budget simply continues next frame where it stopped.
+
+  Once all vertices and indices of a mesh are on the GPU, its completion runs on the render thread
+  and takes over the buffers; until then the mesh isn't drawable and its users skip it. So a mesh
+  spawned mid-session costs the render thread at most the budget per frame instead of a hitch.
+
+  Builders must not touch OpenGL or anything the render thread changes. Needs a current OpenGL
+  context for processUploads, finish and deleteQueue.
+*/
+class MeshUploadQueue
+{
+public:
+	static const size_t DEFAULT_BUDGET_BYTES; //!< Bytes uploaded per frame when not specified (1 MiB)
+	static const size_t UPLOAD_CHUNK_SIZE; //!< Bytes of one glBufferSubData call (64 KiB), the granularity of the budget
+
+	//* \brief How much processUploads may do in one frame, a limit of 0 is no limit.
+	struct Budget
+	{
+		size_t maxBytes = DEFAULT_BUDGET_BYTES; //!< Bytes copied into buffers
+		double maxMicroseconds = 0.0; //!< Time spent in processUploads, checked after every chunk
+	};
+
+	//* \brief Work done so far, for printStats.
+	struct Stats
+	{
+		int numSubmitted = 0; //!< Meshes submitted
+		int numBuilt = 0; //!< Meshes the workers finished building
+		int numUploaded = 0; //!< Meshes whose completion ran
+		size_t uploadedBytes = 0; //!< Bytes copied into buffers
+		int numUploadFrames = 0; //!< Calls of processUploads that uploaded anything
+		size_t maxFrameBytes = 0; //!< Most bytes uploaded by one call of processUploads
+		double maxFrameMicroseconds = 0.0; //!< Longest call of processUploads that uploaded anything
+		double buildMilliseconds = 0.0; //!< Time spent in builders, summed over all workers
+	};
+
+	//* \brief Fills the blob with the mesh, runs on a worker thread.
+	typedef std::function<void(MeshBlob& blob)> Builder;
+
+	//* \brief Takes over the buffers holding the blob's vertices and indices (none without indices) by moving them, runs on the render thread.
+	typedef std::function<void(MeshBlob& blob, GLBuffer& vertexBuffer, GLBuffer& indexBuffer)> Completion;
+
+	/** \brief Starts the worker threads.
+	*   \param numThreads Number of workers, 0 for one less than the hardware threads (at least one)
+	*/
+	explicit MeshUploadQueue(int numThreads = 0);
+	~MeshUploadQueue();
+
+	/** \brief Queues a mesh to be built by a worker and uploaded by processUploads.
+	*   \param builder    Fills the blob, called on a worker thread
+	*   \param completion Called on the render thread once the mesh is on the GPU
+	*/
+	void submit(const Builder& builder, const Completion& completion);
+
+	/** \brief Uploads built meshes until the budget is spent, runs completions of all finished ones.
+	*   \param budget Limits of this call
+	*   \return Number of meshes that became drawable.
+	*/
+	int processUploads(const Budget& budget);
+
+	/** \brief Waits for all submitted meshes to be built and uploads them without any budget.
+	*   \return Number of meshes that became drawable.
+	*/
+	int finish();
+
+	/** \brief Gets number of meshes submitted but not drawable yet.
+	*   \return Meshes being built, waiting for upload or partially uploaded.
+	*/
+	int getNumPending() const;
+
+	/** \brief Gets counters of built and uploaded meshes.
+	*   \return Statistics since the queue was created.
+	*/
+	Stats getStats() const;
+
+	/** \brief Prints number of meshes built and uploaded, and the largest upload of a single frame.
+	*   \param os Stream to print to
+	*/
+	void printStats(std::ostream& os) const;
+
+	//* \brief Stops the workers and drops all meshes not uploaded yet, their completions never run.
+	void deleteQueue();
+
+private:
+	//* \brief One submitted mesh on its way to the GPU.
+	struct Job
+	{
+		Builder builder; //!< Filled the blob on a worker
+		Completion completion; //!< Takes the buffers once uploaded
+		MeshBlob blob; //!< Built mesh
+		GLBuffer vertexBuffer; //!< Created by the first upload of the mesh
+		GLBuffer indexBuffer; //!< Created by the first upload of the mesh, stays empty without indices
+		size_t uploadedBytes = 0; //!< Bytes of vertices and then indices already copied
+	};
+
+	std::vector<std::thread> _workers; //!< Threads running the builders
+	mutable std::mutex _mutex; //!< Guards everything the workers touch
+	std::condition_variable _buildCondition; //!< Wakes workers for a new job or to stop
+	std::condition_variable _builtCondition; //!< Wakes finish when a worker is done with a job
+	std::deque<std::unique_ptr<Job>> _buildQueue; //!< Waiting for a worker
+	std::deque<std::unique_ptr<Job>> _builtQueue; //!< Built, waiting for upload
+	std::unique_ptr<Job> _uploadingJob; //!< Partially uploaded mesh, render thread only
+	int _numPending = 0; //!< Submitted and not drawable yet
+	Stats _stats; //!< Counters for printStats
+	bool _isStopping = false; //!< Tells the workers to exit
+
+	//* \brief Runs builders until the queue is deleted.
+	void workerLoop();
+
+	/** \brief Copies the next chunk of a job into its buffers, creating them first if needed.
+	*   \param job      Job with a built blob
+	*   \param maxBytes Bytes that may be copied, at most UPLOAD_CHUNK_SIZE are
+	*   \return Bytes copied.
+	*/
+	static size_t uploadChunk(Job& job, size_t maxBytes);
+
+	//* \brief Bytes of vertices and indices a job uploads.
+	static size_t getJobBytes(const Job& job);
+};
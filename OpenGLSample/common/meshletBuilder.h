@@ -0,0 +1,81 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <vector>
+
+// GLM
+#include <glm/glm.hpp>
+
+#include <glad/glad.h>
+
+/**
+  Cluster of neighbouring triangles small enough to be culled on its own.
+
+  Its triangles are a contiguous range of the index list written by meshlet_builder::buildMeshlets.
+  The normal cone bounds the normals of all its triangles: seen from inside the cone behind its apex,
+  every triangle faces away from the camera.
+*/
+struct Meshlet
+{
+	GLuint firstIndex = 0; //!< Offset of the first index in the meshlet ordered index list
+	GLuint triangleCount = 0; //!< Number of triangles (three indices each)
+	GLuint vertexCount = 0; //!< Number of distinct vertices referenced
+
+	glm::vec3 center = glm::vec3(0.0f); //!< Center of the bounding sphere
+	float radius = 0.0f; //!< Radius of the bounding sphere
+
+	glm::vec3 coneApex = glm::vec3(0.0f); //!< Apex of the normal cone, behind all triangles
+	glm::vec3 coneAxis = glm::vec3(0.0f, 0.0f, 1.0f); //!< Average triangle normal
+	float coneCutoff = 2.0f; //!< Sine of the cone's half angle, above 1 if the triangles face too many ways to be culled
+};
+
+/**
+  Splits indexed triangle meshes into meshlets of at most MAX_VERTICES vertices and MAX_TRIANGLES
+  triangles, so parts of a mesh can be culled instead of only the whole object.
+
+  Triangles are gathered greedily: a meshlet grows by the neighbouring triangle that adds the fewest
+  new vertices and bends its normal cone the least, and only jumps to the next unused triangle in
+  input order when it has no neighbours left. A cache optimized input order keeps those jumps local.
+  Works on any triangle list, e.g. ShapeData indices, the sphere's tessellations or indexVBO output.
+
+  testMeshlet tests one meshlet in the mesh's own space, with the frustum planes and the camera
+  position brought into it, so no bounds have to be transformed per frame.
+*/
+namespace meshlet_builder {
+
+extern const size_t MAX_VERTICES; //!< Vertices per meshlet (64)
+extern const size_t MAX_TRIANGLES; //!< Triangles per meshlet (124)
+extern const float CONE_WEIGHT; //!< Cost of bending the normal cone relative to adding one vertex (0.5)
+extern const float MIN_CONE_COS; //!< Meshlets whose normals spread wider than acos of this get no cone (0.1)
+
+//* \brief Result of testMeshlet.
+enum class Visibility
+{
+	VISIBLE, //!< At least partially inside the frustum and not entirely back-facing
+	OUTSIDE_FRUSTUM, //!< Bounding sphere outside one of the frustum planes
+	BACK_FACING, //!< Camera inside the normal cone, all triangles face away
+};
+
+/** \brief Splits triangles into meshlets, index-degenerate triangles are dropped.
+*   \param ptrIndices Indices, three per triangle
+*   \param numIndices Number of indices
+*   \param ptrPositions First vertex position (x, y, z floats)
+*   \param positionStride Floats between two positions
+*   \param numVertices Number of vertices the indices refer to
+*   \param meshlets Output, meshlets are appended, their firstIndex refers to meshletIndices
+*   \param meshletIndices Output, indices of all triangles in meshlet order are appended
+*   \return Number of meshlets appended.
+*/
+size_t buildMeshlets(const GLuint* ptrIndices, size_t numIndices, const float* ptrPositions, size_t positionStride,
+	size_t numVertices, std::vector<Meshlet>& meshlets, std::vector<GLuint>& meshletIndices);
+
+/** \brief Tests one meshlet against the frustum and its normal cone.
+*   \param meshlet Meshlet to be tested
+*   \param planes Normalized frustum planes in model space, e.g. of a FrustumCuller set to projection * view * model
+*   \param cameraPosition Camera position in model space
+*   \return Whether and why the meshlet is culled.
+*/
+Visibility testMeshlet(const Meshlet& meshlet, const glm::vec4 planes[6], const glm::vec3& cameraPosition);
+
+} // namespace meshlet_builder
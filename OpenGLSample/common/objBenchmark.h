@@ -0,0 +1,34 @@
+#pragma once
+
+// STL
+#include <ostream>
+#include <string>
+
+/**
+  Compares the memory mapped OBJ parser against the loader it replaced (fscanf token by token,
+  push_back into unreserved vectors). The file is loaded into the triangle soup loadOBJ returns by
+  the old loader, by the parser on one thread and by the parser on all hardware threads. Every
+  variant is timed (best of a few runs, so the file is read from the cache) and its output is
+  checked against the old one.
+
+  Without a file, a wavy grid of about the given size is written in the form the old loader reads
+  (v, vt and vn lines, triangles with all three indices) and removed afterwards. Before timing, a
+  small model with a quad, a pentagon, negative indices, faces without uvs or normals and groups is
+  parsed on one and on three threads and checked against the expected triangles.
+
+  Needs no OpenGL context.
+*/
+namespace obj_benchmark {
+
+extern const int DEFAULT_MEGABYTES; //!< Size of the generated file if none is given (128)
+extern const int NUM_RUNS; //!< Runs of every variant, the fastest one is reported (3)
+
+/** \brief Runs the benchmark and prints a table of timings.
+*   \param path OBJ file to load, empty to generate one
+*   \param megabytes Approximate size of the generated file
+*   \param out Stream to print to
+*   \return 0 if the feature check passes and all parser outputs match the old one, 1 otherwise.
+*/
+int run(const std::string& path, int megabytes, std::ostream& out);
+
+} // namespace obj_benchmark
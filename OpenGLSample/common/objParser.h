@@ -0,0 +1,93 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// GLM
+#include <glm/glm.hpp>
+
+//* \brief Corner of a triangle, 0-based indices into the streams of ObjModel.
+struct ObjCorner
+{
+	int position = -1; //!< Index into positions
+	int uv = -1; //!< Index into uvs, -1 if the face gave none
+	int normal = -1; //!< Index into normals, -1 if the face gave none
+};
+
+//* \brief Triangles following an o or g line.
+struct ObjGroup
+{
+	std::string name; //!< Rest of the o / g line, empty for faces before the first one
+	size_t firstTriangle = 0; //!< First triangle of the group
+	size_t numTriangles = 0; //!< Number of triangles, never 0
+};
+
+//* \brief Contents of an OBJ file, streams as they are in the file, faces triangulated.
+struct ObjModel
+{
+	std::vector<glm::vec3> positions; //!< v lines
+	std::vector<glm::vec2> uvs; //!< vt lines, V as in the file
+	std::vector<glm::vec3> normals; //!< vn lines
+	std::vector<ObjCorner> corners; //!< Three per triangle
+	std::vector<ObjGroup> groups; //!< Consecutive ranges of triangles, in file order
+
+	//* \brief Gets number of triangles.
+	size_t getTriangleCount() const
+	{
+		return corners.size() / 3;
+	}
+};
+
+/**
+  Parses Wavefront OBJ files on all cores.
+
+  The file is memory mapped and split into line-aligned chunks, one per thread. A first pass counts
+  the v, vt and vn lines of every chunk, so each chunk knows where its vertices go in the merged
+  streams and can resolve indices right away, negative (relative) ones included. The second pass
+  parses the chunks in parallel with hand-written number parsers straight into the merged streams;
+  only the triangles of every chunk are collected separately and copied together at the end.
+
+  Faces may have any number of corners (triangulated as a fan around the first one) and give
+  positions only (f 1 2 3), positions and uvs (f 1/1 2/2 3/3), positions and normals (f 1//1 2//1
+  3//1) or all three. o and g lines start a new group, groups without faces are dropped. Anything
+  else (comments, materials, smoothing groups, lines, points) is skipped.
+
+  Errors (unreadable numbers, index 0 or out of range, faces with less than three corners) are
+  printed with their line number and fail the whole file.
+*/
+namespace obj_parser {
+
+extern const size_t MIN_PARALLEL_BYTES; //!< Smaller files are parsed on the calling thread (1 MB)
+
+/** \brief Memory maps and parses an OBJ file.
+*   \param path Path of the file
+*   \param model Output, replaced
+*   \param numThreads Number of threads, 0 picks by size and hardware
+*   \return True if the file was read without errors.
+*/
+bool parseFile(const char* path, ObjModel& model, int numThreads = 0);
+
+/** \brief Parses OBJ text already in memory.
+*   \param text First character, needs no terminating zero
+*   \param size Number of characters
+*   \param model Output, replaced
+*   \param numThreads Number of threads, 0 picks by size and hardware
+*   \param name Name printed with errors, e.g. the path
+*   \return True if the text was read without errors.
+*/
+bool parseText(const char* text, size_t size, ObjModel& model, int numThreads = 0, const char* name = "OBJ text");
+
+/** \brief Expands a model to one vertex per triangle corner, the layout loadOBJ returns.
+*          Missing uvs become (0, 0), missing normals the normal of the triangle.
+*   \param model Parsed model
+*   \param vertices Output positions, replaced
+*   \param uvs Output uvs, replaced
+*   \param normals Output normals, replaced
+*   \param numThreads Number of threads, 0 picks by size and hardware
+*/
+void toTriangleSoup(const ObjModel& model, std::vector<glm::vec3>& vertices, std::vector<glm::vec2>& uvs,
+	std::vector<glm::vec3>& normals, int numThreads = 0);
+
+} // namespace obj_parser
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include "glHandle.h"
+
+/**
+  Framebuffer object with a color and a depth renderbuffer, used as render target
+  when there is no default framebuffer (headless rendering).
+*/
+class OffscreenFramebuffer
+{
+public:
+	/** \brief Creates framebuffer with RGBA8 color and 24-bit depth attachments.
+	*   \param width  Width of the framebuffer, in pixels
+	*   \param height Height of the framebuffer, in pixels
+	*   \return True if the framebuffer is complete, false otherwise.
+	*/
+	bool create(int width, int height);
+
+	//* \brief Binds this framebuffer as draw and read framebuffer.
+	void bind() const;
+
+	/** \brief Gets framebuffer width, in pixels.
+	*   \return Framebuffer width.
+	*/
+	int getWidth() const;
+
+	/** \brief Gets framebuffer height, in pixels.
+	*   \return Framebuffer height.
+	*/
+	int getHeight() const;
+
+	//* \brief Deletes framebuffer and its renderbuffers.
+	void deleteFramebuffer();
+
+private:
+	GLFramebuffer _framebuffer; //!< Framebuffer object
+	GLRenderbuffer _colorRenderbuffer; //!< Color attachment
+	GLRenderbuffer _depthRenderbuffer; //!< Depth attachment
+	int _width = 0; //!< Framebuffer width in pixels
+	int _height = 0; //!< Framebuffer height in pixels
+
+	bool _isCreated = false; //!< Flag telling if the framebuffer has been created
+};
@@ -0,0 +1,382 @@
+#pragma once
+
+// STL
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// GLM
+#include <glm/glm.hpp>
+
+/**
+  Grid of parameter lines a parametric surface is evaluated on. There are outerSegments + 1 outer
+  lines (e.g. stacks of a sphere) and innerSegments + 1 inner lines (e.g. sectors), vertex (i, j)
+  is stored at index i * (innerSegments + 1) + j.
+
+  Every line has an angle start + index * step, surfaces get sine and cosine of both angles from
+  tables computed once per grid, plus the normalized parameter index / segments.
+*/
+struct ParametricGrid
+{
+	int outerSegments = 1;
+	int innerSegments = 1;
+	float outerStart = 0.0f; //!< Angle of outer line 0 in radians
+	float outerStep = 0.0f; //!< Angle between neighbouring outer lines
+	float innerStart = 0.0f; //!< Angle of inner line 0 in radians
+	float innerStep = 0.0f; //!< Angle between neighbouring inner lines
+
+	//* \brief Gets number of vertices of the grid, known before anything is generated.
+	size_t getVertexCount() const
+	{
+		return static_cast<size_t>(outerSegments + 1) * static_cast<size_t>(innerSegments + 1);
+	}
+};
+
+//* \brief How the quads of a grid are split into triangles.
+enum class GridTriangulation
+{
+	QUADS, //!< Two triangles (k1, k2, k2+1) and (k1, k2+1, k1+1) per quad, k2 being below k1
+	SPHERE, //!< Triangles (k1, k2, k1+1) and (k1+1, k2, k2+1), but without the collapsed ones in the first and last band
+};
+
+//* \brief One vertex of the grid, as seen by a surface.
+struct SurfaceSample
+{
+	int outer; //!< Index of the outer line
+	int inner; //!< Index of the inner line
+	float outerSin; //!< Sine of the outer angle
+	float outerCos; //!< Cosine of the outer angle
+	float innerSin; //!< Sine of the inner angle
+	float innerCos; //!< Cosine of the inner angle
+	float outerT; //!< outer / outerSegments, in [0, 1]
+	float innerT; //!< inner / innerSegments, in [0, 1]
+};
+
+//* \brief Attributes a surface computes for one vertex.
+struct SurfaceVertex
+{
+	glm::vec3 position;
+	glm::vec3 normal;
+	glm::vec2 texCoord;
+};
+
+/**
+  Where generated attributes are written to. Every attribute has its own pointer and stride (in floats),
+  so the same surface can fill interleaved vertices, planar (one attribute after another) buffers
+  or a struct like Vertex. Attributes with a null pointer are not written.
+*/
+struct VertexStreams
+{
+	float* positions = nullptr;
+	float* normals = nullptr;
+	float* texCoords = nullptr;
+	size_t positionStride = 3; //!< Floats between two positions
+	size_t normalStride = 3; //!< Floats between two normals
+	size_t texCoordStride = 2; //!< Floats between two texture coordinates
+
+	/** \brief Describes interleaved vertices.
+	*   \param data First vertex
+	*   \param floatsPerVertex Size of one vertex in floats
+	*   \param positionOffset Offset of the position in floats, negative if there is none
+	*   \param normalOffset Offset of the normal in floats, negative if there is none
+	*   \param texCoordOffset Offset of the texture coordinate in floats, negative if there is none
+	*   \return Streams writing interleaved vertices.
+	*/
+	static VertexStreams interleaved(float* data, size_t floatsPerVertex, int positionOffset, int normalOffset, int texCoordOffset);
+
+	/** \brief Describes planar buffer laid out like StaticMesh3D's default layout, all positions, then all texture coordinates, then all normals.
+	*   \param data Start of the buffer
+	*   \param numVertices Number of vertices in every block
+	*   \param withPositions Flag telling, if there is a position block
+	*   \param withTextureCoordinates Flag telling, if there is a texture coordinate block
+	*   \param withNormals Flag telling, if there is a normal block
+	*   \return Streams writing planar blocks.
+	*/
+	static VertexStreams planar(float* data, size_t numVertices, bool withPositions, bool withTextureCoordinates, bool withNormals);
+
+	/** \brief Gets the same streams starting a given number of vertices later.
+	*   \param numVertices Number of vertices to skip
+	*   \return Advanced streams.
+	*/
+	VertexStreams skip(size_t numVertices) const;
+
+	/** \brief Writes all present attributes of one vertex.
+	*   \param index Index of the vertex
+	*   \param vertex Attributes to write
+	*/
+	void write(size_t index, const SurfaceVertex& vertex) const
+	{
+		if (positions != nullptr)
+		{
+			auto* p = positions + index * positionStride;
+			p[0] = vertex.position.x;
+			p[1] = vertex.position.y;
+			p[2] = vertex.position.z;
+		}
+		if (normals != nullptr)
+		{
+			auto* n = normals + index * normalStride;
+			n[0] = vertex.normal.x;
+			n[1] = vertex.normal.y;
+			n[2] = vertex.normal.z;
+		}
+		if (texCoords != nullptr)
+		{
+			auto* t = texCoords + index * texCoordStride;
+			t[0] = vertex.texCoord.x;
+			t[1] = vertex.texCoord.y;
+		}
+	}
+};
+
+/**
+  Sphere (or ellipsoid) around the origin, the outer angle being the latitude and the inner angle the longitude.
+  With longitudeOuter set, the roles of the two angles are swapped.
+*/
+struct SphereSurface
+{
+	float radius = 1.0f;
+	float equatorScale = 1.0f; //!< Scales x and y, the crystal ball uses 1.02
+	bool longitudeOuter = false; //!< If true, outer lines are meridians and inner lines are parallels
+
+	void evaluate(const SurfaceSample& sample, SurfaceVertex& vertex) const
+	{
+		const auto latitudeSin = longitudeOuter ? sample.innerSin : sample.outerSin;
+		const auto latitudeCos = longitudeOuter ? sample.innerCos : sample.outerCos;
+		const auto longitudeSin = longitudeOuter ? sample.outerSin : sample.innerSin;
+		const auto longitudeCos = longitudeOuter ? sample.outerCos : sample.innerCos;
+
+		vertex.normal = glm::vec3(latitudeCos * longitudeCos, latitudeCos * longitudeSin, latitudeSin);
+		const auto xy = equatorScale * radius * latitudeCos;
+		vertex.position = glm::vec3(xy * longitudeCos, xy * longitudeSin, radius * latitudeSin);
+		vertex.texCoord = glm::vec2(sample.innerT, sample.outerT);
+	}
+};
+
+/**
+  Side of a cylinder along y, the outer angle goes around, the inner parameter goes from the top (0)
+  to the bottom (1). Use innerSegments = 1 for a triangle strip of top / bottom pairs.
+*/
+struct CylinderSideSurface
+{
+	float radius = 1.0f;
+	float height = 1.0f;
+	float textureRepeatU = 2.0f; //!< How many times the texture wraps around
+
+	void evaluate(const SurfaceSample& sample, SurfaceVertex& vertex) const
+	{
+		vertex.normal = glm::vec3(sample.outerCos, 0.0f, sample.outerSin);
+		vertex.position = glm::vec3(sample.outerCos * radius, height * (0.5f - sample.innerT), sample.outerSin * radius);
+		vertex.texCoord = glm::vec2(textureRepeatU * sample.outerT, 1.0f - sample.innerT);
+	}
+};
+
+/**
+  Rim of a cylinder cover at height y, the outer angle goes around (innerSegments = 0). The bottom
+  cover (facing down) mirrors z and the texture, so both covers wind the same way seen from outside.
+*/
+struct CylinderCoverSurface
+{
+	float radius = 1.0f;
+	float y = 0.0f;
+	bool facingDown = false;
+
+	void evaluate(const SurfaceSample& sample, SurfaceVertex& vertex) const
+	{
+		const auto sign = facingDown ? -1.0f : 1.0f;
+		vertex.normal = glm::vec3(0.0f, sign, 0.0f);
+		vertex.position = glm::vec3(sample.outerCos * radius, y, sign * sample.outerSin * radius);
+		vertex.texCoord = glm::vec2(0.5f + sample.outerSin * 0.5f, 0.5f + sign * sample.outerCos * 0.5f);
+	}
+};
+
+/**
+  Flat grid in the xz plane with unit spacing, outer lines along z and inner lines along x, facing up.
+  Angles are not used.
+*/
+struct FlatGridSurface
+{
+	glm::vec3 origin = glm::vec3(0.0f); //!< Position of vertex (0, 0)
+
+	void evaluate(const SurfaceSample& sample, SurfaceVertex& vertex) const
+	{
+		vertex.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+		vertex.position = origin + glm::vec3(static_cast<float>(sample.inner), 0.0f, static_cast<float>(sample.outer));
+		vertex.texCoord = glm::vec2(sample.innerT, sample.outerT);
+	}
+};
+
+/**
+  Generates vertices and indices of parametric surfaces straight into caller provided memory.
+
+  Sizes of all outputs are known up front (ParametricGrid::getVertexCount, getIndexCount), so callers
+  allocate once. Sines and cosines are computed once per grid line, four at a time with SSE2, and shared
+  by all vertices and threads. Grids with at least MIN_PARALLEL_VERTICES vertices are split into
+  bands of outer lines generated on separate threads.
+*/
+namespace parametric_surface {
+
+extern const size_t MIN_PARALLEL_VERTICES; //!< Smaller grids are generated on the calling thread (65536)
+
+/** \brief Fills tables with sin / cos of start + i * step, in batches of four with SSE2 (scalar fallback otherwise).
+*   \param start Angle of the first entry in radians
+*   \param step Angle between neighbouring entries
+*   \param count Number of entries
+*   \param sines Output table with room for count floats
+*   \param cosines Output table with room for count floats
+*/
+void fillSinCosTable(float start, float step, int count, float* sines, float* cosines);
+
+/** \brief Gets number of indices a grid triangulates to.
+*   \param grid Grid to triangulate
+*   \param triangulation How quads are split
+*   \return Number of indices.
+*/
+size_t getIndexCount(const ParametricGrid& grid, GridTriangulation triangulation);
+
+/** \brief Gets number of threads used for a number of vertices.
+*   \param numVertices Number of vertices to generate
+*   \param numThreads Requested number of threads, 0 picks by size and hardware
+*   \return Number of threads, at least 1.
+*/
+int getThreadCount(size_t numVertices, int numThreads);
+
+/** \brief Runs job(firstOuter, endOuter) over bands of outer lines, on numThreads threads.
+*   \param numOuterLines Number of outer lines to split
+*   \param numThreads Number of threads, 1 runs everything on the calling thread
+*   \param job Callable generating one band
+*/
+template <typename Job>
+void forEachBand(int numOuterLines, int numThreads, const Job& job)
+{
+	numThreads = std::max(1, std::min(numThreads, numOuterLines));
+	if (numThreads == 1)
+	{
+		job(0, numOuterLines);
+		return;
+	}
+
+	std::vector<std::thread> threads;
+	threads.reserve(numThreads - 1);
+	const auto bandSize = (numOuterLines + numThreads - 1) / numThreads;
+	for (auto first = bandSize; first < numOuterLines; first += bandSize) {
+		threads.emplace_back(job, first, std::min(first + bandSize, numOuterLines));
+	}
+	job(0, std::min(bandSize, numOuterLines));
+
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
+
+/** \brief Evaluates a surface on every vertex of the grid.
+*   \param surface Surface with evaluate(const SurfaceSample&, SurfaceVertex&) const
+*   \param grid Grid to evaluate the surface on
+*   \param streams Output with room for grid.getVertexCount() vertices
+*   \param numThreads Number of threads, 0 picks by size and hardware
+*/
+template <typename Surface>
+void generateVertices(const Surface& surface, const ParametricGrid& grid, const VertexStreams& streams, int numThreads = 0)
+{
+	const auto numOuterLines = grid.outerSegments + 1;
+	const auto numInnerLines = grid.innerSegments + 1;
+	std::vector<float> outerSines(numOuterLines), outerCosines(numOuterLines);
+	std::vector<float> innerSines(numInnerLines), innerCosines(numInnerLines), innerTs(numInnerLines);
+	fillSinCosTable(grid.outerStart, grid.outerStep, numOuterLines, outerSines.data(), outerCosines.data());
+	fillSinCosTable(grid.innerStart, grid.innerStep, numInnerLines, innerSines.data(), innerCosines.data());
+	for (auto j = 0; j < numInnerLines; j++) {
+		innerTs[j] = grid.innerSegments > 0 ? static_cast<float>(j) / grid.innerSegments : 0.0f;
+	}
+
+	const auto generateBand = [&](int firstOuter, int endOuter)
+	{
+		SurfaceSample sample;
+		SurfaceVertex vertex;
+		auto index = static_cast<size_t>(firstOuter) * numInnerLines;
+		for (auto i = firstOuter; i < endOuter; i++)
+		{
+			sample.outer = i;
+			sample.outerSin = outerSines[i];
+			sample.outerCos = outerCosines[i];
+			sample.outerT = grid.outerSegments > 0 ? static_cast<float>(i) / grid.outerSegments : 0.0f;
+			for (auto j = 0; j < numInnerLines; j++, index++)
+			{
+				sample.inner = j;
+				sample.innerSin = innerSines[j];
+				sample.innerCos = innerCosines[j];
+				sample.innerT = innerTs[j];
+				surface.evaluate(sample, vertex);
+				streams.write(index, vertex);
+			}
+		}
+	};
+
+	forEachBand(numOuterLines, getThreadCount(grid.getVertexCount(), numThreads), generateBand);
+}
+
+/** \brief Writes triangle indices of a grid.
+*   \param grid Grid to triangulate
+*   \param triangulation How quads are split
+*   \param indices Output with room for getIndexCount(grid, triangulation) indices
+*   \param baseVertex Added to every index, for grids stored after other vertices
+*   \param numThreads Number of threads, 0 picks by size and hardware
+*/
+template <typename Index>
+void generateIndices(const ParametricGrid& grid, GridTriangulation triangulation, Index* indices, size_t baseVertex = 0, int numThreads = 0)
+{
+	const auto numBands = grid.outerSegments;
+	const auto numInnerLines = static_cast<size_t>(grid.innerSegments) + 1;
+	const auto isSphere = triangulation == GridTriangulation::SPHERE;
+
+	// Every band writes the same number of indices except the collapsed first and last band of a sphere
+	const auto fullBand = static_cast<size_t>(grid.innerSegments) * 6;
+	const auto halfBand = static_cast<size_t>(grid.innerSegments) * 3;
+	const auto bandOffset = [&](int band) -> size_t
+	{
+		if (!isSphere || band == 0) {
+			return band * fullBand;
+		}
+		return halfBand + (band - 1) * fullBand;
+	};
+
+	const auto generateBands = [&](int firstBand, int endBand)
+	{
+		auto* out = indices + bandOffset(firstBand);
+		for (auto i = firstBand; i < endBand; i++)
+		{
+			auto k1 = baseVertex + i * numInnerLines; // beginning of current line
+			auto k2 = k1 + numInnerLines; // beginning of next line
+			for (auto j = 0; j < grid.innerSegments; j++, k1++, k2++)
+			{
+				if (!isSphere)
+				{
+					*out++ = static_cast<Index>(k1);
+					*out++ = static_cast<Index>(k2);
+					*out++ = static_cast<Index>(k2 + 1);
+					*out++ = static_cast<Index>(k1);
+					*out++ = static_cast<Index>(k2 + 1);
+					*out++ = static_cast<Index>(k1 + 1);
+					continue;
+				}
+
+				if (i != 0)
+				{
+					*out++ = static_cast<Index>(k1);
+					*out++ = static_cast<Index>(k2);
+					*out++ = static_cast<Index>(k1 + 1);
+				}
+				if (i != numBands - 1)
+				{
+					*out++ = static_cast<Index>(k1 + 1);
+					*out++ = static_cast<Index>(k2);
+					*out++ = static_cast<Index>(k2 + 1);
+				}
+			}
+		}
+	};
+
+	forEachBand(numBands, getThreadCount(getIndexCount(grid, triangulation) / 6, numThreads), generateBands);
+}
+
+} // namespace parametric_surface
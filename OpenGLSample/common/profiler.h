@@ -0,0 +1,153 @@
+#pragma once
+
+// STL
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+/**
+  Hierarchical CPU / GPU frame profiler. Code is instrumented with PROFILE_SCOPE("name"), scopes
+  can be nested and every scope records its CPU time (high resolution clock) and its GPU time.
+
+  GPU time is measured with pairs of GL_TIMESTAMP queries, because GL_TIME_ELAPSED queries cannot
+  be nested. Every frame has its own pool of queries and pools are read back FRAMES_IN_FLIGHT
+  frames later, so measuring does not stall the pipeline.
+
+  Captured frames can be exported as Chrome trace-event JSON (chrome://tracing or ui.perfetto.dev),
+  CPU scopes are on one track and GPU scopes on another.
+
+  Scopes are recorded only on the thread that created the profiler, which must own the GL context.
+*/
+class Profiler
+{
+public:
+	static const int FRAMES_IN_FLIGHT; //!< Number of frames before query results are read back (4)
+	static const int MAX_GPU_SCOPES_PER_FRAME; //!< Scopes beyond this get CPU time only (256)
+	static const int MAX_CAPTURED_FRAMES; //!< Capture stops by itself after this many frames (5000)
+
+	/** \brief Gets the profiler used by PROFILE_SCOPE.
+	*   \return Global profiler.
+	*/
+	static Profiler& get();
+
+	//* \brief Creates query pools and starts recording scopes. Needs a current OpenGL context.
+	void create();
+
+	//* \brief Starts a frame, all scopes until endFrame belong to it.
+	void beginFrame();
+
+	//* \brief Ends the current frame and collects results of older frames that are already available.
+	void endFrame();
+
+	/** \brief Opens nested scope, use PROFILE_SCOPE instead of calling it directly.
+	*   \param name Name of the scope, must outlive the profiler (string literal)
+	*/
+	void beginScope(const char* name);
+
+	//* \brief Closes the most recently opened scope.
+	void endScope();
+
+	//* \brief Starts collecting frames for the trace export, previously captured frames are dropped.
+	void startCapture();
+
+	//* \brief Stops collecting frames, waits for the GPU results of frames still in flight.
+	void stopCapture();
+
+	/** \brief Tells, if frames are being captured.
+	*   \return True if capturing.
+	*/
+	bool isCapturing() const;
+
+	/** \brief Gets number of frames captured since startCapture.
+	*   \return Number of frames.
+	*/
+	int getNumCapturedFrames() const;
+
+	/** \brief Writes captured frames as Chrome trace-event JSON.
+	*   \param path Path of the output file
+	*   \return True if the file has been written or false otherwise.
+	*/
+	bool writeChromeTrace(const std::string& path) const;
+
+	/** \brief Prints mean CPU and GPU time of every scope over the captured frames, indented by nesting.
+	*   \param out Stream to print to
+	*/
+	void printReport(std::ostream& out) const;
+
+	//* \brief Deletes query pools and captured frames.
+	void deleteProfiler();
+
+private:
+	//* \brief One closed (or still open) scope of a frame.
+	struct ScopeEvent
+	{
+		const char* name; //!< Name given to PROFILE_SCOPE
+		int depth; //!< Nesting level, 0 for outermost scopes
+		int frame; //!< Index of the frame since the capture started
+		double cpuBeginMicroseconds; //!< CPU start, since the profiler has been created
+		double cpuEndMicroseconds; //!< CPU end, since the profiler has been created
+		double gpuBeginMicroseconds; //!< GPU start converted to the CPU time base, negative if not measured
+		double gpuEndMicroseconds; //!< GPU end converted to the CPU time base
+		int firstQuery; //!< Index of the begin query in the frame's pool, -1 if the pool was full
+	};
+
+	//* \brief Queries and scopes of one frame in flight.
+	struct FrameSlot
+	{
+		std::vector<GLuint> queries; //!< Timestamp queries, two per scope
+		std::vector<ScopeEvent> events; //!< Scopes in the order they were opened
+		int usedQueries = 0; //!< Number of queries issued in this frame
+		bool isPending = false; //!< Flag telling, if results have not been read back yet
+		bool isCaptured = false; //!< Flag telling, if the frame goes into the capture
+	};
+
+	std::vector<FrameSlot> _slots; //!< Ring of FRAMES_IN_FLIGHT frames
+	std::vector<int> _openScopes; //!< Indices of open scopes in the current frame's events
+	std::vector<ScopeEvent> _capturedEvents; //!< Scopes of all captured frames
+	int _framesBegun = 0; //!< Number of frames started so far
+	int _framesResolved = 0; //!< Number of frames whose results have been read back
+	int _capturedFrames = 0; //!< Number of frames started since the capture started
+	bool _isInFrame = false; //!< Flag telling, if beginFrame has been called without endFrame
+	bool _isCapturing = false; //!< Flag telling, if frames are being captured
+
+	double _gpuToCpuOffsetMicroseconds = 0.0; //!< Added to GPU timestamps to get the CPU time base
+	size_t _ownerThread = 0; //!< Hash of the id of the thread that created the profiler
+
+	bool _isCreated = false; //!< Flag telling, if the query pools have been created
+
+	/** \brief Reads back query results of the oldest pending frame.
+	*   \param wait If true, blocks until the results are available
+	*   \return True if results have been read.
+	*/
+	bool resolveOldestFrame(bool wait);
+
+	/** \brief Checks, if scopes can be recorded on the calling thread.
+	*   \return True if the profiler is created and called from its owner thread.
+	*/
+	bool isRecordingThread() const;
+};
+
+/**
+  Opens a profiler scope in the constructor and closes it in the destructor.
+*/
+class ProfileScope
+{
+public:
+	explicit ProfileScope(const char* name) { Profiler::get().beginScope(name); }
+	~ProfileScope() { Profiler::get().endScope(); }
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// Define PROFILING_DISABLED to compile all scopes out
+#ifdef PROFILING_DISABLED
+#define PROFILE_SCOPE(name)
+#else
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#endif
@@ -0,0 +1,93 @@
+#pragma once
+
+// STL
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "uniformRingBuffer.h"
+
+/**
+  One draw call together with all the state it needs. The sort key decides the replay order,
+  the GL names decide which binds are actually issued.
+*/
+struct DrawPacket
+{
+	uint64_t sortKey = 0; //!< Key built with RenderQueue::makeSortKey
+	GLuint program = 0; //!< Shader program
+	GLuint diffuseMap = 0; //!< Texture bound to unit 0, 0 if the program samples no textures
+	GLuint specularMap = 0; //!< Texture bound to unit 1, 0 if the program samples no textures
+	GLuint vao = 0; //!< Vertex array object
+	size_t objectBlockOffset = 0; //!< Offset of the object's uniform block in the ring buffer
+
+	GLenum primitiveType = GL_TRIANGLES; //!< Primitive type to render
+	GLsizei count = 0; //!< Number of vertices (or indices when indexType is set)
+	GLint first = 0; //!< First vertex (or first index when indexType is set)
+	GLenum indexType = 0; //!< Type of indices for glDrawElements, 0 for glDrawArrays
+
+	const char* name = "draw"; //!< Name of the profiler scope around the draw call (string literal)
+};
+
+/**
+  Collects draw packets during a frame, sorts them by a 64-bit key and replays them, skipping
+  every program, texture and VAO bind that would not change the current GL state.
+
+  Key layout, most significant bits first:
+    program (10 bits) | material (16 bits) | VAO (14 bits) | front-to-back depth (24 bits)
+  GL names are truncated to their field width, which can only make the order less ideal, never
+  wrong, because the replay compares the actual GL names.
+*/
+class RenderQueue
+{
+public:
+	//* \brief State change counters of one replayed frame.
+	struct Stats
+	{
+		int draws = 0; //!< Number of draw calls issued
+		int programBinds = 0; //!< glUseProgram calls issued
+		int textureBinds = 0; //!< glBindTexture calls issued
+		int vaoBinds = 0; //!< glBindVertexArray calls issued
+		int avoidedStateChanges = 0; //!< Binds skipped compared to binding everything for every draw
+	};
+
+	/** \brief Builds sort key out of the draw state.
+	*   \param program     Shader program
+	*   \param diffuseMap  Diffuse texture (0 if none)
+	*   \param specularMap Specular texture (0 if none)
+	*   \param vao         Vertex array object
+	*   \param viewDepth   Distance from the camera along the view direction
+	*   \param farPlane    Distance of the far plane, depth is quantized in range [0, farPlane]
+	*   \return 64-bit sort key.
+	*/
+	static uint64_t makeSortKey(GLuint program, GLuint diffuseMap, GLuint specularMap, GLuint vao, float viewDepth, float farPlane);
+
+	//* \brief Removes all packets submitted so far.
+	void clear();
+
+	/** \brief Adds packet to the queue.
+	*   \param packet Draw packet to be rendered
+	*/
+	void submit(const DrawPacket& packet);
+
+	/** \brief Sorts packets by their keys and renders them, binding the object block of every packet.
+	*   \param uniformRing Ring buffer holding the object blocks, already flushed for this frame
+	*/
+	void execute(const UniformRingBuffer& uniformRing);
+
+	/** \brief Gets counters of the last executed frame.
+	*   \return Stats of the last frame.
+	*/
+	const Stats& getLastFrameStats() const;
+
+	/** \brief Prints counters of the last executed frame.
+	*   \param os Output stream
+	*/
+	void printStats(std::ostream& os) const;
+
+private:
+	std::vector<DrawPacket> _packets; //!< Packets submitted in the current frame
+	std::vector<size_t> _order; //!< Packet indices sorted by key, kept to avoid reallocations
+	Stats _lastFrameStats; //!< Counters of the last executed frame
+};
@@ -0,0 +1,185 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+  Accounts for every OpenGL object holding memory: buffers, textures (with their whole mip chain),
+  renderbuffers and shader programs. Code creating an object records it with TRACK_RESOURCE, giving
+  its size, an owner tag naming the subsystem (e.g. "mesh registry") and, through the macro, the file
+  and line it was created at. Objects held by GL handles are untracked by GLDeletionQueue when it
+  actually deletes them, others call UNTRACK_RESOURCE.
+
+  Sizes are what the objects were specified with, the driver may pad them or keep extra copies.
+  Programs are counted with their binary length as reported by the driver (OpenGL 4.1), an estimate
+  of what they occupy. Owners that keep a CPU copy of their data next to the OpenGL object (e.g. the
+  instance array) add its size with setHostBytes.
+
+  Usage can be queried at any time, per owner or in total, and printReport dumps it grouped by
+  owner. Owners can be given a budget, exceeding it prints a warning once. Objects still tracked when
+  everything should be deleted are leaks, printReport with listResources shows where they came from.
+
+  Calls must come from the thread owning the OpenGL context. Doesn't include any OpenGL header, so
+  code loading OpenGL with another loader can record its objects, too.
+*/
+class ResourceTracker
+{
+public:
+	//* \brief Kind of OpenGL object, object names are unique only within their kind.
+	enum Type
+	{
+		BUFFER,
+		TEXTURE,
+		RENDERBUFFER,
+		PROGRAM,
+		NUM_TYPES
+	};
+
+	//* \brief One tracked OpenGL object.
+	struct Resource
+	{
+		Type type = BUFFER; //!< Kind of object
+		unsigned int id = 0; //!< OpenGL assigned name
+		size_t bytes = 0; //!< Memory of the object on the GPU
+		size_t hostBytes = 0; //!< CPU copy kept by the owner
+		std::string owner; //!< Subsystem the object belongs to
+		std::string file; //!< Source file the object was created in (or the source of a program)
+		int line = 0; //!< Line in the file, 0 if unknown
+	};
+
+	//* \brief Number and memory of objects, per kind.
+	struct Usage
+	{
+		int count[NUM_TYPES] = {}; //!< Objects of every kind
+		size_t bytes[NUM_TYPES] = {}; //!< GPU memory of every kind
+		size_t hostBytes = 0; //!< CPU copies of all kinds
+
+		int getTotalCount() const; //!< Objects of all kinds
+		size_t getTotalBytes() const; //!< GPU memory of all kinds
+	};
+
+	/** \brief Gets the tracker used by TRACK_RESOURCE.
+	*   \return Global tracker.
+	*/
+	static ResourceTracker& get();
+
+	/** \brief Records a new object, or replaces the record of an object re-specified from scratch.
+	*   \param type  Kind of object
+	*   \param id    OpenGL assigned name, 0 is ignored
+	*   \param bytes Memory of the object on the GPU
+	*   \param owner Subsystem tag, objects are grouped by it
+	*   \param file  Source file creating the object
+	*   \param line  Line in the file
+	*/
+	void track(Type type, unsigned int id, size_t bytes, const char* owner, const char* file, int line);
+
+	/** \brief Changes the size of a tracked object, e.g. when its storage gets specified after creation.
+	*   \param type  Kind of object
+	*   \param id    OpenGL assigned name
+	*   \param bytes New memory of the object on the GPU
+	*/
+	void resize(Type type, unsigned int id, size_t bytes);
+
+	/** \brief Sets the size of the CPU copy the owner keeps of a tracked object.
+	*   \param type      Kind of object
+	*   \param id        OpenGL assigned name
+	*   \param hostBytes Bytes of the CPU copy
+	*/
+	void setHostBytes(Type type, unsigned int id, size_t hostBytes);
+
+	/** \brief Forgets a deleted object.
+	*   \param type Kind of object
+	*   \param id   OpenGL assigned name, 0 and unknown names are ignored
+	*/
+	void untrack(Type type, unsigned int id);
+
+	/** \brief Finds the record of an object.
+	*   \param type Kind of object
+	*   \param id   OpenGL assigned name
+	*   \return Record, nullptr if the object isn't tracked. Valid until the next change.
+	*/
+	const Resource* find(Type type, unsigned int id) const;
+
+	/** \brief Gets usage of all tracked objects.
+	*   \return Total usage.
+	*/
+	const Usage& getUsage() const;
+
+	/** \brief Gets usage of the objects of one owner.
+	*   \param owner Subsystem tag
+	*   \return Usage of the owner, empty if it has no objects.
+	*/
+	Usage getUsage(const std::string& owner) const;
+
+	/** \brief Gets records of all tracked objects.
+	*   \return Records sorted by owner, kind and name.
+	*/
+	std::vector<Resource> getResources() const;
+
+	/** \brief Sets the GPU memory an owner is expected to stay within, going over it prints a warning once.
+	*   \param owner Subsystem tag
+	*   \param bytes Budget, 0 to remove it
+	*/
+	void setBudget(const std::string& owner, size_t bytes);
+
+	/** \brief Prints the usage of every owner and the total, optionally every object with its creation site.
+	*   \param title         Heading of the report
+	*   \param listResources If true, every tracked object is listed below its owner
+	*   \param os            Stream to print to
+	*/
+	void printReport(const char* title, bool listResources, std::ostream& os) const;
+
+	/** \brief Computes the memory of a texture with all its mip levels.
+	*   \param width         Width of level 0, in texels
+	*   \param height        Height of level 0, in texels
+	*   \param layers        Array layers (not halved by the mip levels), 1 for plain textures
+	*   \param bytesPerTexel Bytes of one texel, e.g. 4 for RGBA8
+	*   \param isMipmapped   If true, levels are added down to 1x1
+	*   \return Bytes of all levels.
+	*/
+	static size_t getTextureBytes(int width, int height, int layers, int bytesPerTexel, bool isMipmapped);
+
+	/** \brief Asks the driver for the binary length of a linked program. Needs OpenGL 4.1, returns 0 before.
+	*   \param programID Linked program
+	*   \return Bytes of the program binary, 0 if unknown.
+	*/
+	static size_t getProgramBytes(unsigned int programID);
+
+	//* \brief Gets the name of a kind of object, e.g. "buffers".
+	static const char* getTypeName(Type type);
+
+	//* \brief Forgets all objects, budgets stay.
+	void clear();
+
+private:
+	typedef std::pair<int, unsigned int> Key; //!< Kind and name of an object
+
+	std::map<Key, Resource> _resources; //!< Tracked objects
+	std::map<std::string, Usage> _usageByOwner; //!< Usage of every owner with objects
+	Usage _usage; //!< Usage of all objects
+	std::map<std::string, size_t> _budgets; //!< GPU memory budgets by owner
+	std::map<std::string, bool> _isBudgetExceeded; //!< Owners whose budget warning has been printed
+
+	//* \brief Adds (sign 1) or removes (sign -1) an object to the usage of its owner and the total.
+	void account(const Resource& resource, int sign);
+
+	//* \brief Prints the warning if an owner went over its budget for the first time.
+	void checkBudget(const std::string& owner);
+};
+
+// Define RESOURCE_TRACKING_DISABLED to compile all tracking out
+#ifdef RESOURCE_TRACKING_DISABLED
+#define TRACK_RESOURCE(type, id, bytes, owner)
+#define TRACK_RESOURCE_FROM(type, id, bytes, owner, source)
+#define UNTRACK_RESOURCE(type, id)
+#else
+#define TRACK_RESOURCE(type, id, bytes, owner) ResourceTracker::get().track(ResourceTracker::type, id, bytes, owner, __FILE__, __LINE__)
+// for objects better identified by the file they were made from, e.g. a program by its shader source
+#define TRACK_RESOURCE_FROM(type, id, bytes, owner, source) ResourceTracker::get().track(ResourceTracker::type, id, bytes, owner, source, 0)
+#define UNTRACK_RESOURCE(type, id) ResourceTracker::get().untrack(ResourceTracker::type, id)
+#endif
@@ -1,66 +1,155 @@
-#pragma once
-
-#include "vertextBufferObject.h"
-
-
-namespace static_meshes_3D {
-
-/**
-	Represents generic 3D static mesh.
-*/
-class StaticMesh3D
-{
-public:
-	static const int POSITION_ATTRIBUTE_INDEX; //!< Vertex attribute index of vertex position (0)
-	static const int TEXTURE_COORDINATE_ATTRIBUTE_INDEX; //!< Vertex attribute index of texture coordinate (1)
-	static const int NORMAL_ATTRIBUTE_INDEX; //!< Vertex attribute index of vertex normal (2)
-
-	StaticMesh3D(bool withPositions, bool withTextureCoordinates, bool withNormals);
-	virtual ~StaticMesh3D();
-
-	/** \brief  Renders static mesh. */
-	virtual void render() const = 0;
-
-	/** \brief  Renders static mesh as points only. */
-	virtual void renderPoints() const {}
-
-	/** \brief  Deletes static mesh data. */
-	virtual void deleteMesh();
-
-	/** \brief  Checks, if static mesh has vertex positions.
-	*   \return True if it has or false otherwise.
-	*/
-	bool hasPositions() const;
-
-	/** \brief  Checks, if static mesh has texture coordinates.
-	*   \return True if it has or false otherwise.
-	*/
-	bool hasTextureCoordinates() const;
-
-	/** \brief  Checks, if static mesh has vertex normals.
-	*   \return True if it has or false otherwise.
-	*/
-	bool hasNormals() const;
-
-	/** \brief  Calculates byte size of one vertex, depending on its attributes.
-	*   \return True if it has or false otherwise.
-	*/
-	int getVertexByteSize() const;
-
-protected:
-	bool _hasPositions = false; //!< Flag telling, if we have vertex positions
-	bool _hasTextureCoordinates = false; //!< Flag telling, if we have texture coordinates
-	bool _hasNormals = false; //!< Flag telling, if we have vertex normals
-
-	bool _isInitialized = false; //!< Is mesh initialized flag
-	GLuint _vao = 0; //!< VAO ID from OpenGL
-	VertexBufferObject _vbo; //!< Our VBO wrapper class holding static mesh data
-
-	/** \brief  Initializes vertex data. */
-	virtual void initializeData() {};
-
-	/** \brief  Sets vertex attribute pointers in a standard way. */
-	void setVertexAttributesPointers(int numVertices);
-};
-
+#pragma once
+
+#include "vertextBufferObject.h"
+#include "instanceBuffer.h"
+#include "boundingVolume.h"
+#include "glHandle.h"
+
+struct VertexStreams;
+class GeometryHeap;
+
+namespace static_meshes_3D {
+
+/**
+	Order of the vertex attributes in the VBO of a static mesh.
+*/
+enum class VertexLayout
+{
+	PLANAR, //!< All positions, then all texture coordinates, then all normals
+	INTERLEAVED, //!< Position, texture coordinate and normal of every vertex next to each other
+	SPLIT_POSITIONS, //!< All positions, then texture coordinates and normals interleaved, so depth-only passes fetch only positions
+};
+
+/**
+	Represents generic 3D static mesh.
+
+	All attributes live in one VBO, laid out as given by the vertex layout. Subclasses write their
+	vertices through getVertexStreams and set the attribute pointers with setVertexAttributesPointers,
+	so both always agree on the layout.
+
+	While a geometry heap is set with setGeometryHeap, new meshes take a range of one of its buffers
+	instead of a VBO of their own. Interleaved vertices are then drawn with a base vertex into the
+	heap buffer, planar ones with attribute offsets into it; after the heap is defragmented, the
+	next draw points the VAO at the moved range.
+*/
+class StaticMesh3D
+{
+public:
+	static const int POSITION_ATTRIBUTE_INDEX; //!< Vertex attribute index of vertex position (0)
+	static const int TEXTURE_COORDINATE_ATTRIBUTE_INDEX; //!< Vertex attribute index of texture coordinate (1)
+	static const int NORMAL_ATTRIBUTE_INDEX; //!< Vertex attribute index of vertex normal (2)
+
+	StaticMesh3D(bool withPositions, bool withTextureCoordinates, bool withNormals, VertexLayout vertexLayout = VertexLayout::PLANAR);
+	virtual ~StaticMesh3D();
+
+	/** \brief  Sets heap that meshes created from now on allocate their vertices from.
+	*   \param heap Heap that outlives the meshes, nullptr to give every mesh its own VBO again
+	*/
+	static void setGeometryHeap(GeometryHeap* heap);
+
+	/** \brief  Gets heap set by setGeometryHeap.
+	*   \return Heap or nullptr.
+	*/
+	static GeometryHeap* getGeometryHeap();
+
+	/** \brief  Renders static mesh. */
+	virtual void render() const = 0;
+
+	/** \brief  Renders all instances of static mesh stored in the instance buffer.
+	*   \param instanceBuffer Buffer with per-instance transforms, already updated on the GPU
+	*/
+	void renderInstanced(const InstanceBuffer& instanceBuffer) const;
+
+	/** \brief  Renders static mesh as points only. */
+	virtual void renderPoints() const {}
+
+	/** \brief  Deletes static mesh data. */
+	virtual void deleteMesh();
+
+	/** \brief  Checks, if static mesh has vertex positions.
+	*   \return True if it has or false otherwise.
+	*/
+	bool hasPositions() const;
+
+	/** \brief  Checks, if static mesh has texture coordinates.
+	*   \return True if it has or false otherwise.
+	*/
+	bool hasTextureCoordinates() const;
+
+	/** \brief  Checks, if static mesh has vertex normals.
+	*   \return True if it has or false otherwise.
+	*/
+	bool hasNormals() const;
+
+	/** \brief  Calculates byte size of one vertex, depending on its attributes.
+	*   \return True if it has or false otherwise.
+	*/
+	int getVertexByteSize() const;
+
+	/** \brief  Gets order of the vertex attributes in the VBO.
+	*   \return Vertex layout given to the constructor.
+	*/
+	VertexLayout getVertexLayout() const;
+
+	/** \brief  Gets bounding sphere and box of the mesh in model space, computed when the mesh is built.
+	*   \return Bounding volume of the mesh.
+	*/
+	const BoundingVolume& getBounds() const;
+
+protected:
+	bool _hasPositions = false; //!< Flag telling, if we have vertex positions
+	bool _hasTextureCoordinates = false; //!< Flag telling, if we have texture coordinates
+	bool _hasNormals = false; //!< Flag telling, if we have vertex normals
+	VertexLayout _vertexLayout = VertexLayout::PLANAR; //!< Order of the vertex attributes in the VBO
+
+	bool _isInitialized = false; //!< Is mesh initialized flag
+	GLVertexArray _vao; //!< VAO over the mesh's buffers
+	VertexBufferObject _vbo; //!< Our VBO wrapper class holding static mesh data
+	BoundingVolume _bounds; //!< Bounding volume in model space, to be set by initializeData
+	int _numBufferVertices = 0; //!< Vertices in the VBO, given to setVertexAttributesPointers
+	mutable unsigned int _heapGeneration = 0; //!< Heap generation the VAO points into
+
+	/** \brief  Initializes vertex data. */
+	virtual void initializeData() {};
+
+	/** \brief  Issues instanced draw calls, VAO with instance attributes is already bound.
+	*   \param numInstances Number of instances to render
+	*/
+	virtual void renderInstancedPrimitives(GLsizei numInstances) const {};
+
+	/** \brief  Describes where the attributes of every vertex go in a buffer of the mesh's vertex layout.
+	*   \param data        Start of the buffer, getVertexByteSize() * numVertices bytes
+	*   \param numVertices Number of vertices in the buffer
+	*   \return Streams to write the vertices with.
+	*/
+	VertexStreams getVertexStreams(float* data, int numVertices) const;
+
+	/** \brief  Creates mapped VBO for the vertices, in the geometry heap if one is set.
+	*   \param sizeBytes Size of all vertices
+	*/
+	void createVertexBuffer(uint32_t sizeBytes);
+
+	/** \brief  Sets vertex attribute pointers matching the mesh's vertex layout. VBO must be bound.
+	*   \param numVertices Number of vertices in the VBO
+	*/
+	void setVertexAttributesPointers(int numVertices);
+
+	/** \brief  Binds the VAO, pointing it at the vertices again if the geometry heap moved them.
+	*   \return Base vertex to add to the first vertex of every draw.
+	*/
+	GLint bindVertexArray() const;
+
+	/** \brief  Gets first vertex of the mesh in its buffer, non-zero only for interleaved vertices in a geometry heap.
+	*   \return Base vertex to add to the first vertex of every draw.
+	*/
+	GLint getBaseVertex() const;
+
+	/** \brief  Binds buffers of the bound VAO again after the geometry heap moved them. */
+	virtual void bindHeapBuffers() const;
+
+private:
+	/** \brief  Sets vertex attribute pointers for _numBufferVertices vertices at the VBO's offset. VBO must be bound. */
+	void pointVertexAttributes() const;
+};
+
 }; // namespace static_meshes_3D
\ No newline at end of file
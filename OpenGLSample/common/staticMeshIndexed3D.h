@@ -1,26 +1,45 @@
-#pragma once
-
-#include "staticMesh3D.h"
-
-namespace static_meshes_3D {
-
-/**
-	Represents generic 3D static mesh rendered with indexed rendering.
-*/
-class StaticMeshIndexed3D : public StaticMesh3D
-{
-public:
-	StaticMeshIndexed3D(bool withPositions, bool withTextureCoordinates, bool withNormals);
-	virtual ~StaticMeshIndexed3D();
-
-	void deleteMesh() override;
-
-protected:
-	VertexBufferObject _indicesVBO; //!< Our VBO wrapper class holding indices data
-
-	int _numVertices = 0; //!< Holds the total number of generated vertices
-	int _numIndices = 0; //!< Holds the number of generated indices used for rendering
-	int _primitiveRestartIndex = 0; //!< Index of primitive restart
-};
-
+#pragma once
+
+#include "staticMesh3D.h"
+#include "indexBufferBuilder.h"
+
+namespace static_meshes_3D {
+
+/**
+	Represents generic 3D static mesh rendered with indexed rendering.
+
+	With a geometry heap set, indices take a range of the heap too and are drawn from its offset
+	with the base vertex of the vertices.
+*/
+class StaticMeshIndexed3D : public StaticMesh3D
+{
+public:
+	StaticMeshIndexed3D(bool withPositions, bool withTextureCoordinates, bool withNormals);
+	virtual ~StaticMeshIndexed3D();
+
+	void deleteMesh() override;
+
+protected:
+	VertexBufferObject _indicesVBO; //!< Our VBO wrapper class holding indices data
+
+	int _numVertices = 0; //!< Holds the total number of generated vertices
+	int _numIndices = 0; //!< Holds the number of generated indices used for rendering
+	GLenum _indexType = GL_UNSIGNED_INT; //!< Type of indices, picked by the index buffer builder
+	GLenum _primitiveType = GL_TRIANGLES; //!< GL_TRIANGLE_STRIP if indices are stripified
+	GLuint _primitiveRestartIndex = 0; //!< Index of primitive restart, separates stripified indices
+
+	/** \brief  Uploads finished index buffer to the indices VBO and takes over its index and primitive type. VAO must be bound.
+	*   \param indexBuffer Finished index buffer
+	*/
+	void uploadIndices(const IndexBufferBuilder& indexBuffer);
+
+	/** \brief  Draws all indices, with primitive restart enabled for stripified ones. VAO must be bound.
+	*   \param numInstances Number of instances to render
+	*/
+	void renderIndices(GLsizei numInstances = 1) const;
+
+	/** \brief  Binds vertex and index buffers of the bound VAO again after the geometry heap moved them. */
+	void bindHeapBuffers() const override;
+};
+
 }; // namespace static_meshes_3D
\ No newline at end of file
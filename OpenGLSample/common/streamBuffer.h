@@ -0,0 +1,91 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "glHandle.h"
+
+/**
+  Buffer for data written by the CPU every frame (uniform blocks, culled indices, text vertices),
+  split into several regions, one per frame in flight. Every map call takes the next aligned range
+  of the current region, so all writes of a frame land in one buffer without any reallocation.
+
+  With OpenGL 4.4 or ARB_buffer_storage the buffer is created by glBufferStorage and stays mapped
+  persistently and coherently for its whole life: map only hands out pointers into that mapping. A
+  fence placed when the CPU leaves a region guards it until the GPU is done reading it; coming back
+  to a region whose fence hasn't signaled yet is counted as a stall.
+
+  Without buffer storage (OpenGL 3.3) every map call maps its range unsynchronized, and once the
+  buffer is full it is orphaned with glBufferData, so the driver hands out fresh memory instead of
+  waiting for the GPU. Orphans are counted instead of stalls.
+
+  Usage per frame: map -> write -> unmap -> bind / draw with the returned offset ... -> endFrame.
+  A map that doesn't fit the rest of the current region moves to the next region by itself, so
+  users without a frame loop (e.g. text drawn now and then) never need to call endFrame.
+*/
+class StreamBuffer
+{
+public:
+	static const int DEFAULT_NUM_REGIONS; //!< Number of regions when not specified (3)
+
+	/** \brief Loads glBufferStorage, which glad of this project doesn't, after gladLoadGLLoader.
+	*          Until it is loaded, all stream buffers map and orphan like on OpenGL 3.3.
+	*   \param loader Same function glad was loaded with
+	*   \return True if the context supports persistent mapping.
+	*/
+	static bool loadPersistentMapping(GLADloadproc loader);
+
+	/** \brief Tells, if loadPersistentMapping succeeded.
+	*   \return True if new stream buffers are mapped persistently.
+	*/
+	static bool isPersistentMappingSupported();
+
+	/** \brief Creates the buffer.
+	*   \param regionSizeBytes Bytes one frame can write
+	*   \param numRegions      Number of frames that can be in flight at once
+	*/
+	void createStreamBuffer(size_t regionSizeBytes, int numRegions = DEFAULT_NUM_REGIONS);
+
+	/** \brief Takes the next range of the current region for writing.
+	*   \param sizeBytes Bytes to be written, at most the region size
+	*   \param alignment Alignment of the offset (e.g. GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT or the index size)
+	*   \param offset    Output, byte offset of the range in the buffer, to bind or draw with
+	*   \return Pointer to write sizeBytes bytes to until unmap, nullptr if they don't fit into a region.
+	*/
+	void* map(size_t sizeBytes, size_t alignment, size_t& offset);
+
+	//* \brief Ends writing the range returned by map. Must be called before drawing from it.
+	void unmap();
+
+	//* \brief Places a fence guarding the current region and moves to the next region.
+	void endFrame();
+
+	GLuint getBufferID() const; //!< OpenGL assigned buffer ID, for binding
+	size_t getRegionSize() const; //!< Bytes one frame can write
+	bool isPersistent() const; //!< True if the buffer stays mapped persistently
+	int getStallCount() const; //!< Times the CPU had to wait for the GPU to free a region
+	int getOrphanCount() const; //!< Times the buffer was orphaned, only without persistent mapping
+
+	//* \brief Unmaps and deletes the buffer and all pending fences.
+	void deleteStreamBuffer();
+
+private:
+	GLBuffer _buffer; //!< Buffer of all regions
+	size_t _regionSize = 0; //!< Size of one region (in bytes)
+	int _numRegions = 0; //!< Number of regions
+	int _currentRegion = 0; //!< Region written by the current frame
+	size_t _bytesUsed = 0; //!< Bytes taken from the current region so far
+	unsigned char* _persistentMapping = nullptr; //!< Pointer to the whole buffer, only with persistent mapping
+	bool _isRangeMapped = false; //!< Flag telling, if a range is mapped until unmap without persistent mapping
+	std::vector<GLsync> _fences; //!< One fence per region, nullptr if region is free
+	int _stallCount = 0; //!< How many times the CPU had to wait for the GPU
+	int _orphanCount = 0; //!< How many times the buffer was orphaned
+
+	bool _isBufferCreated = false; //!< Flag telling if the buffer has been created
+
+	//* \brief Fences the current region, moves to the next one and waits until the GPU is done with it.
+	void advanceRegion();
+};
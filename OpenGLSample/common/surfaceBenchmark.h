@@ -0,0 +1,28 @@
+#pragma once
+
+// STL
+#include <ostream>
+
+/**
+  Compares the parametric surface engine against the generators it replaced (per vertex sinf / cosf,
+  push_back into unreserved vectors). Sphere, cylinder and flat grid meshes with about numVertices
+  vertices each are generated by the old code, by the engine on one thread and by the engine on
+  all hardware threads. Every variant is timed (best of a few runs), its output is checked to have
+  the same size and indices as the old one and the largest difference of the vertex data is printed
+  (the old cylinder accumulates its angle, so it drifts on very fine tessellations).
+
+  Needs no OpenGL context.
+*/
+namespace surface_benchmark {
+
+extern const int DEFAULT_VERTICES; //!< Vertices per mesh if not given (10 million)
+extern const int NUM_RUNS; //!< Runs of every variant, the fastest one is reported (3)
+
+/** \brief Runs the benchmark and prints a table of timings.
+*   \param numVertices Approximate number of vertices of every mesh
+*   \param out Stream to print to
+*   \return 0 if sizes and indices of all engine outputs match the old ones, 1 otherwise.
+*/
+int run(int numVertices, std::ostream& out);
+
+} // namespace surface_benchmark
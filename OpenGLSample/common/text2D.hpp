@@ -1,8 +1,8 @@
-#ifndef TEXT2D_HPP
-#define TEXT2D_HPP
-
-void initText2D(const char * texturePath);
-void printText2D(const char * text, int x, int y, int size);
-void cleanupText2D();
-
+#ifndef TEXT2D_HPP
+#define TEXT2D_HPP
+
+void initText2D(const char * texturePath);
+void printText2D(const char * text, int x, int y, int size);
+void cleanupText2D();
+
 #endif
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+// STL
+#include <atomic>
+
+/**
+  Lock-free single producer / single consumer triple buffer. The writer fills its own buffer and
+  publishes it, the reader picks up the newest published buffer. Neither side ever waits for the
+  other, the reader just skips values that were overwritten before it looked.
+
+  The third (middle) buffer is exchanged atomically together with a flag telling, if it holds
+  a value the reader has not seen yet.
+*/
+template <typename T>
+class TripleBuffer
+{
+public:
+	/** \brief Sets all three buffers, call before the writer and reader threads start.
+	*   \param value Initial value seen by the reader
+	*/
+	void reset(const T& value)
+	{
+		_buffers[0] = _buffers[1] = _buffers[2] = value;
+		_writeIndex = 0;
+		_middle.store(1, std::memory_order_relaxed);
+		_readIndex = 2;
+	}
+
+	/** \brief Gets buffer owned by the writer, valid until the next publish.
+	*   \return Buffer to write to.
+	*/
+	T& getWriteBuffer()
+	{
+		return _buffers[_writeIndex];
+	}
+
+	//* \brief Makes the write buffer the newest value and takes over the middle buffer for writing.
+	void publish()
+	{
+		const auto previous = _middle.exchange(_writeIndex | FRESH_BIT, std::memory_order_acq_rel);
+		_writeIndex = previous & INDEX_MASK;
+	}
+
+	/** \brief Takes over the newest published value, if there is one the reader has not seen yet.
+	*   \return True if the read buffer has changed.
+	*/
+	bool update()
+	{
+		if ((_middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0) {
+			return false;
+		}
+
+		const auto previous = _middle.exchange(_readIndex, std::memory_order_acq_rel);
+		_readIndex = previous & INDEX_MASK;
+		return true;
+	}
+
+	/** \brief Gets buffer owned by the reader, valid until the next update.
+	*   \return Newest value taken over by update.
+	*/
+	const T& getReadBuffer() const
+	{
+		return _buffers[_readIndex];
+	}
+
+private:
+	static const unsigned int INDEX_MASK = 3; //!< Bits of the middle state holding the buffer index
+	static const unsigned int FRESH_BIT = 4; //!< Set when the middle buffer has not been read yet
+
+	T _buffers[3]; //!< Write, middle and read buffer (in no fixed order)
+	unsigned int _writeIndex = 0; //!< Buffer owned by the writer
+	std::atomic<unsigned int> _middle{ 1 }; //!< Buffer in the middle together with FRESH_BIT
+	unsigned int _readIndex = 2; //!< Buffer owned by the reader
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+// GLM
+#include <glm/glm.hpp>
+
+/**
+  C++ mirrors of the std140 uniform blocks used by the light caster and light cube shaders.
+  Only vec4 / mat4 / scalar members are used, so the C++ layout matches std140 without any
+  hidden padding rules (vec3 would be aligned to 16 bytes in std140).
+*/
+
+const unsigned int CAMERA_BLOCK_BINDING = 0; //!< Binding point of the per-frame Camera block
+const unsigned int LIGHT_BLOCK_BINDING = 1; //!< Binding point of the per-frame Light block
+const unsigned int OBJECT_BLOCK_BINDING = 2; //!< Binding point of the per-draw Object block
+
+struct CameraBlock
+{
+	glm::mat4 view;
+	glm::mat4 projection;
+	glm::vec4 viewPos; //!< xyz = camera position
+};
+
+struct LightBlock
+{
+	glm::vec4 position; //!< xyz = light position
+	glm::vec4 direction; //!< xyz = spotlight direction
+	glm::vec4 ambient;
+	glm::vec4 diffuse;
+	glm::vec4 specular;
+
+	float cutOff;
+	float outerCutOff;
+	float constant;
+	float linear;
+	float quadratic;
+	float padding[3]; //!< std140 rounds the block size up to 16 bytes
+};
+
+struct ObjectBlock
+{
+	glm::mat4 model;
+	glm::mat4 normalMatrix; //!< transpose(inverse(model)), only upper 3x3 is used
+	float shininess;
+	float materialLayer; //!< Layer of the object's material in the MaterialLibrary arrays
+	float padding[2];
+};
+
+/** \brief Fills per-object block, computing the normal matrix on the CPU once instead of per vertex.
+*   \param model     Model matrix of the object
+*   \param shininess Specular shininess of the object's material
+*   \param materialLayer Layer of the object's material in the MaterialLibrary arrays
+*   \param positionDecode Maps quantized positions to model space (see CompressedMesh), applied before model to positions only
+*   \return Filled object block.
+*/
+inline ObjectBlock makeObjectBlock(const glm::mat4& model, float shininess, int materialLayer = 0, const glm::mat4& positionDecode = glm::mat4(1.0f))
+{
+	ObjectBlock block;
+	block.model = model * positionDecode;
+	block.normalMatrix = glm::mat4(glm::transpose(glm::inverse(glm::mat3(model))));
+	block.shininess = shininess;
+	block.materialLayer = static_cast<float>(materialLayer);
+	block.padding[0] = block.padding[1] = 0.0f;
+	return block;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+// STL
+#include <cstddef>
+
+#include <glad/glad.h>
+
+#include "streamBuffer.h"
+
+/**
+  Uniform buffer split into several regions (triple buffered by default), one region per frame.
+
+  Every frame, all uniform blocks (per-frame and per-object) are written into the current region
+  of a StreamBuffer and then only bound with glBindBufferRange. The stream buffer keeps the region
+  mapped persistently where the context allows it and guards it with a fence placed at the end of
+  each frame, so a region is not overwritten while the GPU still reads it.
+
+  Usage per frame: beginFrame -> push... -> flush -> bindRange... / draw... -> endFrame
+*/
+class UniformRingBuffer
+{
+public:
+	static const int DEFAULT_NUM_REGIONS; //!< Number of regions when not specified (3)
+
+	/** \brief Creates the uniform buffer.
+	*   \param regionSizeBytes Bytes available for uniform blocks in a single frame
+	*   \param numRegions      Number of frames that can be in flight at once
+	*/
+	void createRingBuffer(size_t regionSizeBytes, int numRegions = DEFAULT_NUM_REGIONS);
+
+	//* \brief Takes the whole current region of the stream buffer for writing.
+	void beginFrame();
+
+	/** \brief Copies data of one uniform block into the current region.
+	*   \param ptrData       Pointer to the block data
+	*   \param dataSizeBytes Size of the block (in bytes)
+	*   \return Byte offset of the block in the buffer, to be used with bindRange.
+	*/
+	size_t pushData(const void* ptrData, size_t dataSizeBytes);
+
+	/** \brief Copies a uniform block (std140 mirror struct) into the current region.
+	*   \param block Block to be copied
+	*   \return Byte offset of the block in the buffer, to be used with bindRange.
+	*/
+	template<typename T>
+	size_t push(const T& block)
+	{
+		return pushData(&block, sizeof(T));
+	}
+
+	//* \brief Ends writing the current region. Must be called after pushing and before drawing.
+	void flush();
+
+	/** \brief Binds part of the buffer to a uniform block binding point.
+	*   \param bindingPoint  Uniform block binding point
+	*   \param offset        Offset returned by push / pushData
+	*   \param dataSizeBytes Size of the block (in bytes)
+	*/
+	void bindRange(GLuint bindingPoint, size_t offset, size_t dataSizeBytes) const;
+
+	//* \brief Places a fence guarding the current region and moves to the next region.
+	void endFrame();
+
+	/** \brief Gets the stream buffer the uniform blocks are written to.
+	*   \return Stream buffer, for its mapping mode, stall and orphan counts.
+	*/
+	const StreamBuffer& getStreamBuffer() const;
+
+	//* \brief Deletes the buffer and all pending fences.
+	void deleteRingBuffer();
+
+private:
+	StreamBuffer _streamBuffer; //!< Regions the blocks are written to
+	size_t _alignment = 256; //!< GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+	size_t _regionStart = 0; //!< Offset of the current region in the buffer
+	size_t _bytesUsed = 0; //!< Bytes pushed to the current region so far
+	unsigned char* _mappedRegion = nullptr; //!< Mapped pointer to the current region
+
+	bool _isBufferCreated = false; //!< Flag telling if the buffer has been created
+};
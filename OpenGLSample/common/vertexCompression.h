@@ -0,0 +1,122 @@
+#pragma once
+
+// STL
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+// GLM
+#include <glm/glm.hpp>
+
+#include <glad/glad.h>
+
+/**
+  Packs float vertices into formats the vertex fetch decodes by itself, so no shader has to change:
+
+  - normals and tangents as normalized GL_INT_2_10_10_10_REV (4 bytes instead of 12), the 2-bit w of
+    the tangent holds the sign of the bitangent, which is rebuilt as cross(normal, tangent) * sign
+  - texture coordinates as half floats (4 bytes instead of 8)
+  - optionally positions as 16-bit unsigned normalized values relative to the bounding box of the
+    mesh (8 bytes instead of 12). These decode to 0..1, getPositionDecode maps them back and has to be
+    applied to the model matrix for positions only, normals still use the original model matrix.
+
+  The scene's 8-float vertices shrink from 32 to 16 bytes. The reconstruction error of every stream is
+  measured while packing, so the cost in precision can be reported next to the saved bytes.
+*/
+class CompressedMesh
+{
+public:
+	//* \brief Where the attributes are in the float vertices to compress, offsets are in floats, -1 means missing.
+	struct SourceLayout
+	{
+		int floatsPerVertex = 8; //!< Floats of one vertex
+		int positionOffset = 0; //!< 3 floats, always needed
+		int normalOffset = 3; //!< 3 floats
+		int texCoordOffset = 6; //!< 2 floats
+		int tangentOffset = -1; //!< 3 floats
+		int bitangentOffset = -1; //!< 3 floats, only its sign relative to the normal and tangent is kept
+	};
+
+	//* \brief Largest difference between the source and the decoded vertices, per stream.
+	struct ReconstructionError
+	{
+		float position = 0.0f; //!< In model space units
+		float normalDegrees = 0.0f; //!< Angle between the source and the decoded normal
+		float tangentDegrees = 0.0f; //!< Angle between the source and the decoded tangent
+		float texCoord = 0.0f; //!< In texture coordinate units
+		int bitangentSignErrors = 0; //!< Vertices whose bitangent rebuilt from the sign points the wrong way
+	};
+
+	/** \brief Packs vertices, replaces previously packed ones.
+	*   \param ptrVertices First float of the first vertex
+	*   \param numVertices Number of vertices
+	*   \param layout Where the attributes are in the source vertices
+	*   \param quantizePositions If true, positions are 16-bit unsigned normalized, otherwise they stay floats
+	*   \return True if the vertices could be packed.
+	*/
+	bool compress(const float* ptrVertices, size_t numVertices, const SourceLayout& layout, bool quantizePositions = true);
+
+	/** \brief Sets up attribute pointers into the GL_ARRAY_BUFFER bound to the bound VAO, packed data must start at offset 0.
+	*   \param positionLocation Attribute location of the position
+	*   \param normalLocation Attribute location of the normal, -1 to skip
+	*   \param texCoordLocation Attribute location of the texture coordinate, -1 to skip
+	*   \param tangentLocation Attribute location of the tangent (w = bitangent sign), -1 to skip
+	*/
+	void setupAttributes(GLint positionLocation, GLint normalLocation = -1, GLint texCoordLocation = -1, GLint tangentLocation = -1) const;
+
+	/** \brief Gets packed vertices.
+	*   \return Pointer to getByteSize() bytes.
+	*/
+	const void* getData() const;
+
+	/** \brief Gets size of the packed vertices.
+	*   \return Size in bytes.
+	*/
+	size_t getByteSize() const;
+
+	/** \brief Gets size of one packed vertex.
+	*   \return Size in bytes.
+	*/
+	size_t getVertexSize() const;
+
+	/** \brief Gets size of one source vertex.
+	*   \return Size in bytes.
+	*/
+	size_t getSourceVertexSize() const;
+
+	/** \brief Gets number of packed vertices.
+	*   \return Number of vertices.
+	*/
+	size_t getNumVertices() const;
+
+	/** \brief Gets transform from the decoded position attribute to model space, identity if positions are floats.
+	*   \return Translation to the bounding box minimum times scale by its extent.
+	*/
+	const glm::mat4& getPositionDecode() const;
+
+	/** \brief Gets reconstruction error measured by the last compress.
+	*   \return Largest error of every stream.
+	*/
+	const ReconstructionError& getError() const;
+
+	/** \brief Prints bytes per vertex before and after packing and the reconstruction error.
+	*   \param name Name of the mesh
+	*   \param os Stream to print to
+	*/
+	void printStats(const char* name, std::ostream& os) const;
+
+	//* \brief Frees packed vertices, e.g. once they are uploaded. Sizes, layout and error are kept.
+	void freeData();
+
+private:
+	std::vector<unsigned char> _data; //!< Packed vertices
+	size_t _numVertices = 0; //!< Number of packed vertices
+	size_t _vertexSize = 0; //!< Size of one packed vertex in bytes
+	size_t _sourceVertexSize = 0; //!< Size of one source vertex in bytes
+	int _normalOffset = -1; //!< Byte offset of the packed normal, -1 if missing
+	int _tangentOffset = -1; //!< Byte offset of the packed tangent, -1 if missing
+	int _texCoordOffset = -1; //!< Byte offset of the packed texture coordinate, -1 if missing
+	bool _hasQuantizedPositions = false; //!< Flag telling, if positions are 16-bit
+	glm::mat4 _positionDecode = glm::mat4(1.0f); //!< Maps 0..1 positions to the bounding box
+	ReconstructionError _error; //!< Error measured by the last compress
+};
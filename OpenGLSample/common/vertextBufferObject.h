@@ -1,92 +1,144 @@
-#pragma once
-
-// STL
-#include <vector>
-
-#include <glad\glad.h>
-
-/**
-  Wraps OpenGL's vertex buffer object to a higher level class.
-*/
-
-class VertexBufferObject
-{
-public:
-	/** \brief Creates a new VBO, with optional reserved buffer size.
-	*   \param size Buffer size reservation, in bytes (so that memory allocations don't take place while adding data)
-	*/
-	void createVBO(uint32_t reserveSizeBytes = 0);
-
-	/** \brief Binds this vertex buffer object (makes current).
-	*   \param bufferType Type of the bound buffer (usually GL_ARRAY_BUFFER, but can be also GL_ELEMENT_BUFFER for instance)
-	*/
-	void bindVBO(GLenum bufferType = GL_ARRAY_BUFFER);
-
-	/** \brief Adds raw data to the in-memory buffer, before they get uploaded.
-	*   \param ptrData  Pointer to the raw data (arbitrary type)
-	*   \param dataSize Size of the added data (in bytes)
-	*   \param repeat How many times to repeat same data in the buffer (default is 1)
-	*/
-	void addRawData(const void* ptrData, uint32_t dataSizeBytes, int repeat = 1);
-
-	/** \brief Adds arbitrary data to the in-memory buffer, before they get uploaded.
-	*   \param ptrData Data to be added
-	*   \param repeat  How many times to repeat same data in the buffer (default is 1)
-	*/
-	template<typename T>
-	void addData(const T& obj, int repeat = 1)
-	{
-		addRawData(&obj, sizeof(T), repeat);
-	}
-
-	/** \brief Gets pointer to the data from in-memory buffer (only before uploading them).
-	*   \return Pointer to the raw data.
-	*/
-	void* getRawDataPointer();
-
-	/** \brief Uploads gathered data to the GPU memory. Now the VBO is ready to be used.
-	*   \param usageHint Hint for OpenGL, how is the data intended to be used (GL_STATIC_DRAW, GL_DYNAMIC_DRAW)
-	*/
-	void uploadDataToGPU(GLenum usageHint);
-
-	/** \brief Maps buffer data to a memory pointer.
-	*   \param usageHint Hint for OpenGL, how is the data intended to be used (GL_STATIC_DRAW, GL_DYNAMIC_DRAW)
-	*   \return Pointer to the mapped data, or nullptr, if something fails.
-	*/
-	void* mapBufferToMemory(GLenum usageHint);
-
-	/** \brief Maps buffer sub-data to a memory pointer.
-	*   \param  usageHint Hint for OpenGL, how is the data intended to be used (GL_READ_ONLY, GL_WRITE_ONLY...`)
-	*   \param  offset    Byte offset in buffer, where to start
-	*   \param  length    Byte length of the mapped data
-	*   \return Pointer to the mapped data, or nullptr, if something fails.
-	*/
-	void* mapSubBufferToMemory(GLenum usageHint, uint32_t offset, uint32_t length);
-
-	//* \brief Unmaps buffer (must have been mapped previously).
-	void unmapBuffer();
-
-	/** \brief Gets OpenGL-assigned buffer ID.
-	*   \return Buffer ID.
-	*/
-	GLuint getBufferID();
-
-	/** \brief Gets buffer size, in bytes.
-	*   \return Buffer size in bytes.
-	*/
-	uint32_t getBufferSize();
-
-	//* \brief Deletes VBO and frees memory and internal structures.
-	void deleteVBO();
-
-private:
-	GLuint _bufferID = 0; //! OpenGL assigned buffer ID
-	int _bufferType; //! Buffer type (GL_ARRAY_BUFFER, GL_ELEMENT_BUFFER...)
-
-	std::vector<unsigned char> _rawData; //! In-memory raw data buffer, used to gather the data for VBO.
-	size_t _bytesAdded = 0; //! Number of bytes added to the buffer so far
-	uint32_t _uploadedDataSize; //! Holds buffer data size after uploading to GPU
-
-	bool _isBufferCreated = false;
-	bool _isDataUploaded = false; //! Flag telling, if data has been uploaded to GPU already.
+#pragma once
+
+// STL
+#include <vector>
+
+#include <glad\glad.h>
+
+#include "glHandle.h"
+
+class GeometryHeap;
+
+/**
+  Wraps OpenGL's vertex buffer object to a higher level class.
+
+  Data can be gathered in two ways. When the final size is known, createMappedVBO allocates the
+  buffer storage up front and maps it, so added data (or vertices written through reserveRawData)
+  go straight into GPU visible memory and uploading only unmaps it. Otherwise createVBO gathers
+  the data in an arena of chunks that never move or get copied while it grows, and uploadDataToGPU
+  copies every chunk once into the buffer.
+
+  createHeapVBO takes a range of a GeometryHeap instead of a buffer of its own, written the same way.
+  The buffer ID and offset of such a VBO can change whenever the heap is defragmented.
+*/
+
+class VertexBufferObject
+{
+public:
+	/** \brief Creates a new VBO, with optional reserved buffer size.
+	*   \param size Buffer size reservation, in bytes (so that memory allocations don't take place while adding data)
+	*/
+	void createVBO(uint32_t reserveSizeBytes = 0);
+
+	/** \brief Creates a new VBO with storage of the final size, mapped for writing until uploadDataToGPU.
+	*   Falls back to the arena of createVBO if the buffer can't be mapped.
+	*   \param sizeBytes Exact size of all data that will be added, in bytes
+	*   \param usageHint Hint for OpenGL, how is the data intended to be used (GL_STATIC_DRAW, GL_DYNAMIC_DRAW)
+	*/
+	void createMappedVBO(uint32_t sizeBytes, GLenum usageHint = GL_STATIC_DRAW);
+
+	/** \brief Creates a VBO in a range of the geometry heap, mapped for writing until uploadDataToGPU.
+	*   Falls back to the arena of createVBO if the range can't be mapped.
+	*   \param heap      Heap to allocate from, must outlive the VBO
+	*   \param sizeBytes Exact size of all data that will be added, in bytes
+	*   \param alignment Byte offset of the range is a multiple of it (e.g. the vertex size)
+	*/
+	void createHeapVBO(GeometryHeap& heap, uint32_t sizeBytes, uint32_t alignment);
+
+	/** \brief Binds this vertex buffer object (makes current).
+	*   \param bufferType Type of the bound buffer (usually GL_ARRAY_BUFFER, but can be also GL_ELEMENT_BUFFER for instance)
+	*/
+	void bindVBO(GLenum bufferType = GL_ARRAY_BUFFER);
+
+	/** \brief Adds raw data to the in-memory buffer, before they get uploaded.
+	*   \param ptrData  Pointer to the raw data (arbitrary type)
+	*   \param dataSize Size of the added data (in bytes)
+	*   \param repeat How many times to repeat same data in the buffer (default is 1)
+	*/
+	void addRawData(const void* ptrData, uint32_t dataSizeBytes, int repeat = 1);
+
+	/** \brief Adds arbitrary data to the in-memory buffer, before they get uploaded.
+	*   \param ptrData Data to be added
+	*   \param repeat  How many times to repeat same data in the buffer (default is 1)
+	*/
+	template<typename T>
+	void addData(const T& obj, int repeat = 1)
+	{
+		addRawData(&obj, sizeof(T), repeat);
+	}
+
+	/** \brief Reserves space for data the caller writes itself, e.g. vertices generated in place.
+	*   \param sizeBytes Size of the reserved data (in bytes)
+	*   \return Pointer to write sizeBytes bytes to, valid until uploading. Null if a mapped VBO has no space left.
+	*/
+	void* reserveRawData(uint32_t sizeBytes);
+
+	/** \brief Gets pointer to the data added so far (only before uploading them). Data are contiguous in a
+	*   mapped VBO, or in the arena as long as they fit into the size reserved by createVBO.
+	*   \return Pointer to the raw data.
+	*/
+	void* getRawDataPointer();
+
+	/** \brief Uploads gathered data to the GPU memory, a mapped VBO is just unmapped. Now the VBO is ready to be used.
+	*   \param usageHint Hint for OpenGL, how is the data intended to be used (GL_STATIC_DRAW, GL_DYNAMIC_DRAW),
+	*          ignored by a mapped VBO that got its usage hint in createMappedVBO
+	*/
+	void uploadDataToGPU(GLenum usageHint);
+
+	/** \brief Maps buffer data to a memory pointer.
+	*   \param usageHint Hint for OpenGL, how is the data intended to be used (GL_STATIC_DRAW, GL_DYNAMIC_DRAW)
+	*   \return Pointer to the mapped data, or nullptr, if something fails.
+	*/
+	void* mapBufferToMemory(GLenum usageHint);
+
+	/** \brief Maps buffer sub-data to a memory pointer.
+	*   \param  usageHint Hint for OpenGL, how is the data intended to be used (GL_READ_ONLY, GL_WRITE_ONLY...`)
+	*   \param  offset    Byte offset in buffer, where to start
+	*   \param  length    Byte length of the mapped data
+	*   \return Pointer to the mapped data, or nullptr, if something fails.
+	*/
+	void* mapSubBufferToMemory(GLenum usageHint, uint32_t offset, uint32_t length);
+
+	//* \brief Unmaps buffer (must have been mapped previously).
+	void unmapBuffer();
+
+	/** \brief Gets OpenGL-assigned buffer ID, the heap's buffer for a heap VBO.
+	*   \return Buffer ID.
+	*/
+	GLuint getBufferID() const;
+
+	/** \brief Gets byte offset of the data in the buffer, only a heap VBO doesn't start at 0.
+	*   \return Offset in bytes.
+	*/
+	size_t getBufferOffset() const;
+
+	/** \brief Gets heap the VBO was created in by createHeapVBO.
+	*   \return Heap or nullptr.
+	*/
+	const GeometryHeap* getHeap() const;
+
+	/** \brief Gets buffer size, in bytes.
+	*   \return Buffer size in bytes.
+	*/
+	uint32_t getBufferSize() const;
+
+	//* \brief Deletes VBO and frees memory and internal structures.
+	void deleteVBO();
+
+	static const uint32_t ARENA_CHUNK_SIZE; //!< Smallest chunk the arena grows by (64 KiB)
+
+private:
+	GLBuffer _buffer; //! OpenGL buffer, none for a heap VBO
+	GeometryHeap* _heap = nullptr; //! Heap of a heap VBO
+	int _heapHandle = -1; //! Allocation of a heap VBO
+	int _bufferType = GL_ARRAY_BUFFER; //! Buffer type (GL_ARRAY_BUFFER, GL_ELEMENT_BUFFER...)
+
+	std::vector<std::vector<unsigned char>> _chunks; //! In-memory arena used to gather the data for VBO, chunks are filled one after another
+	unsigned char* _mappedData = nullptr; //! Mapped buffer storage of a mapped VBO, data are written here instead of the arena
+	uint32_t _mappedSize = 0; //! Size of the mapped buffer storage
+	size_t _bytesAdded = 0; //! Number of bytes added to the buffer so far
+	uint32_t _uploadedDataSize = 0; //! Holds buffer data size after uploading to GPU
+
+	bool _isBufferCreated = false;
+	bool _isDataUploaded = false; //! Flag telling, if data has been uploaded to GPU already.
 };
\ No newline at end of file
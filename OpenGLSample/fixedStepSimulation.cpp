@@ -0,0 +1,151 @@
+// STL
+#include <algorithm>
+#include <chrono>
+
+#include "common/fixedStepSimulation.h"
+
+const double FixedStepSimulation::TICK_SECONDS       = 1.0 / 60.0;
+const int    FixedStepSimulation::MAX_CATCH_UP_TICKS = 10;
+const float  FixedStepSimulation::LIGHT_STEP         = 0.01f;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+bool isHeld(const SimulationInput& input, SimulationInput::Action action)
+{
+	return (input.actions & action) != 0;
+}
+
+} // namespace
+
+FixedStepSimulation::~FixedStepSimulation()
+{
+	stop();
+}
+
+void FixedStepSimulation::start(const SimulationState& initialState)
+{
+	if (_isRunning) {
+		return;
+	}
+
+	Snapshot snapshot;
+	snapshot.previous = snapshot.current = initialState;
+	_snapshots.reset(snapshot);
+	_input.reset(SimulationInput());
+
+	_startTime = Clock::now();
+	_isRunning = true;
+	_thread = std::thread(&FixedStepSimulation::run, this, initialState);
+}
+
+void FixedStepSimulation::stop()
+{
+	_isRunning = false;
+	if (_thread.joinable()) {
+		_thread.join();
+	}
+}
+
+void FixedStepSimulation::setInput(const SimulationInput& input)
+{
+	_input.getWriteBuffer() = input;
+	_input.publish();
+}
+
+double FixedStepSimulation::secondsSinceStart() const
+{
+	return std::chrono::duration<double>(Clock::now() - _startTime).count();
+}
+
+SimulationState FixedStepSimulation::getInterpolatedState()
+{
+	_snapshots.update();
+	const auto& snapshot = _snapshots.getReadBuffer();
+
+	const auto alpha = static_cast<float>(std::min(std::max((secondsSinceStart() - snapshot.tickSeconds) / TICK_SECONDS, 0.0), 1.0));
+	SimulationState state = snapshot.current;
+	state.lightPosition = glm::mix(snapshot.previous.lightPosition, snapshot.current.lightPosition, alpha);
+	state.cameraPosition = glm::mix(snapshot.previous.cameraPosition, snapshot.current.cameraPosition, alpha);
+	state.orbitAngle = glm::mix(snapshot.previous.orbitAngle, snapshot.current.orbitAngle, alpha);
+	return state;
+}
+
+SimulationState FixedStepSimulation::step(const SimulationState& state, const SimulationInput& input)
+{
+	SimulationState next = state;
+	next.tick++;
+	next.orbitAngle = static_cast<float>(next.tick * TICK_SECONDS);
+
+	//light controls
+	if (isHeld(input, SimulationInput::LIGHT_UP))
+		next.lightPosition.y += LIGHT_STEP;
+	if (isHeld(input, SimulationInput::LIGHT_DOWN))
+		next.lightPosition.y -= LIGHT_STEP;
+	if (isHeld(input, SimulationInput::LIGHT_LEFT))
+		next.lightPosition.x -= LIGHT_STEP;
+	if (isHeld(input, SimulationInput::LIGHT_RIGHT))
+		next.lightPosition.x += LIGHT_STEP;
+	if (isHeld(input, SimulationInput::LIGHT_BACKWARD))
+		next.lightPosition.z += LIGHT_STEP;
+	if (isHeld(input, SimulationInput::LIGHT_FORWARD))
+		next.lightPosition.z -= LIGHT_STEP;
+
+	//camera controls
+	const auto cameraOffset = input.cameraSpeed * static_cast<float>(TICK_SECONDS);
+	const auto cameraRight = glm::normalize(glm::cross(input.cameraFront, input.cameraUp));
+	if (isHeld(input, SimulationInput::CAMERA_FORWARD))
+		next.cameraPosition += cameraOffset * input.cameraFront;
+	if (isHeld(input, SimulationInput::CAMERA_BACKWARD))
+		next.cameraPosition -= cameraOffset * input.cameraFront;
+	if (isHeld(input, SimulationInput::CAMERA_LEFT))
+		next.cameraPosition -= cameraRight * cameraOffset;
+	if (isHeld(input, SimulationInput::CAMERA_RIGHT))
+		next.cameraPosition += cameraRight * cameraOffset;
+	if (isHeld(input, SimulationInput::CAMERA_UP))
+		next.cameraPosition += cameraOffset * input.cameraUp;
+	if (isHeld(input, SimulationInput::CAMERA_DOWN))
+		next.cameraPosition -= cameraOffset * input.cameraUp;
+
+	return next;
+}
+
+void FixedStepSimulation::run(SimulationState state)
+{
+	auto cameraResetCount = 0;
+	auto nextTickSeconds = TICK_SECONDS;
+	while (_isRunning)
+	{
+		// After a stall (debugger, suspended process) old ticks are dropped instead of replayed
+		const auto now = secondsSinceStart();
+		if (now - nextTickSeconds > MAX_CATCH_UP_TICKS * TICK_SECONDS) {
+			nextTickSeconds = now - MAX_CATCH_UP_TICKS * TICK_SECONDS;
+		}
+
+		while (nextTickSeconds <= now)
+		{
+			_input.update();
+			const auto& input = _input.getReadBuffer();
+
+			// Reset teleports the camera, so it must not be interpolated
+			auto previous = state;
+			if (input.cameraResetCount != cameraResetCount)
+			{
+				cameraResetCount = input.cameraResetCount;
+				state.cameraPosition = previous.cameraPosition = input.cameraResetPosition;
+			}
+			state = step(state, input);
+
+			auto& snapshot = _snapshots.getWriteBuffer();
+			snapshot.previous = previous;
+			snapshot.current = state;
+			snapshot.tickSeconds = nextTickSeconds;
+			_snapshots.publish();
+
+			nextTickSeconds += TICK_SECONDS;
+		}
+
+		std::this_thread::sleep_until(_startTime + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(nextTickSeconds)));
+	}
+}
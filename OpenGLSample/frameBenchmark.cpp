@@ -0,0 +1,142 @@
+// STL
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include "common/frameBenchmark.h"
+
+const int FrameBenchmark::QUERY_RING_SIZE = 4;
+
+namespace {
+
+double nowSeconds()
+{
+	using clock = std::chrono::high_resolution_clock;
+	return std::chrono::duration<double>(clock::now().time_since_epoch()).count();
+}
+
+// Value at given percentile (0-100) of already sorted values, nearest-rank method
+double percentile(const std::vector<double>& sortedValues, double p)
+{
+	if (sortedValues.empty()) {
+		return 0.0;
+	}
+
+	const auto rank = static_cast<size_t>(p / 100.0 * (sortedValues.size() - 1) + 0.5);
+	return sortedValues[std::min(rank, sortedValues.size() - 1)];
+}
+
+void printStatistics(std::ostream& out, const char* label, std::vector<double> values)
+{
+	if (values.empty())
+	{
+		out << "  " << label << ": no samples" << std::endl;
+		return;
+	}
+
+	std::sort(values.begin(), values.end());
+	out << "  " << label << " (ms): min " << values.front()
+		<< "  median " << percentile(values, 50.0)
+		<< "  p99 " << percentile(values, 99.0)
+		<< "  max " << values.back() << std::endl;
+}
+
+} // namespace
+
+void FrameBenchmark::create(int expectedFrames)
+{
+	if (_isCreated)
+	{
+		std::cout << "This benchmark is already created! You need to delete it before re-creating it!" << std::endl;
+		return;
+	}
+
+	_queries.resize(QUERY_RING_SIZE);
+	glGenQueries(QUERY_RING_SIZE, _queries.data());
+	_cpuTimes.reserve(expectedFrames);
+	_gpuTimes.reserve(expectedFrames);
+	_isCreated = true;
+}
+
+void FrameBenchmark::beginFrame()
+{
+	// Query of this ring slot is still pending from QUERY_RING_SIZE frames ago, collect it first
+	if (_framesBegun - _gpuResultsRead >= QUERY_RING_SIZE) {
+		readOldestResult(true);
+	}
+
+	glBeginQuery(GL_TIME_ELAPSED, _queries[_framesBegun % QUERY_RING_SIZE]);
+	_frameStartSeconds = nowSeconds();
+}
+
+void FrameBenchmark::endFrame()
+{
+	glEndQuery(GL_TIME_ELAPSED);
+	_cpuTimes.push_back((nowSeconds() - _frameStartSeconds) * 1000.0);
+	_framesBegun++;
+
+	// Opportunistically collect results that are already available, without waiting
+	while (_gpuResultsRead < _framesBegun - 1 && readOldestResult(false)) {}
+}
+
+void FrameBenchmark::finish()
+{
+	while (_gpuResultsRead < _framesBegun) {
+		readOldestResult(true);
+	}
+}
+
+bool FrameBenchmark::readOldestResult(bool wait)
+{
+	const auto query = _queries[_gpuResultsRead % QUERY_RING_SIZE];
+	if (!wait)
+	{
+		GLint isAvailable = GL_FALSE;
+		glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+		if (!isAvailable) {
+			return false;
+		}
+	}
+
+	GLuint64 elapsedNanoseconds = 0;
+	glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsedNanoseconds);
+	_gpuTimes.push_back(elapsedNanoseconds / 1.0e6);
+	_gpuResultsRead++;
+	return true;
+}
+
+void FrameBenchmark::printReport(std::ostream& out) const
+{
+	const auto flags = out.flags();
+	const auto precision = out.precision();
+
+	out << std::fixed << std::setprecision(3);
+	out << "Frame times over " << _cpuTimes.size() << " frames:" << std::endl;
+	printStatistics(out, "CPU", _cpuTimes);
+	printStatistics(out, "GPU", _gpuTimes);
+
+	out.flags(flags);
+	out.precision(precision);
+}
+
+const std::vector<double>& FrameBenchmark::getCpuTimes() const
+{
+	return _cpuTimes;
+}
+
+const std::vector<double>& FrameBenchmark::getGpuTimes() const
+{
+	return _gpuTimes;
+}
+
+void FrameBenchmark::deleteBenchmark()
+{
+	if (!_isCreated) {
+		return;
+	}
+
+	glDeleteQueries(static_cast<GLsizei>(_queries.size()), _queries.data());
+	_queries.clear();
+	_isCreated = false;
+}
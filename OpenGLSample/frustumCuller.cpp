@@ -0,0 +1,200 @@
+#include <cmath>
+
+#include "common/frustumCuller.h"
+
+// SSE2 is always there on x64, on x86 MSVC defines _M_IX86_FP with /arch:SSE2 (the default)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define FRUSTUM_CULLER_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FRUSTUM_CULLER_SSE
+#endif
+
+void FrustumCuller::setViewProjection(const glm::mat4& viewProjection)
+{
+	// Gribb / Hartmann: planes are sums and differences of the matrix rows (glm is column major)
+	const auto row = [&viewProjection](int i) {
+		return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+	};
+
+	_planes[0] = row(3) + row(0); // left
+	_planes[1] = row(3) - row(0); // right
+	_planes[2] = row(3) + row(1); // bottom
+	_planes[3] = row(3) - row(1); // top
+	_planes[4] = row(3) + row(2); // near
+	_planes[5] = row(3) - row(2); // far
+
+	// Normalized planes give true distances, so they can be compared with radii
+	for (auto& plane : _planes) {
+		plane /= glm::length(glm::vec3(plane));
+	}
+}
+
+const glm::vec4& FrustumCuller::getPlane(int index) const
+{
+	return _planes[index];
+}
+
+void FrustumCuller::clear()
+{
+	_sphereX.clear();
+	_sphereY.clear();
+	_sphereZ.clear();
+	_sphereRadius.clear();
+	_boxCenterX.clear();
+	_boxCenterY.clear();
+	_boxCenterZ.clear();
+	_boxExtentX.clear();
+	_boxExtentY.clear();
+	_boxExtentZ.clear();
+	_isVisible.clear();
+	_visibleCount = 0;
+}
+
+int FrustumCuller::addObject(const BoundingVolume& worldBounds)
+{
+	const auto boxCenter = (worldBounds.aabbMin + worldBounds.aabbMax) * 0.5f;
+	const auto boxExtents = (worldBounds.aabbMax - worldBounds.aabbMin) * 0.5f;
+
+	_sphereX.push_back(worldBounds.sphereCenter.x);
+	_sphereY.push_back(worldBounds.sphereCenter.y);
+	_sphereZ.push_back(worldBounds.sphereCenter.z);
+	_sphereRadius.push_back(worldBounds.sphereRadius);
+	_boxCenterX.push_back(boxCenter.x);
+	_boxCenterY.push_back(boxCenter.y);
+	_boxCenterZ.push_back(boxCenter.z);
+	_boxExtentX.push_back(boxExtents.x);
+	_boxExtentY.push_back(boxExtents.y);
+	_boxExtentZ.push_back(boxExtents.z);
+
+	return static_cast<int>(_sphereX.size()) - 1;
+}
+
+void FrustumCuller::cull()
+{
+	const auto numObjects = _sphereX.size();
+	_isVisible.assign(numObjects, 0);
+
+	size_t first = 0;
+
+#if defined(FRUSTUM_CULLER_AVX)
+	for (; first + 8 <= numObjects; first += 8)
+	{
+		const auto sx = _mm256_loadu_ps(&_sphereX[first]);
+		const auto sy = _mm256_loadu_ps(&_sphereY[first]);
+		const auto sz = _mm256_loadu_ps(&_sphereZ[first]);
+		const auto negRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(&_sphereRadius[first]));
+		const auto bx = _mm256_loadu_ps(&_boxCenterX[first]);
+		const auto by = _mm256_loadu_ps(&_boxCenterY[first]);
+		const auto bz = _mm256_loadu_ps(&_boxCenterZ[first]);
+		const auto ex = _mm256_loadu_ps(&_boxExtentX[first]);
+		const auto ey = _mm256_loadu_ps(&_boxExtentY[first]);
+		const auto ez = _mm256_loadu_ps(&_boxExtentZ[first]);
+
+		auto outside = _mm256_setzero_ps();
+		for (const auto& plane : _planes)
+		{
+			const auto nx = _mm256_set1_ps(plane.x);
+			const auto ny = _mm256_set1_ps(plane.y);
+			const auto nz = _mm256_set1_ps(plane.z);
+			const auto nw = _mm256_set1_ps(plane.w);
+
+			// Sphere is outside when its center is farther than radius behind the plane
+			auto sphereDistance = _mm256_add_ps(_mm256_mul_ps(nx, sx), _mm256_mul_ps(ny, sy));
+			sphereDistance = _mm256_add_ps(sphereDistance, _mm256_add_ps(_mm256_mul_ps(nz, sz), nw));
+			outside = _mm256_or_ps(outside, _mm256_cmp_ps(sphereDistance, negRadius, _CMP_LT_OQ));
+
+			// Box is outside when its center is farther than its projected extents behind the plane
+			auto boxDistance = _mm256_add_ps(_mm256_mul_ps(nx, bx), _mm256_mul_ps(ny, by));
+			boxDistance = _mm256_add_ps(boxDistance, _mm256_add_ps(_mm256_mul_ps(nz, bz), nw));
+			auto boxRadius = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(std::fabs(plane.x)), ex), _mm256_mul_ps(_mm256_set1_ps(std::fabs(plane.y)), ey));
+			boxRadius = _mm256_add_ps(boxRadius, _mm256_mul_ps(_mm256_set1_ps(std::fabs(plane.z)), ez));
+			outside = _mm256_or_ps(outside, _mm256_cmp_ps(boxDistance, _mm256_sub_ps(_mm256_setzero_ps(), boxRadius), _CMP_LT_OQ));
+		}
+
+		const auto outsideMask = _mm256_movemask_ps(outside);
+		for (auto i = 0; i < 8; i++) {
+			_isVisible[first + i] = (outsideMask & (1 << i)) == 0;
+		}
+	}
+#elif defined(FRUSTUM_CULLER_SSE)
+	for (; first + 4 <= numObjects; first += 4)
+	{
+		const auto sx = _mm_loadu_ps(&_sphereX[first]);
+		const auto sy = _mm_loadu_ps(&_sphereY[first]);
+		const auto sz = _mm_loadu_ps(&_sphereZ[first]);
+		const auto negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&_sphereRadius[first]));
+		const auto bx = _mm_loadu_ps(&_boxCenterX[first]);
+		const auto by = _mm_loadu_ps(&_boxCenterY[first]);
+		const auto bz = _mm_loadu_ps(&_boxCenterZ[first]);
+		const auto ex = _mm_loadu_ps(&_boxExtentX[first]);
+		const auto ey = _mm_loadu_ps(&_boxExtentY[first]);
+		const auto ez = _mm_loadu_ps(&_boxExtentZ[first]);
+
+		auto outside = _mm_setzero_ps();
+		for (const auto& plane : _planes)
+		{
+			const auto nx = _mm_set1_ps(plane.x);
+			const auto ny = _mm_set1_ps(plane.y);
+			const auto nz = _mm_set1_ps(plane.z);
+			const auto nw = _mm_set1_ps(plane.w);
+
+			// Sphere is outside when its center is farther than radius behind the plane
+			auto sphereDistance = _mm_add_ps(_mm_mul_ps(nx, sx), _mm_mul_ps(ny, sy));
+			sphereDistance = _mm_add_ps(sphereDistance, _mm_add_ps(_mm_mul_ps(nz, sz), nw));
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(sphereDistance, negRadius));
+
+			// Box is outside when its center is farther than its projected extents behind the plane
+			auto boxDistance = _mm_add_ps(_mm_mul_ps(nx, bx), _mm_mul_ps(ny, by));
+			boxDistance = _mm_add_ps(boxDistance, _mm_add_ps(_mm_mul_ps(nz, bz), nw));
+			auto boxRadius = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::fabs(plane.x)), ex), _mm_mul_ps(_mm_set1_ps(std::fabs(plane.y)), ey));
+			boxRadius = _mm_add_ps(boxRadius, _mm_mul_ps(_mm_set1_ps(std::fabs(plane.z)), ez));
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(boxDistance, _mm_sub_ps(_mm_setzero_ps(), boxRadius)));
+		}
+
+		const auto outsideMask = _mm_movemask_ps(outside);
+		for (auto i = 0; i < 4; i++) {
+			_isVisible[first + i] = (outsideMask & (1 << i)) == 0;
+		}
+	}
+#endif
+
+	cullScalar(first, numObjects);
+
+	_visibleCount = 0;
+	for (auto visible : _isVisible) {
+		_visibleCount += visible;
+	}
+}
+
+void FrustumCuller::cullScalar(size_t first, size_t last)
+{
+	for (auto i = first; i < last; i++)
+	{
+		auto outside = false;
+		for (const auto& plane : _planes)
+		{
+			const auto sphereDistance = plane.x * _sphereX[i] + plane.y * _sphereY[i] + plane.z * _sphereZ[i] + plane.w;
+			const auto boxDistance = plane.x * _boxCenterX[i] + plane.y * _boxCenterY[i] + plane.z * _boxCenterZ[i] + plane.w;
+			const auto boxRadius = std::fabs(plane.x) * _boxExtentX[i] + std::fabs(plane.y) * _boxExtentY[i] + std::fabs(plane.z) * _boxExtentZ[i];
+			outside = outside || sphereDistance < -_sphereRadius[i] || boxDistance < -boxRadius;
+		}
+		_isVisible[i] = !outside;
+	}
+}
+
+bool FrustumCuller::isVisible(int index) const
+{
+	return index >= 0 && index < static_cast<int>(_isVisible.size()) && _isVisible[index] != 0;
+}
+
+int FrustumCuller::getVisibleCount() const
+{
+	return _visibleCount;
+}
+
+int FrustumCuller::getCulledCount() const
+{
+	return static_cast<int>(_isVisible.size()) - _visibleCount;
+}
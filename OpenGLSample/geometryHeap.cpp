@@ -0,0 +1,395 @@
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+
+#include "common/geometryHeap.h"
+#include "common/resourceTracker.h"
+
+const size_t GeometryHeap::DEFAULT_BLOCK_SIZE = 4 * 1024 * 1024;
+const int    GeometryHeap::INVALID_HANDLE     = -1;
+
+namespace {
+
+size_t alignUp(size_t offset, size_t alignment)
+{
+	return (offset + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+void GeometryHeap::createHeap(size_t blockSizeBytes)
+{
+	if (_isHeapCreated)
+	{
+		std::cout << "This geometry heap is already created! You need to delete it before re-creating it!" << std::endl;
+		return;
+	}
+
+	_blockSize = blockSizeBytes > 0 ? blockSizeBytes : DEFAULT_BLOCK_SIZE;
+	_isHeapCreated = true;
+}
+
+int GeometryHeap::allocate(size_t sizeBytes, size_t alignment)
+{
+	if (!_isHeapCreated)
+	{
+		std::cout << "This geometry heap is not created yet! Call createHeap before allocating from it!" << std::endl;
+		return INVALID_HANDLE;
+	}
+
+	alignment = std::max<size_t>(alignment, 1);
+	sizeBytes = std::max<size_t>(sizeBytes, 1);
+
+	// Best fit over all blocks: the smallest free range that still holds the aligned size
+	int bestBlock = -1;
+	size_t bestRangeOffset = 0, bestRangeSize = 0;
+	for (size_t i = 0; i < _blocks.size(); i++)
+	{
+		const auto& freeBySize = _blocks[i].freeBySize;
+		for (auto itRange = freeBySize.lower_bound(sizeBytes); itRange != freeBySize.end(); ++itRange)
+		{
+			if (bestBlock != -1 && itRange->first >= bestRangeSize) {
+				break;
+			}
+			const auto padding = alignUp(itRange->second, alignment) - itRange->second;
+			if (padding + sizeBytes <= itRange->first)
+			{
+				bestBlock = static_cast<int>(i);
+				bestRangeOffset = itRange->second;
+				bestRangeSize = itRange->first;
+				break;
+			}
+		}
+	}
+
+	if (bestBlock == -1)
+	{
+		bestBlock = addBlock(std::max(_blockSize, sizeBytes));
+		bestRangeOffset = 0;
+		bestRangeSize = _blocks[bestBlock].size;
+	}
+
+	// Padding in front and the rest behind stay free
+	auto& block = _blocks[bestBlock];
+	const auto offset = alignUp(bestRangeOffset, alignment);
+	eraseFreeRange(block, bestRangeOffset);
+	if (offset > bestRangeOffset) {
+		insertFreeRange(block, bestRangeOffset, offset - bestRangeOffset);
+	}
+	if (offset + sizeBytes < bestRangeOffset + bestRangeSize) {
+		insertFreeRange(block, offset + sizeBytes, bestRangeOffset + bestRangeSize - offset - sizeBytes);
+	}
+
+	int handle;
+	if (!_freeHandles.empty())
+	{
+		handle = _freeHandles.back();
+		_freeHandles.pop_back();
+	}
+	else
+	{
+		handle = static_cast<int>(_allocations.size());
+		_allocations.emplace_back();
+	}
+
+	auto& allocation = _allocations[handle];
+	allocation.block = bestBlock;
+	allocation.offset = offset;
+	allocation.size = sizeBytes;
+	allocation.alignment = alignment;
+	allocation.isMapped = false;
+	return handle;
+}
+
+void GeometryHeap::free(int handle)
+{
+	if (!isValidHandle(handle)) {
+		return;
+	}
+
+	auto& allocation = _allocations[handle];
+	if (allocation.isMapped) {
+		unmap(handle);
+	}
+
+	// Merge with the free ranges right before and right after
+	auto& block = _blocks[allocation.block];
+	auto offset = allocation.offset;
+	auto end = allocation.offset + allocation.size;
+	auto itNext = block.freeByOffset.lower_bound(offset);
+	if (itNext != block.freeByOffset.begin())
+	{
+		const auto itPrevious = std::prev(itNext);
+		if (itPrevious->first + itPrevious->second == offset)
+		{
+			offset = itPrevious->first;
+			eraseFreeRange(block, itPrevious->first);
+		}
+	}
+	itNext = block.freeByOffset.lower_bound(end);
+	if (itNext != block.freeByOffset.end() && itNext->first == end)
+	{
+		end += itNext->second;
+		eraseFreeRange(block, itNext->first);
+	}
+	insertFreeRange(block, offset, end - offset);
+
+	allocation = Allocation();
+	_freeHandles.push_back(handle);
+}
+
+void* GeometryHeap::map(int handle)
+{
+	if (!isValidHandle(handle)) {
+		return nullptr;
+	}
+
+	// The range may have belonged to a mesh drawn a moment ago, so the mapping stays synchronized
+	auto& allocation = _allocations[handle];
+	glBindBuffer(GL_COPY_WRITE_BUFFER, _blocks[allocation.block].buffer.get());
+	void* ptrRange = glMapBufferRange(GL_COPY_WRITE_BUFFER, allocation.offset, allocation.size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	allocation.isMapped = ptrRange != nullptr;
+	return ptrRange;
+}
+
+bool GeometryHeap::unmap(int handle)
+{
+	if (!isValidHandle(handle) || !_allocations[handle].isMapped) {
+		return false;
+	}
+
+	auto& allocation = _allocations[handle];
+	glBindBuffer(GL_COPY_WRITE_BUFFER, _blocks[allocation.block].buffer.get());
+	const auto isIntact = glUnmapBuffer(GL_COPY_WRITE_BUFFER) == GL_TRUE;
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	allocation.isMapped = false;
+	return isIntact;
+}
+
+void GeometryHeap::upload(int handle, size_t offset, const void* ptrData, size_t sizeBytes)
+{
+	if (!isValidHandle(handle)) {
+		return;
+	}
+
+	const auto& allocation = _allocations[handle];
+	if (offset + sizeBytes > allocation.size)
+	{
+		std::cout << "Upload of " << sizeBytes << " bytes at offset " << offset << " exceeds allocation of " << allocation.size << " bytes!" << std::endl;
+		return;
+	}
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, _blocks[allocation.block].buffer.get());
+	glBufferSubData(GL_COPY_WRITE_BUFFER, allocation.offset + offset, sizeBytes, ptrData);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+bool GeometryHeap::defragment()
+{
+	// Nothing to gain if all free space is one range at the end of the only block
+	const auto stats = getStats();
+	if (stats.numBuffers == 0 || (stats.numBuffers == 1 && stats.numFreeRanges <= 1 && stats.fragmentation == 0.0f
+		&& (stats.numFreeRanges == 0 || _blocks[0].freeByOffset.rbegin()->first + stats.freeBytes == _blocks[0].size))) {
+		return false;
+	}
+
+	std::vector<int> handles;
+	for (size_t i = 0; i < _allocations.size(); i++)
+	{
+		if (_allocations[i].block == -1) {
+			continue;
+		}
+		if (_allocations[i].isMapped)
+		{
+			std::cout << "Geometry heap can't be defragmented while allocation " << i << " is mapped!" << std::endl;
+			return false;
+		}
+		handles.push_back(static_cast<int>(i));
+	}
+
+	// Old order is kept, so allocations that were close stay close
+	std::sort(handles.begin(), handles.end(), [this](int a, int b) {
+		return _allocations[a].block != _allocations[b].block ? _allocations[a].block < _allocations[b].block : _allocations[a].offset < _allocations[b].offset;
+	});
+
+	// Blocks are filled one after another, each new block is as big as the old ones or the allocation
+	std::vector<Block> oldBlocks;
+	oldBlocks.swap(_blocks);
+	size_t end = 0;
+	for (const auto handle : handles)
+	{
+		auto& allocation = _allocations[handle];
+		auto offset = alignUp(end, allocation.alignment);
+		if (_blocks.empty() || offset + allocation.size > _blocks.back().size)
+		{
+			if (!_blocks.empty() && end < _blocks.back().size) {
+				insertFreeRange(_blocks.back(), end, _blocks.back().size - end);
+			}
+			_blocks.emplace_back();
+			_blocks.back().size = std::max(_blockSize, allocation.size);
+			_blocks.back().buffer = GLBuffer::create();
+			glBindBuffer(GL_COPY_WRITE_BUFFER, _blocks.back().buffer.get());
+			glBufferData(GL_COPY_WRITE_BUFFER, _blocks.back().size, nullptr, GL_STATIC_DRAW);
+			TRACK_RESOURCE(BUFFER, _blocks.back().buffer.get(), _blocks.back().size, "geometry heap");
+			end = offset = 0;
+		}
+
+		// Only the padding of the alignment stays free in between
+		auto& block = _blocks.back();
+		if (offset > end) {
+			insertFreeRange(block, end, offset - end);
+		}
+
+		glBindBuffer(GL_COPY_READ_BUFFER, oldBlocks[allocation.block].buffer.get());
+		glBindBuffer(GL_COPY_WRITE_BUFFER, block.buffer.get());
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, allocation.offset, offset, allocation.size);
+		_movedBytes += allocation.size;
+
+		allocation.block = static_cast<int>(_blocks.size()) - 1;
+		allocation.offset = offset;
+		end = offset + allocation.size;
+	}
+	if (!_blocks.empty() && end < _blocks.back().size) {
+		insertFreeRange(_blocks.back(), end, _blocks.back().size - end);
+	}
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	// The copies above still read the old buffers, the deletion queue keeps them until they are done
+	oldBlocks.clear();
+
+	_generation++;
+	_numDefragmentations++;
+	return true;
+}
+
+GLuint GeometryHeap::getBufferID(int handle) const
+{
+	return isValidHandle(handle) ? _blocks[_allocations[handle].block].buffer.get() : 0;
+}
+
+size_t GeometryHeap::getOffset(int handle) const
+{
+	return isValidHandle(handle) ? _allocations[handle].offset : 0;
+}
+
+size_t GeometryHeap::getSize(int handle) const
+{
+	return isValidHandle(handle) ? _allocations[handle].size : 0;
+}
+
+unsigned int GeometryHeap::getGeneration() const
+{
+	return _generation;
+}
+
+GeometryHeap::Stats GeometryHeap::getStats() const
+{
+	Stats stats;
+	stats.numBuffers = static_cast<int>(_blocks.size());
+	for (const auto& block : _blocks)
+	{
+		stats.reservedBytes += block.size;
+		stats.numFreeRanges += static_cast<int>(block.freeByOffset.size());
+		for (const auto& range : block.freeByOffset) {
+			stats.freeBytes += range.second;
+		}
+		if (!block.freeBySize.empty()) {
+			stats.largestFreeRange = std::max(stats.largestFreeRange, block.freeBySize.rbegin()->first);
+		}
+	}
+	for (const auto& allocation : _allocations)
+	{
+		if (allocation.block != -1)
+		{
+			stats.numAllocations++;
+			stats.liveBytes += allocation.size;
+		}
+	}
+	stats.fragmentation = stats.freeBytes > 0 ? 1.0f - static_cast<float>(stats.largestFreeRange) / stats.freeBytes : 0.0f;
+	stats.numDefragmentations = _numDefragmentations;
+	stats.movedBytes = _movedBytes;
+	return stats;
+}
+
+void GeometryHeap::printStats(const char* name, std::ostream& os) const
+{
+	const auto stats = getStats();
+	const auto flags = os.flags();
+	const auto precision = os.precision();
+
+	os << std::fixed << std::setprecision(1);
+	os << "Geometry heap (" << name << "): " << stats.numAllocations << " allocations in " << stats.numBuffers
+		<< (stats.numBuffers == 1 ? " buffer, " : " buffers, ") << stats.liveBytes << " of " << stats.reservedBytes << " bytes live, "
+		<< stats.freeBytes << " free in " << stats.numFreeRanges << " ranges (largest " << stats.largestFreeRange << ", "
+		<< stats.fragmentation * 100.0f << "% fragmented), " << stats.numDefragmentations << " defragmentations moved "
+		<< stats.movedBytes << " bytes" << std::endl;
+
+	os.flags(flags);
+	os.precision(precision);
+}
+
+void GeometryHeap::deleteHeap()
+{
+	if (!_isHeapCreated) {
+		return;
+	}
+
+	// Deleting a mapped buffer unmaps it
+	_blocks.clear();
+	_allocations.clear();
+	_freeHandles.clear();
+	_isHeapCreated = false;
+}
+
+int GeometryHeap::addBlock(size_t sizeBytes)
+{
+	Block block;
+	block.size = sizeBytes;
+	block.buffer = GLBuffer::create();
+	glBindBuffer(GL_COPY_WRITE_BUFFER, block.buffer.get());
+	glBufferData(GL_COPY_WRITE_BUFFER, sizeBytes, nullptr, GL_STATIC_DRAW);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	TRACK_RESOURCE(BUFFER, block.buffer.get(), sizeBytes, "geometry heap");
+	insertFreeRange(block, 0, sizeBytes);
+
+	_blocks.push_back(std::move(block));
+	return static_cast<int>(_blocks.size()) - 1;
+}
+
+void GeometryHeap::insertFreeRange(Block& block, size_t offset, size_t size)
+{
+	block.freeByOffset[offset] = size;
+	block.freeBySize.emplace(size, offset);
+}
+
+void GeometryHeap::eraseFreeRange(Block& block, size_t offset)
+{
+	const auto itRange = block.freeByOffset.find(offset);
+	if (itRange == block.freeByOffset.end()) {
+		return;
+	}
+
+	auto range = block.freeBySize.equal_range(itRange->second);
+	for (auto itSize = range.first; itSize != range.second; ++itSize)
+	{
+		if (itSize->second == offset)
+		{
+			block.freeBySize.erase(itSize);
+			break;
+		}
+	}
+	block.freeByOffset.erase(itRange);
+}
+
+bool GeometryHeap::isValidHandle(int handle) const
+{
+	if (handle < 0 || handle >= static_cast<int>(_allocations.size()) || _allocations[handle].block == -1)
+	{
+		std::cout << "Invalid geometry heap handle " << handle << "!" << std::endl;
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,107 @@
+#include <iostream>
+
+#include "common/geometryPool.h"
+#include "common/resourceTracker.h"
+
+const int GeometryPool::FLOATS_PER_VERTEX = 8;
+
+int GeometryPool::addMesh(const float* ptrVertices, int numVertices)
+{
+	std::vector<GLuint> indices(numVertices);
+	for (auto i = 0; i < numVertices; i++) {
+		indices[i] = i;
+	}
+
+	return addIndexedMesh(ptrVertices, numVertices, indices.data(), numVertices);
+}
+
+int GeometryPool::addIndexedMesh(const float* ptrVertices, int numVertices, const GLuint* ptrIndices, int numIndices)
+{
+	if (_isUploaded)
+	{
+		std::cout << "This geometry pool is already uploaded! You cannot add meshes to it anymore!" << std::endl;
+		return -1;
+	}
+
+	MeshRange range;
+	range.indexCount = numIndices;
+	range.firstIndex = static_cast<GLuint>(_indices.size());
+	range.baseVertex = static_cast<GLint>(_vertices.size() / FLOATS_PER_VERTEX);
+	_meshRanges.push_back(range);
+
+	_vertices.insert(_vertices.end(), ptrVertices, ptrVertices + numVertices * FLOATS_PER_VERTEX);
+	_indices.insert(_indices.end(), ptrIndices, ptrIndices + numIndices);
+
+	return static_cast<int>(_meshRanges.size()) - 1;
+}
+
+void GeometryPool::uploadToGPU()
+{
+	if (_isUploaded)
+	{
+		std::cout << "This geometry pool is already uploaded!" << std::endl;
+		return;
+	}
+
+	_vao = GLVertexArray::create();
+	glBindVertexArray(_vao.get());
+
+	_vertexBuffer = GLBuffer::create();
+	glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer.get());
+	glBufferData(GL_ARRAY_BUFFER, _vertices.size() * sizeof(float), _vertices.data(), GL_STATIC_DRAW);
+	TRACK_RESOURCE(BUFFER, _vertexBuffer.get(), _vertices.size() * sizeof(float), "geometry pool");
+
+	_indexBuffer = GLBuffer::create();
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer.get());
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, _indices.size() * sizeof(GLuint), _indices.data(), GL_STATIC_DRAW);
+	TRACK_RESOURCE(BUFFER, _indexBuffer.get(), _indices.size() * sizeof(GLuint), "geometry pool");
+
+	const auto stride = FLOATS_PER_VERTEX * sizeof(float);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float)));
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// Data live on the GPU now, only the ranges are needed
+	_vertices.clear();
+	_vertices.shrink_to_fit();
+	_indices.clear();
+	_indices.shrink_to_fit();
+
+	_isUploaded = true;
+}
+
+const GeometryPool::MeshRange& GeometryPool::getMeshRange(int meshIndex) const
+{
+	return _meshRanges[meshIndex];
+}
+
+int GeometryPool::getNumMeshes() const
+{
+	return static_cast<int>(_meshRanges.size());
+}
+
+GLuint GeometryPool::getVAO() const
+{
+	return _vao.get();
+}
+
+void GeometryPool::deletePool()
+{
+	if (_isUploaded)
+	{
+		_vao.reset();
+		_vertexBuffer.reset();
+		_indexBuffer.reset();
+		_isUploaded = false;
+	}
+
+	_vertices.clear();
+	_indices.clear();
+	_meshRanges.clear();
+}
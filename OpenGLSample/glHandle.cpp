@@ -0,0 +1,183 @@
+// STL
+#include <algorithm>
+#include <iostream>
+
+#include "common/glHandle.h"
+#include "common/resourceTracker.h"
+
+namespace {
+
+// Kinds the resource tracker accounts memory of, NUM_TYPES for the others
+const ResourceTracker::Type TRACKED_TYPES[GLDeletionQueue::NUM_TYPES] = {
+	ResourceTracker::BUFFER,
+	ResourceTracker::NUM_TYPES,
+	ResourceTracker::TEXTURE,
+	ResourceTracker::RENDERBUFFER,
+	ResourceTracker::NUM_TYPES,
+	ResourceTracker::PROGRAM
+};
+
+} // namespace
+
+GLDeletionQueue& GLDeletionQueue::get()
+{
+	static GLDeletionQueue queue;
+	return queue;
+}
+
+GLuint GLDeletionQueue::generate(Type type)
+{
+	GLuint name = 0;
+	switch (type)
+	{
+	case BUFFER:
+		glGenBuffers(1, &name);
+		break;
+	case VERTEX_ARRAY:
+		glGenVertexArrays(1, &name);
+		break;
+	case TEXTURE:
+		glGenTextures(1, &name);
+		break;
+	case RENDERBUFFER:
+		glGenRenderbuffers(1, &name);
+		break;
+	case FRAMEBUFFER:
+		glGenFramebuffers(1, &name);
+		break;
+	case PROGRAM:
+		name = glCreateProgram();
+		break;
+	default:
+		break;
+	}
+	return name;
+}
+
+void GLDeletionQueue::release(Type type, GLuint name)
+{
+	if (name == 0) {
+		return;
+	}
+
+	Object object;
+	object.type = type;
+	object.name = name;
+	_released.push_back(object);
+
+	_numPending++;
+	_stats.numReleased++;
+	_stats.maxPending = std::max(_stats.maxPending, _numPending);
+}
+
+void GLDeletionQueue::endFrame()
+{
+	if (!_released.empty())
+	{
+		Batch batch;
+		batch.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		batch.objects.swap(_released);
+		_batches.push_back(std::move(batch));
+	}
+
+	// Fences signal in order, the first one still pending holds back all later batches
+	while (!_batches.empty())
+	{
+		auto& batch = _batches.front();
+		const auto waitResult = glClientWaitSync(batch.fence, 0, 0);
+		if (waitResult != GL_ALREADY_SIGNALED && waitResult != GL_CONDITION_SATISFIED) {
+			break;
+		}
+
+		glDeleteSync(batch.fence);
+		deleteObjects(batch.objects);
+		_batches.pop_front();
+	}
+}
+
+void GLDeletionQueue::flush()
+{
+	// OpenGL itself keeps deleted objects alive while queued commands still use them
+	for (auto& batch : _batches)
+	{
+		glDeleteSync(batch.fence);
+		_stats.numFlushed += static_cast<int>(batch.objects.size());
+		deleteObjects(batch.objects);
+	}
+	_batches.clear();
+
+	_stats.numFlushed += static_cast<int>(_released.size());
+	deleteObjects(_released);
+	_released.clear();
+}
+
+int GLDeletionQueue::getNumPending() const
+{
+	return _numPending;
+}
+
+const GLDeletionQueue::Stats& GLDeletionQueue::getStats() const
+{
+	return _stats;
+}
+
+void GLDeletionQueue::printStats(std::ostream& os) const
+{
+	os << "GL deletion queue: " << _stats.numReleased << " released, " << _stats.numDeleted << " deleted ("
+		<< _stats.numFlushed << " flushed), " << _numPending << " pending, at most " << _stats.maxPending << " pending" << std::endl;
+}
+
+void GLDeletionQueue::deleteObjects(const std::vector<Object>& objects)
+{
+	std::vector<GLuint> names;
+	for (int type = 0; type < NUM_TYPES; type++)
+	{
+		names.clear();
+		for (const auto& object : objects)
+		{
+			if (object.type == type) {
+				names.push_back(object.name);
+			}
+		}
+		if (names.empty()) {
+			continue;
+		}
+
+		if (TRACKED_TYPES[type] != ResourceTracker::NUM_TYPES)
+		{
+			for (auto name : names) {
+				ResourceTracker::get().untrack(TRACKED_TYPES[type], name);
+			}
+		}
+
+		const auto count = static_cast<GLsizei>(names.size());
+		switch (type)
+		{
+		case BUFFER:
+			glDeleteBuffers(count, names.data());
+			break;
+		case VERTEX_ARRAY:
+			glDeleteVertexArrays(count, names.data());
+			break;
+		case TEXTURE:
+			glDeleteTextures(count, names.data());
+			break;
+		case RENDERBUFFER:
+			glDeleteRenderbuffers(count, names.data());
+			break;
+		case FRAMEBUFFER:
+			glDeleteFramebuffers(count, names.data());
+			break;
+		case PROGRAM:
+			for (auto name : names) {
+				glDeleteProgram(name);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	_numPending -= static_cast<int>(objects.size());
+	_stats.numDeleted += static_cast<int>(objects.size());
+}
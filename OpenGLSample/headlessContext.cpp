@@ -0,0 +1,157 @@
+#include <iostream>
+
+#include "common/headlessContext.h"
+
+#if defined(__linux__)
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+bool HeadlessContext::create(int majorVersion, int minorVersion)
+{
+	if (_isCreated)
+	{
+		std::cout << "Headless context is already created!" << std::endl;
+		return false;
+	}
+
+	// Prefer the surfaceless platform, it works without X11/Wayland and without a GPU
+	EGLDisplay display = EGL_NO_DISPLAY;
+	const auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+	if (getPlatformDisplay != nullptr) {
+		display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+	}
+	if (display == EGL_NO_DISPLAY) {
+		display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	}
+
+	EGLint eglMajor, eglMinor;
+	if (display == EGL_NO_DISPLAY || !eglInitialize(display, &eglMajor, &eglMinor))
+	{
+		std::cout << "Failed to initialize EGL display" << std::endl;
+		return false;
+	}
+
+	if (!eglBindAPI(EGL_OPENGL_API))
+	{
+		std::cout << "EGL implementation does not support desktop OpenGL" << std::endl;
+		eglTerminate(display);
+		return false;
+	}
+
+	const EGLint configAttributes[] = {
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_NONE
+	};
+	EGLConfig config = nullptr;
+	EGLint numConfigs = 0;
+	eglChooseConfig(display, configAttributes, &config, 1, &numConfigs);
+
+	const EGLint contextAttributes[] = {
+		EGL_CONTEXT_MAJOR_VERSION, majorVersion,
+		EGL_CONTEXT_MINOR_VERSION, minorVersion,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		EGL_NONE
+	};
+	EGLContext context = eglCreateContext(display, numConfigs > 0 ? config : EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, contextAttributes);
+	if (context == EGL_NO_CONTEXT)
+	{
+		std::cout << "Failed to create EGL context (error 0x" << std::hex << eglGetError() << std::dec << ")" << std::endl;
+		eglTerminate(display);
+		return false;
+	}
+
+	// No surface at all, we render into a framebuffer object
+	if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+	{
+		std::cout << "Failed to make surfaceless EGL context current" << std::endl;
+		eglDestroyContext(display, context);
+		eglTerminate(display);
+		return false;
+	}
+
+	_display = display;
+	_context = context;
+	_isCreated = true;
+	return true;
+}
+
+void HeadlessContext::destroy()
+{
+	if (!_isCreated) {
+		return;
+	}
+
+	eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	eglDestroyContext(_display, _context);
+	eglTerminate(_display);
+	_display = nullptr;
+	_context = nullptr;
+	_isCreated = false;
+}
+
+void* HeadlessContext::getProcAddress(const char* name)
+{
+	return (void*)eglGetProcAddress(name);
+}
+
+#else
+
+#include <GLFW/glfw3.h>
+
+bool HeadlessContext::create(int majorVersion, int minorVersion)
+{
+	if (_isCreated)
+	{
+		std::cout << "Headless context is already created!" << std::endl;
+		return false;
+	}
+
+	if (!glfwInit())
+	{
+		std::cout << "Failed to initialize GLFW" << std::endl;
+		return false;
+	}
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, majorVersion);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, minorVersion);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+	// The window is never shown, the default framebuffer is not used at all
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+	GLFWwindow* window = glfwCreateWindow(1, 1, "OpenGLSample headless", NULL, NULL);
+	if (window == NULL)
+	{
+		std::cout << "Failed to create hidden GLFW window" << std::endl;
+		glfwTerminate();
+		return false;
+	}
+	glfwMakeContextCurrent(window);
+
+	_context = window;
+	_isCreated = true;
+	return true;
+}
+
+void HeadlessContext::destroy()
+{
+	if (!_isCreated) {
+		return;
+	}
+
+	glfwDestroyWindow((GLFWwindow*)_context);
+	glfwTerminate();
+	_context = nullptr;
+	_isCreated = false;
+}
+
+void* HeadlessContext::getProcAddress(const char* name)
+{
+	return (void*)glfwGetProcAddress(name);
+}
+
+#endif
@@ -0,0 +1,269 @@
+// STL
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <unordered_map>
+
+#include "common/indexBufferBuilder.h"
+
+const size_t IndexBufferBuilder::MAX_SHORT_VERTICES = 0xFFFF;
+
+namespace {
+
+// Restart index used while indices are still 32-bit, replaced by the one of the picked type in finish
+const GLuint PENDING_RESTART_INDEX = 0xFFFFFFFF;
+
+uint64_t edgeKey(GLuint from, GLuint to)
+{
+	return (static_cast<uint64_t>(from) << 32) | to;
+}
+
+bool isDegenerate(const GLuint* triangle)
+{
+	return triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[0] == triangle[2];
+}
+
+} // namespace
+
+IndexBufferBuilder::IndexBufferBuilder(bool useStrips, size_t stripLookahead)
+	: _useStrips(useStrips)
+	, _stripLookahead(stripLookahead) {}
+
+IndexBufferBuilder::Range IndexBufferBuilder::addTriangles(const GLuint* ptrIndices, size_t numIndices)
+{
+	Range range;
+	range.first = static_cast<GLsizei>(_indices.size());
+	range.count = 0;
+	range.numTriangles = 0;
+	if (_isFinished)
+	{
+		std::cout << "This index buffer is already finished! You cannot add triangles to it anymore!" << std::endl;
+		return range;
+	}
+
+	for (size_t i = 0; i < numIndices; i++) {
+		_maxIndex = std::max(_maxIndex, ptrIndices[i]);
+	}
+
+	if (_useStrips)
+	{
+		// Strips of different meshes must not run into each other
+		if (!_indices.empty())
+		{
+			_indices.push_back(PENDING_RESTART_INDEX);
+			range.first++;
+		}
+		range.numTriangles = static_cast<GLsizei>(stripify(ptrIndices, numIndices, PENDING_RESTART_INDEX, _indices, _stripLookahead));
+	}
+	else
+	{
+		_indices.reserve(_indices.size() + numIndices);
+		for (size_t i = 0; i + 2 < numIndices; i += 3)
+		{
+			if (isDegenerate(ptrIndices + i)) {
+				continue;
+			}
+			_indices.insert(_indices.end(), ptrIndices + i, ptrIndices + i + 3);
+			range.numTriangles++;
+		}
+	}
+
+	range.count = static_cast<GLsizei>(_indices.size()) - range.first;
+	_numTriangles += range.numTriangles;
+	return range;
+}
+
+void IndexBufferBuilder::finish()
+{
+	if (_isFinished) {
+		return;
+	}
+
+	_indexType = _maxIndex < MAX_SHORT_VERTICES ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	const auto restartIndex = getPrimitiveRestartIndex(_indexType);
+	if (_indexType == GL_UNSIGNED_SHORT)
+	{
+		_packed.resize(_indices.size() * sizeof(GLushort));
+		auto* out = reinterpret_cast<GLushort*>(_packed.data());
+		for (auto index : _indices) {
+			*out++ = static_cast<GLushort>(index == PENDING_RESTART_INDEX ? restartIndex : index);
+		}
+	}
+	else
+	{
+		_packed.resize(_indices.size() * sizeof(GLuint));
+		std::copy(_indices.begin(), _indices.end(), reinterpret_cast<GLuint*>(_packed.data()));
+	}
+
+	// Only the packed copy is needed from now on
+	std::vector<GLuint>().swap(_indices);
+	_isFinished = true;
+}
+
+GLenum IndexBufferBuilder::getIndexType() const
+{
+	return _indexType;
+}
+
+GLenum IndexBufferBuilder::getPrimitiveType() const
+{
+	return _useStrips ? GL_TRIANGLE_STRIP : GL_TRIANGLES;
+}
+
+const std::vector<GLuint>& IndexBufferBuilder::getIndices() const
+{
+	return _indices;
+}
+
+const void* IndexBufferBuilder::getData() const
+{
+	return _packed.data();
+}
+
+size_t IndexBufferBuilder::getIndexCount() const
+{
+	if (!_isFinished) {
+		return _indices.size();
+	}
+	return _packed.size() / (_indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint));
+}
+
+size_t IndexBufferBuilder::getByteSize() const
+{
+	return _packed.size();
+}
+
+size_t IndexBufferBuilder::getTriangleListByteSize() const
+{
+	return _numTriangles * 3 * sizeof(GLuint);
+}
+
+void IndexBufferBuilder::printStats(const char* name, std::ostream& os) const
+{
+	printStats(name, _indexType, getPrimitiveType(), getIndexCount(), _numTriangles, os);
+}
+
+void IndexBufferBuilder::printStats(const char* name, GLenum indexType, GLenum primitiveType, size_t indexCount, size_t numTriangles, std::ostream& os)
+{
+	const auto indexBytes = indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+	const auto byteSize = indexCount * indexBytes;
+	const auto listBytes = numTriangles * 3 * sizeof(GLuint);
+	const auto flags = os.flags();
+	const auto precision = os.precision();
+
+	os << "Index buffer (" << name << "): " << (indexType == GL_UNSIGNED_SHORT ? 16 : 32) << "-bit "
+		<< (primitiveType == GL_TRIANGLE_STRIP ? "triangle strips" : "triangle list") << ", " << indexCount << " indices, "
+		<< byteSize << " bytes (32-bit triangle list " << listBytes << " bytes, "
+		<< std::fixed << std::setprecision(1)
+		<< (listBytes > 0 ? 100.0 * (1.0 - double(byteSize) / listBytes) : 0.0) << "% saved)" << std::endl;
+
+	os.flags(flags);
+	os.precision(precision);
+}
+
+GLuint IndexBufferBuilder::getPrimitiveRestartIndex(GLenum indexType)
+{
+	return indexType == GL_UNSIGNED_SHORT ? 0xFFFF : 0xFFFFFFFF;
+}
+
+void IndexBufferBuilder::enablePrimitiveRestart(GLenum indexType)
+{
+	glEnable(GL_PRIMITIVE_RESTART);
+	glPrimitiveRestartIndex(getPrimitiveRestartIndex(indexType));
+}
+
+size_t IndexBufferBuilder::stripify(const GLuint* ptrIndices, size_t numIndices, GLuint restartIndex, std::vector<GLuint>& strips, size_t lookahead)
+{
+	const auto numTriangles = numIndices / 3;
+
+	// Every directed edge points to its triangle, the neighbour across edge a->b owns edge b->a
+	std::unordered_map<uint64_t, GLuint> edgeTriangles;
+	edgeTriangles.reserve(numTriangles * 3);
+	std::vector<char> isUsed(numTriangles, 0);
+	for (size_t t = 0; t < numTriangles; t++)
+	{
+		const auto* triangle = ptrIndices + 3 * t;
+		if (isDegenerate(triangle))
+		{
+			isUsed[t] = 1;
+			continue;
+		}
+		for (int e = 0; e < 3; e++) {
+			edgeTriangles.emplace(edgeKey(triangle[e], triangle[(e + 1) % 3]), static_cast<GLuint>(t));
+		}
+	}
+
+	// Unused triangle owning edge from->to within the lookahead of the strip's first triangle, or -1
+	size_t stripFirstTriangle = 0;
+	const auto findNeighbour = [&](GLuint from, GLuint to) -> long long
+	{
+		const auto it = edgeTriangles.find(edgeKey(from, to));
+		if (it == edgeTriangles.end() || isUsed[it->second]) {
+			return -1;
+		}
+		if (lookahead > 0 && it->second >= stripFirstTriangle + lookahead) {
+			return -1;
+		}
+		return it->second;
+	};
+
+	size_t numStripTriangles = 0;
+	for (size_t t = 0; t < numTriangles; t++)
+	{
+		if (isUsed[t]) {
+			continue;
+		}
+
+		// Start with the rotation whose last edge leads to an unused neighbour, so the strip can grow
+		stripFirstTriangle = t;
+		const auto* triangle = ptrIndices + 3 * t;
+		auto rotation = 0;
+		for (int r = 0; r < 3; r++)
+		{
+			if (findNeighbour(triangle[(r + 2) % 3], triangle[(r + 1) % 3]) >= 0)
+			{
+				rotation = r;
+				break;
+			}
+		}
+
+		if (numStripTriangles > 0) {
+			strips.push_back(restartIndex);
+		}
+		const auto stripStart = strips.size();
+		strips.push_back(triangle[rotation]);
+		strips.push_back(triangle[(rotation + 1) % 3]);
+		strips.push_back(triangle[(rotation + 2) % 3]);
+		isUsed[t] = 1;
+		numStripTriangles++;
+
+		// Triangle i of a strip is (v[i], v[i+1], v[i+2]), odd ones are flipped by GL. The next triangle
+		// shares edge v[n-2] v[n-1] and must run it opposite to how the last triangle is really wound.
+		for (;;)
+		{
+			const auto stripLength = strips.size() - stripStart;
+			const auto p = strips[strips.size() - 2];
+			const auto q = strips[strips.size() - 1];
+			const auto isLastOdd = (stripLength - 3) % 2 == 1;
+			const auto neighbour = isLastOdd ? findNeighbour(p, q) : findNeighbour(q, p);
+			if (neighbour < 0) {
+				break;
+			}
+
+			const auto* next = ptrIndices + 3 * neighbour;
+			for (int e = 0; e < 3; e++)
+			{
+				if (next[e] != p && next[e] != q)
+				{
+					strips.push_back(next[e]);
+					break;
+				}
+			}
+			isUsed[neighbour] = 1;
+			numStripTriangles++;
+		}
+	}
+
+	return numStripTriangles;
+}
@@ -0,0 +1,249 @@
+#include <iostream>
+#include <cstring>
+#include <utility>
+
+#include "common/indirectDrawList.h"
+#include "common/resourceTracker.h"
+#include "shader.h"
+
+const int IndirectDrawList::OBJECT_BUFFER_BINDING        = 3;
+const int IndirectDrawList::COMMAND_BUFFER_BINDING       = 4;
+const int IndirectDrawList::OBJECT_INDEX_ATTRIBUTE_INDEX = 3;
+
+namespace {
+
+// Must match local_size_x of shaderfiles/cull_objects.comp
+const int CULL_WORK_GROUP_SIZE = 64;
+
+} // namespace
+
+void IndirectDrawList::createDrawList(const GeometryPool& pool, int maxObjects, bool useComputeCulling)
+{
+	if (_isCreated)
+	{
+		std::cout << "This draw list is already created! You need to delete it before re-creating it!" << std::endl;
+		return;
+	}
+
+	_pool = &pool;
+	_maxObjects = maxObjects;
+	_useComputeCulling = useComputeCulling;
+	_objects.reserve(maxObjects);
+	_localBounds.reserve(maxObjects);
+
+	_objectBuffer = GLBuffer::create();
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, _objectBuffer.get());
+	glBufferData(GL_SHADER_STORAGE_BUFFER, maxObjects * sizeof(ObjectData), nullptr, GL_DYNAMIC_DRAW);
+	TRACK_RESOURCE(BUFFER, _objectBuffer.get(), maxObjects * sizeof(ObjectData), "indirect draws");
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	_commandBuffer = GLBuffer::create();
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _commandBuffer.get());
+	glBufferData(GL_DRAW_INDIRECT_BUFFER, maxObjects * sizeof(DrawElementsIndirectCommand), nullptr, GL_DYNAMIC_DRAW);
+	TRACK_RESOURCE(BUFFER, _commandBuffer.get(), maxObjects * sizeof(DrawElementsIndirectCommand), "indirect draws");
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+	// Instance i of a command reads element baseInstance + i, so with one instance it is the object index
+	std::vector<GLuint> objectIndices(maxObjects);
+	for (auto i = 0; i < maxObjects; i++) {
+		objectIndices[i] = i;
+	}
+
+	glBindVertexArray(pool.getVAO());
+	_objectIndexBuffer = GLBuffer::create();
+	glBindBuffer(GL_ARRAY_BUFFER, _objectIndexBuffer.get());
+	glBufferData(GL_ARRAY_BUFFER, objectIndices.size() * sizeof(GLuint), objectIndices.data(), GL_STATIC_DRAW);
+	TRACK_RESOURCE(BUFFER, _objectIndexBuffer.get(), objectIndices.size() * sizeof(GLuint), "indirect draws");
+	glEnableVertexAttribArray(OBJECT_INDEX_ATTRIBUTE_INDEX);
+	glVertexAttribIPointer(OBJECT_INDEX_ATTRIBUTE_INDEX, 1, GL_UNSIGNED_INT, sizeof(GLuint), (void*)0);
+	glVertexAttribDivisor(OBJECT_INDEX_ATTRIBUTE_INDEX, 1);
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	if (_useComputeCulling) {
+		Shader cullShader("shaderfiles/cull_objects.comp");
+		_cullProgram = std::move(cullShader.program);
+	}
+
+	_isCreated = true;
+}
+
+int IndirectDrawList::addBatch()
+{
+	Batch batch;
+	batch.firstObject = static_cast<int>(_objects.size());
+	batch.numObjects = 0;
+	_batches.push_back(batch);
+
+	return static_cast<int>(_batches.size()) - 1;
+}
+
+int IndirectDrawList::addObject(int meshIndex, const BoundingVolume& localBounds, const glm::mat4& model, float shininess, int materialLayer)
+{
+	if (!_isCreated || _batches.empty())
+	{
+		std::cout << "Create the draw list and add a batch before adding objects to it!" << std::endl;
+		return -1;
+	}
+
+	if (static_cast<int>(_objects.size()) >= _maxObjects)
+	{
+		std::cout << "This draw list is full, it can hold only " << _maxObjects << " objects!" << std::endl;
+		return -1;
+	}
+
+	const auto& meshRange = _pool->getMeshRange(meshIndex);
+	ObjectData object;
+	object.shininess = shininess;
+	object.indexCount = meshRange.indexCount;
+	object.firstIndex = meshRange.firstIndex;
+	object.baseVertex = meshRange.baseVertex;
+	object.materialLayer = static_cast<float>(materialLayer);
+	object.padding[0] = object.padding[1] = object.padding[2] = 0.0f;
+	_objects.push_back(object);
+	_localBounds.push_back(localBounds);
+	_batches.back().numObjects++;
+
+	const auto objectIndex = static_cast<int>(_objects.size()) - 1;
+	setObjectTransform(objectIndex, model);
+	return objectIndex;
+}
+
+void IndirectDrawList::setObjectTransform(int objectIndex, const glm::mat4& model)
+{
+	auto& object = _objects[objectIndex];
+	object.model = model;
+	object.normalMatrix = glm::mat4(glm::transpose(glm::inverse(glm::mat3(model))));
+	updateWorldBounds(objectIndex);
+	_areObjectsDirty = true;
+}
+
+void IndirectDrawList::updateWorldBounds(int objectIndex)
+{
+	auto& object = _objects[objectIndex];
+	const auto worldBounds = _localBounds[objectIndex].transformed(object.model);
+	object.sphere = glm::vec4(worldBounds.sphereCenter, worldBounds.sphereRadius);
+	object.boxCenter = glm::vec4((worldBounds.aabbMin + worldBounds.aabbMax) * 0.5f, 0.0f);
+	object.boxExtents = glm::vec4((worldBounds.aabbMax - worldBounds.aabbMin) * 0.5f, 0.0f);
+}
+
+void IndirectDrawList::cull(const glm::mat4& viewProjection)
+{
+	if (!_isCreated) {
+		return;
+	}
+
+	if (_areObjectsDirty)
+	{
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, _objectBuffer.get());
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, _objects.size() * sizeof(ObjectData), _objects.data());
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		_areObjectsDirty = false;
+	}
+
+	if (!_useComputeCulling)
+	{
+		buildCommandsOnCPU(viewProjection, _cpuCommands);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _commandBuffer.get());
+		glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, _cpuCommands.size() * sizeof(DrawElementsIndirectCommand), _cpuCommands.data());
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+		return;
+	}
+
+	// Planes are extracted on the CPU once per frame, the compute shader only tests them
+	_cpuCuller.setViewProjection(viewProjection);
+	glm::vec4 planes[6];
+	for (auto i = 0; i < 6; i++) {
+		planes[i] = _cpuCuller.getPlane(i);
+	}
+
+	const auto numObjects = static_cast<GLuint>(_objects.size());
+	glUseProgram(_cullProgram.get());
+	glUniform4fv(glGetUniformLocation(_cullProgram.get(), "frustumPlanes"), 6, &planes[0][0]);
+	glUniform1ui(glGetUniformLocation(_cullProgram.get(), "numObjects"), numObjects);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, OBJECT_BUFFER_BINDING, _objectBuffer.get());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COMMAND_BUFFER_BINDING, _commandBuffer.get());
+	glDispatchCompute((numObjects + CULL_WORK_GROUP_SIZE - 1) / CULL_WORK_GROUP_SIZE, 1, 1);
+
+	// Commands are consumed as indirect draw parameters, reads back go through buffer updates
+	glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+}
+
+void IndirectDrawList::drawBatch(int batchIndex) const
+{
+	const auto& batch = _batches[batchIndex];
+	if (batch.numObjects == 0) {
+		return;
+	}
+
+	glBindVertexArray(_pool->getVAO());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, OBJECT_BUFFER_BINDING, _objectBuffer.get());
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _commandBuffer.get());
+	glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+		(void*)(batch.firstObject * sizeof(DrawElementsIndirectCommand)), batch.numObjects, 0);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void IndirectDrawList::buildCommandsOnCPU(const glm::mat4& viewProjection, std::vector<DrawElementsIndirectCommand>& commands)
+{
+	_cpuCuller.setViewProjection(viewProjection);
+	_cpuCuller.clear();
+	for (const auto& object : _objects)
+	{
+		BoundingVolume worldBounds;
+		worldBounds.sphereCenter = glm::vec3(object.sphere);
+		worldBounds.sphereRadius = object.sphere.w;
+		worldBounds.aabbMin = glm::vec3(object.boxCenter - object.boxExtents);
+		worldBounds.aabbMax = glm::vec3(object.boxCenter + object.boxExtents);
+		_cpuCuller.addObject(worldBounds);
+	}
+	_cpuCuller.cull();
+
+	commands.resize(_objects.size());
+	for (size_t i = 0; i < _objects.size(); i++)
+	{
+		auto& command = commands[i];
+		command.count = _objects[i].indexCount;
+		command.instanceCount = _cpuCuller.isVisible(static_cast<int>(i)) ? 1 : 0;
+		command.firstIndex = _objects[i].firstIndex;
+		command.baseVertex = _objects[i].baseVertex;
+		command.baseInstance = static_cast<GLuint>(i);
+	}
+}
+
+void IndirectDrawList::readBackCommands(std::vector<DrawElementsIndirectCommand>& commands) const
+{
+	commands.resize(_objects.size());
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _commandBuffer.get());
+	glGetBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, commands.size() * sizeof(DrawElementsIndirectCommand), commands.data());
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+bool IndirectDrawList::isUsingComputeCulling() const
+{
+	return _useComputeCulling;
+}
+
+int IndirectDrawList::getNumObjects() const
+{
+	return static_cast<int>(_objects.size());
+}
+
+void IndirectDrawList::deleteDrawList()
+{
+	if (!_isCreated) {
+		return;
+	}
+
+	_objectBuffer.reset();
+	_commandBuffer.reset();
+	_objectIndexBuffer.reset();
+	_cullProgram.reset();
+
+	_objects.clear();
+	_localBounds.clear();
+	_batches.clear();
+	_cpuCommands.clear();
+	_pool = nullptr;
+	_isCreated = false;
+}
@@ -0,0 +1,159 @@
+#include <iostream>
+#include <algorithm>
+#include <cstddef>
+
+#include "common/instanceBuffer.h"
+#include "common/resourceTracker.h"
+
+const int InstanceBuffer::MODEL_MATRIX_ATTRIBUTE_INDEX  = 3;
+const int InstanceBuffer::NORMAL_MATRIX_ATTRIBUTE_INDEX = 7;
+
+namespace {
+
+// Runs of changed instances closer than this are uploaded together, fewer calls beat fewer bytes
+const int MERGE_GAP_INSTANCES = 16;
+
+} // namespace
+
+void InstanceBuffer::createInstanceBuffer(int maxInstances)
+{
+	if (_isBufferCreated)
+	{
+		std::cout << "This instance buffer is already created! You need to delete it before re-creating it!" << std::endl;
+		return;
+	}
+
+	_instances.assign(maxInstances, InstanceData{ glm::mat4(1.0f), glm::mat3(1.0f) });
+	_isInstanceDirty.assign(maxInstances, false);
+	_numDirtyInstances = 0;
+	_instanceCount = 0;
+
+	_buffer = GLBuffer::create();
+	glBindBuffer(GL_ARRAY_BUFFER, _buffer.get());
+	glBufferData(GL_ARRAY_BUFFER, _instances.size() * sizeof(InstanceData), _instances.data(), GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	// The instance array stays on the CPU, dirty instances are copied from it
+	TRACK_RESOURCE(BUFFER, _buffer.get(), _instances.size() * sizeof(InstanceData), "instances");
+	ResourceTracker::get().setHostBytes(ResourceTracker::BUFFER, _buffer.get(), _instances.size() * sizeof(InstanceData));
+
+	_isBufferCreated = true;
+}
+
+void InstanceBuffer::setInstance(int index, const glm::mat4& model)
+{
+	if (index < 0 || index >= static_cast<int>(_instances.size()))
+	{
+		std::cout << "Instance index " << index << " is out of range of the instance buffer!" << std::endl;
+		return;
+	}
+
+	auto& instance = _instances[index];
+	instance.modelMatrix = model;
+	instance.normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+
+	if (!_isInstanceDirty[index])
+	{
+		_isInstanceDirty[index] = true;
+		_numDirtyInstances++;
+	}
+}
+
+void InstanceBuffer::setInstanceCount(int numInstances)
+{
+	_instanceCount = std::min(std::max(numInstances, 0), static_cast<int>(_instances.size()));
+}
+
+int InstanceBuffer::getInstanceCount() const
+{
+	return _instanceCount;
+}
+
+size_t InstanceBuffer::updateGPU()
+{
+	if (!_isBufferCreated || _numDirtyInstances == 0) {
+		return 0;
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, _buffer.get());
+
+	size_t bytesUploaded = 0;
+	const auto numInstances = static_cast<int>(_instances.size());
+	auto index = 0;
+	while (index < numInstances)
+	{
+		if (!_isInstanceDirty[index])
+		{
+			index++;
+			continue;
+		}
+
+		// Extend the run while the next changed instance is close enough
+		auto runBegin = index;
+		auto runEnd = index + 1;
+		for (auto next = runEnd; next < numInstances && next - runEnd < MERGE_GAP_INSTANCES; next++)
+		{
+			if (_isInstanceDirty[next]) {
+				runEnd = next + 1;
+			}
+		}
+
+		const auto runSizeBytes = (runEnd - runBegin) * sizeof(InstanceData);
+		glBufferSubData(GL_ARRAY_BUFFER, runBegin * sizeof(InstanceData), runSizeBytes, &_instances[runBegin]);
+		bytesUploaded += runSizeBytes;
+
+		for (auto i = runBegin; i < runEnd; i++) {
+			_isInstanceDirty[i] = false;
+		}
+		index = runEnd;
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	_numDirtyInstances = 0;
+	return bytesUploaded;
+}
+
+void InstanceBuffer::setVertexAttributesPointers() const
+{
+	if (!_isBufferCreated)
+	{
+		std::cout << "This instance buffer is not created yet! Call createInstanceBuffer before rendering with it!" << std::endl;
+		return;
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, _buffer.get());
+
+	// Matrices are passed column by column, every column is a separate attribute advancing once per instance
+	for (auto column = 0; column < 4; column++)
+	{
+		const auto index = MODEL_MATRIX_ATTRIBUTE_INDEX + column;
+		const auto offset = offsetof(InstanceData, modelMatrix) + column * sizeof(glm::vec4);
+		glEnableVertexAttribArray(index);
+		glVertexAttribPointer(index, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), reinterpret_cast<void*>(offset));
+		glVertexAttribDivisor(index, 1);
+	}
+
+	for (auto column = 0; column < 3; column++)
+	{
+		const auto index = NORMAL_MATRIX_ATTRIBUTE_INDEX + column;
+		const auto offset = offsetof(InstanceData, normalMatrix) + column * sizeof(glm::vec3);
+		glEnableVertexAttribArray(index);
+		glVertexAttribPointer(index, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData), reinterpret_cast<void*>(offset));
+		glVertexAttribDivisor(index, 1);
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstanceBuffer::deleteInstanceBuffer()
+{
+	if (!_isBufferCreated) {
+		return;
+	}
+
+	_buffer.reset();
+	_instances.clear();
+	_isInstanceDirty.clear();
+	_numDirtyInstances = 0;
+	_instanceCount = 0;
+	_isBufferCreated = false;
+}
@@ -0,0 +1,203 @@
+// STL
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+// GLM
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "common/frameBenchmark.h"
+#include "common/geometryHeap.h"
+#include "common/glHandle.h"
+#include "common/instanceBuffer.h"
+#include "common/layoutBenchmark.h"
+#include "cube.h"
+#include "cylinder.h"
+#include "shader.h"
+
+namespace layout_benchmark {
+
+const int CYLINDER_SLICES    = 20000;
+const int CYLINDER_INSTANCES = 16;
+const int CUBE_INSTANCES     = 32768;
+const int HEAP_FILLER_MESHES = 64;
+
+} // namespace layout_benchmark
+
+namespace {
+
+using static_meshes_3D::StaticMesh3D;
+using static_meshes_3D::VertexLayout;
+
+/** \brief Fills instance buffer with a square grid of small instances covering the view.
+*   \param instances Instance buffer to fill
+*   \param numInstances Number of instances
+*   \param size Size of every instance in the [-1, 1] view
+*/
+void fillGrid(InstanceBuffer& instances, int numInstances, float size)
+{
+	const auto columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(numInstances))));
+	const auto spacing = 2.0f / columns;
+	for (auto i = 0; i < numInstances; i++)
+	{
+		const auto x = -1.0f + spacing * (i % columns + 0.5f);
+		const auto y = -1.0f + spacing * (i / columns + 0.5f);
+		auto model = glm::translate(glm::mat4(1.0f), glm::vec3(x, y, 0.0f));
+		model = glm::rotate(model, glm::radians(30.0f), glm::vec3(1.0f, 1.0f, 0.0f));
+		instances.setInstance(i, glm::scale(model, glm::vec3(size)));
+	}
+	instances.setInstanceCount(numInstances);
+	instances.updateGPU();
+}
+
+/** \brief Median GPU time of the measured frames.
+*   \param benchmark Finished frame benchmark
+*   \return Median in milliseconds.
+*/
+double medianGpuTime(const FrameBenchmark& benchmark)
+{
+	auto times = benchmark.getGpuTimes();
+	if (times.empty()) {
+		return 0.0;
+	}
+	std::sort(times.begin(), times.end());
+	return times[times.size() / 2];
+}
+
+} // namespace
+
+namespace layout_benchmark {
+
+int run(int numFrames, int width, int height, std::ostream& out)
+{
+	struct Layout
+	{
+		const char* name;
+		VertexLayout layout;
+		bool isInHeap;
+	};
+	const Layout layouts[] = {
+		{ "planar", VertexLayout::PLANAR, false },
+		{ "interleaved", VertexLayout::INTERLEAVED, false },
+		{ "split positions", VertexLayout::SPLIT_POSITIONS, false },
+		{ "planar, heap", VertexLayout::PLANAR, true },
+		{ "interleaved, heap", VertexLayout::INTERLEAVED, true },
+	};
+
+	Shader shadingShader("shaderfiles/layout_benchmark.vs", "shaderfiles/layout_benchmark.fs");
+	Shader depthShader("shaderfiles/layout_benchmark_depth.vs", "shaderfiles/layout_benchmark_depth.fs");
+	const auto viewProjection = glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f);
+
+	InstanceBuffer cylinderInstances, cubeInstances;
+	cylinderInstances.createInstanceBuffer(CYLINDER_INSTANCES);
+	cubeInstances.createInstanceBuffer(CUBE_INSTANCES);
+	fillGrid(cylinderInstances, CYLINDER_INSTANCES, 0.2f);
+	fillGrid(cubeInstances, CUBE_INSTANCES, 0.005f);
+
+	const auto flags = out.flags();
+	const auto precision = out.precision();
+
+	out << std::fixed << std::setprecision(2);
+	out << "Vertex layouts, " << CYLINDER_INSTANCES << " cylinders with " << CYLINDER_SLICES << " slices and " << CUBE_INSTANCES
+		<< " cubes per frame, median GPU time of " << numFrames << " frames (ms):" << std::endl;
+	out << "  layout                all attributes   depth only" << std::endl;
+
+	auto result = 0;
+	std::vector<unsigned char> referencePixels, pixels(static_cast<size_t>(width) * height * 4);
+	std::ostringstream heapReport;
+	for (const auto& layout : layouts)
+	{
+		// Small meshes around the measured ones leave holes in the heap, which defragment has to close
+		GeometryHeap heap;
+		std::vector<std::unique_ptr<static_meshes_3D::Cube>> fillers;
+		if (layout.isInHeap)
+		{
+			heap.createHeap();
+			StaticMesh3D::setGeometryHeap(&heap);
+			for (auto i = 0; i < HEAP_FILLER_MESHES; i++) {
+				fillers.emplace_back(new static_meshes_3D::Cube(glm::vec4(1.0f), true, true, true, layout.layout));
+			}
+			for (auto i = 0; i < HEAP_FILLER_MESHES; i += 2) {
+				fillers[i]->deleteMesh();
+			}
+		}
+
+		static_meshes_3D::Cylinder cylinder(1.0f, CYLINDER_SLICES, 2.0f, true, true, true, layout.layout);
+		static_meshes_3D::Cube cube(glm::vec4(1.0f), true, true, true, layout.layout);
+
+		if (layout.isInHeap)
+		{
+			StaticMesh3D::setGeometryHeap(nullptr);
+			heap.printStats((std::string(layout.name) + ", fragmented").c_str(), heapReport);
+			fillers.clear();
+			heap.defragment();
+			heap.printStats((std::string(layout.name) + ", defragmented").c_str(), heapReport);
+		}
+
+		const auto measurePass = [&](Shader& shader, bool isDepthOnly)
+		{
+			glColorMask(!isDepthOnly, !isDepthOnly, !isDepthOnly, !isDepthOnly);
+			shader.use();
+			shader.setMat4("viewProjection", viewProjection);
+
+			FrameBenchmark benchmark;
+			benchmark.create(numFrames);
+			for (auto frame = 0; frame < numFrames; frame++)
+			{
+				benchmark.beginFrame();
+				glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+				cylinder.renderInstanced(cylinderInstances);
+				cube.renderInstanced(cubeInstances);
+				benchmark.endFrame();
+			}
+			benchmark.finish();
+			glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+			const auto milliseconds = medianGpuTime(benchmark);
+			benchmark.deleteBenchmark();
+			return milliseconds;
+		};
+
+		const auto shadingMilliseconds = measurePass(shadingShader, false);
+		glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+		const auto depthMilliseconds = measurePass(depthShader, true);
+
+		if (referencePixels.empty()) {
+			referencePixels = pixels;
+		}
+		const auto isMatching = pixels == referencePixels;
+		if (!isMatching) {
+			result = 1;
+		}
+
+		out << "  " << std::left << std::setw(20) << layout.name << std::right
+			<< std::setw(16) << shadingMilliseconds
+			<< std::setw(13) << depthMilliseconds
+			<< (isMatching ? "" : "  MISMATCH") << std::endl;
+
+		cylinder.deleteMesh();
+		cube.deleteMesh();
+		heap.deleteHeap();
+		GLDeletionQueue::get().endFrame();
+	}
+	out << heapReport.str();
+
+	out.flags(flags);
+	out.precision(precision);
+
+	glBindVertexArray(0);
+	cylinderInstances.deleteInstanceBuffer();
+	cubeInstances.deleteInstanceBuffer();
+	shadingShader.deleteProgram();
+	depthShader.deleteProgram();
+	return result;
+}
+
+} // namespace layout_benchmark
@@ -0,0 +1,381 @@
+// STL
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+// GLM
+#include <glm/glm.hpp>
+
+#include "common/frustumCuller.h"
+#include "common/lodMesh.h"
+#include "common/meshOptimizer.h"
+#include "common/meshSimplifier.h"
+#include "common/objloader.hpp"
+#include "common/resourceTracker.h"
+#include "vboindexer.hpp"
+
+const std::vector<float> LodMesh::DEFAULT_LOD_RATIOS       = { 1.0f, 0.5f, 0.25f, 0.125f, 0.0625f };
+const float              LodMesh::MAX_LOD_PIXEL_ERROR      = 0.5f;
+const float              LodMesh::LOD_HYSTERESIS           = 0.8f;
+const float              LodMesh::MAX_SIMPLIFICATION_ERROR = 0.1f;
+
+namespace {
+
+const int FLOATS_PER_VERTEX = 8;
+
+} // namespace
+
+bool LodMesh::loadOBJ(const char* path)
+{
+	std::vector<glm::vec3> objVertices, objNormals;
+	std::vector<glm::vec2> objUVs;
+	if (!::loadOBJ(path, objVertices, objUVs, objNormals) || objVertices.empty())
+	{
+		std::cout << "Failed to load mesh from " << path << "!" << std::endl;
+		return false;
+	}
+
+	// indexVBO welds into 16-bit indices
+	std::vector<unsigned short> weldedIndices;
+	std::vector<glm::vec3> positions, normals;
+	std::vector<glm::vec2> uvs;
+	indexVBO(objVertices, objUVs, objNormals, weldedIndices, positions, uvs, normals);
+	if (positions.size() > IndexBufferBuilder::MAX_SHORT_VERTICES)
+	{
+		std::cout << "Mesh " << path << " has more than " << IndexBufferBuilder::MAX_SHORT_VERTICES << " different vertices!" << std::endl;
+		return false;
+	}
+
+	_name = path;
+	_vertices.resize(positions.size() * FLOATS_PER_VERTEX);
+	for (size_t i = 0; i < positions.size(); i++)
+	{
+		float* vertex = _vertices.data() + i * FLOATS_PER_VERTEX;
+		vertex[0] = positions[i].x;
+		vertex[1] = positions[i].y;
+		vertex[2] = positions[i].z;
+		vertex[3] = normals[i].x;
+		vertex[4] = normals[i].y;
+		vertex[5] = normals[i].z;
+		vertex[6] = uvs[i].x;
+		vertex[7] = uvs[i].y;
+	}
+	_indices.assign(weldedIndices.begin(), weldedIndices.end());
+	_bounds = BoundingVolume::fromPositions(_vertices.data(), positions.size(), FLOATS_PER_VERTEX * sizeof(float));
+
+	generateLods(std::vector<float>(1, 1.0f));
+	return true;
+}
+
+void LodMesh::generateLods(const std::vector<float>& ratios)
+{
+	if (_isUploaded)
+	{
+		std::cout << "This mesh is already uploaded! You cannot generate its levels anymore!" << std::endl;
+		return;
+	}
+
+	_indexBuffer = IndexBufferBuilder();
+	_levels.clear();
+	_meshlets.clear();
+
+	// Every level is simplified from the previous one, so their errors add up
+	const size_t numVertices = _vertices.size() / FLOATS_PER_VERTEX;
+	const size_t numTriangles = _indices.size() / 3;
+	std::vector<GLuint> levelIndices(_indices), simplified, meshletIndices;
+	const float maxError = MAX_SIMPLIFICATION_ERROR * _bounds.sphereRadius;
+	float error = 0.0f;
+	for (auto ratio : ratios)
+	{
+		if (!_levels.empty())
+		{
+			const size_t targetIndexCount = static_cast<size_t>(ratio * numTriangles) * 3;
+			if (targetIndexCount >= levelIndices.size()) {
+				continue;
+			}
+			error += mesh_simplifier::simplify(levelIndices.data(), levelIndices.size(), _vertices.data(), FLOATS_PER_VERTEX,
+				numVertices, targetIndexCount, maxError - error, simplified);
+			if (simplified.empty() || simplified.size() >= levelIndices.size()) {
+				break;
+			}
+			levelIndices.swap(simplified);
+			mesh_optimizer::optimizeVertexCache(levelIndices.data(), levelIndices.size(), numVertices);
+		}
+
+		// Meshlets drop degenerate triangles, so the index buffer keeps all of theirs and the offsets hold
+		const size_t firstMeshlet = _meshlets.size();
+		meshletIndices.clear();
+		meshlet_builder::buildMeshlets(levelIndices.data(), levelIndices.size(), _vertices.data(), FLOATS_PER_VERTEX,
+			numVertices, _meshlets, meshletIndices);
+		const auto range = _indexBuffer.addTriangles(meshletIndices.data(), meshletIndices.size());
+		for (size_t i = firstMeshlet; i < _meshlets.size(); i++) {
+			_meshlets[i].firstIndex += range.first;
+		}
+
+		Level level;
+		level.firstIndex = range.first;
+		level.indexCount = range.count;
+		level.triangleCount = range.numTriangles;
+		level.error = error;
+		level.firstMeshlet = firstMeshlet;
+		level.meshletCount = _meshlets.size() - firstMeshlet;
+		_levels.push_back(level);
+	}
+
+	_indexBuffer.finish();
+	_indexType = _indexBuffer.getIndexType();
+}
+
+void LodMesh::generateLods(std::vector<LodMesh>& meshes, const std::vector<float>& ratios, int numThreads)
+{
+	if (numThreads <= 0) {
+		numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	}
+	numThreads = std::min(numThreads, static_cast<int>(meshes.size()));
+
+	// Meshes differ a lot in size, so every thread takes the next mesh once it is done with one
+	std::atomic<size_t> nextMesh(0);
+	const auto job = [&]()
+	{
+		for (size_t i = nextMesh++; i < meshes.size(); i = nextMesh++) {
+			meshes[i].generateLods(ratios);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (int i = 1; i < numThreads; i++) {
+		threads.emplace_back(job);
+	}
+	job();
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
+
+void LodMesh::uploadToGPU()
+{
+	if (_isUploaded)
+	{
+		std::cout << "This mesh is already uploaded!" << std::endl;
+		return;
+	}
+
+	const auto setupAttributes = []()
+	{
+		const auto stride = FLOATS_PER_VERTEX * sizeof(float);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
+		glEnableVertexAttribArray(2);
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float)));
+	};
+
+	_vao = GLVertexArray::create();
+	glBindVertexArray(_vao.get());
+
+	_vertexBuffer = GLBuffer::create();
+	glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer.get());
+	glBufferData(GL_ARRAY_BUFFER, _vertices.size() * sizeof(float), _vertices.data(), GL_STATIC_DRAW);
+	TRACK_RESOURCE(BUFFER, _vertexBuffer.get(), _vertices.size() * sizeof(float), "lod meshes");
+
+	_elementBuffer = GLBuffer::create();
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _elementBuffer.get());
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer.getByteSize(), _indexBuffer.getData(), GL_STATIC_DRAW);
+	TRACK_RESOURCE(BUFFER, _elementBuffer.get(), _indexBuffer.getByteSize(), "lod meshes");
+	setupAttributes();
+
+	// Same vertices, but the indices of the meshlets that passed cullClusters
+	_clusterVAO = GLVertexArray::create();
+	glBindVertexArray(_clusterVAO.get());
+	_clusterIndices.createStreamBuffer(_indexBuffer.getByteSize());
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _clusterIndices.getBufferID());
+	setupAttributes();
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// Data live on the GPU now, only the levels and the packed indices for cullClusters are needed
+	const auto* packed = static_cast<const unsigned char*>(_indexBuffer.getData());
+	_packedIndices.assign(packed, packed + _indexBuffer.getByteSize());
+	std::vector<float>().swap(_vertices);
+	std::vector<GLuint>().swap(_indices);
+	_indexBuffer = IndexBufferBuilder();
+
+	_isUploaded = true;
+}
+
+GLsizei LodMesh::cullClusters(int lod, const glm::mat4& model, const glm::mat4& viewProjection, const glm::vec3& cameraPosition)
+{
+	_clusterStats = ClusterStats();
+	_clusterFirstIndex = 0;
+	if (!_isUploaded) {
+		return 0;
+	}
+
+	// Meshlets stay in model space, the frustum and the camera are moved there instead
+	FrustumCuller frustum;
+	frustum.setViewProjection(viewProjection * model);
+	glm::vec4 planes[6];
+	for (int i = 0; i < 6; i++) {
+		planes[i] = frustum.getPlane(i);
+	}
+	const glm::vec3 modelCameraPosition = glm::vec3(glm::inverse(model) * glm::vec4(cameraPosition, 1.0f));
+
+	const size_t indexSize = _indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+	const Level& level = _levels[lod];
+	_visibleMeshlets.clear();
+	for (size_t i = level.firstMeshlet; i < level.firstMeshlet + level.meshletCount; i++)
+	{
+		const Meshlet& meshlet = _meshlets[i];
+		const auto visibility = meshlet_builder::testMeshlet(meshlet, planes, modelCameraPosition);
+		if (visibility == meshlet_builder::Visibility::OUTSIDE_FRUSTUM)
+		{
+			_clusterStats.outsideFrustum++;
+			continue;
+		}
+		if (visibility == meshlet_builder::Visibility::BACK_FACING)
+		{
+			_clusterStats.backFacing++;
+			continue;
+		}
+
+		_visibleMeshlets.push_back(i);
+		_clusterStats.visible++;
+		_clusterStats.triangleCount += meshlet.triangleCount;
+	}
+
+	if (_visibleMeshlets.empty()) {
+		return 0;
+	}
+
+	// Indices are copied straight into a range of the stream buffer that the GPU doesn't read anymore,
+	// a region holds all levels, so it is reused only after several frames
+	size_t offset = 0;
+	auto* ptrIndices = static_cast<unsigned char*>(_clusterIndices.map(_clusterStats.triangleCount * 3 * indexSize, indexSize, offset));
+	if (ptrIndices == nullptr) {
+		return 0;
+	}
+	for (const auto i : _visibleMeshlets)
+	{
+		const Meshlet& meshlet = _meshlets[i];
+		const auto meshletBytes = meshlet.triangleCount * 3 * indexSize;
+		memcpy(ptrIndices, _packedIndices.data() + meshlet.firstIndex * indexSize, meshletBytes);
+		ptrIndices += meshletBytes;
+	}
+	_clusterIndices.unmap();
+	_clusterFirstIndex = static_cast<GLsizei>(offset / indexSize);
+
+	return _clusterStats.triangleCount * 3;
+}
+
+float LodMesh::getScreenSpaceError(int lod, float projectedRadius) const
+{
+	return projectedRadius * _levels[lod].error / std::max(_bounds.sphereRadius, 1e-6f);
+}
+
+int LodMesh::selectLod(float projectedRadius, int currentLod) const
+{
+	int lod = getLodCount() - 1;
+	while (lod > 0 && getScreenSpaceError(lod, projectedRadius) > MAX_LOD_PIXEL_ERROR) {
+		lod--;
+	}
+
+	// Going coarser needs a clear margin, going finer happens right away
+	while (lod > currentLod && getScreenSpaceError(lod, projectedRadius) > MAX_LOD_PIXEL_ERROR * LOD_HYSTERESIS) {
+		lod--;
+	}
+	return lod;
+}
+
+void LodMesh::printStats(std::ostream& os) const
+{
+	const auto flags = os.flags();
+	const auto precision = os.precision();
+
+	os << "LOD mesh (" << _name << "):";
+	for (size_t i = 0; i < _levels.size(); i++)
+	{
+		os << (i == 0 ? " " : ", ") << _levels[i].triangleCount << " triangles in " << _levels[i].meshletCount << " meshlets";
+		if (i > 0) {
+			os << " (error " << std::scientific << std::setprecision(1) << _levels[i].error << ")";
+		}
+	}
+	os << std::endl;
+
+	os.flags(flags);
+	os.precision(precision);
+}
+
+const std::string& LodMesh::getName() const
+{
+	return _name;
+}
+
+const BoundingVolume& LodMesh::getBounds() const
+{
+	return _bounds;
+}
+
+const LodMesh::Level& LodMesh::getLevel(int lod) const
+{
+	return _levels[lod];
+}
+
+int LodMesh::getLodCount() const
+{
+	return static_cast<int>(_levels.size());
+}
+
+GLenum LodMesh::getIndexType() const
+{
+	return _indexType;
+}
+
+GLuint LodMesh::getVAO() const
+{
+	return _vao.get();
+}
+
+GLuint LodMesh::getClusterVAO() const
+{
+	return _clusterVAO.get();
+}
+
+GLsizei LodMesh::getClusterFirstIndex() const
+{
+	return _clusterFirstIndex;
+}
+
+const StreamBuffer& LodMesh::getClusterIndexStream() const
+{
+	return _clusterIndices;
+}
+
+const LodMesh::ClusterStats& LodMesh::getClusterStats() const
+{
+	return _clusterStats;
+}
+
+void LodMesh::deleteMesh()
+{
+	if (_isUploaded)
+	{
+		_vao.reset();
+		_vertexBuffer.reset();
+		_elementBuffer.reset();
+		_clusterVAO.reset();
+		_clusterIndices.deleteStreamBuffer();
+		_isUploaded = false;
+	}
+
+	_vertices.clear();
+	_indices.clear();
+	_levels.clear();
+	_meshlets.clear();
+	_packedIndices.clear();
+	_visibleMeshlets.clear();
+}
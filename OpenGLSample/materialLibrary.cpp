@@ -0,0 +1,196 @@
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+
+#include "common/materialLibrary.h"
+#include "common/resourceTracker.h"
+#include "stb_image.h"
+
+const int MaterialLibrary::DIFFUSE_TEXTURE_UNIT  = 0;
+const int MaterialLibrary::SPECULAR_TEXTURE_UNIT = 1;
+
+namespace {
+
+// All layers are stored as RGBA, whatever the source image has
+const int CHANNELS = 4;
+
+//* \brief Decoded image, empty pixels when loading failed.
+struct Image
+{
+	int width = 0;
+	int height = 0;
+	std::vector<unsigned char> pixels;
+};
+
+Image loadImage(const std::string& path)
+{
+	Image image;
+	int components;
+	unsigned char* data = stbi_load(path.c_str(), &image.width, &image.height, &components, CHANNELS);
+	if (data == nullptr)
+	{
+		std::cout << "Texture failed to load at path: " << path << std::endl;
+		image.width = image.height = 0;
+		return image;
+	}
+
+	image.pixels.assign(data, data + image.width * image.height * CHANNELS);
+	stbi_image_free(data);
+	return image;
+}
+
+// Bilinear resampling with texel centers aligned, good enough for the small scale factors between maps
+std::vector<unsigned char> resample(const Image& image, int width, int height)
+{
+	if (image.width == width && image.height == height) {
+		return image.pixels;
+	}
+
+	std::vector<unsigned char> result(width * height * CHANNELS);
+	const auto scaleX = float(image.width) / float(width);
+	const auto scaleY = float(image.height) / float(height);
+	for (auto y = 0; y < height; y++)
+	{
+		const auto sourceY = std::max((y + 0.5f) * scaleY - 0.5f, 0.0f);
+		const auto y0 = std::min(int(sourceY), image.height - 1);
+		const auto y1 = std::min(y0 + 1, image.height - 1);
+		const auto fy = sourceY - float(y0);
+
+		for (auto x = 0; x < width; x++)
+		{
+			const auto sourceX = std::max((x + 0.5f) * scaleX - 0.5f, 0.0f);
+			const auto x0 = std::min(int(sourceX), image.width - 1);
+			const auto x1 = std::min(x0 + 1, image.width - 1);
+			const auto fx = sourceX - float(x0);
+
+			const auto* p00 = &image.pixels[(y0 * image.width + x0) * CHANNELS];
+			const auto* p10 = &image.pixels[(y0 * image.width + x1) * CHANNELS];
+			const auto* p01 = &image.pixels[(y1 * image.width + x0) * CHANNELS];
+			const auto* p11 = &image.pixels[(y1 * image.width + x1) * CHANNELS];
+			auto* out = &result[(y * width + x) * CHANNELS];
+			for (auto c = 0; c < CHANNELS; c++)
+			{
+				const auto top = p00[c] + (p10[c] - p00[c]) * fx;
+				const auto bottom = p01[c] + (p11[c] - p01[c]) * fx;
+				out[c] = static_cast<unsigned char>(std::lround(top + (bottom - top) * fy));
+			}
+		}
+	}
+
+	return result;
+}
+
+GLTexture createTextureArray(const std::vector<Image>& images, int width, int height)
+{
+	auto texture = GLTexture::create();
+	glBindTexture(GL_TEXTURE_2D_ARRAY, texture.get());
+	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, static_cast<GLsizei>(images.size()), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+	const std::vector<unsigned char> black(width * height * CHANNELS, 0);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	for (size_t layer = 0; layer < images.size(); layer++)
+	{
+		const auto& image = images[layer];
+		const auto pixels = image.pixels.empty() ? black : resample(image, width, height);
+		glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(layer), width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+	}
+	glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+	TRACK_RESOURCE(TEXTURE, texture.get(), ResourceTracker::getTextureBytes(width, height, static_cast<int>(images.size()), CHANNELS, true), "materials");
+
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+	return texture;
+}
+
+} // namespace
+
+int MaterialLibrary::addMaterial(const std::string& diffusePath, const std::string& specularPath)
+{
+	if (_isBuilt)
+	{
+		std::cout << "This material library is already built! You cannot add materials to it anymore!" << std::endl;
+		return -1;
+	}
+
+	_materials.push_back(MaterialPaths{ diffusePath, specularPath });
+	return static_cast<int>(_materials.size()) - 1;
+}
+
+bool MaterialLibrary::build(int width, int height)
+{
+	if (_isBuilt)
+	{
+		std::cout << "This material library is already built! You need to delete it before re-building it!" << std::endl;
+		return false;
+	}
+
+	if (_materials.empty()) {
+		return false;
+	}
+
+	// OpenGL expects the first row at the bottom
+	stbi_set_flip_vertically_on_load(true);
+
+	std::vector<Image> diffuseImages, specularImages;
+	auto allLoaded = true;
+	auto maxWidth = 1, maxHeight = 1;
+	for (const auto& material : _materials)
+	{
+		diffuseImages.push_back(loadImage(material.diffusePath));
+		specularImages.push_back(loadImage(material.specularPath));
+		for (const auto* image : { &diffuseImages.back(), &specularImages.back() })
+		{
+			allLoaded = allLoaded && !image->pixels.empty();
+			maxWidth = std::max(maxWidth, image->width);
+			maxHeight = std::max(maxHeight, image->height);
+		}
+	}
+
+	_width = width > 0 ? width : maxWidth;
+	_height = height > 0 ? height : maxHeight;
+	_diffuseArray = createTextureArray(diffuseImages, _width, _height);
+	_specularArray = createTextureArray(specularImages, _width, _height);
+
+	_isBuilt = true;
+	return allLoaded;
+}
+
+void MaterialLibrary::bind() const
+{
+	glActiveTexture(GL_TEXTURE0 + DIFFUSE_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, _diffuseArray.get());
+	glActiveTexture(GL_TEXTURE0 + SPECULAR_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, _specularArray.get());
+}
+
+int MaterialLibrary::getNumMaterials() const
+{
+	return static_cast<int>(_materials.size());
+}
+
+int MaterialLibrary::getWidth() const
+{
+	return _width;
+}
+
+int MaterialLibrary::getHeight() const
+{
+	return _height;
+}
+
+void MaterialLibrary::deleteLibrary()
+{
+	if (_isBuilt)
+	{
+		_diffuseArray.reset();
+		_specularArray.reset();
+		_isBuilt = false;
+	}
+
+	_materials.clear();
+	_width = _height = 0;
+}
@@ -0,0 +1,391 @@
+// STL
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+
+// GLM
+#include <glm/glm.hpp>
+
+#include "common/meshOptimizer.h"
+
+namespace mesh_optimizer {
+
+const int   FIFO_CACHE_SIZE    = 16;
+const float OVERDRAW_THRESHOLD = 1.05f;
+
+} // namespace mesh_optimizer
+
+namespace {
+
+/**
+  FIFO cache simulated with time stamps: a vertex is cached while fewer than cacheSize misses
+  happened since it was last transformed.
+*/
+class FifoCache
+{
+public:
+	FifoCache(size_t numVertices, int cacheSize)
+		: _timestamps(numVertices, 0)
+		, _cacheSize(static_cast<unsigned int>(cacheSize))
+		, _time(static_cast<unsigned int>(cacheSize) + 1) {}
+
+	//* \brief Looks vertex up, transforms it on a miss. \return True if it was a miss.
+	bool access(GLuint vertex)
+	{
+		if (_time - _timestamps[vertex] <= _cacheSize) {
+			return false;
+		}
+		_timestamps[vertex] = _time++;
+		return true;
+	}
+
+	//* \brief Forgets all cached vertices.
+	void flush()
+	{
+		_time += _cacheSize + 1;
+	}
+
+private:
+	std::vector<unsigned int> _timestamps; //!< Time every vertex was last transformed
+	unsigned int _cacheSize; //!< Number of entries
+	unsigned int _time; //!< Number of misses so far, plus offset
+};
+
+//* \brief Triangles using each vertex, in compressed rows.
+struct VertexTriangles
+{
+	std::vector<GLuint> offsets; //!< Triangles of vertex v are triangles[offsets[v]] .. triangles[offsets[v + 1] - 1]
+	std::vector<GLuint> triangles;
+
+	VertexTriangles(const GLuint* ptrIndices, size_t numIndices, size_t numVertices)
+		: offsets(numVertices + 1, 0)
+		, triangles(numIndices)
+	{
+		for (size_t i = 0; i < numIndices; i++) {
+			offsets[ptrIndices[i] + 1]++;
+		}
+		for (size_t v = 0; v < numVertices; v++) {
+			offsets[v + 1] += offsets[v];
+		}
+
+		std::vector<GLuint> fill(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < numIndices; i++) {
+			triangles[fill[ptrIndices[i]]++] = static_cast<GLuint>(i / 3);
+		}
+	}
+};
+
+} // namespace
+
+namespace mesh_optimizer {
+
+VertexCacheStats analyzeVertexCache(const GLuint* ptrIndices, size_t numIndices, size_t numVertices,
+	GLenum primitiveType, GLuint restartIndex, int cacheSize)
+{
+	VertexCacheStats stats;
+	FifoCache cache(numVertices, cacheSize);
+	std::vector<char> isReferenced(numVertices, 0);
+
+	// Strips send every index once, a strip of n indices draws n - 2 triangles
+	size_t stripLength = 0;
+	for (size_t i = 0; i < numIndices; i++)
+	{
+		const auto vertex = ptrIndices[i];
+		if (primitiveType == GL_TRIANGLE_STRIP)
+		{
+			if (vertex == restartIndex)
+			{
+				stripLength = 0;
+				continue;
+			}
+			if (++stripLength >= 3) {
+				stats.numTriangles++;
+			}
+		}
+
+		if (cache.access(vertex)) {
+			stats.numMisses++;
+		}
+		if (!isReferenced[vertex])
+		{
+			isReferenced[vertex] = 1;
+			stats.numVertices++;
+		}
+	}
+
+	if (primitiveType != GL_TRIANGLE_STRIP) {
+		stats.numTriangles = numIndices / 3;
+	}
+	stats.acmr = stats.numTriangles > 0 ? float(stats.numMisses) / stats.numTriangles : 0.0f;
+	stats.atvr = stats.numVertices > 0 ? float(stats.numMisses) / stats.numVertices : 0.0f;
+	return stats;
+}
+
+void optimizeVertexCache(GLuint* ptrIndices, size_t numIndices, size_t numVertices, int cacheSize)
+{
+	const auto numTriangles = numIndices / 3;
+	if (numTriangles == 0) {
+		return;
+	}
+
+	const VertexTriangles adjacency(ptrIndices, numTriangles * 3, numVertices);
+	std::vector<GLuint> liveTriangles(numVertices);
+	for (size_t v = 0; v < numVertices; v++) {
+		liveTriangles[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+	}
+
+	std::vector<unsigned int> cacheTimestamps(numVertices, 0);
+	std::vector<char> isEmitted(numTriangles, 0);
+	std::vector<GLuint> deadEnd; // vertices of emitted triangles, most recent on top
+	std::vector<GLuint> candidates; // vertices of the triangles emitted around the current fanning vertex
+	std::vector<GLuint> result;
+	result.reserve(numTriangles * 3);
+
+	const auto cacheSizeU = static_cast<unsigned int>(cacheSize);
+	auto time = cacheSizeU + 1;
+	size_t cursor = 0; // next vertex in input order to try, once the dead-end stack is empty
+	long long fanning = ptrIndices[0];
+
+	while (fanning >= 0)
+	{
+		// Emit all remaining triangles around the fanning vertex
+		candidates.clear();
+		for (auto t = adjacency.offsets[fanning]; t < adjacency.offsets[fanning + 1]; t++)
+		{
+			const auto triangle = adjacency.triangles[t];
+			if (isEmitted[triangle]) {
+				continue;
+			}
+
+			for (int k = 0; k < 3; k++)
+			{
+				const auto vertex = ptrIndices[3 * triangle + k];
+				result.push_back(vertex);
+				deadEnd.push_back(vertex);
+				candidates.push_back(vertex);
+				liveTriangles[vertex]--;
+				if (time - cacheTimestamps[vertex] > cacheSizeU) {
+					cacheTimestamps[vertex] = time++;
+				}
+			}
+			isEmitted[triangle] = 1;
+		}
+
+		// Next fanning vertex: the candidate that stays in the cache longest while its triangles are emitted
+		fanning = -1;
+		auto bestPriority = -1LL;
+		for (auto vertex : candidates)
+		{
+			if (liveTriangles[vertex] == 0) {
+				continue;
+			}
+
+			auto priority = 0LL;
+			if (time - cacheTimestamps[vertex] + 2 * liveTriangles[vertex] <= cacheSizeU) {
+				priority = time - cacheTimestamps[vertex];
+			}
+			if (priority > bestPriority)
+			{
+				bestPriority = priority;
+				fanning = vertex;
+			}
+		}
+
+		// Dead end: go back to recently used vertices, then continue in input order
+		while (fanning < 0 && !deadEnd.empty())
+		{
+			const auto vertex = deadEnd.back();
+			deadEnd.pop_back();
+			if (liveTriangles[vertex] > 0) {
+				fanning = vertex;
+			}
+		}
+		while (fanning < 0 && cursor < numVertices)
+		{
+			if (liveTriangles[cursor] > 0) {
+				fanning = static_cast<long long>(cursor);
+			}
+			cursor++;
+		}
+	}
+
+	std::copy(result.begin(), result.end(), ptrIndices);
+}
+
+void optimizeOverdraw(GLuint* ptrIndices, size_t numIndices, const float* ptrPositions, size_t positionStride,
+	size_t numVertices, float threshold)
+{
+	const auto numTriangles = numIndices / 3;
+	if (numTriangles == 0) {
+		return;
+	}
+
+	optimizeVertexCache(ptrIndices, numIndices, numVertices);
+
+	// Hard boundaries: triangles missing the cache with all three vertices start a new patch of the mesh
+	std::vector<size_t> hardStarts;
+	{
+		FifoCache cache(numVertices, FIFO_CACHE_SIZE);
+		for (size_t t = 0; t < numTriangles; t++)
+		{
+			auto misses = 0;
+			for (int k = 0; k < 3; k++) {
+				misses += cache.access(ptrIndices[3 * t + k]) ? 1 : 0;
+			}
+			if (t == 0 || misses == 3) {
+				hardStarts.push_back(t);
+			}
+		}
+	}
+	hardStarts.push_back(numTriangles);
+
+	// Soft boundaries: a patch is split wherever its ACMR so far is already close to the ACMR of the whole patch
+	std::vector<size_t> clusterStarts;
+	FifoCache cache(numVertices, FIFO_CACHE_SIZE);
+	for (size_t h = 0; h + 1 < hardStarts.size(); h++)
+	{
+		const auto start = hardStarts[h];
+		const auto end = hardStarts[h + 1];
+
+		cache.flush();
+		size_t patchMisses = 0;
+		for (auto t = start; t < end; t++)
+		{
+			for (int k = 0; k < 3; k++) {
+				patchMisses += cache.access(ptrIndices[3 * t + k]) ? 1 : 0;
+			}
+		}
+		const auto patchThreshold = threshold * float(patchMisses) / float(end - start);
+
+		cache.flush();
+		clusterStarts.push_back(start);
+		size_t clusterMisses = 0;
+		auto clusterStart = start;
+		for (auto t = start; t < end; t++)
+		{
+			for (int k = 0; k < 3; k++) {
+				clusterMisses += cache.access(ptrIndices[3 * t + k]) ? 1 : 0;
+			}
+
+			const auto clusterTriangles = t + 1 - clusterStart;
+			if (t + 1 < end && float(clusterMisses) <= patchThreshold * clusterTriangles)
+			{
+				clusterStarts.push_back(t + 1);
+				clusterStart = t + 1;
+				clusterMisses = 0;
+				cache.flush();
+			}
+		}
+	}
+	clusterStarts.push_back(numTriangles);
+
+	// Area weighted centroid and normal of every cluster and of the whole mesh
+	const auto numClusters = clusterStarts.size() - 1;
+	std::vector<glm::vec3> clusterCentroids(numClusters, glm::vec3(0.0f));
+	std::vector<glm::vec3> clusterNormals(numClusters, glm::vec3(0.0f));
+	std::vector<float> clusterAreas(numClusters, 0.0f);
+	glm::vec3 meshCentroid(0.0f);
+	auto meshArea = 0.0f;
+	const auto position = [&](GLuint vertex) {
+		const auto* p = ptrPositions + vertex * positionStride;
+		return glm::vec3(p[0], p[1], p[2]);
+	};
+	for (size_t c = 0; c < numClusters; c++)
+	{
+		for (auto t = clusterStarts[c]; t < clusterStarts[c + 1]; t++)
+		{
+			const auto a = position(ptrIndices[3 * t]);
+			const auto b = position(ptrIndices[3 * t + 1]);
+			const auto d = position(ptrIndices[3 * t + 2]);
+			const auto normal = glm::cross(b - a, d - a);
+			const auto area = glm::length(normal);
+			clusterCentroids[c] += (a + b + d) * (area / 3.0f);
+			clusterNormals[c] += normal;
+			clusterAreas[c] += area;
+		}
+		meshCentroid += clusterCentroids[c];
+		meshArea += clusterAreas[c];
+	}
+	if (meshArea > 0.0f) {
+		meshCentroid /= meshArea;
+	}
+
+	// Clusters facing away from the center are in front of the rest of the mesh from where they are visible
+	std::vector<float> sortKeys(numClusters, 0.0f);
+	for (size_t c = 0; c < numClusters; c++)
+	{
+		if (clusterAreas[c] <= 0.0f || glm::length(clusterNormals[c]) <= 0.0f) {
+			continue;
+		}
+		const auto centroid = clusterCentroids[c] / clusterAreas[c];
+		sortKeys[c] = glm::dot(centroid - meshCentroid, glm::normalize(clusterNormals[c]));
+	}
+
+	std::vector<size_t> order(numClusters);
+	for (size_t c = 0; c < numClusters; c++) {
+		order[c] = c;
+	}
+	std::stable_sort(order.begin(), order.end(), [&sortKeys](size_t a, size_t b) { return sortKeys[a] > sortKeys[b]; });
+
+	std::vector<GLuint> result;
+	result.reserve(numTriangles * 3);
+	for (auto c : order) {
+		result.insert(result.end(), ptrIndices + 3 * clusterStarts[c], ptrIndices + 3 * clusterStarts[c + 1]);
+	}
+	std::copy(result.begin(), result.end(), ptrIndices);
+}
+
+size_t buildVertexFetchRemap(const GLuint* ptrIndices, size_t numIndices, size_t numVertices, std::vector<GLuint>& remap)
+{
+	const auto unassigned = static_cast<GLuint>(numVertices);
+	remap.assign(numVertices, unassigned);
+
+	GLuint next = 0;
+	for (size_t i = 0; i < numIndices; i++)
+	{
+		auto& entry = remap[ptrIndices[i]];
+		if (entry == unassigned) {
+			entry = next++;
+		}
+	}
+
+	const size_t numReferenced = next;
+	for (auto& entry : remap)
+	{
+		if (entry == unassigned) {
+			entry = next++;
+		}
+	}
+	return numReferenced;
+}
+
+void remapIndices(GLuint* ptrIndices, size_t numIndices, const std::vector<GLuint>& remap)
+{
+	for (size_t i = 0; i < numIndices; i++) {
+		ptrIndices[i] = remap[ptrIndices[i]];
+	}
+}
+
+void remapVertices(void* ptrVertices, size_t numVertices, size_t vertexSize, const std::vector<GLuint>& remap)
+{
+	auto* bytes = static_cast<unsigned char*>(ptrVertices);
+	const std::vector<unsigned char> original(bytes, bytes + numVertices * vertexSize);
+	for (size_t v = 0; v < numVertices; v++) {
+		memcpy(bytes + remap[v] * vertexSize, original.data() + v * vertexSize, vertexSize);
+	}
+}
+
+void printVertexCacheStats(const char* name, const VertexCacheStats& before, const VertexCacheStats& after, std::ostream& os)
+{
+	const auto flags = os.flags();
+	const auto precision = os.precision();
+
+	os << std::fixed << std::setprecision(3);
+	os << "Vertex cache (" << name << ", FIFO " << FIFO_CACHE_SIZE << "): ACMR " << before.acmr << " -> " << after.acmr
+		<< ", ATVR " << before.atvr << " -> " << after.atvr << std::endl;
+
+	os.flags(flags);
+	os.precision(precision);
+}
+
+} // namespace mesh_optimizer
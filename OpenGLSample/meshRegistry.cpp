@@ -0,0 +1,377 @@
+// STL
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <utility>
+
+#include "common/meshRegistry.h"
+#include "common/meshUploadQueue.h"
+#include "common/resourceTracker.h"
+
+const uint32_t MeshRegistry::CACHE_FORMAT_VERSION = 1;
+const char*    MeshRegistry::CACHE_FILE_EXTENSION = ".mesh";
+
+namespace {
+
+const char CACHE_MAGIC[4] = { 'M', 'E', 'S', 'H' };
+
+// Fixed size part of a cache file, followed by key, vertices, indices, metadata and the checksum of everything before it
+struct CacheHeader
+{
+	char magic[4];
+	uint32_t version;
+	uint32_t pointerBytes; // metadata may hold size_t, so 32 and 64-bit builds can't share files
+	uint32_t floatsPerVertex;
+	uint32_t indexType;
+	uint32_t primitiveType;
+	uint32_t keyBytes;
+	uint32_t reserved;
+	uint64_t vertexBytes;
+	uint64_t indexBytes;
+	uint64_t metadataBytes;
+};
+
+double millisecondsSince(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void appendBytes(std::vector<unsigned char>& file, const void* ptrData, size_t numBytes)
+{
+	const auto* bytes = static_cast<const unsigned char*>(ptrData);
+	file.insert(file.end(), bytes, bytes + numBytes);
+}
+
+} // namespace
+
+MeshRegistry::MeshRegistry(const std::string& cacheDirectory)
+	: _cacheDirectory(cacheDirectory)
+{
+	if (!_cacheDirectory.empty() && _cacheDirectory.back() != '/' && _cacheDirectory.back() != '\\') {
+		_cacheDirectory += '/';
+	}
+}
+
+MeshRegistry::~MeshRegistry()
+{
+	deleteRegistry();
+}
+
+const MeshRegistry::SharedMesh* MeshRegistry::acquire(const std::string& key, const Generator& generator)
+{
+	_stats.numAcquires++;
+
+	auto itMesh = _meshes.find(key);
+	if (itMesh != _meshes.end())
+	{
+		_stats.numShared++;
+		itMesh->second.referenceCount++;
+		return &itMesh->second;
+	}
+
+	MeshBlob blob;
+	recordBuild(buildBlob(key, generator, blob));
+
+	if (blob.vertices.empty() || blob.floatsPerVertex == 0)
+	{
+		std::cout << "Generator of mesh '" << key << "' produced no vertices!" << std::endl;
+		return nullptr;
+	}
+
+	SharedMesh& mesh = _meshes[key];
+	mesh.key = key;
+	mesh.referenceCount = 1;
+	fillMesh(mesh, blob);
+
+	// Element array binding belongs to the VAO, so the upload goes through another target
+	mesh.vertexBuffer = GLBuffer::create();
+	glBindBuffer(GL_ARRAY_BUFFER, mesh.vertexBuffer.get());
+	glBufferData(GL_ARRAY_BUFFER, blob.vertices.size() * sizeof(float), blob.vertices.data(), GL_STATIC_DRAW);
+	mesh.indexBuffer = GLBuffer::create();
+	glBindBuffer(GL_COPY_WRITE_BUFFER, mesh.indexBuffer.get());
+	glBufferData(GL_COPY_WRITE_BUFFER, blob.indices.size(), blob.indices.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	TRACK_RESOURCE(BUFFER, mesh.vertexBuffer.get(), blob.vertices.size() * sizeof(float), "mesh registry");
+	TRACK_RESOURCE(BUFFER, mesh.indexBuffer.get(), blob.indices.size(), "mesh registry");
+
+	return &mesh;
+}
+
+const MeshRegistry::SharedMesh* MeshRegistry::acquireAsync(const std::string& key, const Generator& generator, MeshUploadQueue& uploadQueue)
+{
+	_stats.numAcquires++;
+
+	auto itMesh = _meshes.find(key);
+	if (itMesh != _meshes.end())
+	{
+		_stats.numShared++;
+		itMesh->second.referenceCount++;
+		return &itMesh->second;
+	}
+
+	SharedMesh& mesh = _meshes[key];
+	mesh.key = key;
+	mesh.referenceCount = 1;
+	mesh.isReady = false;
+	mesh.uploadTicket = ++_nextUploadTicket;
+
+	// The worker only reads the cache directory, everything else happens in the completion on the render thread
+	auto result = std::make_shared<BuildResult>();
+	const auto ticket = mesh.uploadTicket;
+	uploadQueue.submit(
+		[this, key, generator, result](MeshBlob& blob) { *result = buildBlob(key, generator, blob); },
+		[this, key, ticket, result](MeshBlob& blob, GLBuffer& vertexBuffer, GLBuffer& indexBuffer)
+		{
+			recordBuild(*result);
+
+			// Released (and maybe acquired again) while the upload was pending
+			auto itPending = _meshes.find(key);
+			const auto isStale = itPending == _meshes.end() || itPending->second.uploadTicket != ticket;
+			// Buffers not taken are released by the queue
+			if (isStale || blob.vertices.empty() || blob.floatsPerVertex == 0)
+			{
+				if (!isStale) {
+					std::cout << "Generator of mesh '" << key << "' produced no vertices!" << std::endl;
+				}
+				return;
+			}
+
+			// The queue's buffers belong to the registry from now on
+			TRACK_RESOURCE(BUFFER, vertexBuffer.get(), blob.vertices.size() * sizeof(float), "mesh registry");
+			TRACK_RESOURCE(BUFFER, indexBuffer.get(), blob.indices.size(), "mesh registry");
+
+			auto& pendingMesh = itPending->second;
+			pendingMesh.vertexBuffer = std::move(vertexBuffer);
+			pendingMesh.indexBuffer = std::move(indexBuffer);
+			fillMesh(pendingMesh, blob);
+			pendingMesh.isReady = true;
+		});
+
+	return &mesh;
+}
+
+void MeshRegistry::release(const SharedMesh* mesh)
+{
+	if (mesh == nullptr) {
+		return;
+	}
+
+	auto itMesh = _meshes.find(mesh->key);
+	if (itMesh == _meshes.end())
+	{
+		std::cout << "Mesh '" << mesh->key << "' is not in this registry!" << std::endl;
+		return;
+	}
+
+	if (--itMesh->second.referenceCount > 0) {
+		return;
+	}
+
+	// Users may have drawn the mesh this frame, the buffers go through the deletion queue
+	_meshes.erase(itMesh);
+}
+
+int MeshRegistry::getNumMeshes() const
+{
+	return static_cast<int>(_meshes.size());
+}
+
+const MeshRegistry::Stats& MeshRegistry::getStats() const
+{
+	return _stats;
+}
+
+void MeshRegistry::printStats(std::ostream& os) const
+{
+	const auto flags = os.flags();
+	const auto precision = os.precision();
+
+	os << std::fixed << std::setprecision(2);
+	os << "Mesh registry: " << _stats.numAcquires << " acquires, " << _stats.numShared << " shared, "
+		<< _stats.numLoaded << " loaded from cache (" << _stats.loadMilliseconds << " ms), "
+		<< _stats.numGenerated << " generated (" << _stats.generateMilliseconds << " ms), "
+		<< _stats.numWritten << " cache files written" << std::endl;
+	for (const auto& keyMesh : _meshes)
+	{
+		const auto& mesh = keyMesh.second;
+		const auto indexBytes = static_cast<size_t>(mesh.numIndices) * (mesh.indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint));
+		if (!mesh.isReady)
+		{
+			os << "  " << mesh.key << ": " << mesh.referenceCount << (mesh.referenceCount == 1 ? " user, " : " users, ") << "upload pending" << std::endl;
+			continue;
+		}
+		os << "  " << mesh.key << ": " << mesh.referenceCount << (mesh.referenceCount == 1 ? " user, " : " users, ")
+			<< mesh.numVertices << " vertices, " << mesh.numIndices << " indices, "
+			<< static_cast<size_t>(mesh.numVertices) * mesh.floatsPerVertex * sizeof(float) + indexBytes << " bytes" << std::endl;
+	}
+
+	os.flags(flags);
+	os.precision(precision);
+}
+
+std::string MeshRegistry::getCachePath(const std::string& key) const
+{
+	if (_cacheDirectory.empty()) {
+		return std::string();
+	}
+
+	std::ostringstream path;
+	path << _cacheDirectory << std::hex << std::setw(16) << std::setfill('0') << hashBytes(key.data(), key.size()) << CACHE_FILE_EXTENSION;
+	return path.str();
+}
+
+uint64_t MeshRegistry::hashBytes(const void* ptrData, size_t numBytes, uint64_t hash)
+{
+	const auto* bytes = static_cast<const unsigned char*>(ptrData);
+	for (size_t i = 0; i < numBytes; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+void MeshRegistry::deleteRegistry()
+{
+	_meshes.clear();
+}
+
+MeshRegistry::BuildResult MeshRegistry::buildBlob(const std::string& key, const Generator& generator, MeshBlob& blob) const
+{
+	// Disk cache first, generator only if there's no valid file
+	BuildResult result;
+	const auto start = std::chrono::steady_clock::now();
+	if (loadBlob(key, blob)) {
+		result.isLoaded = true;
+	}
+	else
+	{
+		blob = MeshBlob();
+		generator(blob);
+		result.isWritten = saveBlob(key, blob);
+	}
+	result.milliseconds = millisecondsSince(start);
+	return result;
+}
+
+void MeshRegistry::recordBuild(const BuildResult& result)
+{
+	if (result.isLoaded)
+	{
+		_stats.numLoaded++;
+		_stats.loadMilliseconds += result.milliseconds;
+		return;
+	}
+
+	_stats.numGenerated++;
+	_stats.generateMilliseconds += result.milliseconds;
+	if (result.isWritten) {
+		_stats.numWritten++;
+	}
+}
+
+void MeshRegistry::fillMesh(SharedMesh& mesh, MeshBlob& blob)
+{
+	mesh.floatsPerVertex = blob.floatsPerVertex;
+	mesh.numVertices = static_cast<GLsizei>(blob.vertices.size() / blob.floatsPerVertex);
+	mesh.indexType = blob.indexType;
+	mesh.primitiveType = blob.primitiveType;
+	mesh.numIndices = static_cast<GLsizei>(blob.indices.size() / (blob.indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint)));
+	mesh.metadata.metadata.swap(blob.metadata);
+}
+
+bool MeshRegistry::loadBlob(const std::string& key, MeshBlob& blob) const
+{
+	const auto path = getCachePath(key);
+	if (path.empty()) {
+		return false;
+	}
+
+	std::ifstream stream(path, std::ios::in | std::ios::binary);
+	if (!stream) {
+		return false;
+	}
+	const std::vector<unsigned char> file((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+	// Everything is checked before it's used, a stale or truncated file is just generated again
+	CacheHeader header;
+	if (file.size() < sizeof(header) + sizeof(uint64_t)) {
+		return false;
+	}
+	memcpy(&header, file.data(), sizeof(header));
+	if (memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != CACHE_FORMAT_VERSION
+		|| header.pointerBytes != sizeof(void*) || header.floatsPerVertex == 0) {
+		return false;
+	}
+
+	const uint64_t payloadBytes = header.keyBytes + header.vertexBytes + header.indexBytes + header.metadataBytes;
+	if (file.size() != sizeof(header) + payloadBytes + sizeof(uint64_t) || header.vertexBytes % (header.floatsPerVertex * sizeof(float)) != 0) {
+		return false;
+	}
+
+	uint64_t checksum;
+	memcpy(&checksum, file.data() + file.size() - sizeof(checksum), sizeof(checksum));
+	if (checksum != hashBytes(file.data(), file.size() - sizeof(checksum))) {
+		return false;
+	}
+
+	const auto* ptrData = file.data() + sizeof(header);
+	if (std::string(reinterpret_cast<const char*>(ptrData), header.keyBytes) != key) {
+		return false;
+	}
+	ptrData += header.keyBytes;
+
+	blob.floatsPerVertex = header.floatsPerVertex;
+	blob.indexType = header.indexType;
+	blob.primitiveType = header.primitiveType;
+	blob.vertices.resize(static_cast<size_t>(header.vertexBytes / sizeof(float)));
+	memcpy(blob.vertices.data(), ptrData, static_cast<size_t>(header.vertexBytes));
+	ptrData += header.vertexBytes;
+	blob.indices.assign(ptrData, ptrData + header.indexBytes);
+	ptrData += header.indexBytes;
+	blob.metadata.assign(ptrData, ptrData + header.metadataBytes);
+	return true;
+}
+
+bool MeshRegistry::saveBlob(const std::string& key, const MeshBlob& blob) const
+{
+	const auto path = getCachePath(key);
+	if (path.empty()) {
+		return false;
+	}
+
+	CacheHeader header;
+	memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	header.version = CACHE_FORMAT_VERSION;
+	header.pointerBytes = sizeof(void*);
+	header.floatsPerVertex = blob.floatsPerVertex;
+	header.indexType = blob.indexType;
+	header.primitiveType = blob.primitiveType;
+	header.keyBytes = static_cast<uint32_t>(key.size());
+	header.reserved = 0;
+	header.vertexBytes = blob.vertices.size() * sizeof(float);
+	header.indexBytes = blob.indices.size();
+	header.metadataBytes = blob.metadata.size();
+
+	std::vector<unsigned char> file;
+	file.reserve(sizeof(header) + key.size() + header.vertexBytes + header.indexBytes + header.metadataBytes + sizeof(uint64_t));
+	appendBytes(file, &header, sizeof(header));
+	appendBytes(file, key.data(), key.size());
+	appendBytes(file, blob.vertices.data(), blob.vertices.size() * sizeof(float));
+	appendBytes(file, blob.indices.data(), blob.indices.size());
+	appendBytes(file, blob.metadata.data(), blob.metadata.size());
+	const auto checksum = hashBytes(file.data(), file.size());
+	appendBytes(file, &checksum, sizeof(checksum));
+
+	std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!stream || !stream.write(reinterpret_cast<const char*>(file.data()), file.size()))
+	{
+		std::cout << "Cannot write mesh cache file '" << path << "'!" << std::endl;
+		return false;
+	}
+	return true;
+}
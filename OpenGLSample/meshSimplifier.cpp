@@ -0,0 +1,423 @@
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+
+// GLM
+#include <glm/glm.hpp>
+
+#include "common/meshSimplifier.h"
+
+namespace mesh_simplifier {
+
+const float BORDER_WEIGHT = 10.0f;
+const float MAX_FLIP_COS  = 0.25f;
+
+} // namespace mesh_simplifier
+
+namespace {
+
+/**
+  Sum of squared distances to a set of planes, as the symmetric 4x4 matrix of the plane equations.
+  Only surface planes count into the weight, so evaluate / weight is a mean squared distance.
+*/
+struct Quadric
+{
+	double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+	double b2 = 0.0, bc = 0.0, bd = 0.0;
+	double c2 = 0.0, cd = 0.0;
+	double d2 = 0.0;
+	double weight = 0.0; //!< Area of the surface planes
+
+	//* \brief Adds plane n.p + d = 0 (n unit length) scaled by planeWeight.
+	void addPlane(const glm::dvec3& n, double d, double planeWeight, bool isSurface)
+	{
+		a2 += planeWeight * n.x * n.x; ab += planeWeight * n.x * n.y; ac += planeWeight * n.x * n.z; ad += planeWeight * n.x * d;
+		b2 += planeWeight * n.y * n.y; bc += planeWeight * n.y * n.z; bd += planeWeight * n.y * d;
+		c2 += planeWeight * n.z * n.z; cd += planeWeight * n.z * d;
+		d2 += planeWeight * d * d;
+		weight += isSurface ? planeWeight : 0.0;
+	}
+
+	void add(const Quadric& other)
+	{
+		a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+		b2 += other.b2; bc += other.bc; bd += other.bd;
+		c2 += other.c2; cd += other.cd;
+		d2 += other.d2;
+		weight += other.weight;
+	}
+
+	//* \brief Gets weighted sum of squared distances of p to the planes.
+	double evaluate(const glm::dvec3& p) const
+	{
+		const double value = a2 * p.x * p.x + b2 * p.y * p.y + c2 * p.z * p.z
+			+ 2.0 * (ab * p.x * p.y + ac * p.x * p.z + bc * p.y * p.z)
+			+ 2.0 * (ad * p.x + bd * p.y + cd * p.z) + d2;
+		return std::max(value, 0.0);
+	}
+};
+
+//* \brief Bit pattern of a position, vertices with equal keys are wedges of one position.
+struct PositionKey
+{
+	uint32_t bits[3];
+
+	bool operator==(const PositionKey& other) const
+	{
+		return bits[0] == other.bits[0] && bits[1] == other.bits[1] && bits[2] == other.bits[2];
+	}
+};
+
+struct PositionKeyHash
+{
+	size_t operator()(const PositionKey& key) const
+	{
+		return (key.bits[0] * 73856093u) ^ (key.bits[1] * 19349663u) ^ (key.bits[2] * 83492791u);
+	}
+};
+
+//* \brief Triangles using each vertex, in compressed rows.
+struct VertexTriangles
+{
+	std::vector<GLuint> offsets; //!< Triangles of vertex v are triangles[offsets[v]] .. triangles[offsets[v + 1] - 1]
+	std::vector<GLuint> triangles;
+
+	VertexTriangles(const std::vector<GLuint>& corners, size_t numVertices)
+		: offsets(numVertices + 1, 0)
+		, triangles(corners.size())
+	{
+		for (auto corner : corners) {
+			offsets[corner + 1]++;
+		}
+		for (size_t v = 0; v < numVertices; v++) {
+			offsets[v + 1] += offsets[v];
+		}
+
+		std::vector<GLuint> fill(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < corners.size(); i++) {
+			triangles[fill[corners[i]]++] = static_cast<GLuint>(i / 3);
+		}
+	}
+};
+
+//* \brief Candidate edge collapse, vertex from is moved onto vertex to.
+struct Collapse
+{
+	GLuint from;
+	GLuint to;
+	double error; //!< Mean squared distance to the planes of both vertices
+};
+
+uint64_t edgeKey(GLuint from, GLuint to)
+{
+	return (static_cast<uint64_t>(from) << 32) | to;
+}
+
+uint64_t undirectedEdgeKey(GLuint a, GLuint b)
+{
+	return a < b ? edgeKey(a, b) : edgeKey(b, a);
+}
+
+//* \brief Directed edges of all triangles, between vertices (not positions).
+std::unordered_set<uint64_t> collectHalfEdges(const std::vector<GLuint>& indices)
+{
+	std::unordered_set<uint64_t> halfEdges;
+	halfEdges.reserve(indices.size());
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		for (int k = 0; k < 3; k++) {
+			halfEdges.insert(edgeKey(indices[i + k], indices[i + (k + 1) % 3]));
+		}
+	}
+	return halfEdges;
+}
+
+/**
+  Finds seam and border edges: edges whose half-edge between the same two vertices (not positions)
+  has no twin. Gets them as undirected edges between positions, and how many of them meet at each position.
+*/
+void findBorderEdges(const std::vector<GLuint>& indices, const std::vector<GLuint>& canonical,
+	std::unordered_set<uint64_t>& borderEdges, std::vector<int>& numBorderEdges)
+{
+	const auto halfEdges = collectHalfEdges(indices);
+	borderEdges.clear();
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		for (int k = 0; k < 3; k++)
+		{
+			const auto a = indices[i + k];
+			const auto b = indices[i + (k + 1) % 3];
+			if (halfEdges.count(edgeKey(b, a)) == 0) {
+				borderEdges.insert(undirectedEdgeKey(canonical[a], canonical[b]));
+			}
+		}
+	}
+
+	std::fill(numBorderEdges.begin(), numBorderEdges.end(), 0);
+	for (auto edge : borderEdges)
+	{
+		numBorderEdges[static_cast<GLuint>(edge >> 32)]++;
+		numBorderEdges[static_cast<GLuint>(edge & 0xFFFFFFFF)]++;
+	}
+}
+
+} // namespace
+
+namespace mesh_simplifier {
+
+float simplify(const GLuint* ptrIndices, size_t numIndices, const float* ptrPositions, size_t positionStride,
+	size_t numVertices, size_t targetIndexCount, float maxError, std::vector<GLuint>& outIndices)
+{
+	const auto position = [&](GLuint vertex)
+	{
+		const float* p = ptrPositions + vertex * positionStride;
+		return glm::dvec3(p[0], p[1], p[2]);
+	};
+
+	// Vertices at one position form a circular list of wedges, the first of them stands for the position
+	std::vector<GLuint> canonical(numVertices), nextWedge(numVertices);
+	{
+		std::unordered_map<PositionKey, GLuint, PositionKeyHash> firstWedges;
+		firstWedges.reserve(numVertices);
+		for (GLuint v = 0; v < numVertices; v++)
+		{
+			PositionKey key;
+			memcpy(key.bits, ptrPositions + v * positionStride, sizeof(key.bits));
+			const auto inserted = firstWedges.emplace(key, v);
+			canonical[v] = inserted.first->second;
+			nextWedge[v] = v;
+			if (!inserted.second)
+			{
+				nextWedge[v] = nextWedge[canonical[v]];
+				nextWedge[canonical[v]] = v;
+			}
+		}
+	}
+
+	// Triangles collapsed to a line or a point are dropped
+	const auto isDegenerate = [&](const GLuint* triangle)
+	{
+		return canonical[triangle[0]] == canonical[triangle[1]] || canonical[triangle[1]] == canonical[triangle[2]]
+			|| canonical[triangle[0]] == canonical[triangle[2]];
+	};
+	std::vector<GLuint> indices;
+	indices.reserve(numIndices);
+	for (size_t i = 0; i + 2 < numIndices; i += 3)
+	{
+		if (!isDegenerate(ptrIndices + i)) {
+			indices.insert(indices.end(), ptrIndices + i, ptrIndices + i + 3);
+		}
+	}
+
+	// Planes of the triangles around every position, plus planes standing on seam and border edges
+	std::vector<Quadric> quadrics(numVertices);
+	std::unordered_set<uint64_t> borderEdges;
+	std::vector<int> numBorderEdges(numVertices, 0);
+	{
+		const auto halfEdges = collectHalfEdges(indices);
+		for (size_t i = 0; i < indices.size(); i += 3)
+		{
+			const glm::dvec3 corners[3] = { position(indices[i]), position(indices[i + 1]), position(indices[i + 2]) };
+			const auto cross = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+			const double length = glm::length(cross);
+			if (length <= 0.0) {
+				continue;
+			}
+			const auto normal = cross / length;
+			for (int k = 0; k < 3; k++) {
+				quadrics[canonical[indices[i + k]]].addPlane(normal, -glm::dot(normal, corners[0]), 0.5 * length, true);
+			}
+
+			for (int k = 0; k < 3; k++)
+			{
+				const auto a = indices[i + k];
+				const auto b = indices[i + (k + 1) % 3];
+				if (halfEdges.count(edgeKey(b, a)) != 0) {
+					continue;
+				}
+				const auto edge = corners[(k + 1) % 3] - corners[k];
+				const auto edgeNormal = glm::cross(edge, normal);
+				const double edgeLength = glm::length(edge);
+				if (edgeLength <= 0.0) {
+					continue;
+				}
+				const auto planeNormal = edgeNormal / glm::length(edgeNormal);
+				const double planeD = -glm::dot(planeNormal, corners[k]);
+				const double planeWeight = BORDER_WEIGHT * edgeLength * edgeLength;
+				quadrics[canonical[a]].addPlane(planeNormal, planeD, planeWeight, false);
+				quadrics[canonical[b]].addPlane(planeNormal, planeD, planeWeight, false);
+			}
+		}
+	}
+
+	const size_t targetTriangles = targetIndexCount / 3;
+	const double maxCollapseError = static_cast<double>(maxError) * maxError;
+	double largestError = 0.0;
+	std::vector<GLuint> remap(numVertices);
+	std::vector<char> isLocked(numVertices);
+	std::vector<GLuint> corners;
+	std::vector<Collapse> collapses;
+	std::vector<std::pair<GLuint, GLuint>> wedgeTargets;
+
+	// Every pass collapses the cheapest edges whose surroundings were not touched yet in the pass
+	while (indices.size() / 3 > targetTriangles)
+	{
+		findBorderEdges(indices, canonical, borderEdges, numBorderEdges);
+		corners.resize(indices.size());
+		for (size_t i = 0; i < indices.size(); i++) {
+			corners[i] = canonical[indices[i]];
+		}
+		const VertexTriangles positionTriangles(corners, numVertices);
+
+		// Vertices on one seam or border only move along it, where seams or borders meet they stay
+		const auto canMove = [&](GLuint from, GLuint to)
+		{
+			if (numBorderEdges[from] == 0) {
+				return true;
+			}
+			return numBorderEdges[from] == 2 && borderEdges.count(undirectedEdgeKey(from, to)) != 0;
+		};
+
+		collapses.clear();
+		for (size_t i = 0; i < corners.size(); i += 3)
+		{
+			for (int k = 0; k < 3; k++)
+			{
+				const auto a = corners[i + k];
+				const auto b = corners[i + (k + 1) % 3];
+				const GLuint directions[2][2] = { { a, b }, { b, a } };
+				for (const auto& direction : directions)
+				{
+					if (!canMove(direction[0], direction[1])) {
+						continue;
+					}
+					Quadric quadric = quadrics[direction[0]];
+					quadric.add(quadrics[direction[1]]);
+					Collapse collapse;
+					collapse.from = direction[0];
+					collapse.to = direction[1];
+					collapse.error = quadric.evaluate(position(direction[1])) / std::max(quadric.weight, 1e-30);
+					collapses.push_back(collapse);
+				}
+			}
+		}
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.error < b.error; });
+
+		std::iota(remap.begin(), remap.end(), 0);
+		std::fill(isLocked.begin(), isLocked.end(), 0);
+		size_t numTriangles = indices.size() / 3;
+		size_t numCollapses = 0;
+		for (const auto& collapse : collapses)
+		{
+			if (numTriangles <= targetTriangles || collapse.error > maxCollapseError) {
+				break;
+			}
+			if (isLocked[collapse.from] || isLocked[collapse.to]) {
+				continue;
+			}
+
+			const auto first = positionTriangles.triangles.begin() + positionTriangles.offsets[collapse.from];
+			const auto last = positionTriangles.triangles.begin() + positionTriangles.offsets[collapse.from + 1];
+
+			// Triangles sharing the edge disappear, the others must not flip or turn too far
+			bool isValid = true;
+			size_t numRemoved = 0;
+			for (auto it = first; it != last && isValid; ++it)
+			{
+				const GLuint* triangle = corners.data() + 3 * *it;
+				if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+				{
+					numRemoved++;
+					continue;
+				}
+
+				glm::dvec3 before[3], after[3];
+				for (int k = 0; k < 3; k++)
+				{
+					before[k] = position(triangle[k]);
+					after[k] = triangle[k] == collapse.from ? position(collapse.to) : before[k];
+				}
+				const auto normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+				const auto normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+				const double lengths = glm::length(normalBefore) * glm::length(normalAfter);
+				isValid = lengths > 0.0 && glm::dot(normalBefore, normalAfter) >= mesh_simplifier::MAX_FLIP_COS * lengths;
+			}
+
+			// Every wedge of the removed position goes onto the wedge it shares a triangle with,
+			// a wedge sharing none (it is on the other side of a seam) makes the collapse invalid
+			wedgeTargets.clear();
+			auto wedge = collapse.from;
+			do
+			{
+				bool isUsed = false;
+				GLuint target = collapse.to;
+				bool hasTarget = false;
+				for (auto it = first; it != last && !hasTarget; ++it)
+				{
+					const GLuint* triangle = indices.data() + 3 * *it;
+					if (triangle[0] != wedge && triangle[1] != wedge && triangle[2] != wedge) {
+						continue;
+					}
+					isUsed = true;
+					for (int k = 0; k < 3 && !hasTarget; k++)
+					{
+						if (canonical[triangle[k]] == collapse.to)
+						{
+							target = triangle[k];
+							hasTarget = true;
+						}
+					}
+				}
+				isValid = isValid && (hasTarget || !isUsed);
+				wedgeTargets.push_back(std::make_pair(wedge, target));
+				wedge = nextWedge[wedge];
+			} while (wedge != collapse.from && isValid);
+
+			if (!isValid) {
+				continue;
+			}
+
+			for (const auto& wedgeTarget : wedgeTargets) {
+				remap[wedgeTarget.first] = wedgeTarget.second;
+			}
+			quadrics[collapse.to].add(quadrics[collapse.from]);
+			largestError = std::max(largestError, collapse.error);
+			numTriangles -= numRemoved;
+			numCollapses++;
+
+			// Costs and flip tests around the collapse are stale until the next pass
+			for (auto it = first; it != last; ++it)
+			{
+				for (int k = 0; k < 3; k++) {
+					isLocked[corners[3 * *it + k]] = 1;
+				}
+			}
+		}
+
+		if (numCollapses == 0) {
+			break;
+		}
+
+		size_t numKept = 0;
+		for (size_t i = 0; i < indices.size(); i += 3)
+		{
+			const GLuint triangle[3] = { remap[indices[i]], remap[indices[i + 1]], remap[indices[i + 2]] };
+			if (isDegenerate(triangle)) {
+				continue;
+			}
+			memcpy(indices.data() + numKept, triangle, sizeof(triangle));
+			numKept += 3;
+		}
+		indices.resize(numKept);
+	}
+
+	outIndices.swap(indices);
+	return static_cast<float>(std::sqrt(largestError));
+}
+
+} // namespace mesh_simplifier
@@ -0,0 +1,253 @@
+// STL
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include "common/meshUploadQueue.h"
+#include "common/resourceTracker.h"
+
+const size_t MeshUploadQueue::DEFAULT_BUDGET_BYTES = 1024 * 1024;
+const size_t MeshUploadQueue::UPLOAD_CHUNK_SIZE    = 64 * 1024;
+
+namespace {
+
+double microsecondsSince(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+MeshUploadQueue::MeshUploadQueue(int numThreads)
+{
+	if (numThreads <= 0) {
+		numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+	}
+
+	for (int i = 0; i < numThreads; i++) {
+		_workers.push_back(std::thread(&MeshUploadQueue::workerLoop, this));
+	}
+}
+
+MeshUploadQueue::~MeshUploadQueue()
+{
+	deleteQueue();
+}
+
+void MeshUploadQueue::submit(const Builder& builder, const Completion& completion)
+{
+	std::unique_ptr<Job> job(new Job);
+	job->builder = builder;
+	job->completion = completion;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_workers.empty())
+		{
+			std::cout << "This mesh upload queue is deleted! Meshes can't be submitted anymore!" << std::endl;
+			return;
+		}
+		_buildQueue.push_back(std::move(job));
+		_numPending++;
+		_stats.numSubmitted++;
+	}
+	_buildCondition.notify_one();
+}
+
+int MeshUploadQueue::processUploads(const Budget& budget)
+{
+	const auto start = std::chrono::steady_clock::now();
+	size_t frameBytes = 0;
+	int numCompleted = 0;
+
+	while (true)
+	{
+		if (!_uploadingJob)
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (_builtQueue.empty()) {
+				break;
+			}
+			_uploadingJob = std::move(_builtQueue.front());
+			_builtQueue.pop_front();
+		}
+
+		// Meshes without any data complete right away, they need no buffers
+		auto& job = *_uploadingJob;
+		if (job.uploadedBytes < getJobBytes(job))
+		{
+			if (budget.maxBytes > 0 && frameBytes >= budget.maxBytes) {
+				break;
+			}
+			if (budget.maxMicroseconds > 0.0 && frameBytes > 0 && microsecondsSince(start) >= budget.maxMicroseconds) {
+				break;
+			}
+
+			frameBytes += uploadChunk(job, budget.maxBytes > 0 ? budget.maxBytes - frameBytes : UPLOAD_CHUNK_SIZE);
+			continue;
+		}
+
+		// The completion takes the buffers it keeps, the rest is released with the job
+		job.completion(job.blob, job.vertexBuffer, job.indexBuffer);
+		_uploadingJob.reset();
+		numCompleted++;
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		_numPending--;
+		_stats.numUploaded++;
+	}
+
+	if (frameBytes > 0)
+	{
+		const auto frameMicroseconds = microsecondsSince(start);
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stats.uploadedBytes += frameBytes;
+		_stats.numUploadFrames++;
+		_stats.maxFrameBytes = std::max(_stats.maxFrameBytes, frameBytes);
+		_stats.maxFrameMicroseconds = std::max(_stats.maxFrameMicroseconds, frameMicroseconds);
+	}
+	return numCompleted;
+}
+
+int MeshUploadQueue::finish()
+{
+	Budget unlimited;
+	unlimited.maxBytes = 0;
+	unlimited.maxMicroseconds = 0.0;
+
+	int numCompleted = 0;
+	while (true)
+	{
+		numCompleted += processUploads(unlimited);
+
+		// Everything built so far is uploaded now, wait for the workers to hand over more
+		std::unique_lock<std::mutex> lock(_mutex);
+		if (_numPending == 0 || _workers.empty()) {
+			break;
+		}
+		_builtCondition.wait(lock, [this]() { return !_builtQueue.empty(); });
+	}
+	return numCompleted;
+}
+
+int MeshUploadQueue::getNumPending() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _numPending;
+}
+
+MeshUploadQueue::Stats MeshUploadQueue::getStats() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _stats;
+}
+
+void MeshUploadQueue::printStats(std::ostream& os) const
+{
+	const auto stats = getStats();
+	const auto flags = os.flags();
+	const auto precision = os.precision();
+
+	os << std::fixed << std::setprecision(2);
+	os << "Mesh upload queue: " << _workers.size() << (_workers.size() == 1 ? " worker, " : " workers, ")
+		<< stats.numSubmitted << " submitted, " << stats.numBuilt << " built (" << stats.buildMilliseconds << " ms), "
+		<< stats.numUploaded << " uploaded, " << stats.uploadedBytes << " bytes in " << stats.numUploadFrames
+		<< (stats.numUploadFrames == 1 ? " frame" : " frames") << ", at most " << stats.maxFrameBytes << " bytes and "
+		<< stats.maxFrameMicroseconds << " us per frame" << std::endl;
+
+	os.flags(flags);
+	os.precision(precision);
+}
+
+void MeshUploadQueue::deleteQueue()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_isStopping = true;
+	}
+	_buildCondition.notify_all();
+	for (auto& worker : _workers) {
+		worker.join();
+	}
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_workers.clear();
+	_isStopping = false;
+
+	_uploadingJob.reset();
+	_buildQueue.clear();
+	_builtQueue.clear();
+	_numPending = 0;
+}
+
+void MeshUploadQueue::workerLoop()
+{
+	while (true)
+	{
+		std::unique_ptr<Job> job;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_buildCondition.wait(lock, [this]() { return _isStopping || !_buildQueue.empty(); });
+			if (_isStopping) {
+				return;
+			}
+			job = std::move(_buildQueue.front());
+			_buildQueue.pop_front();
+		}
+
+		const auto start = std::chrono::steady_clock::now();
+		job->builder(job->blob);
+		const auto buildMicroseconds = microsecondsSince(start);
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_builtQueue.push_back(std::move(job));
+			_stats.numBuilt++;
+			_stats.buildMilliseconds += buildMicroseconds / 1000.0;
+		}
+		_builtCondition.notify_all();
+	}
+}
+
+size_t MeshUploadQueue::uploadChunk(Job& job, size_t maxBytes)
+{
+	const auto vertexBytes = job.blob.vertices.size() * sizeof(float);
+	const auto indexBytes = job.blob.indices.size();
+
+	// Storage of the whole mesh first, the data follows chunk by chunk;
+	// copy write target, so that no binding a VAO relies on is disturbed
+	if (job.uploadedBytes == 0)
+	{
+		job.vertexBuffer = GLBuffer::create();
+		glBindBuffer(GL_COPY_WRITE_BUFFER, job.vertexBuffer.get());
+		glBufferData(GL_COPY_WRITE_BUFFER, vertexBytes, nullptr, GL_STATIC_DRAW);
+		TRACK_RESOURCE(BUFFER, job.vertexBuffer.get(), vertexBytes, "mesh upload queue");
+		if (indexBytes > 0)
+		{
+			job.indexBuffer = GLBuffer::create();
+			glBindBuffer(GL_COPY_WRITE_BUFFER, job.indexBuffer.get());
+			glBufferData(GL_COPY_WRITE_BUFFER, indexBytes, nullptr, GL_STATIC_DRAW);
+			TRACK_RESOURCE(BUFFER, job.indexBuffer.get(), indexBytes, "mesh upload queue");
+		}
+	}
+
+	// Vertices come first, a chunk never spans both buffers
+	const auto isVertexChunk = job.uploadedBytes < vertexBytes;
+	const auto offset = isVertexChunk ? job.uploadedBytes : job.uploadedBytes - vertexBytes;
+	const auto remaining = isVertexChunk ? vertexBytes - offset : indexBytes - offset;
+	const auto chunkBytes = std::min(remaining, std::min(maxBytes, UPLOAD_CHUNK_SIZE));
+	const auto* ptrData = isVertexChunk ? reinterpret_cast<const unsigned char*>(job.blob.vertices.data()) : job.blob.indices.data();
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, isVertexChunk ? job.vertexBuffer.get() : job.indexBuffer.get());
+	glBufferSubData(GL_COPY_WRITE_BUFFER, offset, chunkBytes, ptrData + offset);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	job.uploadedBytes += chunkBytes;
+	return chunkBytes;
+}
+
+size_t MeshUploadQueue::getJobBytes(const Job& job)
+{
+	return job.blob.vertices.size() * sizeof(float) + job.blob.indices.size();
+}
@@ -0,0 +1,265 @@
+// STL
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "common/meshletBuilder.h"
+
+const size_t meshlet_builder::MAX_VERTICES  = 64;
+const size_t meshlet_builder::MAX_TRIANGLES = 124;
+const float  meshlet_builder::CONE_WEIGHT   = 0.5f;
+const float  meshlet_builder::MIN_CONE_COS  = 0.1f;
+
+namespace {
+
+const size_t NO_TRIANGLE = std::numeric_limits<size_t>::max();
+
+glm::vec3 readPosition(const float* ptrPositions, size_t positionStride, GLuint vertex)
+{
+	const float* position = ptrPositions + vertex * positionStride;
+	return glm::vec3(position[0], position[1], position[2]);
+}
+
+// Bounding sphere and normal cone of triangles [firstIndex, firstIndex + 3 * triangleCount) of indices
+void computeBounds(Meshlet& meshlet, const std::vector<GLuint>& indices, const std::vector<glm::vec3>& triangleNormals,
+	const std::vector<size_t>& triangleIds, const float* ptrPositions, size_t positionStride)
+{
+	const GLuint* first = indices.data() + meshlet.firstIndex;
+	const size_t numCorners = meshlet.triangleCount * 3;
+
+	// Sphere around the center of the bounding box, a little larger than the minimal one
+	glm::vec3 boxMin = readPosition(ptrPositions, positionStride, first[0]);
+	glm::vec3 boxMax = boxMin;
+	for (size_t i = 1; i < numCorners; i++)
+	{
+		const auto position = readPosition(ptrPositions, positionStride, first[i]);
+		boxMin = glm::min(boxMin, position);
+		boxMax = glm::max(boxMax, position);
+	}
+	meshlet.center = 0.5f * (boxMin + boxMax);
+	float radiusSquared = 0.0f;
+	for (size_t i = 0; i < numCorners; i++)
+	{
+		const auto offset = readPosition(ptrPositions, positionStride, first[i]) - meshlet.center;
+		radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+	}
+	meshlet.radius = std::sqrt(radiusSquared);
+
+	// Cone around the average normal, wide spreads can't be culled by their normals
+	meshlet.coneCutoff = 2.0f;
+	glm::vec3 normalSum(0.0f);
+	for (GLuint t = 0; t < meshlet.triangleCount; t++) {
+		normalSum += triangleNormals[triangleIds[t]];
+	}
+	const float normalLength = glm::length(normalSum);
+	if (normalLength <= 0.0f) {
+		return;
+	}
+	meshlet.coneAxis = normalSum / normalLength;
+
+	float minDot = 1.0f;
+	for (GLuint t = 0; t < meshlet.triangleCount; t++) {
+		minDot = std::min(minDot, glm::dot(meshlet.coneAxis, triangleNormals[triangleIds[t]]));
+	}
+	if (minDot <= meshlet_builder::MIN_CONE_COS) {
+		return;
+	}
+
+	// Apex lies on the axis behind the planes of all triangles, so directions from it bound the view vectors
+	float maxDistance = 0.0f;
+	for (GLuint t = 0; t < meshlet.triangleCount; t++)
+	{
+		const auto& normal = triangleNormals[triangleIds[t]];
+		const auto corner = readPosition(ptrPositions, positionStride, first[t * 3]);
+		const float distance = glm::dot(meshlet.center - corner, normal) / glm::dot(meshlet.coneAxis, normal);
+		maxDistance = std::max(maxDistance, distance);
+	}
+	meshlet.coneApex = meshlet.center - meshlet.coneAxis * maxDistance;
+	meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+}
+
+} // namespace
+
+size_t meshlet_builder::buildMeshlets(const GLuint* ptrIndices, size_t numIndices, const float* ptrPositions, size_t positionStride,
+	size_t numVertices, std::vector<Meshlet>& meshlets, std::vector<GLuint>& meshletIndices)
+{
+	const size_t numTriangles = numIndices / 3;
+	const size_t firstMeshlet = meshlets.size();
+
+	// Unit normals, degenerate triangles are marked as used right away
+	std::vector<glm::vec3> triangleNormals(numTriangles, glm::vec3(0.0f));
+	std::vector<unsigned char> isUsed(numTriangles, 0);
+	for (size_t t = 0; t < numTriangles; t++)
+	{
+		const GLuint* triangle = ptrIndices + t * 3;
+		if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[0] == triangle[2])
+		{
+			isUsed[t] = 1;
+			continue;
+		}
+		const auto p0 = readPosition(ptrPositions, positionStride, triangle[0]);
+		const auto normal = glm::cross(readPosition(ptrPositions, positionStride, triangle[1]) - p0,
+			readPosition(ptrPositions, positionStride, triangle[2]) - p0);
+		const float length = glm::length(normal);
+		triangleNormals[t] = length > 0.0f ? normal / length : glm::vec3(0.0f);
+	}
+
+	// Triangles around every vertex (compressed rows), to find the neighbours of a meshlet
+	std::vector<size_t> vertexTriangleOffsets(numVertices + 1, 0);
+	for (size_t t = 0; t < numTriangles; t++)
+	{
+		if (isUsed[t]) {
+			continue;
+		}
+		for (int corner = 0; corner < 3; corner++) {
+			vertexTriangleOffsets[ptrIndices[t * 3 + corner] + 1]++;
+		}
+	}
+	for (size_t v = 0; v < numVertices; v++) {
+		vertexTriangleOffsets[v + 1] += vertexTriangleOffsets[v];
+	}
+	std::vector<size_t> vertexTriangles(vertexTriangleOffsets[numVertices]);
+	std::vector<size_t> fill(vertexTriangleOffsets.begin(), vertexTriangleOffsets.end() - 1);
+	for (size_t t = 0; t < numTriangles; t++)
+	{
+		if (isUsed[t]) {
+			continue;
+		}
+		for (int corner = 0; corner < 3; corner++) {
+			vertexTriangles[fill[ptrIndices[t * 3 + corner]]++] = t;
+		}
+	}
+
+	// State of the meshlet being built
+	std::vector<unsigned char> isInMeshlet(numVertices, 0);
+	std::vector<GLuint> meshletVertices;
+	std::vector<size_t> meshletTriangles;
+	glm::vec3 normalSum(0.0f);
+	size_t nextSeed = 0;
+
+	const auto countNewVertices = [&](size_t t)
+	{
+		size_t count = 0;
+		for (int corner = 0; corner < 3; corner++) {
+			count += isInMeshlet[ptrIndices[t * 3 + corner]] ? 0 : 1;
+		}
+		return count;
+	};
+
+	const auto finishMeshlet = [&]()
+	{
+		if (meshletTriangles.empty()) {
+			return;
+		}
+
+		Meshlet meshlet;
+		meshlet.firstIndex = static_cast<GLuint>(meshletIndices.size());
+		meshlet.triangleCount = static_cast<GLuint>(meshletTriangles.size());
+		meshlet.vertexCount = static_cast<GLuint>(meshletVertices.size());
+		for (auto t : meshletTriangles) {
+			meshletIndices.insert(meshletIndices.end(), ptrIndices + t * 3, ptrIndices + t * 3 + 3);
+		}
+		computeBounds(meshlet, meshletIndices, triangleNormals, meshletTriangles, ptrPositions, positionStride);
+		meshlets.push_back(meshlet);
+
+		for (auto v : meshletVertices) {
+			isInMeshlet[v] = 0;
+		}
+		meshletVertices.clear();
+		meshletTriangles.clear();
+		normalSum = glm::vec3(0.0f);
+	};
+
+	for (;;)
+	{
+		// Cheapest unused neighbour that still fits
+		size_t best = NO_TRIANGLE;
+		float bestCost = std::numeric_limits<float>::max();
+		bool hasNeighbours = false;
+		const float normalLength = glm::length(normalSum);
+		const glm::vec3 coneAxis = normalLength > 0.0f ? normalSum / normalLength : glm::vec3(0.0f);
+		for (auto v : meshletVertices)
+		{
+			for (size_t i = vertexTriangleOffsets[v]; i < vertexTriangleOffsets[v + 1]; i++)
+			{
+				const size_t t = vertexTriangles[i];
+				if (isUsed[t]) {
+					continue;
+				}
+				hasNeighbours = true;
+
+				const size_t newVertices = countNewVertices(t);
+				if (meshletVertices.size() + newVertices > meshlet_builder::MAX_VERTICES) {
+					continue;
+				}
+				const float cost = newVertices + meshlet_builder::CONE_WEIGHT * (1.0f - glm::dot(coneAxis, triangleNormals[t]));
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					best = t;
+				}
+			}
+		}
+
+		if (best == NO_TRIANGLE)
+		{
+			// Neighbours that don't fit end the meshlet, without neighbours it continues elsewhere
+			if (hasNeighbours)
+			{
+				finishMeshlet();
+				continue;
+			}
+			while (nextSeed < numTriangles && isUsed[nextSeed]) {
+				nextSeed++;
+			}
+			if (nextSeed == numTriangles) {
+				break;
+			}
+			best = nextSeed;
+			if (meshletVertices.size() + countNewVertices(best) > meshlet_builder::MAX_VERTICES) {
+				finishMeshlet();
+			}
+		}
+
+		isUsed[best] = 1;
+		meshletTriangles.push_back(best);
+		normalSum += triangleNormals[best];
+		for (int corner = 0; corner < 3; corner++)
+		{
+			const GLuint v = ptrIndices[best * 3 + corner];
+			if (!isInMeshlet[v])
+			{
+				isInMeshlet[v] = 1;
+				meshletVertices.push_back(v);
+			}
+		}
+		if (meshletTriangles.size() == meshlet_builder::MAX_TRIANGLES) {
+			finishMeshlet();
+		}
+	}
+	finishMeshlet();
+
+	return meshlets.size() - firstMeshlet;
+}
+
+meshlet_builder::Visibility meshlet_builder::testMeshlet(const Meshlet& meshlet, const glm::vec4 planes[6], const glm::vec3& cameraPosition)
+{
+	for (int i = 0; i < 6; i++)
+	{
+		if (glm::dot(glm::vec3(planes[i]), meshlet.center) + planes[i].w < -meshlet.radius) {
+			return Visibility::OUTSIDE_FRUSTUM;
+		}
+	}
+
+	// Coming from inside the cone, the view direction hits every triangle from behind
+	if (meshlet.coneCutoff <= 1.0f)
+	{
+		const glm::vec3 view = meshlet.coneApex - cameraPosition;
+		const float distance = glm::length(view);
+		if (distance > 0.0f && glm::dot(view, meshlet.coneAxis) >= meshlet.coneCutoff * distance) {
+			return Visibility::BACK_FACING;
+		}
+	}
+
+	return Visibility::VISIBLE;
+}
@@ -0,0 +1,395 @@
+// STL
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+// GLM
+#include <glm/glm.hpp>
+
+#include "common/objBenchmark.h"
+#include "common/objParser.h"
+
+namespace obj_benchmark {
+
+const int DEFAULT_MEGABYTES = 128;
+const int NUM_RUNS          = 3;
+
+} // namespace obj_benchmark
+
+namespace {
+
+// Written when no file is given, removed after the benchmark
+const char* GENERATED_PATH = "obj_benchmark.obj";
+
+// Approximate bytes the generated file needs per grid vertex (v, vt and vn line, two faces)
+const int GENERATED_BYTES_PER_VERTEX = 200;
+
+// Quad, empty group name, CRLF and tab, pentagon with negative indices, exponent, group without faces
+const char FEATURE_MODEL[] =
+	"# feature check\n"
+	"v 0 0 0\n"
+	"v 1 0 0\n"
+	"v 1 1 0\n"
+	"v 0 1 0\n"
+	"vt 0 0\n"
+	"vt 1 0\n"
+	"vt 1 1\n"
+	"vn 0 0 1\r\n"
+	"o quad\n"
+	"f 1/1/1 2/2/1 3/3/1 4/1/1\n"
+	"g\n"
+	"f -4//-1\t-3//-1 -1//-1\n"
+	"usemtl none\n"
+	"g pentagon\n"
+	"v 2 0 0\n"
+	"v 3 0 0\n"
+	"v 3.5 0.5e0 -0\n"
+	"v 3 1 0\n"
+	"v 2 1 0\n"
+	"f -5/1 -4/2 -3/3 -2/1 -1/2\n"
+	"o empty\n"
+	"g last\n"
+	"f 1 2 3";
+
+// Position, uv and normal index of every corner FEATURE_MODEL must give
+const int FEATURE_CORNERS[][3] = {
+	{ 0, 0, 0 }, { 1, 1, 0 }, { 2, 2, 0 },
+	{ 0, 0, 0 }, { 2, 2, 0 }, { 3, 0, 0 },
+	{ 0, -1, 0 }, { 1, -1, 0 }, { 3, -1, 0 },
+	{ 4, 0, -1 }, { 5, 1, -1 }, { 6, 2, -1 },
+	{ 4, 0, -1 }, { 6, 2, -1 }, { 7, 0, -1 },
+	{ 4, 0, -1 }, { 7, 0, -1 }, { 8, 1, -1 },
+	{ 0, -1, -1 }, { 1, -1, -1 }, { 2, -1, -1 }
+};
+
+//* \brief Expected group of FEATURE_MODEL.
+struct FeatureGroup
+{
+	const char* name;
+	size_t firstTriangle;
+	size_t numTriangles;
+};
+
+const FeatureGroup FEATURE_GROUPS[] = {
+	{ "quad", 0, 2 },
+	{ "", 2, 1 },
+	{ "pentagon", 3, 3 },
+	{ "last", 6, 1 }
+};
+
+//* \brief Loaded model in the layout loadOBJ returns, one vertex per triangle corner.
+struct TriangleSoup
+{
+	std::vector<glm::vec3> vertices;
+	std::vector<glm::vec2> uvs;
+	std::vector<glm::vec3> normals;
+};
+
+// --- Loader as it was before the memory mapped parser, kept for comparison (without its prints and getchar) ---
+
+bool legacyLoadOBJ(const char* path, TriangleSoup& soup)
+{
+	std::vector<unsigned int> vertexIndices, uvIndices, normalIndices;
+	std::vector<glm::vec3> temp_vertices;
+	std::vector<glm::vec2> temp_uvs;
+	std::vector<glm::vec3> temp_normals;
+
+	FILE* file = fopen(path, "r");
+	if (file == NULL) {
+		return false;
+	}
+
+	while (1)
+	{
+		char lineHeader[128];
+		int res = fscanf(file, "%127s", lineHeader);
+		if (res == EOF)
+			break;
+
+		if (strcmp(lineHeader, "v") == 0)
+		{
+			glm::vec3 vertex;
+			fscanf(file, "%f %f %f\n", &vertex.x, &vertex.y, &vertex.z);
+			temp_vertices.push_back(vertex);
+		}
+		else if (strcmp(lineHeader, "vt") == 0)
+		{
+			glm::vec2 uv;
+			fscanf(file, "%f %f\n", &uv.x, &uv.y);
+			uv.y = -uv.y;
+			temp_uvs.push_back(uv);
+		}
+		else if (strcmp(lineHeader, "vn") == 0)
+		{
+			glm::vec3 normal;
+			fscanf(file, "%f %f %f\n", &normal.x, &normal.y, &normal.z);
+			temp_normals.push_back(normal);
+		}
+		else if (strcmp(lineHeader, "f") == 0)
+		{
+			unsigned int vertexIndex[3], uvIndex[3], normalIndex[3];
+			int matches = fscanf(file, "%d/%d/%d %d/%d/%d %d/%d/%d\n", &vertexIndex[0], &uvIndex[0], &normalIndex[0], &vertexIndex[1], &uvIndex[1], &normalIndex[1], &vertexIndex[2], &uvIndex[2], &normalIndex[2]);
+			if (matches != 9)
+			{
+				fclose(file);
+				return false;
+			}
+			vertexIndices.push_back(vertexIndex[0]);
+			vertexIndices.push_back(vertexIndex[1]);
+			vertexIndices.push_back(vertexIndex[2]);
+			uvIndices.push_back(uvIndex[0]);
+			uvIndices.push_back(uvIndex[1]);
+			uvIndices.push_back(uvIndex[2]);
+			normalIndices.push_back(normalIndex[0]);
+			normalIndices.push_back(normalIndex[1]);
+			normalIndices.push_back(normalIndex[2]);
+		}
+		else
+		{
+			char stupidBuffer[1000];
+			fgets(stupidBuffer, 1000, file);
+		}
+	}
+
+	for (unsigned int i = 0; i < vertexIndices.size(); i++)
+	{
+		soup.vertices.push_back(temp_vertices[vertexIndices[i] - 1]);
+		soup.uvs.push_back(temp_uvs[uvIndices[i] - 1]);
+		soup.normals.push_back(temp_normals[normalIndices[i] - 1]);
+	}
+	fclose(file);
+	return true;
+}
+
+// --- The same soup from the parser, what loadOBJ does now ---
+
+bool parserLoadOBJ(const char* path, int numThreads, TriangleSoup& soup)
+{
+	ObjModel model;
+	if (!obj_parser::parseFile(path, model, numThreads)) {
+		return false;
+	}
+
+	obj_parser::toTriangleSoup(model, soup.vertices, soup.uvs, soup.normals, numThreads);
+	for (auto& uv : soup.uvs) {
+		uv.y = -uv.y;
+	}
+	return true;
+}
+
+/** \brief Writes a wavy grid with positions, uvs, normals and fully indexed triangles.
+*   \param path File to write
+*   \param megabytes Approximate size of the file
+*   \return True if the file could be written.
+*/
+bool writeGeneratedModel(const char* path, int megabytes)
+{
+	FILE* file = fopen(path, "w");
+	if (file == NULL) {
+		return false;
+	}
+
+	const auto numVertices = static_cast<double>(megabytes) * 1024.0 * 1024.0 / GENERATED_BYTES_PER_VERTEX;
+	const auto dimensions = std::max(2, static_cast<int>(std::sqrt(numVertices)));
+	const auto step = 20.0f / (dimensions - 1);
+	for (auto row = 0; row < dimensions; row++)
+	{
+		for (auto col = 0; col < dimensions; col++)
+		{
+			const auto x = -10.0f + col * step;
+			const auto z = -10.0f + row * step;
+			const auto normal = glm::normalize(glm::vec3(-0.5f * std::cos(x) * std::cos(z), 1.0f, 0.5f * std::sin(x) * std::sin(z)));
+			fprintf(file, "v %.6f %.6f %.6f\n", x, 0.5f * std::sin(x) * std::cos(z), z);
+			fprintf(file, "vt %.6f %.6f\n", static_cast<float>(col) / (dimensions - 1), static_cast<float>(row) / (dimensions - 1));
+			fprintf(file, "vn %.6f %.6f %.6f\n", normal.x, normal.y, normal.z);
+		}
+	}
+	for (auto row = 0; row < dimensions - 1; row++)
+	{
+		for (auto col = 0; col < dimensions - 1; col++)
+		{
+			const auto a = row * dimensions + col + 1;
+			const auto b = a + dimensions;
+			fprintf(file, "f %d/%d/%d %d/%d/%d %d/%d/%d\n", a, a, a, b, b, b, b + 1, b + 1, b + 1);
+			fprintf(file, "f %d/%d/%d %d/%d/%d %d/%d/%d\n", a, a, a, b + 1, b + 1, b + 1, a + 1, a + 1, a + 1);
+		}
+	}
+
+	const auto isWritten = ferror(file) == 0;
+	return fclose(file) == 0 && isWritten;
+}
+
+/** \brief Parses FEATURE_MODEL and compares it with the expected triangles and groups.
+*   \param numThreads Number of threads to parse with
+*   \return True if triangles, groups and the position with an exponent match.
+*/
+bool checkFeatures(int numThreads)
+{
+	ObjModel model;
+	if (!obj_parser::parseText(FEATURE_MODEL, sizeof(FEATURE_MODEL) - 1, model, numThreads, "feature check")) {
+		return false;
+	}
+
+	const auto numCorners = sizeof(FEATURE_CORNERS) / sizeof(FEATURE_CORNERS[0]);
+	const auto numGroups = sizeof(FEATURE_GROUPS) / sizeof(FEATURE_GROUPS[0]);
+	if (model.corners.size() != numCorners || model.groups.size() != numGroups || model.positions.size() != 9) {
+		return false;
+	}
+	for (size_t i = 0; i < numCorners; i++)
+	{
+		const auto& corner = model.corners[i];
+		if (corner.position != FEATURE_CORNERS[i][0] || corner.uv != FEATURE_CORNERS[i][1] || corner.normal != FEATURE_CORNERS[i][2]) {
+			return false;
+		}
+	}
+	for (size_t i = 0; i < numGroups; i++)
+	{
+		const auto& group = model.groups[i];
+		if (group.name != FEATURE_GROUPS[i].name || group.firstTriangle != FEATURE_GROUPS[i].firstTriangle || group.numTriangles != FEATURE_GROUPS[i].numTriangles) {
+			return false;
+		}
+	}
+	return model.positions[6] == glm::vec3(3.5f, 0.5f, 0.0f);
+}
+
+/** \brief Runs a loader NUM_RUNS times into a fresh output.
+*   \param load Loader to run
+*   \param soup Output of the last run
+*   \param isLoaded False if any run failed
+*   \return Time of the fastest run in milliseconds.
+*/
+double timeBest(const std::function<bool(TriangleSoup&)>& load, TriangleSoup& soup, bool& isLoaded)
+{
+	using clock = std::chrono::steady_clock;
+	auto best = 0.0;
+	isLoaded = true;
+	for (auto run = 0; run < obj_benchmark::NUM_RUNS; run++)
+	{
+		soup = TriangleSoup();
+		const auto start = clock::now();
+		isLoaded = load(soup) && isLoaded;
+		const auto milliseconds = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+		best = run == 0 ? milliseconds : std::min(best, milliseconds);
+	}
+	return best;
+}
+
+/** \brief Compares parser output with the old one.
+*   \param legacy Output of the old loader
+*   \param parsed Output of the parser
+*   \param maxDifference Largest difference of positions, uvs and normals
+*   \return True if the sizes are equal.
+*/
+bool compare(const TriangleSoup& legacy, const TriangleSoup& parsed, float& maxDifference)
+{
+	maxDifference = 0.0f;
+	if (legacy.vertices.size() != parsed.vertices.size() || legacy.uvs.size() != parsed.uvs.size() || legacy.normals.size() != parsed.normals.size()) {
+		return false;
+	}
+
+	for (size_t i = 0; i < legacy.vertices.size(); i++)
+	{
+		const auto position = glm::abs(legacy.vertices[i] - parsed.vertices[i]);
+		const auto uv = glm::abs(legacy.uvs[i] - parsed.uvs[i]);
+		const auto normal = glm::abs(legacy.normals[i] - parsed.normals[i]);
+		maxDifference = std::max(maxDifference, std::max(std::max(position.x, std::max(position.y, position.z)), std::max(uv.x, uv.y)));
+		maxDifference = std::max(maxDifference, std::max(normal.x, std::max(normal.y, normal.z)));
+	}
+	return true;
+}
+
+} // namespace
+
+namespace obj_benchmark {
+
+int run(const std::string& path, int megabytes, std::ostream& out)
+{
+	const auto numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+	auto result = 0;
+	const auto isSingleThreadOk = checkFeatures(1);
+	const auto isMultiThreadOk = checkFeatures(3);
+	out << "Feature check (n-gons, negative indices, missing uvs and normals, groups): "
+		<< (isSingleThreadOk && isMultiThreadOk ? "passed" : "FAILED") << std::endl;
+	if (!isSingleThreadOk || !isMultiThreadOk) {
+		result = 1;
+	}
+
+	auto modelPath = path;
+	if (modelPath.empty())
+	{
+		modelPath = GENERATED_PATH;
+		out << "Writing a " << megabytes << " MB test model to " << modelPath << "..." << std::endl;
+		if (!writeGeneratedModel(modelPath.c_str(), megabytes))
+		{
+			out << "Cannot write " << modelPath << "!" << std::endl;
+			std::remove(modelPath.c_str());
+			return 1;
+		}
+	}
+
+	std::ifstream file(modelPath, std::ios::binary | std::ios::ate);
+	const auto megabytesRead = file ? static_cast<double>(file.tellg()) / (1024.0 * 1024.0) : 0.0;
+	file.close();
+
+	struct Variant
+	{
+		std::string name;
+		std::function<bool(TriangleSoup&)> load;
+	};
+	const auto* cpath = modelPath.c_str();
+	const Variant variants[] = {
+		{ "parser 1 thread", [cpath](TriangleSoup& soup) { return parserLoadOBJ(cpath, 1, soup); } },
+		{ "parser " + std::to_string(numThreads) + (numThreads == 1 ? " thread" : " threads"), [cpath, numThreads](TriangleSoup& soup) { return parserLoadOBJ(cpath, numThreads, soup); } }
+	};
+
+	const auto flags = out.flags();
+	const auto precision = out.precision();
+
+	TriangleSoup legacy;
+	bool isLegacyLoaded = false;
+	const auto legacyMilliseconds = timeBest([cpath](TriangleSoup& soup) { return legacyLoadOBJ(cpath, soup); }, legacy, isLegacyLoaded);
+
+	out << std::fixed << std::setprecision(1);
+	out << "OBJ loading, " << modelPath << " (" << megabytesRead << " MB, " << legacy.vertices.size() / 3 << " triangles), best of " << NUM_RUNS << " runs:" << std::endl;
+	out << "  loader                     ms       MB/s   max difference" << std::endl;
+	out << "  " << std::left << std::setw(20) << "old loader (fscanf)" << std::right
+		<< std::setw(10) << legacyMilliseconds
+		<< std::setw(11) << megabytesRead * 1000.0 / legacyMilliseconds
+		<< (isLegacyLoaded ? "" : "   old loader can't read this file, output not compared") << std::endl;
+
+	for (const auto& variant : variants)
+	{
+		TriangleSoup parsed;
+		bool isLoaded = false;
+		const auto milliseconds = timeBest(variant.load, parsed, isLoaded);
+
+		float maxDifference = 0.0f;
+		const auto isMatching = isLoaded && (!isLegacyLoaded || compare(legacy, parsed, maxDifference));
+		out << "  " << std::left << std::setw(20) << variant.name << std::right
+			<< std::setw(10) << milliseconds
+			<< std::setw(11) << megabytesRead * 1000.0 / milliseconds
+			<< "   " << std::scientific << std::setprecision(2) << maxDifference << std::fixed << std::setprecision(1)
+			<< (isMatching ? "" : "  MISMATCH") << std::endl;
+		if (!isMatching) {
+			result = 1;
+		}
+	}
+
+	out.flags(flags);
+	out.precision(precision);
+
+	if (path.empty()) {
+		std::remove(modelPath.c_str());
+	}
+	return result;
+}
+
+} // namespace obj_benchmark
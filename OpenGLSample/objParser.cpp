@@ -0,0 +1,796 @@
+// STL
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "common/objParser.h"
+
+namespace obj_parser {
+
+const size_t MIN_PARALLEL_BYTES = 1024 * 1024;
+
+} // namespace obj_parser
+
+namespace {
+
+// Exactly representable as double, so numbers with up to 19 digits and small exponents convert with one rounding
+const double POWERS_OF_TEN[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+const int MAX_EXACT_POWER = 22;
+
+// Longest number handed to strtod (inf, nan, hexadecimal)
+const size_t MAX_FALLBACK_LENGTH = 63;
+
+//* \brief Read-only mapping of a whole file, unmapped when destroyed.
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	~MappedFile()
+	{
+		close();
+	}
+
+	/** \brief Maps a file, empty files map to no data.
+	*   \param path Path of the file
+	*   \return True if the file could be opened and mapped.
+	*/
+	bool open(const char* path)
+	{
+		close();
+#ifdef _WIN32
+		_file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (_file == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(_file, &size))
+		{
+			close();
+			return false;
+		}
+		_size = static_cast<size_t>(size.QuadPart);
+		if (_size == 0) {
+			return true;
+		}
+
+		_mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (_mapping != nullptr) {
+			_data = static_cast<const char*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+		}
+		if (_data == nullptr)
+		{
+			close();
+			return false;
+		}
+#else
+		const auto file = ::open(path, O_RDONLY);
+		if (file < 0) {
+			return false;
+		}
+
+		struct stat status;
+		if (fstat(file, &status) != 0)
+		{
+			::close(file);
+			return false;
+		}
+		_size = static_cast<size_t>(status.st_size);
+		if (_size > 0)
+		{
+			auto* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+			if (data == MAP_FAILED)
+			{
+				::close(file);
+				_size = 0;
+				return false;
+			}
+
+			// All threads start reading at once, so the kernel may read ahead everywhere
+			madvise(data, _size, MADV_WILLNEED);
+			_data = static_cast<const char*>(data);
+		}
+
+		// The mapping keeps the file open
+		::close(file);
+#endif
+		return true;
+	}
+
+	//* \brief Unmaps the file.
+	void close()
+	{
+#ifdef _WIN32
+		if (_data != nullptr) {
+			UnmapViewOfFile(_data);
+		}
+		if (_mapping != nullptr) {
+			CloseHandle(_mapping);
+		}
+		if (_file != INVALID_HANDLE_VALUE) {
+			CloseHandle(_file);
+		}
+		_mapping = nullptr;
+		_file = INVALID_HANDLE_VALUE;
+#else
+		if (_data != nullptr) {
+			munmap(const_cast<char*>(_data), _size);
+		}
+#endif
+		_data = nullptr;
+		_size = 0;
+	}
+
+	//* \brief Gets the first character of the file, nullptr if it is empty.
+	const char* getData() const
+	{
+		return _data;
+	}
+
+	//* \brief Gets the size of the file in bytes.
+	size_t getSize() const
+	{
+		return _size;
+	}
+
+private:
+	const char* _data = nullptr; //!< Mapped contents
+	size_t _size = 0; //!< Bytes mapped
+#ifdef _WIN32
+	HANDLE _file = INVALID_HANDLE_VALUE; //!< Opened file
+	HANDLE _mapping = nullptr; //!< File mapping object of _file
+#endif
+};
+
+//* \brief Kind of line, decided by its first word.
+enum LineType
+{
+	OTHER,
+	POSITION,
+	UV,
+	NORMAL,
+	FACE,
+	GROUP
+};
+
+//* \brief Lines of a file parsed by one thread, and what they produced.
+struct Chunk
+{
+	const char* begin = nullptr; //!< First character of the first line
+	const char* end = nullptr; //!< Behind the last line (its newline included)
+	size_t numPositions = 0; //!< v lines, counted by the first pass
+	size_t numUVs = 0; //!< vt lines, counted by the first pass
+	size_t numNormals = 0; //!< vn lines, counted by the first pass
+	size_t firstPosition = 0; //!< Index of the first position of the chunk in the whole file
+	size_t firstUV = 0; //!< Index of the first uv of the chunk in the whole file
+	size_t firstNormal = 0; //!< Index of the first normal of the chunk in the whole file
+	size_t firstTriangle = 0; //!< Index of the first triangle of the chunk in the whole file
+	std::vector<ObjCorner> corners; //!< Triangles of the chunk, indices already resolved for the whole file
+	std::vector<ObjGroup> groups; //!< o / g lines, first triangle counted within the chunk
+	const char* errorLine = nullptr; //!< Start of the first line that couldn't be read, nullptr if none
+	const char* errorMessage = nullptr; //!< What was wrong with it
+};
+
+int getThreadCount(size_t numBytes, int numThreads)
+{
+	if (numThreads > 0) {
+		return numThreads;
+	}
+	if (numBytes < obj_parser::MIN_PARALLEL_BYTES) {
+		return 1;
+	}
+
+	const auto hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+	return std::max(1, hardwareThreads);
+}
+
+//* \brief Runs job(i) for every i below count, i = 0 on the calling thread and the others on threads of their own.
+template <typename Job>
+void forEachChunk(int count, const Job& job)
+{
+	std::vector<std::thread> threads;
+	threads.reserve(std::max(0, count - 1));
+	for (auto i = 1; i < count; i++) {
+		threads.emplace_back(job, i);
+	}
+	if (count > 0) {
+		job(0);
+	}
+
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
+
+inline bool isSpace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline bool isDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+inline const char* skipSpaces(const char* p, const char* end)
+{
+	while (p < end && isSpace(*p)) {
+		p++;
+	}
+	return p;
+}
+
+//* \brief Finds the newline ending the line starting at p, end if the last line has none.
+inline const char* findLineEnd(const char* p, const char* end)
+{
+	const auto* newline = static_cast<const char*>(memchr(p, '\n', end - p));
+	return newline != nullptr ? newline : end;
+}
+
+//* \brief Checks whether the line continues with a keyword followed by a space or the end of the line.
+inline bool isKeyword(const char* p, const char* end, const char* keyword, size_t length)
+{
+	const auto remaining = static_cast<size_t>(end - p);
+	return remaining >= length && memcmp(p, keyword, length) == 0 && (remaining == length || isSpace(p[length]));
+}
+
+/** \brief Decides the kind of a line from its first word.
+*   \param p First non-space character of the line, moved behind the keyword
+*   \param end End of the line
+*   \return Kind of line, OTHER for everything that is skipped.
+*/
+LineType getLineType(const char*& p, const char* end)
+{
+	static const struct
+	{
+		const char* keyword;
+		size_t length;
+		LineType type;
+	} KEYWORDS[] = {
+		{ "v", 1, POSITION },
+		{ "vt", 2, UV },
+		{ "vn", 2, NORMAL },
+		{ "f", 1, FACE },
+		{ "o", 1, GROUP },
+		{ "g", 1, GROUP }
+	};
+
+	if (p == end) {
+		return OTHER;
+	}
+	for (const auto& keyword : KEYWORDS)
+	{
+		if (isKeyword(p, end, keyword.keyword, keyword.length))
+		{
+			p += keyword.length;
+			return keyword.type;
+		}
+	}
+	return OTHER;
+}
+
+//* \brief Parses a number strtod understands but parseFloat doesn't (inf, nan, hexadecimal), copied out because the file isn't zero-terminated.
+const char* parseFloatFallback(const char* p, const char* end, float& value)
+{
+	auto tokenEnd = p;
+	while (tokenEnd < end && !isSpace(*tokenEnd)) {
+		tokenEnd++;
+	}
+	const auto length = static_cast<size_t>(tokenEnd - p);
+	if (length == 0 || length > MAX_FALLBACK_LENGTH) {
+		return nullptr;
+	}
+
+	char token[MAX_FALLBACK_LENGTH + 1];
+	memcpy(token, p, length);
+	token[length] = '\0';
+	char* parsedEnd = nullptr;
+	value = static_cast<float>(strtod(token, &parsedEnd));
+	return parsedEnd == token + length ? tokenEnd : nullptr;
+}
+
+/** \brief Parses a decimal number like 1, -0.5 or 1.5e-3.
+*   \param p First character of the number
+*   \param end End of the line
+*   \param value Parsed number
+*   \return Character behind the number, nullptr if there is no number or it isn't followed by a space or the line end.
+*/
+const char* parseFloat(const char* p, const char* end, float& value)
+{
+	const auto start = p;
+	auto isNegative = false;
+	if (p < end && (*p == '-' || *p == '+'))
+	{
+		isNegative = *p == '-';
+		p++;
+	}
+
+	// 19 digits fit into the mantissa, further ones only count for the exponent
+	const uint64_t MAX_MANTISSA = 1000000000000000000ULL;
+	uint64_t mantissa = 0;
+	auto exponent = 0;
+	auto numDigits = 0;
+	for (; p < end && isDigit(*p); p++, numDigits++)
+	{
+		if (mantissa < MAX_MANTISSA) {
+			mantissa = mantissa * 10 + (*p - '0');
+		} else {
+			exponent++;
+		}
+	}
+	if (p < end && *p == '.')
+	{
+		p++;
+		for (; p < end && isDigit(*p); p++, numDigits++)
+		{
+			if (mantissa < MAX_MANTISSA)
+			{
+				mantissa = mantissa * 10 + (*p - '0');
+				exponent--;
+			}
+		}
+	}
+	if (numDigits == 0) {
+		return parseFloatFallback(start, end, value);
+	}
+
+	if (p < end && (*p == 'e' || *p == 'E'))
+	{
+		p++;
+		auto isExponentNegative = false;
+		if (p < end && (*p == '-' || *p == '+'))
+		{
+			isExponentNegative = *p == '-';
+			p++;
+		}
+		if (p == end || !isDigit(*p)) {
+			return nullptr;
+		}
+		auto writtenExponent = 0;
+		for (; p < end && isDigit(*p); p++) {
+			writtenExponent = std::min(writtenExponent * 10 + (*p - '0'), 10000);
+		}
+		exponent += isExponentNegative ? -writtenExponent : writtenExponent;
+	}
+	if (p < end && !isSpace(*p)) {
+		return parseFloatFallback(start, end, value);
+	}
+
+	auto result = static_cast<double>(mantissa);
+	if (exponent < 0) {
+		result = exponent >= -MAX_EXACT_POWER ? result / POWERS_OF_TEN[-exponent] : result * std::pow(10.0, exponent);
+	} else if (exponent > 0) {
+		result = exponent <= MAX_EXACT_POWER ? result * POWERS_OF_TEN[exponent] : result * std::pow(10.0, exponent);
+	}
+	value = static_cast<float>(isNegative ? -result : result);
+	return p;
+}
+
+/** \brief Parses the numbers of a v, vt or vn line, numbers beyond maxCount (w, vertex colors) are skipped.
+*   \param p Behind the keyword
+*   \param end End of the line
+*   \param values Output for maxCount numbers, missing ones are left alone
+*   \param minCount Numbers the line must have
+*   \param maxCount Numbers read
+*   \return True if at least minCount numbers could be read.
+*/
+bool parseFloats(const char* p, const char* end, float* values, int minCount, int maxCount)
+{
+	for (auto i = 0; i < maxCount; i++)
+	{
+		p = skipSpaces(p, end);
+		if (p == end) {
+			return i >= minCount;
+		}
+		p = parseFloat(p, end, values[i]);
+		if (p == nullptr) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/** \brief Parses an index of a face corner.
+*   \param p First character of the index
+*   \param end End of the line
+*   \param index Parsed index, 1-based or negative
+*   \return Character behind the index, nullptr if there is none or it has more than 10 digits.
+*/
+const char* parseIndex(const char* p, const char* end, long long& index)
+{
+	auto isNegative = false;
+	if (p < end && *p == '-')
+	{
+		isNegative = true;
+		p++;
+	}
+
+	const auto digits = p;
+	long long value = 0;
+	for (; p < end && isDigit(*p) && p - digits < 10; p++) {
+		value = value * 10 + (*p - '0');
+	}
+	if (p == digits || (p < end && isDigit(*p))) {
+		return nullptr;
+	}
+
+	index = isNegative ? -value : value;
+	return p;
+}
+
+/** \brief Turns an OBJ index into a 0-based one.
+*   \param index 1-based index, or negative to count back from the last element defined so far
+*   \param numDefined Elements defined before the face
+*   \param numTotal Elements in the whole file
+*   \return 0-based index, -1 if the index is 0 or out of range.
+*/
+inline int resolveIndex(long long index, size_t numDefined, size_t numTotal)
+{
+	const auto resolved = index > 0 ? index - 1 : static_cast<long long>(numDefined) + index;
+	return index != 0 && resolved >= 0 && resolved < static_cast<long long>(numTotal) ? static_cast<int>(resolved) : -1;
+}
+
+//* \brief First pass, counts the v, vt and vn lines of a chunk.
+void countVertices(Chunk& chunk)
+{
+	auto p = chunk.begin;
+	while (p < chunk.end)
+	{
+		const auto lineEnd = findLineEnd(p, chunk.end);
+		p = skipSpaces(p, lineEnd);
+		if (p < lineEnd && *p == 'v')
+		{
+			switch (getLineType(p, lineEnd))
+			{
+			case POSITION:
+				chunk.numPositions++;
+				break;
+			case UV:
+				chunk.numUVs++;
+				break;
+			case NORMAL:
+				chunk.numNormals++;
+				break;
+			default:
+				break;
+			}
+		}
+		p = lineEnd < chunk.end ? lineEnd + 1 : chunk.end;
+	}
+}
+
+/** \brief Second pass, parses the lines of a chunk into the streams of the model and the triangles of the chunk.
+*   \param chunk Chunk with its first pass counts and offsets, stops at the first line that can't be read
+*   \param model Model with streams sized for the whole file
+*/
+void parseChunk(Chunk& chunk, ObjModel& model)
+{
+	auto* positions = model.positions.data() + chunk.firstPosition;
+	auto* uvs = model.uvs.data() + chunk.firstUV;
+	auto* normals = model.normals.data() + chunk.firstNormal;
+	size_t numPositions = 0;
+	size_t numUVs = 0;
+	size_t numNormals = 0;
+
+	auto p = chunk.begin;
+	while (p < chunk.end)
+	{
+		const auto line = p;
+		const auto lineEnd = findLineEnd(p, chunk.end);
+		const auto fail = [&chunk, line](const char* message)
+		{
+			chunk.errorLine = line;
+			chunk.errorMessage = message;
+		};
+
+		p = skipSpaces(p, lineEnd);
+		switch (getLineType(p, lineEnd))
+		{
+		case POSITION:
+			if (!parseFloats(p, lineEnd, &positions[numPositions++].x, 3, 3))
+			{
+				fail("Cannot read vertex position");
+				return;
+			}
+			break;
+		case UV:
+			if (!parseFloats(p, lineEnd, &uvs[numUVs++].x, 1, 2))
+			{
+				fail("Cannot read texture coordinate");
+				return;
+			}
+			break;
+		case NORMAL:
+			if (!parseFloats(p, lineEnd, &normals[numNormals++].x, 3, 3))
+			{
+				fail("Cannot read normal");
+				return;
+			}
+			break;
+		case FACE:
+		{
+			// Fan around the first corner, (first, previous, current) for every corner from the third on
+			ObjCorner first, previous, corner;
+			auto numCorners = 0;
+			while (true)
+			{
+				p = skipSpaces(p, lineEnd);
+				if (p == lineEnd) {
+					break;
+				}
+
+				long long index = 0;
+				p = parseIndex(p, lineEnd, index);
+				corner.position = p != nullptr ? resolveIndex(index, chunk.firstPosition + numPositions, model.positions.size()) : -1;
+				if (corner.position < 0)
+				{
+					fail("Invalid vertex index");
+					return;
+				}
+
+				corner.uv = -1;
+				corner.normal = -1;
+				if (p < lineEnd && *p == '/')
+				{
+					p++;
+					if (p < lineEnd && *p != '/')
+					{
+						p = parseIndex(p, lineEnd, index);
+						corner.uv = p != nullptr ? resolveIndex(index, chunk.firstUV + numUVs, model.uvs.size()) : -1;
+						if (corner.uv < 0)
+						{
+							fail("Invalid texture coordinate index");
+							return;
+						}
+					}
+					if (p < lineEnd && *p == '/')
+					{
+						p = parseIndex(p + 1, lineEnd, index);
+						corner.normal = p != nullptr ? resolveIndex(index, chunk.firstNormal + numNormals, model.normals.size()) : -1;
+						if (corner.normal < 0)
+						{
+							fail("Invalid normal index");
+							return;
+						}
+					}
+				}
+				if (p < lineEnd && !isSpace(*p))
+				{
+					fail("Cannot read face");
+					return;
+				}
+
+				if (numCorners == 0) {
+					first = corner;
+				}
+				else if (numCorners >= 2)
+				{
+					chunk.corners.push_back(first);
+					chunk.corners.push_back(previous);
+					chunk.corners.push_back(corner);
+				}
+				previous = corner;
+				numCorners++;
+			}
+			if (numCorners < 3)
+			{
+				fail("Face has less than 3 corners");
+				return;
+			}
+			break;
+		}
+		case GROUP:
+		{
+			auto nameEnd = lineEnd;
+			p = skipSpaces(p, lineEnd);
+			while (nameEnd > p && isSpace(nameEnd[-1])) {
+				nameEnd--;
+			}
+
+			ObjGroup group;
+			group.name.assign(p, nameEnd);
+			group.firstTriangle = chunk.corners.size() / 3;
+			chunk.groups.push_back(group);
+			break;
+		}
+		default:
+			break;
+		}
+		p = lineEnd < chunk.end ? lineEnd + 1 : chunk.end;
+	}
+}
+
+} // namespace
+
+namespace obj_parser {
+
+bool parseFile(const char* path, ObjModel& model, int numThreads)
+{
+	MappedFile file;
+	if (!file.open(path))
+	{
+		model = ObjModel();
+		std::cout << "Cannot open OBJ file " << path << "!" << std::endl;
+		return false;
+	}
+	return parseText(file.getData(), file.getSize(), model, numThreads, path);
+}
+
+bool parseText(const char* text, size_t size, ObjModel& model, int numThreads, const char* name)
+{
+	model = ObjModel();
+	if (size == 0) {
+		return true;
+	}
+
+	// Chunks end behind the first newline after their share of the text, so no line is split
+	const auto numChunks = static_cast<int>(std::min(static_cast<size_t>(getThreadCount(size, numThreads)), size));
+	const auto* end = text + size;
+	std::vector<Chunk> chunks(numChunks);
+	auto begin = text;
+	for (auto i = 0; i < numChunks; i++)
+	{
+		auto chunkEnd = end;
+		if (i + 1 < numChunks)
+		{
+			const auto target = std::max(begin, text + size / numChunks * (i + 1));
+			chunkEnd = target < end ? findLineEnd(target, end) : end;
+			chunkEnd = chunkEnd < end ? chunkEnd + 1 : end;
+		}
+		chunks[i].begin = begin;
+		chunks[i].end = chunkEnd;
+		begin = chunkEnd;
+	}
+
+	forEachChunk(numChunks, [&chunks](int i) { countVertices(chunks[i]); });
+
+	size_t numPositions = 0;
+	size_t numUVs = 0;
+	size_t numNormals = 0;
+	for (auto& chunk : chunks)
+	{
+		chunk.firstPosition = numPositions;
+		chunk.firstUV = numUVs;
+		chunk.firstNormal = numNormals;
+		numPositions += chunk.numPositions;
+		numUVs += chunk.numUVs;
+		numNormals += chunk.numNormals;
+	}
+	if (std::max(numPositions, std::max(numUVs, numNormals)) > static_cast<size_t>(INT_MAX))
+	{
+		std::cout << name << " has too many vertices to index!" << std::endl;
+		return false;
+	}
+	model.positions.resize(numPositions);
+	model.uvs.resize(numUVs);
+	model.normals.resize(numNormals);
+
+	forEachChunk(numChunks, [&chunks, &model](int i) { parseChunk(chunks[i], model); });
+
+	for (const auto& chunk : chunks)
+	{
+		if (chunk.errorLine != nullptr)
+		{
+			const auto lineNumber = std::count(text, chunk.errorLine, '\n') + 1;
+			std::cout << chunk.errorMessage << " in " << name << " line " << lineNumber << "!" << std::endl;
+			model = ObjModel();
+			return false;
+		}
+	}
+
+	// Triangles of the chunks copied together, in parallel as well
+	size_t numCorners = 0;
+	for (auto& chunk : chunks)
+	{
+		chunk.firstTriangle = numCorners / 3;
+		numCorners += chunk.corners.size();
+	}
+	model.corners.resize(numCorners);
+	forEachChunk(numChunks, [&chunks, &model](int i)
+	{
+		std::copy(chunks[i].corners.begin(), chunks[i].corners.end(), model.corners.begin() + chunks[i].firstTriangle * 3);
+		std::vector<ObjCorner>().swap(chunks[i].corners);
+	});
+
+	// A group goes on until the next one starts, also into later chunks
+	for (const auto& chunk : chunks)
+	{
+		for (auto group : chunk.groups)
+		{
+			group.firstTriangle += chunk.firstTriangle;
+			model.groups.push_back(group);
+		}
+	}
+	if (model.groups.empty() || model.groups.front().firstTriangle > 0) {
+		model.groups.insert(model.groups.begin(), ObjGroup());
+	}
+
+	const auto numTriangles = model.getTriangleCount();
+	size_t numGroups = 0;
+	for (size_t i = 0; i < model.groups.size(); i++)
+	{
+		const auto groupEnd = i + 1 < model.groups.size() ? model.groups[i + 1].firstTriangle : numTriangles;
+		model.groups[i].numTriangles = groupEnd - model.groups[i].firstTriangle;
+		if (model.groups[i].numTriangles == 0) {
+			continue;
+		}
+		if (numGroups != i) {
+			model.groups[numGroups] = std::move(model.groups[i]);
+		}
+		numGroups++;
+	}
+	model.groups.resize(numGroups);
+	return true;
+}
+
+void toTriangleSoup(const ObjModel& model, std::vector<glm::vec3>& vertices, std::vector<glm::vec2>& uvs,
+	std::vector<glm::vec3>& normals, int numThreads)
+{
+	const auto numTriangles = model.getTriangleCount();
+	vertices.resize(numTriangles * 3);
+	uvs.resize(numTriangles * 3);
+	normals.resize(numTriangles * 3);
+
+	const auto numBytes = numTriangles * 3 * (sizeof(glm::vec3) * 2 + sizeof(glm::vec2));
+	const auto numChunks = static_cast<int>(std::max<size_t>(1, std::min(static_cast<size_t>(getThreadCount(numBytes, numThreads)), numTriangles)));
+	forEachChunk(numChunks, [&](int chunk)
+	{
+		const auto firstTriangle = numTriangles * chunk / numChunks;
+		const auto endTriangle = numTriangles * (chunk + 1) / numChunks;
+		for (auto triangle = firstTriangle; triangle < endTriangle; triangle++)
+		{
+			const auto* corners = &model.corners[triangle * 3];
+			const auto& a = model.positions[corners[0].position];
+			const auto& b = model.positions[corners[1].position];
+			const auto& c = model.positions[corners[2].position];
+
+			// Only computed if a corner has no normal, degenerate triangles get a zero normal
+			auto faceNormal = glm::vec3(0.0f);
+			if (corners[0].normal < 0 || corners[1].normal < 0 || corners[2].normal < 0)
+			{
+				const auto cross = glm::cross(b - a, c - a);
+				const auto length = glm::length(cross);
+				if (length > 0.0f) {
+					faceNormal = cross / length;
+				}
+			}
+
+			for (auto i = 0; i < 3; i++)
+			{
+				const auto& corner = corners[i];
+				const auto vertex = triangle * 3 + i;
+				vertices[vertex] = model.positions[corner.position];
+				uvs[vertex] = corner.uv >= 0 ? model.uvs[corner.uv] : glm::vec2(0.0f);
+				normals[vertex] = corner.normal >= 0 ? model.normals[corner.normal] : faceNormal;
+			}
+		}
+	});
+}
+
+} // namespace obj_parser
@@ -0,0 +1,72 @@
+#include <iostream>
+
+#include "common/offscreenFramebuffer.h"
+#include "common/resourceTracker.h"
+
+bool OffscreenFramebuffer::create(int width, int height)
+{
+	if (_isCreated)
+	{
+		std::cout << "This framebuffer is already created! You need to delete it before re-creating it!" << std::endl;
+		return false;
+	}
+
+	_framebuffer = GLFramebuffer::create();
+	glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer.get());
+
+	_colorRenderbuffer = GLRenderbuffer::create();
+	glBindRenderbuffer(GL_RENDERBUFFER, _colorRenderbuffer.get());
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+	TRACK_RESOURCE(RENDERBUFFER, _colorRenderbuffer.get(), static_cast<size_t>(width) * height * 4, "framebuffers");
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, _colorRenderbuffer.get());
+
+	_depthRenderbuffer = GLRenderbuffer::create();
+	glBindRenderbuffer(GL_RENDERBUFFER, _depthRenderbuffer.get());
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+	// 24-bit depth is stored in 32 bits
+	TRACK_RESOURCE(RENDERBUFFER, _depthRenderbuffer.get(), static_cast<size_t>(width) * height * 4, "framebuffers");
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, _depthRenderbuffer.get());
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	_width = width;
+	_height = height;
+	_isCreated = true;
+
+	const auto status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "Offscreen framebuffer is not complete (status 0x" << std::hex << status << std::dec << ")" << std::endl;
+		deleteFramebuffer();
+		return false;
+	}
+
+	return true;
+}
+
+void OffscreenFramebuffer::bind() const
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer.get());
+}
+
+int OffscreenFramebuffer::getWidth() const
+{
+	return _width;
+}
+
+int OffscreenFramebuffer::getHeight() const
+{
+	return _height;
+}
+
+void OffscreenFramebuffer::deleteFramebuffer()
+{
+	if (!_isCreated) {
+		return;
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	_colorRenderbuffer.reset();
+	_depthRenderbuffer.reset();
+	_framebuffer.reset();
+	_isCreated = false;
+}
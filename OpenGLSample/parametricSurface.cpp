@@ -0,0 +1,165 @@
+#include <cmath>
+
+#include "common/parametricSurface.h"
+
+// SSE2 is always there on x64, on x86 MSVC defines _M_IX86_FP with /arch:SSE2 (the default)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARAMETRIC_SURFACE_SSE
+#endif
+
+namespace parametric_surface {
+
+const size_t MIN_PARALLEL_VERTICES = 65536;
+
+} // namespace parametric_surface
+
+namespace {
+
+#ifdef PARAMETRIC_SURFACE_SSE
+/** \brief Computes sine and cosine of four angles at once (Cephes single precision polynomials).
+*   \param x Angles in radians, |x| up to a few thousand
+*   \param sines Output sines
+*   \param cosines Output cosines
+*/
+void sinCos4(__m128 x, __m128& sines, __m128& cosines)
+{
+	const auto signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000)));
+
+	// sin is odd, cos is even, so both are computed for |x| and the sign of sin is restored at the end
+	auto sinSign = _mm_and_ps(x, signMask);
+	x = _mm_andnot_ps(signMask, x);
+
+	// Octant j of x, rounded up to even, and x reduced into [-pi/4, pi/4] by extended precision pi/4
+	auto octant = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.27323954473516f)));
+	octant = _mm_and_si128(_mm_add_epi32(octant, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+	const auto y = _mm_cvtepi32_ps(octant);
+	x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(0.78515625f)));
+	x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(2.4187564849853515625e-4f)));
+	x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(3.77489497744594108e-8f)));
+
+	// Octants 4..7 flip the sign of sin, octants 2..5 flip the sign of cos
+	sinSign = _mm_xor_ps(sinSign, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(octant, _mm_set1_epi32(4)), 29)));
+	const auto cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(octant, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+
+	// Octants 2 and 6 swap the polynomials
+	const auto useSinPolynomial = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(octant, _mm_set1_epi32(2)), _mm_setzero_si128()));
+
+	const auto z = _mm_mul_ps(x, x);
+	auto cosPolynomial = _mm_set1_ps(2.443315711809948e-5f);
+	cosPolynomial = _mm_add_ps(_mm_mul_ps(cosPolynomial, z), _mm_set1_ps(-1.388731625493765e-3f));
+	cosPolynomial = _mm_add_ps(_mm_mul_ps(cosPolynomial, z), _mm_set1_ps(4.166664568298827e-2f));
+	cosPolynomial = _mm_mul_ps(_mm_mul_ps(cosPolynomial, z), z);
+	cosPolynomial = _mm_sub_ps(cosPolynomial, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+	cosPolynomial = _mm_add_ps(cosPolynomial, _mm_set1_ps(1.0f));
+
+	auto sinPolynomial = _mm_set1_ps(-1.9515295891e-4f);
+	sinPolynomial = _mm_add_ps(_mm_mul_ps(sinPolynomial, z), _mm_set1_ps(8.3321608736e-3f));
+	sinPolynomial = _mm_add_ps(_mm_mul_ps(sinPolynomial, z), _mm_set1_ps(-1.6666654611e-1f));
+	sinPolynomial = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinPolynomial, z), x), x);
+
+	const auto sinResult = _mm_or_ps(_mm_and_ps(useSinPolynomial, sinPolynomial), _mm_andnot_ps(useSinPolynomial, cosPolynomial));
+	const auto cosResult = _mm_or_ps(_mm_and_ps(useSinPolynomial, cosPolynomial), _mm_andnot_ps(useSinPolynomial, sinPolynomial));
+	sines = _mm_xor_ps(sinResult, sinSign);
+	cosines = _mm_xor_ps(cosResult, cosSign);
+}
+#endif
+
+} // namespace
+
+VertexStreams VertexStreams::interleaved(float* data, size_t floatsPerVertex, int positionOffset, int normalOffset, int texCoordOffset)
+{
+	VertexStreams streams;
+	streams.positions = positionOffset >= 0 ? data + positionOffset : nullptr;
+	streams.normals = normalOffset >= 0 ? data + normalOffset : nullptr;
+	streams.texCoords = texCoordOffset >= 0 ? data + texCoordOffset : nullptr;
+	streams.positionStride = streams.normalStride = streams.texCoordStride = floatsPerVertex;
+	return streams;
+}
+
+VertexStreams VertexStreams::planar(float* data, size_t numVertices, bool withPositions, bool withTextureCoordinates, bool withNormals)
+{
+	VertexStreams streams;
+	auto* block = data;
+	if (withPositions)
+	{
+		streams.positions = block;
+		block += numVertices * 3;
+	}
+	if (withTextureCoordinates)
+	{
+		streams.texCoords = block;
+		block += numVertices * 2;
+	}
+	if (withNormals) {
+		streams.normals = block;
+	}
+	return streams;
+}
+
+VertexStreams VertexStreams::skip(size_t numVertices) const
+{
+	auto streams = *this;
+	if (streams.positions != nullptr) {
+		streams.positions += numVertices * positionStride;
+	}
+	if (streams.normals != nullptr) {
+		streams.normals += numVertices * normalStride;
+	}
+	if (streams.texCoords != nullptr) {
+		streams.texCoords += numVertices * texCoordStride;
+	}
+	return streams;
+}
+
+namespace parametric_surface {
+
+void fillSinCosTable(float start, float step, int count, float* sines, float* cosines)
+{
+	auto i = 0;
+#ifdef PARAMETRIC_SURFACE_SSE
+	const auto steps = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+	for (; i + 4 <= count; i += 4)
+	{
+		// start + index * step, like a scalar loop would compute it (no accumulated error)
+		const auto indices = _mm_add_ps(_mm_set1_ps(static_cast<float>(i)), steps);
+		const auto angles = _mm_add_ps(_mm_set1_ps(start), _mm_mul_ps(indices, _mm_set1_ps(step)));
+		__m128 s, c;
+		sinCos4(angles, s, c);
+		_mm_storeu_ps(sines + i, s);
+		_mm_storeu_ps(cosines + i, c);
+	}
+#endif
+	for (; i < count; i++)
+	{
+		const auto angle = start + static_cast<float>(i) * step;
+		sines[i] = std::sin(angle);
+		cosines[i] = std::cos(angle);
+	}
+}
+
+size_t getIndexCount(const ParametricGrid& grid, GridTriangulation triangulation)
+{
+	const auto numQuads = static_cast<size_t>(grid.outerSegments) * grid.innerSegments;
+	if (triangulation == GridTriangulation::QUADS) {
+		return numQuads * 6;
+	}
+
+	// First and last band lose one triangle per quad to the poles
+	return grid.outerSegments < 2 ? 0 : (numQuads - grid.innerSegments) * 6;
+}
+
+int getThreadCount(size_t numVertices, int numThreads)
+{
+	if (numThreads > 0) {
+		return numThreads;
+	}
+	if (numVertices < MIN_PARALLEL_VERTICES) {
+		return 1;
+	}
+
+	const auto hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+	return std::max(1, hardwareThreads);
+}
+
+} // namespace parametric_surface
@@ -0,0 +1,333 @@
+// STL
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include "common/profiler.h"
+
+const int Profiler::FRAMES_IN_FLIGHT         = 4;
+const int Profiler::MAX_GPU_SCOPES_PER_FRAME = 256;
+const int Profiler::MAX_CAPTURED_FRAMES      = 5000;
+
+namespace {
+
+// Trace tracks, Chrome shows them as threads of one process
+const int TRACE_CPU_TRACK = 1;
+const int TRACE_GPU_TRACK = 2;
+
+double nowMicroseconds()
+{
+	using clock = std::chrono::steady_clock;
+	static const auto start = clock::now();
+	return std::chrono::duration<double, std::micro>(clock::now() - start).count();
+}
+
+size_t currentThreadHash()
+{
+	return std::hash<std::thread::id>()(std::this_thread::get_id());
+}
+
+void writeJsonString(std::ostream& out, const char* text)
+{
+	out << '"';
+	for (auto* c = text; *c != '\0'; c++)
+	{
+		if (*c == '"' || *c == '\\') {
+			out << '\\';
+		}
+		out << *c;
+	}
+	out << '"';
+}
+
+} // namespace
+
+Profiler& Profiler::get()
+{
+	static Profiler profiler;
+	return profiler;
+}
+
+void Profiler::create()
+{
+	if (_isCreated)
+	{
+		std::cout << "This profiler is already created! You need to delete it before re-creating it!" << std::endl;
+		return;
+	}
+
+	_slots.resize(FRAMES_IN_FLIGHT);
+	for (auto& slot : _slots)
+	{
+		slot.queries.resize(2 * MAX_GPU_SCOPES_PER_FRAME);
+		glGenQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data());
+		slot.events.reserve(MAX_GPU_SCOPES_PER_FRAME);
+	}
+
+	// GPU timestamps count from an arbitrary point, line them up with the CPU clock once
+	GLint64 gpuNanoseconds = 0;
+	glGetInteger64v(GL_TIMESTAMP, &gpuNanoseconds);
+	_gpuToCpuOffsetMicroseconds = nowMicroseconds() - gpuNanoseconds / 1000.0;
+
+	_ownerThread = currentThreadHash();
+	_framesBegun = _framesResolved = 0;
+	_isCreated = true;
+}
+
+bool Profiler::isRecordingThread() const
+{
+	return _isCreated && currentThreadHash() == _ownerThread;
+}
+
+void Profiler::beginFrame()
+{
+	if (!isRecordingThread()) {
+		return;
+	}
+
+	// Pool of this slot is still in flight from FRAMES_IN_FLIGHT frames ago, collect it first
+	if (_framesBegun - _framesResolved >= FRAMES_IN_FLIGHT) {
+		resolveOldestFrame(true);
+	}
+
+	auto& slot = _slots[_framesBegun % FRAMES_IN_FLIGHT];
+	slot.events.clear();
+	slot.usedQueries = 0;
+	slot.isPending = true;
+	slot.isCaptured = _isCapturing;
+	_openScopes.clear();
+	_isInFrame = true;
+}
+
+void Profiler::endFrame()
+{
+	if (!isRecordingThread() || !_isInFrame) {
+		return;
+	}
+
+	while (!_openScopes.empty())
+	{
+		std::cout << "Profiler scope '" << _slots[_framesBegun % FRAMES_IN_FLIGHT].events[_openScopes.back()].name
+			<< "' is still open at the end of the frame!" << std::endl;
+		endScope();
+	}
+
+	_isInFrame = false;
+	_framesBegun++;
+	if (_isCapturing && ++_capturedFrames >= MAX_CAPTURED_FRAMES) {
+		_isCapturing = false;
+	}
+
+	// Opportunistically collect frames that are already finished, without waiting
+	while (_framesResolved < _framesBegun - 1 && resolveOldestFrame(false)) {}
+}
+
+void Profiler::beginScope(const char* name)
+{
+	if (!_isInFrame || !isRecordingThread()) {
+		return;
+	}
+
+	auto& slot = _slots[_framesBegun % FRAMES_IN_FLIGHT];
+	ScopeEvent event;
+	event.name = name;
+	event.depth = static_cast<int>(_openScopes.size());
+	event.frame = _capturedFrames;
+	event.gpuBeginMicroseconds = event.gpuEndMicroseconds = -1.0;
+	event.firstQuery = -1;
+	if (slot.usedQueries + 2 <= static_cast<int>(slot.queries.size()))
+	{
+		event.firstQuery = slot.usedQueries;
+		glQueryCounter(slot.queries[slot.usedQueries], GL_TIMESTAMP);
+		slot.usedQueries += 2;
+	}
+
+	_openScopes.push_back(static_cast<int>(slot.events.size()));
+	event.cpuBeginMicroseconds = event.cpuEndMicroseconds = nowMicroseconds();
+	slot.events.push_back(event);
+}
+
+void Profiler::endScope()
+{
+	if (_openScopes.empty() || !isRecordingThread()) {
+		return;
+	}
+
+	auto& slot = _slots[_framesBegun % FRAMES_IN_FLIGHT];
+	auto& event = slot.events[_openScopes.back()];
+	_openScopes.pop_back();
+
+	event.cpuEndMicroseconds = nowMicroseconds();
+	if (event.firstQuery >= 0) {
+		glQueryCounter(slot.queries[event.firstQuery + 1], GL_TIMESTAMP);
+	}
+}
+
+bool Profiler::resolveOldestFrame(bool wait)
+{
+	auto& slot = _slots[_framesResolved % FRAMES_IN_FLIGHT];
+
+	// Queries finish in order, so the last one tells about the whole frame
+	if (!wait && slot.usedQueries > 0)
+	{
+		GLint isAvailable = GL_FALSE;
+		glGetQueryObjectiv(slot.queries[slot.usedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+		if (!isAvailable) {
+			return false;
+		}
+	}
+
+	for (auto& event : slot.events)
+	{
+		if (event.firstQuery < 0) {
+			continue;
+		}
+
+		GLuint64 beginNanoseconds = 0, endNanoseconds = 0;
+		glGetQueryObjectui64v(slot.queries[event.firstQuery], GL_QUERY_RESULT, &beginNanoseconds);
+		glGetQueryObjectui64v(slot.queries[event.firstQuery + 1], GL_QUERY_RESULT, &endNanoseconds);
+		event.gpuBeginMicroseconds = beginNanoseconds / 1000.0 + _gpuToCpuOffsetMicroseconds;
+		event.gpuEndMicroseconds = endNanoseconds / 1000.0 + _gpuToCpuOffsetMicroseconds;
+	}
+
+	if (slot.isCaptured) {
+		_capturedEvents.insert(_capturedEvents.end(), slot.events.begin(), slot.events.end());
+	}
+
+	slot.isPending = false;
+	_framesResolved++;
+	return true;
+}
+
+void Profiler::startCapture()
+{
+	_capturedEvents.clear();
+	_capturedFrames = 0;
+	_isCapturing = true;
+}
+
+void Profiler::stopCapture()
+{
+	_isCapturing = false;
+	if (!isRecordingThread()) {
+		return;
+	}
+
+	while (_framesResolved < _framesBegun) {
+		resolveOldestFrame(true);
+	}
+}
+
+bool Profiler::isCapturing() const
+{
+	return _isCapturing;
+}
+
+int Profiler::getNumCapturedFrames() const
+{
+	return _capturedFrames;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) const
+{
+	std::ofstream file(path);
+	if (!file)
+	{
+		std::cout << "Failed to open trace file " << path << std::endl;
+		return false;
+	}
+
+	file << std::fixed << std::setprecision(3);
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << TRACE_CPU_TRACK << ",\"args\":{\"name\":\"CPU\"}},\n";
+	file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << TRACE_GPU_TRACK << ",\"args\":{\"name\":\"GPU\"}}";
+
+	for (const auto& event : _capturedEvents)
+	{
+		file << ",\n{\"name\":";
+		writeJsonString(file, event.name);
+		file << ",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << TRACE_CPU_TRACK
+			<< ",\"ts\":" << event.cpuBeginMicroseconds << ",\"dur\":" << event.cpuEndMicroseconds - event.cpuBeginMicroseconds
+			<< ",\"args\":{\"frame\":" << event.frame << "}}";
+
+		if (event.gpuBeginMicroseconds < 0.0) {
+			continue;
+		}
+
+		file << ",\n{\"name\":";
+		writeJsonString(file, event.name);
+		file << ",\"cat\":\"gpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << TRACE_GPU_TRACK
+			<< ",\"ts\":" << event.gpuBeginMicroseconds << ",\"dur\":" << event.gpuEndMicroseconds - event.gpuBeginMicroseconds
+			<< ",\"args\":{\"frame\":" << event.frame << "}}";
+	}
+
+	file << "\n]}\n";
+	return file.good();
+}
+
+void Profiler::printReport(std::ostream& out) const
+{
+	if (_capturedFrames == 0) {
+		return;
+	}
+
+	// Scopes with equal name and depth are summed, in the order they first appeared
+	struct ScopeTotal
+	{
+		const char* name;
+		int depth;
+		double cpuMicroseconds;
+		double gpuMicroseconds;
+	};
+	std::vector<ScopeTotal> totals;
+	for (const auto& event : _capturedEvents)
+	{
+		auto it = totals.begin();
+		while (it != totals.end() && !(it->depth == event.depth && std::string(it->name) == event.name)) {
+			++it;
+		}
+		if (it == totals.end()) {
+			it = totals.insert(totals.end(), ScopeTotal{ event.name, event.depth, 0.0, 0.0 });
+		}
+
+		it->cpuMicroseconds += event.cpuEndMicroseconds - event.cpuBeginMicroseconds;
+		if (event.gpuBeginMicroseconds >= 0.0) {
+			it->gpuMicroseconds += event.gpuEndMicroseconds - event.gpuBeginMicroseconds;
+		}
+	}
+
+	const auto flags = out.flags();
+	const auto precision = out.precision();
+
+	out << std::fixed << std::setprecision(3);
+	out << "Profiler scopes, mean per frame over " << _capturedFrames << " frames (CPU ms / GPU ms):" << std::endl;
+	for (const auto& total : totals)
+	{
+		out << "  " << std::string(2 * total.depth, ' ') << total.name << ": "
+			<< total.cpuMicroseconds / 1000.0 / _capturedFrames << " / "
+			<< total.gpuMicroseconds / 1000.0 / _capturedFrames << std::endl;
+	}
+
+	out.flags(flags);
+	out.precision(precision);
+}
+
+void Profiler::deleteProfiler()
+{
+	if (!_isCreated) {
+		return;
+	}
+
+	for (auto& slot : _slots) {
+		glDeleteQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data());
+	}
+	_slots.clear();
+	_openScopes.clear();
+	_capturedEvents.clear();
+	_capturedFrames = 0;
+	_isInFrame = _isCapturing = false;
+	_isCreated = false;
+}
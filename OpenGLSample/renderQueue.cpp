@@ -0,0 +1,147 @@
+#include <algorithm>
+
+#include "common/renderQueue.h"
+#include "common/uniformBlocks.h"
+#include "common/profiler.h"
+#include "common/indexBufferBuilder.h"
+
+namespace {
+
+const int PROGRAM_BITS = 10;
+const int MATERIAL_BITS = 16;
+const int VAO_BITS = 14;
+const int DEPTH_BITS = 24;
+
+uint64_t maskBits(uint64_t value, int bits)
+{
+	return value & ((uint64_t(1) << bits) - 1);
+}
+
+} // namespace
+
+uint64_t RenderQueue::makeSortKey(GLuint program, GLuint diffuseMap, GLuint specularMap, GLuint vao, float viewDepth, float farPlane)
+{
+	// Both textures of a material are usually created together, so mixing them keeps pairs apart
+	const auto material = diffuseMap * 256u + specularMap;
+
+	auto normalizedDepth = farPlane > 0.0f ? viewDepth / farPlane : 0.0f;
+	normalizedDepth = std::min(std::max(normalizedDepth, 0.0f), 1.0f);
+	const auto depth = static_cast<uint64_t>(normalizedDepth * float((1 << DEPTH_BITS) - 1));
+
+	uint64_t key = maskBits(program, PROGRAM_BITS);
+	key = (key << MATERIAL_BITS) | maskBits(material, MATERIAL_BITS);
+	key = (key << VAO_BITS) | maskBits(vao, VAO_BITS);
+	key = (key << DEPTH_BITS) | depth;
+	return key;
+}
+
+void RenderQueue::clear()
+{
+	_packets.clear();
+}
+
+void RenderQueue::submit(const DrawPacket& packet)
+{
+	_packets.push_back(packet);
+}
+
+void RenderQueue::execute(const UniformRingBuffer& uniformRing)
+{
+	_order.resize(_packets.size());
+	for (size_t i = 0; i < _order.size(); i++) {
+		_order[i] = i;
+	}
+
+	// Stable sort keeps submission order for packets with equal keys
+	std::stable_sort(_order.begin(), _order.end(), [this](size_t a, size_t b) {
+		return _packets[a].sortKey < _packets[b].sortKey;
+	});
+
+	// State is unknown at the beginning of every frame, anything else could have changed it
+	Stats stats;
+	auto naiveStateChanges = 0;
+	auto hasState = false;
+	GLuint currentProgram = 0;
+	GLuint currentTextures[2] = { 0, 0 };
+	GLuint currentVAO = 0;
+	GLenum restartIndexType = 0; // index type primitive restart is enabled for, 0 if disabled
+
+	for (auto index : _order)
+	{
+		const auto& packet = _packets[index];
+		PROFILE_SCOPE(packet.name);
+		naiveStateChanges += 2;
+
+		if (!hasState || packet.program != currentProgram)
+		{
+			glUseProgram(packet.program);
+			currentProgram = packet.program;
+			stats.programBinds++;
+		}
+
+		// Programs without textures leave whatever is bound untouched
+		const GLuint textures[2] = { packet.diffuseMap, packet.specularMap };
+		for (int unit = 0; unit < 2; unit++)
+		{
+			if (textures[unit] == 0) {
+				continue;
+			}
+
+			naiveStateChanges++;
+			if (!hasState || textures[unit] != currentTextures[unit])
+			{
+				glActiveTexture(GL_TEXTURE0 + unit);
+				glBindTexture(GL_TEXTURE_2D, textures[unit]);
+				currentTextures[unit] = textures[unit];
+				stats.textureBinds++;
+			}
+		}
+
+		if (!hasState || packet.vao != currentVAO)
+		{
+			glBindVertexArray(packet.vao);
+			currentVAO = packet.vao;
+			stats.vaoBinds++;
+		}
+
+		hasState = true;
+		uniformRing.bindRange(OBJECT_BLOCK_BINDING, packet.objectBlockOffset, sizeof(ObjectBlock));
+
+		if (packet.indexType == 0) {
+			glDrawArrays(packet.primitiveType, packet.first, packet.count);
+		}
+		else {
+			// Stripified indices are separated by the largest value of their type
+			if (packet.primitiveType == GL_TRIANGLE_STRIP && packet.indexType != restartIndexType)
+			{
+				IndexBufferBuilder::enablePrimitiveRestart(packet.indexType);
+				restartIndexType = packet.indexType;
+			}
+
+			const auto indexSize = packet.indexType == GL_UNSIGNED_INT ? 4 : packet.indexType == GL_UNSIGNED_SHORT ? 2 : 1;
+			glDrawElements(packet.primitiveType, packet.count, packet.indexType, (void*)(size_t(packet.first) * indexSize));
+		}
+		stats.draws++;
+	}
+
+	if (restartIndexType != 0) {
+		glDisable(GL_PRIMITIVE_RESTART);
+	}
+
+	stats.avoidedStateChanges = naiveStateChanges - stats.programBinds - stats.textureBinds - stats.vaoBinds;
+	_lastFrameStats = stats;
+}
+
+const RenderQueue::Stats& RenderQueue::getLastFrameStats() const
+{
+	return _lastFrameStats;
+}
+
+void RenderQueue::printStats(std::ostream& os) const
+{
+	os << "Render queue (last frame): " << _lastFrameStats.draws << " draws, "
+		<< _lastFrameStats.programBinds << " program binds, "
+		<< _lastFrameStats.textureBinds << " texture binds, "
+		<< _lastFrameStats.vaoBinds << " VAO binds, "
+		<< _lastFrameStats.avoidedStateChanges << " redundant state changes avoided" << std::endl;
+}
@@ -0,0 +1,313 @@
+// STL
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+#include <glad/glad.h>
+
+#include "common/resourceTracker.h"
+
+namespace {
+
+const char* TYPE_NAMES[ResourceTracker::NUM_TYPES] = { "buffers", "textures", "renderbuffers", "programs" };
+const char* SINGULAR_TYPE_NAMES[ResourceTracker::NUM_TYPES] = { "buffer", "texture", "renderbuffer", "program" };
+
+// __FILE__ may be a full path, the file name is enough to find the site
+const char* getFileName(const char* path)
+{
+	const char* name = path;
+	for (auto* c = path; *c != '\0'; c++)
+	{
+		if (*c == '/' || *c == '\\') {
+			name = c + 1;
+		}
+	}
+	return name;
+}
+
+void printBytes(size_t bytes, std::ostream& os)
+{
+	if (bytes >= 1024 * 1024) {
+		os << bytes / (1024.0 * 1024.0) << " MiB";
+	}
+	else {
+		os << bytes / 1024.0 << " KiB";
+	}
+}
+
+void printUsage(const ResourceTracker::Usage& usage, std::ostream& os)
+{
+	printBytes(usage.getTotalBytes(), os);
+	os << " (";
+	auto isFirst = true;
+	for (int type = 0; type < ResourceTracker::NUM_TYPES; type++)
+	{
+		if (usage.count[type] == 0) {
+			continue;
+		}
+		os << (isFirst ? "" : ", ") << usage.count[type] << " " << (usage.count[type] == 1 ? SINGULAR_TYPE_NAMES[type] : TYPE_NAMES[type]);
+		isFirst = false;
+	}
+	os << ")";
+	if (usage.hostBytes > 0)
+	{
+		os << ", CPU copies ";
+		printBytes(usage.hostBytes, os);
+	}
+}
+
+} // namespace
+
+int ResourceTracker::Usage::getTotalCount() const
+{
+	int total = 0;
+	for (auto typeCount : count) {
+		total += typeCount;
+	}
+	return total;
+}
+
+size_t ResourceTracker::Usage::getTotalBytes() const
+{
+	size_t total = 0;
+	for (auto typeBytes : bytes) {
+		total += typeBytes;
+	}
+	return total;
+}
+
+ResourceTracker& ResourceTracker::get()
+{
+	static ResourceTracker tracker;
+	return tracker;
+}
+
+void ResourceTracker::track(Type type, unsigned int id, size_t bytes, const char* owner, const char* file, int line)
+{
+	if (id == 0) {
+		return;
+	}
+
+	// Re-specifying an object from scratch counts as a new one
+	untrack(type, id);
+
+	Resource& resource = _resources[Key(type, id)];
+	resource.type = type;
+	resource.id = id;
+	resource.bytes = bytes;
+	resource.owner = owner;
+	resource.file = getFileName(file);
+	resource.line = line;
+	account(resource, 1);
+	checkBudget(resource.owner);
+}
+
+void ResourceTracker::resize(Type type, unsigned int id, size_t bytes)
+{
+	auto itResource = _resources.find(Key(type, id));
+	if (itResource == _resources.end()) {
+		return;
+	}
+
+	account(itResource->second, -1);
+	itResource->second.bytes = bytes;
+	account(itResource->second, 1);
+	checkBudget(itResource->second.owner);
+}
+
+void ResourceTracker::setHostBytes(Type type, unsigned int id, size_t hostBytes)
+{
+	auto itResource = _resources.find(Key(type, id));
+	if (itResource == _resources.end()) {
+		return;
+	}
+
+	account(itResource->second, -1);
+	itResource->second.hostBytes = hostBytes;
+	account(itResource->second, 1);
+}
+
+void ResourceTracker::untrack(Type type, unsigned int id)
+{
+	auto itResource = _resources.find(Key(type, id));
+	if (itResource == _resources.end()) {
+		return;
+	}
+
+	account(itResource->second, -1);
+	_resources.erase(itResource);
+}
+
+const ResourceTracker::Resource* ResourceTracker::find(Type type, unsigned int id) const
+{
+	auto itResource = _resources.find(Key(type, id));
+	return itResource != _resources.end() ? &itResource->second : nullptr;
+}
+
+const ResourceTracker::Usage& ResourceTracker::getUsage() const
+{
+	return _usage;
+}
+
+ResourceTracker::Usage ResourceTracker::getUsage(const std::string& owner) const
+{
+	auto itUsage = _usageByOwner.find(owner);
+	return itUsage != _usageByOwner.end() ? itUsage->second : Usage();
+}
+
+std::vector<ResourceTracker::Resource> ResourceTracker::getResources() const
+{
+	std::vector<Resource> resources;
+	resources.reserve(_resources.size());
+	for (const auto& keyResource : _resources) {
+		resources.push_back(keyResource.second);
+	}
+
+	// The map is sorted by kind and name already, a stable sort keeps that within an owner
+	std::stable_sort(resources.begin(), resources.end(), [](const Resource& a, const Resource& b) { return a.owner < b.owner; });
+	return resources;
+}
+
+void ResourceTracker::setBudget(const std::string& owner, size_t bytes)
+{
+	_isBudgetExceeded.erase(owner);
+	if (bytes == 0)
+	{
+		_budgets.erase(owner);
+		return;
+	}
+
+	_budgets[owner] = bytes;
+	checkBudget(owner);
+}
+
+void ResourceTracker::printReport(const char* title, bool listResources, std::ostream& os) const
+{
+	const auto flags = os.flags();
+	const auto precision = os.precision();
+
+	os << std::fixed << std::setprecision(1);
+	os << title << ": ";
+	printUsage(_usage, os);
+	os << std::endl;
+
+	// Largest owners first
+	std::vector<std::pair<std::string, Usage>> owners(_usageByOwner.begin(), _usageByOwner.end());
+	std::stable_sort(owners.begin(), owners.end(), [](const std::pair<std::string, Usage>& a, const std::pair<std::string, Usage>& b) {
+		return a.second.getTotalBytes() > b.second.getTotalBytes();
+	});
+
+	const auto resources = listResources ? getResources() : std::vector<Resource>();
+	for (const auto& ownerUsage : owners)
+	{
+		os << "  " << std::left << std::setw(20) << ownerUsage.first << std::right << " ";
+		printUsage(ownerUsage.second, os);
+		auto itBudget = _budgets.find(ownerUsage.first);
+		if (itBudget != _budgets.end())
+		{
+			os << ", budget ";
+			printBytes(itBudget->second, os);
+			if (ownerUsage.second.getTotalBytes() > itBudget->second) {
+				os << " EXCEEDED";
+			}
+		}
+		os << std::endl;
+
+		for (const auto& resource : resources)
+		{
+			if (resource.owner != ownerUsage.first) {
+				continue;
+			}
+			os << "    " << SINGULAR_TYPE_NAMES[resource.type] << " " << resource.id << ": ";
+			printBytes(resource.bytes, os);
+			os << ", created at " << resource.file;
+			if (resource.line > 0) {
+				os << ":" << resource.line;
+			}
+			os << std::endl;
+		}
+	}
+
+	os.flags(flags);
+	os.precision(precision);
+}
+
+size_t ResourceTracker::getTextureBytes(int width, int height, int layers, int bytesPerTexel, bool isMipmapped)
+{
+	size_t bytes = 0;
+	while (true)
+	{
+		bytes += static_cast<size_t>(width) * height * layers * bytesPerTexel;
+		if (!isMipmapped || (width == 1 && height == 1)) {
+			break;
+		}
+		width = std::max(width / 2, 1);
+		height = std::max(height / 2, 1);
+	}
+	return bytes;
+}
+
+size_t ResourceTracker::getProgramBytes(unsigned int programID)
+{
+	const auto hasProgramBinary = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 1);
+	if (!hasProgramBinary || programID == 0) {
+		return 0;
+	}
+
+	GLint binaryLength = 0;
+	glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+	return static_cast<size_t>(std::max(binaryLength, 0));
+}
+
+const char* ResourceTracker::getTypeName(Type type)
+{
+	return TYPE_NAMES[type];
+}
+
+void ResourceTracker::clear()
+{
+	_resources.clear();
+	_usageByOwner.clear();
+	_usage = Usage();
+	_isBudgetExceeded.clear();
+}
+
+void ResourceTracker::account(const Resource& resource, int sign)
+{
+	auto& ownerUsage = _usageByOwner[resource.owner];
+	Usage* usages[] = { &ownerUsage, &_usage };
+	for (auto* usage : usages)
+	{
+		usage->count[resource.type] += sign;
+		if (sign > 0)
+		{
+			usage->bytes[resource.type] += resource.bytes;
+			usage->hostBytes += resource.hostBytes;
+		}
+		else
+		{
+			usage->bytes[resource.type] -= resource.bytes;
+			usage->hostBytes -= resource.hostBytes;
+		}
+	}
+
+	if (ownerUsage.getTotalCount() == 0) {
+		_usageByOwner.erase(resource.owner);
+	}
+}
+
+void ResourceTracker::checkBudget(const std::string& owner)
+{
+	auto itBudget = _budgets.find(owner);
+	if (itBudget == _budgets.end() || _isBudgetExceeded[owner]) {
+		return;
+	}
+
+	const auto bytes = getUsage(owner).getTotalBytes();
+	if (bytes > itBudget->second)
+	{
+		_isBudgetExceeded[owner] = true;
+		std::cout << "GPU memory of '" << owner << "' (" << bytes << " bytes) exceeds its budget of " << itBudget->second << " bytes!" << std::endl;
+	}
+}
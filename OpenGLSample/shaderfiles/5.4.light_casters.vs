@@ -1,21 +1,36 @@
-#version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
-layout (location = 2) in vec2 aTexCoords;
-
-out vec3 FragPos;
-out vec3 Normal;
-out vec2 TexCoords;
-
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
-void main()
-{
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;  
-    TexCoords = aTexCoords;
-    
-    gl_Position = projection * view * vec4(FragPos, 1.0);
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoords;
+flat out float Shininess;
+flat out float MaterialLayer;
+
+// per-frame camera state, shared with the light cube shader (binding point 0)
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;
+} camera;
+
+// per-object state, bound with a different offset for every draw (binding point 2)
+layout (std140) uniform Object {
+    mat4 model;
+    mat4 normalMatrix;
+    float shininess;
+    float materialLayer;
+} object;
+
+void main()
+{
+    FragPos = vec3(object.model * vec4(aPos, 1.0));
+    Normal = mat3(object.normalMatrix) * aNormal;  
+    TexCoords = aTexCoords;
+    Shininess = object.shininess;
+    MaterialLayer = object.materialLayer;
+    
+    gl_Position = camera.projection * camera.view * vec4(FragPos, 1.0);
 }
\ No newline at end of file
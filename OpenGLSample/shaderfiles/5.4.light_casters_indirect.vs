@@ -0,0 +1,49 @@
+#version 430 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+// index of the drawn object, per-instance attribute offset by the command's baseInstance (see IndirectDrawList)
+layout (location = 3) in uint aObjectIndex;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoords;
+flat out float Shininess;
+flat out float MaterialLayer;
+
+// per-frame camera state, shared with the light cube shader (binding point 0)
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;
+} camera;
+
+// per-object state of all objects drawn by multi-draw-indirect (storage buffer binding 3)
+struct ObjectData {
+    mat4 model;
+    mat4 normalMatrix;
+    vec4 sphere;
+    vec4 boxCenter;
+    vec4 boxExtents;
+    float shininess;
+    uint indexCount;
+    uint firstIndex;
+    int baseVertex;
+    float materialLayer;
+};
+
+layout (std430, binding = 3) readonly buffer Objects {
+    ObjectData objects[];
+};
+
+void main()
+{
+    ObjectData object = objects[aObjectIndex];
+    FragPos = vec3(object.model * vec4(aPos, 1.0));
+    Normal = mat3(object.normalMatrix) * aNormal;
+    TexCoords = aTexCoords;
+    Shininess = object.shininess;
+    MaterialLayer = object.materialLayer;
+    
+    gl_Position = camera.projection * camera.view * vec4(FragPos, 1.0);
+}
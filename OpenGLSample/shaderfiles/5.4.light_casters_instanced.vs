@@ -0,0 +1,39 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+// per-instance transforms, advanced once per instance (see InstanceBuffer)
+layout (location = 3) in mat4 aInstanceModel;
+layout (location = 7) in mat3 aInstanceNormalMatrix;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoords;
+flat out float Shininess;
+flat out float MaterialLayer;
+
+// per-frame camera state, shared with the light cube shader (binding point 0)
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;
+} camera;
+
+// per-object state shared by all instances, only shininess and material layer are used here (binding point 2)
+layout (std140) uniform Object {
+    mat4 model;
+    mat4 normalMatrix;
+    float shininess;
+    float materialLayer;
+} object;
+
+void main()
+{
+    FragPos = vec3(aInstanceModel * vec4(aPos, 1.0));
+    Normal = aInstanceNormalMatrix * aNormal;
+    TexCoords = aTexCoords;
+    Shininess = object.shininess;
+    MaterialLayer = object.materialLayer;
+    
+    gl_Position = camera.projection * camera.view * vec4(FragPos, 1.0);
+}
\ No newline at end of file
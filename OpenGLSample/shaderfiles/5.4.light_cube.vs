@@ -1,11 +1,20 @@
-#version 330 core
-layout (location = 0) in vec3 aPos;
-
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
-void main()
-{
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
+#version 330 core
+layout (location = 0) in vec3 aPos;
+
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;
+} camera;
+
+layout (std140) uniform Object {
+    mat4 model;
+    mat4 normalMatrix;
+    float shininess;
+    float materialLayer;
+} object;
+
+void main()
+{
+    gl_Position = camera.projection * camera.view * object.model * vec4(aPos, 1.0);
 }
\ No newline at end of file
@@ -0,0 +1,31 @@
+#version 430 core
+layout (location = 0) in vec3 aPos;
+layout (location = 3) in uint aObjectIndex;
+
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;
+} camera;
+
+struct ObjectData {
+    mat4 model;
+    mat4 normalMatrix;
+    vec4 sphere;
+    vec4 boxCenter;
+    vec4 boxExtents;
+    float shininess;
+    uint indexCount;
+    uint firstIndex;
+    int baseVertex;
+    float materialLayer;
+};
+
+layout (std430, binding = 3) readonly buffer Objects {
+    ObjectData objects[];
+};
+
+void main()
+{
+    gl_Position = camera.projection * camera.view * objects[aObjectIndex].model * vec4(aPos, 1.0);
+}
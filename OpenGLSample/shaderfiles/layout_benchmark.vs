@@ -0,0 +1,20 @@
+#version 330 core
+// attribute locations of StaticMesh3D
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec2 aTexCoords;
+layout (location = 2) in vec3 aNormal;
+// per-instance transforms (see InstanceBuffer)
+layout (location = 3) in mat4 aInstanceModel;
+layout (location = 7) in mat3 aInstanceNormalMatrix;
+
+out vec3 Color;
+
+uniform mat4 viewProjection;
+
+void main()
+{
+    // every attribute is fetched and used, so the layout decides how much memory the fetch touches
+    vec3 normal = normalize(aInstanceNormalMatrix * aNormal);
+    Color = vec3(aTexCoords, 0.5) * (0.5 + 0.5 * normal.y);
+    gl_Position = viewProjection * aInstanceModel * vec4(aPos, 1.0);
+}
@@ -0,0 +1,11 @@
+#version 330 core
+// depth-only pass, only the position attribute of StaticMesh3D is fetched
+layout (location = 0) in vec3 aPos;
+layout (location = 3) in mat4 aInstanceModel;
+
+uniform mat4 viewProjection;
+
+void main()
+{
+    gl_Position = viewProjection * aInstanceModel * vec4(aPos, 1.0);
+}
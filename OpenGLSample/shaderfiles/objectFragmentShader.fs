@@ -1,58 +1,58 @@
-#version 440 core 
-
-out vec4 FragColor;
-
-struct Material {
-    sampler2D diffuse;    
-    sampler2D specular;
-    float shininess;
-};
-
-struct Light {
-    vec3 position;
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-};
-
-in vec3 FragPos;
-in vec3 Normal;
-in vec2 TexCoords;
-
-uniform vec3 viewPos;
-uniform Material material;
-
-uniform Light keyLight;
-uniform Light fillLight;
-
-vec3 calcLight(Light light, vec3 normal, vec3 viewDir);
-
-void main()
-{
-    // properties
-    vec3 norm = normalize(Normal);
-    vec3 viewDir = normalize(viewPos - FragPos);
-
-    // Step 1: Key Lighting
-    vec3 result = calcLight(keyLight, norm, viewDir);
-
-    // Setp 2: Fill Lighting
-    result += calcLight(fillLight, norm, viewDir);
-
-    FragColor = vec4(result, 1.0);
-}
-
-vec3 calcLight(Light light, vec3 normal, vec3 viewDir)
-{
-    vec3 lightDir = normalize(light.position);
-    // diffuse shading
-    float diff = max(dot(normal, lightDir), 0.0);
-    // specular shading
-    vec3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-    // combine results
-    vec3 ambient = light.ambient * vec3(texture(material.diffuse, TexCoords));
-    vec3 diffuse = light.diffuse * diff * vec3(texture(material.diffuse, TexCoords));
-    vec3 specular = light.specular * spec * vec3(texture(material.specular, TexCoords));
-    return (ambient + diffuse + specular);
+#version 440 core 
+
+out vec4 FragColor;
+
+struct Material {
+    sampler2D diffuse;    
+    sampler2D specular;
+    float shininess;
+};
+
+struct Light {
+    vec3 position;
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+};
+
+in vec3 FragPos;
+in vec3 Normal;
+in vec2 TexCoords;
+
+uniform vec3 viewPos;
+uniform Material material;
+
+uniform Light keyLight;
+uniform Light fillLight;
+
+vec3 calcLight(Light light, vec3 normal, vec3 viewDir);
+
+void main()
+{
+    // properties
+    vec3 norm = normalize(Normal);
+    vec3 viewDir = normalize(viewPos - FragPos);
+
+    // Step 1: Key Lighting
+    vec3 result = calcLight(keyLight, norm, viewDir);
+
+    // Setp 2: Fill Lighting
+    result += calcLight(fillLight, norm, viewDir);
+
+    FragColor = vec4(result, 1.0);
+}
+
+vec3 calcLight(Light light, vec3 normal, vec3 viewDir)
+{
+    vec3 lightDir = normalize(light.position);
+    // diffuse shading
+    float diff = max(dot(normal, lightDir), 0.0);
+    // specular shading
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+    // combine results
+    vec3 ambient = light.ambient * vec3(texture(material.diffuse, TexCoords));
+    vec3 diffuse = light.diffuse * diff * vec3(texture(material.diffuse, TexCoords));
+    vec3 specular = light.specular * spec * vec3(texture(material.specular, TexCoords));
+    return (ambient + diffuse + specular);
 }
\ No newline at end of file
@@ -1,92 +1,241 @@
-#include "common/staticMesh3D.h"
-
-#include <glm/glm.hpp>
-
-namespace static_meshes_3D {
-
-const int StaticMesh3D::POSITION_ATTRIBUTE_INDEX           = 0;
-const int StaticMesh3D::TEXTURE_COORDINATE_ATTRIBUTE_INDEX = 1;
-const int StaticMesh3D::NORMAL_ATTRIBUTE_INDEX             = 2;
-
-StaticMesh3D::StaticMesh3D(bool withPositions, bool withTextureCoordinates, bool withNormals)
-	: _hasPositions(withPositions)
-	, _hasTextureCoordinates(withTextureCoordinates)
-	, _hasNormals(withNormals) {}
-
-StaticMesh3D::~StaticMesh3D()
-{
-	deleteMesh();
-}
-
-void StaticMesh3D::deleteMesh()
-{
-	if (!_isInitialized) {
-		return;
-	}
-
-	glDeleteVertexArrays(1, &_vao);
-	_vbo.deleteVBO();
-
-	_isInitialized = false;
-}
-
-bool StaticMesh3D::hasPositions() const
-{
-	return _hasPositions;
-}
-
-bool StaticMesh3D::hasTextureCoordinates() const
-{
-	return _hasTextureCoordinates;
-}
-
-bool StaticMesh3D::hasNormals() const
-{
-	return _hasNormals;
-}
-
-int StaticMesh3D::getVertexByteSize() const
-{
-	int result = 0;
-	if (hasPositions()) {
-		result += sizeof(glm::vec3);
-	}
-	if (hasTextureCoordinates()) {
-		result += sizeof(glm::vec2);
-	}
-	if (hasNormals()) {
-		result += sizeof(glm::vec3);
-	}
-
-	return result;
-}
-
-void StaticMesh3D::setVertexAttributesPointers(int numVertices)
-{
-	uint64_t offset = 0;
-	if (hasPositions())
-	{
-		glEnableVertexAttribArray(POSITION_ATTRIBUTE_INDEX);
-		glVertexAttribPointer(POSITION_ATTRIBUTE_INDEX, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), reinterpret_cast<void*>(offset));
-
-		offset += sizeof(glm::vec3)*numVertices;
-	}
-
-	if (hasTextureCoordinates())
-	{
-		glEnableVertexAttribArray(TEXTURE_COORDINATE_ATTRIBUTE_INDEX);
-		glVertexAttribPointer(TEXTURE_COORDINATE_ATTRIBUTE_INDEX, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), reinterpret_cast<void*>(offset));
-
-		offset += sizeof(glm::vec2)*numVertices;
-	}
-
-	if (hasNormals())
-	{
-		glEnableVertexAttribArray(NORMAL_ATTRIBUTE_INDEX);
-		glVertexAttribPointer(NORMAL_ATTRIBUTE_INDEX, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), reinterpret_cast<void*>(offset));
-
-		offset += sizeof(glm::vec3)*numVertices;
-	}
-}
-
+#include "common/staticMesh3D.h"
+#include "common/geometryHeap.h"
+#include "common/parametricSurface.h"
+
+#include <glm/glm.hpp>
+
+namespace static_meshes_3D {
+
+const int StaticMesh3D::POSITION_ATTRIBUTE_INDEX           = 0;
+const int StaticMesh3D::TEXTURE_COORDINATE_ATTRIBUTE_INDEX = 1;
+const int StaticMesh3D::NORMAL_ATTRIBUTE_INDEX             = 2;
+
+namespace {
+
+GeometryHeap* sharedGeometryHeap = nullptr; // heap new meshes allocate from, nullptr for own VBOs
+
+} // namespace
+
+StaticMesh3D::StaticMesh3D(bool withPositions, bool withTextureCoordinates, bool withNormals, VertexLayout vertexLayout)
+	: _hasPositions(withPositions)
+	, _hasTextureCoordinates(withTextureCoordinates)
+	, _hasNormals(withNormals)
+	, _vertexLayout(vertexLayout) {}
+
+StaticMesh3D::~StaticMesh3D()
+{
+	deleteMesh();
+}
+
+void StaticMesh3D::setGeometryHeap(GeometryHeap* heap)
+{
+	sharedGeometryHeap = heap;
+}
+
+GeometryHeap* StaticMesh3D::getGeometryHeap()
+{
+	return sharedGeometryHeap;
+}
+
+void StaticMesh3D::deleteMesh()
+{
+	if (!_isInitialized) {
+		return;
+	}
+
+	_vao.reset();
+	_vbo.deleteVBO();
+
+	_isInitialized = false;
+}
+
+void StaticMesh3D::renderInstanced(const InstanceBuffer& instanceBuffer) const
+{
+	if (!_isInitialized || instanceBuffer.getInstanceCount() == 0) {
+		return;
+	}
+
+	bindVertexArray();
+	instanceBuffer.setVertexAttributesPointers();
+	renderInstancedPrimitives(instanceBuffer.getInstanceCount());
+}
+
+bool StaticMesh3D::hasPositions() const
+{
+	return _hasPositions;
+}
+
+bool StaticMesh3D::hasTextureCoordinates() const
+{
+	return _hasTextureCoordinates;
+}
+
+bool StaticMesh3D::hasNormals() const
+{
+	return _hasNormals;
+}
+
+int StaticMesh3D::getVertexByteSize() const
+{
+	int result = 0;
+	if (hasPositions()) {
+		result += sizeof(glm::vec3);
+	}
+	if (hasTextureCoordinates()) {
+		result += sizeof(glm::vec2);
+	}
+	if (hasNormals()) {
+		result += sizeof(glm::vec3);
+	}
+
+	return result;
+}
+
+VertexLayout StaticMesh3D::getVertexLayout() const
+{
+	return _vertexLayout;
+}
+
+const BoundingVolume& StaticMesh3D::getBounds() const
+{
+	return _bounds;
+}
+
+VertexStreams StaticMesh3D::getVertexStreams(float* data, int numVertices) const
+{
+	const auto positionFloats = hasPositions() ? 3 : 0;
+	const auto textureCoordinateFloats = hasTextureCoordinates() ? 2 : 0;
+	const auto normalFloats = hasNormals() ? 3 : 0;
+
+	if (_vertexLayout == VertexLayout::INTERLEAVED)
+	{
+		return VertexStreams::interleaved(data, positionFloats + textureCoordinateFloats + normalFloats,
+			hasPositions() ? 0 : -1,
+			hasNormals() ? positionFloats + textureCoordinateFloats : -1,
+			hasTextureCoordinates() ? positionFloats : -1);
+	}
+
+	if (_vertexLayout == VertexLayout::SPLIT_POSITIONS)
+	{
+		// Planar position block followed by the rest interleaved
+		auto streams = VertexStreams::interleaved(data + positionFloats * numVertices, textureCoordinateFloats + normalFloats,
+			-1, hasNormals() ? textureCoordinateFloats : -1, hasTextureCoordinates() ? 0 : -1);
+		streams.positions = hasPositions() ? data : nullptr;
+		streams.positionStride = 3;
+		return streams;
+	}
+
+	return VertexStreams::planar(data, numVertices, hasPositions(), hasTextureCoordinates(), hasNormals());
+}
+
+void StaticMesh3D::createVertexBuffer(uint32_t sizeBytes)
+{
+	if (sharedGeometryHeap == nullptr)
+	{
+		_vbo.createMappedVBO(sizeBytes);
+		return;
+	}
+
+	// Base vertex draws need interleaved vertices to start at a multiple of their size
+	const auto alignment = _vertexLayout == VertexLayout::INTERLEAVED ? getVertexByteSize() : static_cast<int>(sizeof(float));
+	_vbo.createHeapVBO(*sharedGeometryHeap, sizeBytes, alignment);
+}
+
+void StaticMesh3D::setVertexAttributesPointers(int numVertices)
+{
+	_numBufferVertices = numVertices;
+	if (_vbo.getHeap() != nullptr) {
+		_heapGeneration = _vbo.getHeap()->getGeneration();
+	}
+	pointVertexAttributes();
+}
+
+GLint StaticMesh3D::bindVertexArray() const
+{
+	glBindVertexArray(_vao.get());
+	const auto* heap = _vbo.getHeap();
+	if (heap != nullptr && heap->getGeneration() != _heapGeneration)
+	{
+		bindHeapBuffers();
+		_heapGeneration = heap->getGeneration();
+	}
+
+	return getBaseVertex();
+}
+
+GLint StaticMesh3D::getBaseVertex() const
+{
+	if (_vbo.getHeap() == nullptr || _vertexLayout != VertexLayout::INTERLEAVED) {
+		return 0;
+	}
+
+	return static_cast<GLint>(_vbo.getBufferOffset() / getVertexByteSize());
+}
+
+void StaticMesh3D::bindHeapBuffers() const
+{
+	glBindBuffer(GL_ARRAY_BUFFER, _vbo.getBufferID());
+	pointVertexAttributes();
+}
+
+void StaticMesh3D::pointVertexAttributes() const
+{
+	const auto numVertices = _numBufferVertices;
+	const uint64_t positionSize = hasPositions() ? sizeof(glm::vec3) : 0;
+	const uint64_t textureCoordinateSize = hasTextureCoordinates() ? sizeof(glm::vec2) : 0;
+	const uint64_t normalSize = hasNormals() ? sizeof(glm::vec3) : 0;
+
+	// Byte offset of the first vertex's attribute and distance between two vertices, must match getVertexStreams
+	uint64_t positionOffset = 0, textureCoordinateOffset, normalOffset;
+	GLsizei positionStride, textureCoordinateStride, normalStride;
+	if (_vertexLayout == VertexLayout::INTERLEAVED)
+	{
+		textureCoordinateOffset = positionSize;
+		normalOffset = positionSize + textureCoordinateSize;
+		positionStride = textureCoordinateStride = normalStride = static_cast<GLsizei>(getVertexByteSize());
+	}
+	else if (_vertexLayout == VertexLayout::SPLIT_POSITIONS)
+	{
+		textureCoordinateOffset = positionSize * numVertices;
+		normalOffset = textureCoordinateOffset + textureCoordinateSize;
+		positionStride = sizeof(glm::vec3);
+		textureCoordinateStride = normalStride = static_cast<GLsizei>(textureCoordinateSize + normalSize);
+	}
+	else
+	{
+		textureCoordinateOffset = positionSize * numVertices;
+		normalOffset = textureCoordinateOffset + textureCoordinateSize * numVertices;
+		positionStride = sizeof(glm::vec3);
+		textureCoordinateStride = sizeof(glm::vec2);
+		normalStride = sizeof(glm::vec3);
+	}
+
+	// Interleaved vertices in a heap are reached by the base vertex, planar blocks only by their offset
+	if (_vertexLayout != VertexLayout::INTERLEAVED)
+	{
+		const uint64_t bufferOffset = _vbo.getBufferOffset();
+		positionOffset += bufferOffset;
+		textureCoordinateOffset += bufferOffset;
+		normalOffset += bufferOffset;
+	}
+
+	if (hasPositions())
+	{
+		glEnableVertexAttribArray(POSITION_ATTRIBUTE_INDEX);
+		glVertexAttribPointer(POSITION_ATTRIBUTE_INDEX, 3, GL_FLOAT, GL_FALSE, positionStride, reinterpret_cast<void*>(positionOffset));
+	}
+
+	if (hasTextureCoordinates())
+	{
+		glEnableVertexAttribArray(TEXTURE_COORDINATE_ATTRIBUTE_INDEX);
+		glVertexAttribPointer(TEXTURE_COORDINATE_ATTRIBUTE_INDEX, 2, GL_FLOAT, GL_FALSE, textureCoordinateStride, reinterpret_cast<void*>(textureCoordinateOffset));
+	}
+
+	if (hasNormals())
+	{
+		glEnableVertexAttribArray(NORMAL_ATTRIBUTE_INDEX);
+		glVertexAttribPointer(NORMAL_ATTRIBUTE_INDEX, 3, GL_FLOAT, GL_FALSE, normalStride, reinterpret_cast<void*>(normalOffset));
+	}
+}
+
 } // namespace static_meshes_3D
\ No newline at end of file
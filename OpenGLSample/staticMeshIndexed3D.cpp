@@ -1,24 +1,73 @@
-#include "common/staticMeshIndexed3D.h"
-
-namespace static_meshes_3D {
-
-StaticMeshIndexed3D::StaticMeshIndexed3D(bool withPositions, bool withTextureCoordinates, bool withNormals)
-	: StaticMesh3D(withPositions, withTextureCoordinates, withNormals) {}
-
-StaticMeshIndexed3D::~StaticMeshIndexed3D()
-{
-	if (_isInitialized) {
-		// It's enough to delete indices VBO here, rest of stuff is destructed in super destructor
-		_indicesVBO.deleteVBO();
-	}
-}
-
-void StaticMeshIndexed3D::deleteMesh()
-{
-	if (_isInitialized) {
-		_indicesVBO.deleteVBO();
-		StaticMesh3D::deleteMesh();
-	}
-}
-
+#include "common/staticMeshIndexed3D.h"
+#include "common/geometryHeap.h"
+
+namespace static_meshes_3D {
+
+StaticMeshIndexed3D::StaticMeshIndexed3D(bool withPositions, bool withTextureCoordinates, bool withNormals)
+	: StaticMesh3D(withPositions, withTextureCoordinates, withNormals) {}
+
+StaticMeshIndexed3D::~StaticMeshIndexed3D()
+{
+	if (_isInitialized) {
+		// It's enough to delete indices VBO here, rest of stuff is destructed in super destructor
+		_indicesVBO.deleteVBO();
+	}
+}
+
+void StaticMeshIndexed3D::deleteMesh()
+{
+	if (_isInitialized) {
+		_indicesVBO.deleteVBO();
+		StaticMesh3D::deleteMesh();
+	}
+}
+
+void StaticMeshIndexed3D::uploadIndices(const IndexBufferBuilder& indexBuffer)
+{
+	const auto indexBytes = static_cast<uint32_t>(indexBuffer.getByteSize());
+	if (getGeometryHeap() != nullptr) {
+		_indicesVBO.createHeapVBO(*getGeometryHeap(), indexBytes, indexBuffer.getIndexType() == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint));
+	}
+	else {
+		_indicesVBO.createMappedVBO(indexBytes);
+	}
+	_indicesVBO.bindVBO(GL_ELEMENT_ARRAY_BUFFER);
+	_indicesVBO.addRawData(indexBuffer.getData(), static_cast<uint32_t>(indexBuffer.getByteSize()));
+	_indicesVBO.uploadDataToGPU(GL_STATIC_DRAW);
+
+	_numIndices = static_cast<int>(indexBuffer.getIndexCount());
+	_indexType = indexBuffer.getIndexType();
+	_primitiveType = indexBuffer.getPrimitiveType();
+	_primitiveRestartIndex = IndexBufferBuilder::getPrimitiveRestartIndex(_indexType);
+}
+
+void StaticMeshIndexed3D::renderIndices(GLsizei numInstances) const
+{
+	const auto isStrip = _primitiveType == GL_TRIANGLE_STRIP;
+	if (isStrip)
+	{
+		glEnable(GL_PRIMITIVE_RESTART);
+		glPrimitiveRestartIndex(_primitiveRestartIndex);
+	}
+
+	// Indices in a heap start at their range's offset and refer to the mesh's first vertex
+	const auto* indices = reinterpret_cast<const void*>(_indicesVBO.getBufferOffset());
+	if (numInstances == 1) {
+		glDrawElementsBaseVertex(_primitiveType, _numIndices, _indexType, indices, getBaseVertex());
+	}
+	else {
+		glDrawElementsInstancedBaseVertex(_primitiveType, _numIndices, _indexType, indices, numInstances, getBaseVertex());
+	}
+
+	if (isStrip) {
+		glDisable(GL_PRIMITIVE_RESTART);
+	}
+}
+
+void StaticMeshIndexed3D::bindHeapBuffers() const
+{
+	StaticMesh3D::bindHeapBuffers();
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indicesVBO.getBufferID());
+}
+
 } // namespace static_meshes_3D
\ No newline at end of file
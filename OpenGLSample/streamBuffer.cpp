@@ -0,0 +1,252 @@
+#include <iostream>
+#include <cstring>
+
+#include "common/resourceTracker.h"
+#include "common/streamBuffer.h"
+
+// glad of this project ends at OpenGL 4.3, buffer storage came with 4.4
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+const int StreamBuffer::DEFAULT_NUM_REGIONS = 3;
+
+namespace {
+
+typedef void (APIENTRYP PFNGLBUFFERSTORAGEPROC)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+PFNGLBUFFERSTORAGEPROC bufferStorage = nullptr;
+
+} // namespace
+
+bool StreamBuffer::loadPersistentMapping(GLADloadproc loader)
+{
+	bufferStorage = nullptr;
+
+	auto isSupported = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 4);
+	if (!isSupported)
+	{
+		GLint numExtensions = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &numExtensions);
+		for (GLint i = 0; i < numExtensions && !isSupported; i++)
+		{
+			const auto* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+			isSupported = extension != nullptr && strcmp(extension, "GL_ARB_buffer_storage") == 0;
+		}
+	}
+
+	if (isSupported) {
+		bufferStorage = reinterpret_cast<PFNGLBUFFERSTORAGEPROC>(loader("glBufferStorage"));
+	}
+	return bufferStorage != nullptr;
+}
+
+bool StreamBuffer::isPersistentMappingSupported()
+{
+	return bufferStorage != nullptr;
+}
+
+void StreamBuffer::createStreamBuffer(size_t regionSizeBytes, int numRegions)
+{
+	if (_isBufferCreated)
+	{
+		std::cout << "This stream buffer is already created! You need to delete it before re-creating it!" << std::endl;
+		return;
+	}
+
+	_regionSize = regionSizeBytes;
+	_numRegions = numRegions;
+	_currentRegion = 0;
+	_bytesUsed = 0;
+	_fences.assign(numRegions, nullptr);
+	_stallCount = 0;
+	_orphanCount = 0;
+
+	// Copy write target, so that creating the buffer disturbs no binding a VAO or a shader relies on
+	_buffer = GLBuffer::create();
+	glBindBuffer(GL_COPY_WRITE_BUFFER, _buffer.get());
+	if (bufferStorage != nullptr)
+	{
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		bufferStorage(GL_COPY_WRITE_BUFFER, _regionSize * numRegions, nullptr, flags);
+		_persistentMapping = static_cast<unsigned char*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, _regionSize * numRegions, flags));
+		if (_persistentMapping == nullptr)
+		{
+			// Storage can't be re-specified, so orphaning needs a fresh buffer
+			std::cout << "Cannot map stream buffer persistently, falling back to orphaning!" << std::endl;
+			_buffer = GLBuffer::create();
+			glBindBuffer(GL_COPY_WRITE_BUFFER, _buffer.get());
+		}
+	}
+	if (_persistentMapping == nullptr) {
+		glBufferData(GL_COPY_WRITE_BUFFER, _regionSize * numRegions, nullptr, GL_STREAM_DRAW);
+	}
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	TRACK_RESOURCE(BUFFER, _buffer.get(), _regionSize * numRegions, "stream buffers");
+
+	_isBufferCreated = true;
+}
+
+void* StreamBuffer::map(size_t sizeBytes, size_t alignment, size_t& offset)
+{
+	offset = 0;
+	if (!_isBufferCreated)
+	{
+		std::cout << "This stream buffer is not created yet! Call createStreamBuffer before using it!" << std::endl;
+		return nullptr;
+	}
+
+	if (sizeBytes > _regionSize)
+	{
+		std::cout << "Stream buffer region is too small (" << _regionSize << " bytes) for " << sizeBytes << " bytes, increase its size!" << std::endl;
+		return nullptr;
+	}
+
+	unmap();
+
+	// Offsets are aligned in the whole buffer, regions don't need to start aligned
+	const auto regionStart = _regionSize * _currentRegion;
+	auto start = (regionStart + _bytesUsed + alignment - 1) / alignment * alignment;
+	if (start + sizeBytes > regionStart + _regionSize)
+	{
+		advanceRegion();
+		const auto nextRegionStart = _regionSize * _currentRegion;
+		start = (nextRegionStart + alignment - 1) / alignment * alignment;
+		if (start + sizeBytes > nextRegionStart + _regionSize)
+		{
+			std::cout << "Stream buffer region is too small (" << _regionSize << " bytes) for " << sizeBytes << " aligned bytes, increase its size!" << std::endl;
+			return nullptr;
+		}
+	}
+	_bytesUsed = start + sizeBytes - _regionSize * _currentRegion;
+	offset = start;
+
+	if (_persistentMapping != nullptr) {
+		return _persistentMapping + start;
+	}
+
+	// Ranges handed out since the last orphaning are never written twice, so no implicit synchronization is needed
+	glBindBuffer(GL_COPY_WRITE_BUFFER, _buffer.get());
+	void* ptrRange = glMapBufferRange(GL_COPY_WRITE_BUFFER, start, sizeBytes,
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	_isRangeMapped = ptrRange != nullptr;
+	return ptrRange;
+}
+
+void StreamBuffer::unmap()
+{
+	// A coherent persistent mapping makes the writes visible to the GPU without any call
+	if (!_isRangeMapped) {
+		return;
+	}
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, _buffer.get());
+	glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	_isRangeMapped = false;
+}
+
+void StreamBuffer::endFrame()
+{
+	if (!_isBufferCreated) {
+		return;
+	}
+
+	unmap();
+	advanceRegion();
+}
+
+void StreamBuffer::advanceRegion()
+{
+	_bytesUsed = 0;
+	_currentRegion = (_currentRegion + 1) % _numRegions;
+
+	if (_persistentMapping == nullptr)
+	{
+		// Back at the start, the GPU may still read any region, so the driver gets to allocate new memory
+		if (_currentRegion == 0)
+		{
+			glBindBuffer(GL_COPY_WRITE_BUFFER, _buffer.get());
+			glBufferData(GL_COPY_WRITE_BUFFER, _regionSize * _numRegions, nullptr, GL_STREAM_DRAW);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+			_orphanCount++;
+		}
+		return;
+	}
+
+	const auto previousRegion = (_currentRegion + _numRegions - 1) % _numRegions;
+	_fences[previousRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+	// Wait until the GPU is done with the frame that used this region last time
+	auto& fence = _fences[_currentRegion];
+	if (fence != nullptr)
+	{
+		auto waitResult = glClientWaitSync(fence, 0, 0);
+		if (waitResult == GL_TIMEOUT_EXPIRED)
+		{
+			_stallCount++;
+			do {
+				waitResult = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+			} while (waitResult == GL_TIMEOUT_EXPIRED);
+		}
+
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+}
+
+GLuint StreamBuffer::getBufferID() const
+{
+	return _buffer.get();
+}
+
+size_t StreamBuffer::getRegionSize() const
+{
+	return _regionSize;
+}
+
+bool StreamBuffer::isPersistent() const
+{
+	return _persistentMapping != nullptr;
+}
+
+int StreamBuffer::getStallCount() const
+{
+	return _stallCount;
+}
+
+int StreamBuffer::getOrphanCount() const
+{
+	return _orphanCount;
+}
+
+void StreamBuffer::deleteStreamBuffer()
+{
+	if (!_isBufferCreated) {
+		return;
+	}
+
+	unmap();
+	for (auto& fence : _fences)
+	{
+		if (fence != nullptr)
+		{
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+	}
+
+	if (_persistentMapping != nullptr)
+	{
+		glBindBuffer(GL_COPY_WRITE_BUFFER, _buffer.get());
+		glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		_persistentMapping = nullptr;
+	}
+
+	_buffer.reset();
+	_isBufferCreated = false;
+}
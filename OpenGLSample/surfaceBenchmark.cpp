@@ -0,0 +1,372 @@
+// STL
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+// GLM
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include "common/parametricSurface.h"
+#include "common/surfaceBenchmark.h"
+
+namespace surface_benchmark {
+
+const int DEFAULT_VERTICES = 10000000;
+const int NUM_RUNS         = 3;
+
+} // namespace surface_benchmark
+
+namespace {
+
+//* \brief Generated vertex data and indices of one mesh, float data in whatever layout the generator uses.
+struct MeshOutput
+{
+	std::vector<float> vertices;
+	std::vector<unsigned int> indices;
+};
+
+// --- Generators as they were before the parametric surface engine, kept for comparison ---
+
+// Sphere::addLod: per vertex cosf / sinf, interleaved position + tex coord, push_back without reserve
+void legacySphere(float radius, int sectors, int stacks, MeshOutput& mesh)
+{
+	const auto pi = glm::pi<double>();
+	const auto sectorStep = (float)(2 * pi / sectors);
+	const auto stackStep = (float)(pi / stacks);
+	for (int i = 0; i <= stacks; ++i)
+	{
+		const auto stackAngle = (float)(pi / 2 - i * stackStep);
+		const auto xy = 1.02f * radius * cosf(stackAngle);
+		const auto z = radius * sinf(stackAngle);
+		for (int j = 0; j <= sectors; ++j)
+		{
+			const auto sectorAngle = j * sectorStep;
+			mesh.vertices.push_back(xy * cosf(sectorAngle));
+			mesh.vertices.push_back(xy * sinf(sectorAngle));
+			mesh.vertices.push_back(z);
+			mesh.vertices.push_back((float)j / sectors);
+			mesh.vertices.push_back((float)i / stacks);
+		}
+	}
+
+	for (int i = 0; i < stacks; ++i)
+	{
+		unsigned int k1 = i * (sectors + 1);
+		unsigned int k2 = k1 + sectors + 1;
+		for (int j = 0; j < sectors; ++j, ++k1, ++k2)
+		{
+			if (i != 0)
+			{
+				mesh.indices.push_back(k1);
+				mesh.indices.push_back(k2);
+				mesh.indices.push_back(k1 + 1);
+			}
+			if (i != (stacks - 1))
+			{
+				mesh.indices.push_back(k1 + 1);
+				mesh.indices.push_back(k2);
+				mesh.indices.push_back(k2 + 1);
+			}
+		}
+	}
+}
+
+// Cylinder::initializeData: accumulated slice angle, planar positions / tex coords / normals appended piece by piece
+void legacyCylinder(float radius, int slices, float height, MeshOutput& mesh)
+{
+	const auto push = [&mesh](const float* data, int count, int repeat) {
+		for (auto r = 0; r < repeat; r++) {
+			mesh.vertices.insert(mesh.vertices.end(), data, data + count);
+		}
+	};
+	const auto pushVec3 = [&push](const glm::vec3& v, int repeat) { push(&v.x, 3, repeat); };
+	const auto pushVec2 = [&push](const glm::vec2& v) { push(&v.x, 2, 1); };
+
+	const auto sliceAngleStep = 2.0f * glm::pi<float>() / float(slices);
+	auto currentSliceAngle = 0.0f;
+	std::vector<float> sines, cosines;
+	for (auto i = 0; i <= slices; i++)
+	{
+		sines.push_back(sinf(currentSliceAngle));
+		cosines.push_back(cosf(currentSliceAngle));
+		currentSliceAngle += sliceAngleStep;
+	}
+
+	std::vector<float> x, z;
+	for (auto i = 0; i <= slices; i++)
+	{
+		x.push_back(cosines[i] * radius);
+		z.push_back(sines[i] * radius);
+	}
+	for (auto i = 0; i <= slices; i++)
+	{
+		pushVec3(glm::vec3(x[i], height / 2.0f, z[i]), 1);
+		pushVec3(glm::vec3(x[i], -height / 2.0f, z[i]), 1);
+	}
+	pushVec3(glm::vec3(0.0f, height / 2.0f, 0.0f), 1);
+	for (auto i = 0; i <= slices; i++) {
+		pushVec3(glm::vec3(x[i], height / 2.0f, z[i]), 1);
+	}
+	pushVec3(glm::vec3(0.0f, -height / 2.0f, 0.0f), 1);
+	for (auto i = 0; i <= slices; i++) {
+		pushVec3(glm::vec3(x[i], -height / 2.0f, -z[i]), 1);
+	}
+
+	const auto sliceTextureStepU = 2.0f / float(slices);
+	auto currentSliceTexCoordU = 0.0f;
+	for (auto i = 0; i <= slices; i++)
+	{
+		pushVec2(glm::vec2(currentSliceTexCoordU, 1.0f));
+		pushVec2(glm::vec2(currentSliceTexCoordU, 0.0f));
+		currentSliceTexCoordU += sliceTextureStepU;
+	}
+	pushVec2(glm::vec2(0.5f, 0.5f));
+	for (auto i = 0; i <= slices; i++) {
+		pushVec2(glm::vec2(0.5f + sines[i] * 0.5f, 0.5f + cosines[i] * 0.5f));
+	}
+	pushVec2(glm::vec2(0.5f, 0.5f));
+	for (auto i = 0; i <= slices; i++) {
+		pushVec2(glm::vec2(0.5f + sines[i] * 0.5f, 0.5f - cosines[i] * 0.5f));
+	}
+
+	for (auto i = 0; i <= slices; i++) {
+		pushVec3(glm::vec3(cosines[i], 0.0f, sines[i]), 2);
+	}
+	pushVec3(glm::vec3(0.0f, 1.0f, 0.0f), slices + 2);
+	pushVec3(glm::vec3(0.0f, -1.0f, 0.0f), slices + 2);
+}
+
+// ShapeGenerator::makePlane: new[] arrays of position + color + normal, colors left out here
+void legacyGrid(int dimensions, MeshOutput& mesh)
+{
+	struct LegacyVertex
+	{
+		glm::vec3 position;
+		glm::vec3 color;
+		glm::vec3 normal;
+	};
+
+	const auto numVertices = dimensions * dimensions;
+	const auto half = dimensions / 2;
+	auto* vertices = new LegacyVertex[numVertices];
+	for (int i = 0; i < dimensions; i++)
+	{
+		for (int j = 0; j < dimensions; j++)
+		{
+			auto& thisVert = vertices[i * dimensions + j];
+			thisVert.position = glm::vec3(j - half, 0.0f, i - half);
+			thisVert.color = glm::vec3(0.0f);
+			thisVert.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+		}
+	}
+
+	const auto numIndices = (dimensions - 1) * (dimensions - 1) * 6;
+	auto* indices = new unsigned int[numIndices];
+	int runner = 0;
+	for (int row = 0; row < dimensions - 1; row++)
+	{
+		for (int col = 0; col < dimensions - 1; col++)
+		{
+			indices[runner++] = dimensions * row + col;
+			indices[runner++] = dimensions * row + col + dimensions;
+			indices[runner++] = dimensions * row + col + dimensions + 1;
+			indices[runner++] = dimensions * row + col;
+			indices[runner++] = dimensions * row + col + dimensions + 1;
+			indices[runner++] = dimensions * row + col + 1;
+		}
+	}
+
+	// Hand over like ShapeData did (same memory layout as the engine writes into)
+	const auto* first = &vertices[0].position.x;
+	mesh.vertices.assign(first, first + numVertices * 9);
+	mesh.indices.assign(indices, indices + numIndices);
+	delete[] vertices;
+	delete[] indices;
+}
+
+// --- The same meshes generated by the engine ---
+
+void engineSphere(float radius, int sectors, int stacks, int numThreads, MeshOutput& mesh)
+{
+	ParametricGrid grid;
+	grid.outerSegments = stacks;
+	grid.innerSegments = sectors;
+	grid.outerStart = glm::half_pi<float>();
+	grid.outerStep = -glm::pi<float>() / stacks;
+	grid.innerStep = 2.0f * glm::pi<float>() / sectors;
+
+	SphereSurface surface;
+	surface.radius = radius;
+	surface.equatorScale = 1.02f;
+
+	mesh.vertices.resize(grid.getVertexCount() * 5);
+	mesh.indices.resize(parametric_surface::getIndexCount(grid, GridTriangulation::SPHERE));
+	parametric_surface::generateVertices(surface, grid, VertexStreams::interleaved(mesh.vertices.data(), 5, 0, -1, 3), numThreads);
+	parametric_surface::generateIndices(grid, GridTriangulation::SPHERE, mesh.indices.data(), 0, numThreads);
+}
+
+void engineCylinder(float radius, int slices, float height, int numThreads, MeshOutput& mesh)
+{
+	ParametricGrid sideGrid;
+	sideGrid.outerSegments = slices;
+	sideGrid.innerSegments = 1;
+	sideGrid.outerStep = 2.0f * glm::pi<float>() / float(slices);
+	auto coverGrid = sideGrid;
+	coverGrid.innerSegments = 0;
+
+	CylinderSideSurface side;
+	side.radius = radius;
+	side.height = height;
+	CylinderCoverSurface topCover;
+	topCover.radius = radius;
+	topCover.y = height / 2.0f;
+	auto bottomCover = topCover;
+	bottomCover.y = -height / 2.0f;
+	bottomCover.facingDown = true;
+
+	const auto numVerticesSide = (slices + 1) * 2;
+	const auto numVerticesTopBottom = slices + 2;
+	const auto numVerticesTotal = numVerticesSide + numVerticesTopBottom * 2;
+	mesh.vertices.resize(numVerticesTotal * 8);
+	const auto streams = VertexStreams::planar(mesh.vertices.data(), numVerticesTotal, true, true, true);
+	const auto topStreams = streams.skip(numVerticesSide);
+	const auto bottomStreams = topStreams.skip(numVerticesTopBottom);
+
+	parametric_surface::generateVertices(side, sideGrid, streams, numThreads);
+	SurfaceVertex center;
+	center.texCoord = glm::vec2(0.5f, 0.5f);
+	center.position = glm::vec3(0.0f, height / 2.0f, 0.0f);
+	center.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+	topStreams.write(0, center);
+	parametric_surface::generateVertices(topCover, coverGrid, topStreams.skip(1), numThreads);
+	center.position = glm::vec3(0.0f, -height / 2.0f, 0.0f);
+	center.normal = glm::vec3(0.0f, -1.0f, 0.0f);
+	bottomStreams.write(0, center);
+	parametric_surface::generateVertices(bottomCover, coverGrid, bottomStreams.skip(1), numThreads);
+}
+
+void engineGrid(int dimensions, int numThreads, MeshOutput& mesh)
+{
+	ParametricGrid grid;
+	grid.outerSegments = dimensions - 1;
+	grid.innerSegments = dimensions - 1;
+
+	FlatGridSurface surface;
+	surface.origin = glm::vec3(-(dimensions / 2), 0.0f, -(dimensions / 2));
+
+	// Position + color + normal like Vertex, colors stay zero
+	mesh.vertices.resize(grid.getVertexCount() * 9);
+	mesh.indices.resize(parametric_surface::getIndexCount(grid, GridTriangulation::QUADS));
+	parametric_surface::generateVertices(surface, grid, VertexStreams::interleaved(mesh.vertices.data(), 9, 0, 6, -1), numThreads);
+	parametric_surface::generateIndices(grid, GridTriangulation::QUADS, mesh.indices.data(), 0, numThreads);
+}
+
+/** \brief Runs a generator NUM_RUNS times into a fresh output.
+*   \param generate Generator to run
+*   \param mesh Output of the last run
+*   \return Time of the fastest run in milliseconds.
+*/
+double timeBest(const std::function<void(MeshOutput&)>& generate, MeshOutput& mesh)
+{
+	using clock = std::chrono::steady_clock;
+	auto best = 0.0;
+	for (auto run = 0; run < surface_benchmark::NUM_RUNS; run++)
+	{
+		mesh = MeshOutput();
+		const auto start = clock::now();
+		generate(mesh);
+		const auto milliseconds = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+		best = run == 0 ? milliseconds : std::min(best, milliseconds);
+	}
+	return best;
+}
+
+/** \brief Compares engine output with the old one.
+*   \param legacy Output of the old generator
+*   \param engine Output of the engine
+*   \param maxDifference Largest difference of the vertex data
+*   \return True if sizes and indices are equal.
+*/
+bool compare(const MeshOutput& legacy, const MeshOutput& engine, float& maxDifference)
+{
+	maxDifference = 0.0f;
+	if (legacy.vertices.size() != engine.vertices.size() || legacy.indices != engine.indices) {
+		return false;
+	}
+
+	for (size_t i = 0; i < legacy.vertices.size(); i++) {
+		maxDifference = std::max(maxDifference, std::abs(legacy.vertices[i] - engine.vertices[i]));
+	}
+	return true;
+}
+
+} // namespace
+
+namespace surface_benchmark {
+
+int run(int numVertices, std::ostream& out)
+{
+	const auto numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+	// Tessellations giving about numVertices vertices
+	const auto sphereSegments = std::max(2, static_cast<int>(std::sqrt(static_cast<double>(numVertices))) - 1);
+	const auto cylinderSlices = std::max(3, numVertices / 4);
+	const auto gridDimensions = std::max(2, static_cast<int>(std::sqrt(static_cast<double>(numVertices))));
+
+	struct Case
+	{
+		const char* name;
+		std::function<void(MeshOutput&)> legacy;
+		std::function<void(MeshOutput&, int)> engine;
+	};
+	const Case cases[] = {
+		{ "sphere",
+			[=](MeshOutput& mesh) { legacySphere(1.0f, sphereSegments, sphereSegments, mesh); },
+			[=](MeshOutput& mesh, int threads) { engineSphere(1.0f, sphereSegments, sphereSegments, threads, mesh); } },
+		{ "cylinder",
+			[=](MeshOutput& mesh) { legacyCylinder(1.0f, cylinderSlices, 2.0f, mesh); },
+			[=](MeshOutput& mesh, int threads) { engineCylinder(1.0f, cylinderSlices, 2.0f, threads, mesh); } },
+		{ "grid",
+			[=](MeshOutput& mesh) { legacyGrid(gridDimensions, mesh); },
+			[=](MeshOutput& mesh, int threads) { engineGrid(gridDimensions, threads, mesh); } },
+	};
+
+	const auto flags = out.flags();
+	const auto precision = out.precision();
+
+	out << std::fixed << std::setprecision(1);
+	out << "Surface generation, about " << numVertices << " vertices per mesh, best of " << NUM_RUNS << " runs (ms):" << std::endl;
+	out << "  mesh      old code   engine 1 thread   engine " << numThreads << " threads   max difference" << std::endl;
+
+	auto result = 0;
+	for (const auto& testCase : cases)
+	{
+		MeshOutput legacy, engine;
+		const auto legacyMilliseconds = timeBest(testCase.legacy, legacy);
+		const auto singleMilliseconds = timeBest([&testCase](MeshOutput& mesh) { testCase.engine(mesh, 1); }, engine);
+		const auto multiMilliseconds = timeBest([&testCase, numThreads](MeshOutput& mesh) { testCase.engine(mesh, numThreads); }, engine);
+
+		float maxDifference = 0.0f;
+		const auto isMatching = compare(legacy, engine, maxDifference);
+		out << "  " << std::left << std::setw(8) << testCase.name << std::right
+			<< std::setw(10) << legacyMilliseconds
+			<< std::setw(18) << singleMilliseconds
+			<< std::setw(18) << multiMilliseconds
+			<< "   " << std::scientific << std::setprecision(2) << maxDifference << std::fixed << std::setprecision(1)
+			<< (isMatching ? "" : "  MISMATCH") << std::endl;
+		if (!isMatching) {
+			result = 1;
+		}
+	}
+
+	out.flags(flags);
+	out.precision(precision);
+	return result;
+}
+
+} // namespace surface_benchmark
@@ -0,0 +1,100 @@
+#include <iostream>
+#include <cstring>
+
+#include "common/uniformRingBuffer.h"
+
+const int UniformRingBuffer::DEFAULT_NUM_REGIONS = 3;
+
+void UniformRingBuffer::createRingBuffer(size_t regionSizeBytes, int numRegions)
+{
+	if (_isBufferCreated)
+	{
+		std::cout << "This ring buffer is already created! You need to delete it before re-creating it!" << std::endl;
+		return;
+	}
+
+	GLint alignment = 0;
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+	_alignment = alignment > 0 ? static_cast<size_t>(alignment) : 256;
+
+	// Every region has to start at an aligned offset as well
+	_streamBuffer.createStreamBuffer((regionSizeBytes + _alignment - 1) / _alignment * _alignment, numRegions);
+
+	_isBufferCreated = true;
+}
+
+void UniformRingBuffer::beginFrame()
+{
+	if (!_isBufferCreated)
+	{
+		std::cout << "This ring buffer is not created yet! Call createRingBuffer before using it!" << std::endl;
+		return;
+	}
+
+	// The stream buffer waits for the GPU if it still reads the region
+	_mappedRegion = static_cast<unsigned char*>(_streamBuffer.map(_streamBuffer.getRegionSize(), _alignment, _regionStart));
+	_bytesUsed = 0;
+}
+
+size_t UniformRingBuffer::pushData(const void* ptrData, size_t dataSizeBytes)
+{
+	if (_mappedRegion == nullptr)
+	{
+		std::cout << "Uniform ring buffer is not mapped! Call beginFrame before pushing data!" << std::endl;
+		return _regionStart;
+	}
+
+	if (_bytesUsed + dataSizeBytes > _streamBuffer.getRegionSize())
+	{
+		std::cout << "Uniform ring buffer region is full (" << _streamBuffer.getRegionSize() << " bytes), increase its size!" << std::endl;
+		return _regionStart;
+	}
+
+	const auto offsetInRegion = _bytesUsed;
+	memcpy(_mappedRegion + offsetInRegion, ptrData, dataSizeBytes);
+
+	// Next block has to start at an aligned offset
+	_bytesUsed += (dataSizeBytes + _alignment - 1) / _alignment * _alignment;
+	return _regionStart + offsetInRegion;
+}
+
+void UniformRingBuffer::flush()
+{
+	if (_mappedRegion == nullptr) {
+		return;
+	}
+
+	_streamBuffer.unmap();
+	_mappedRegion = nullptr;
+}
+
+void UniformRingBuffer::bindRange(GLuint bindingPoint, size_t offset, size_t dataSizeBytes) const
+{
+	glBindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, _streamBuffer.getBufferID(), offset, dataSizeBytes);
+}
+
+void UniformRingBuffer::endFrame()
+{
+	if (!_isBufferCreated) {
+		return;
+	}
+
+	flush();
+	_streamBuffer.endFrame();
+}
+
+const StreamBuffer& UniformRingBuffer::getStreamBuffer() const
+{
+	return _streamBuffer;
+}
+
+void UniformRingBuffer::deleteRingBuffer()
+{
+	if (!_isBufferCreated) {
+		return;
+	}
+
+	flush();
+	_streamBuffer.deleteStreamBuffer();
+	_isBufferCreated = false;
+}
@@ -1,32 +1,32 @@
-#pragma once
-#ifndef VBOINDEXER_HPP
-#define VBOINDEXER_HPP
-
-void indexVBO(
-	std::vector<glm::vec3>& in_vertices,
-	std::vector<glm::vec2>& in_uvs,
-	std::vector<glm::vec3>& in_normals,
-
-	std::vector<unsigned short>& out_indices,
-	std::vector<glm::vec3>& out_vertices,
-	std::vector<glm::vec2>& out_uvs,
-	std::vector<glm::vec3>& out_normals
-);
-
-
-void indexVBO_TBN(
-	std::vector<glm::vec3>& in_vertices,
-	std::vector<glm::vec2>& in_uvs,
-	std::vector<glm::vec3>& in_normals,
-	std::vector<glm::vec3>& in_tangents,
-	std::vector<glm::vec3>& in_bitangents,
-
-	std::vector<unsigned short>& out_indices,
-	std::vector<glm::vec3>& out_vertices,
-	std::vector<glm::vec2>& out_uvs,
-	std::vector<glm::vec3>& out_normals,
-	std::vector<glm::vec3>& out_tangents,
-	std::vector<glm::vec3>& out_bitangents
-);
-
+#pragma once
+#ifndef VBOINDEXER_HPP
+#define VBOINDEXER_HPP
+
+void indexVBO(
+	std::vector<glm::vec3>& in_vertices,
+	std::vector<glm::vec2>& in_uvs,
+	std::vector<glm::vec3>& in_normals,
+
+	std::vector<unsigned short>& out_indices,
+	std::vector<glm::vec3>& out_vertices,
+	std::vector<glm::vec2>& out_uvs,
+	std::vector<glm::vec3>& out_normals
+);
+
+
+void indexVBO_TBN(
+	std::vector<glm::vec3>& in_vertices,
+	std::vector<glm::vec2>& in_uvs,
+	std::vector<glm::vec3>& in_normals,
+	std::vector<glm::vec3>& in_tangents,
+	std::vector<glm::vec3>& in_bitangents,
+
+	std::vector<unsigned short>& out_indices,
+	std::vector<glm::vec3>& out_vertices,
+	std::vector<glm::vec2>& out_uvs,
+	std::vector<glm::vec3>& out_normals,
+	std::vector<glm::vec3>& out_tangents,
+	std::vector<glm::vec3>& out_bitangents
+);
+
 #endif
\ No newline at end of file
@@ -1,112 +1,277 @@
-#include <iostream>
-
-#include "common/vertextBufferObject.h"
-
-void VertexBufferObject::createVBO(uint32_t reserveSizeBytes)
-{
-	if (_isBufferCreated)
-	{
-		std::cout << "This buffer is already created! You need to delete it before re-creating it!" << std::endl;
-		return;
-	}
-
-	glGenBuffers(1, &_bufferID);
-	_rawData.reserve(reserveSizeBytes > 0 ? reserveSizeBytes : 1024);
-
-	_isBufferCreated = true;
-}
-
-void VertexBufferObject::bindVBO(GLenum bufferType)
-{
-	if (!_isBufferCreated)
-	{
-		std::cout << "This buffer is not created yet! You cannot bind it before you create it!" << std::endl;
-		return;
-	}
-
-	_bufferType = bufferType;
-	glBindBuffer(_bufferType, _bufferID);
-}
-
-void VertexBufferObject::addRawData(const void* ptrData, uint32_t dataSize, int repeat)
-{
-	const auto bytesToAdd = dataSize * repeat;
-	if (_bytesAdded + bytesToAdd > _rawData.capacity())
-	{
-		const auto newCapacity = _rawData.capacity() * 2;
-		std::vector<unsigned char> newRawData;
-		newRawData.reserve(newCapacity);
-		memcpy(newRawData.data(), _rawData.data(), _bytesAdded);
-		_rawData = std::move(newRawData);
-	}
-
-	for (int i = 0; i < repeat; i++)
-	{
-		memcpy(_rawData.data() + _bytesAdded, ptrData, dataSize);
-		_bytesAdded += dataSize;
-	}
-}
-
-void* VertexBufferObject::getRawDataPointer()
-{
-	return _rawData.data();
-}
-
-void VertexBufferObject::uploadDataToGPU(GLenum usageHint)
-{
-	if (!_isBufferCreated)
-	{
-		std::cout << "This buffer is not created yet! Call createVBO before uploading data to GPU!" << std::endl;
-		return;
-	}
-
-	glBufferData(_bufferType, _bytesAdded, _rawData.data(), usageHint);
-	_isDataUploaded = true;
-	_uploadedDataSize = _bytesAdded;
-	_bytesAdded = 0;
-}
-
-void* VertexBufferObject::mapBufferToMemory(GLenum usageHint)
-{
-	if (!_isDataUploaded)
-	{
-		return nullptr;
-	}
-
-	return glMapBuffer(_bufferType, usageHint);
-}
-
-void* VertexBufferObject::mapSubBufferToMemory(GLenum usageHint, uint32_t offset, uint32_t length)
-{
-	if (!_isDataUploaded)
-	{
-		return nullptr;
-	}
-
-	return glMapBufferRange(_bufferType, offset, length, usageHint);
-}
-
-void VertexBufferObject::unmapBuffer()
-{
-	glUnmapBuffer(_bufferType);
-}
-
-GLuint VertexBufferObject::getBufferID()
-{
-	return _bufferID;
-}
-
-uint32_t VertexBufferObject::getBufferSize()
-{
-	return _isDataUploaded ? _uploadedDataSize : _bytesAdded;
-}
-
-void VertexBufferObject::deleteVBO()
-{
-	if (_isBufferCreated)
-	{
-		glDeleteBuffers(1, &_bufferID);
-		_isDataUploaded = false;
-		_isBufferCreated = false;
-	}
+#include <cstring>
+#include <iostream>
+
+#include "common/geometryHeap.h"
+#include "common/resourceTracker.h"
+#include "common/vertextBufferObject.h"
+
+const uint32_t VertexBufferObject::ARENA_CHUNK_SIZE = 64 * 1024;
+
+void VertexBufferObject::createVBO(uint32_t reserveSizeBytes)
+{
+	if (_isBufferCreated)
+	{
+		std::cout << "This buffer is already created! You need to delete it before re-creating it!" << std::endl;
+		return;
+	}
+
+	// Storage is specified by uploadDataToGPU
+	_buffer = GLBuffer::create();
+	TRACK_RESOURCE(BUFFER, _buffer.get(), 0, "vertex buffers");
+	_chunks.emplace_back();
+	_chunks.back().reserve(reserveSizeBytes > 0 ? reserveSizeBytes : ARENA_CHUNK_SIZE);
+
+	_isBufferCreated = true;
+}
+
+void VertexBufferObject::createMappedVBO(uint32_t sizeBytes, GLenum usageHint)
+{
+	if (_isBufferCreated)
+	{
+		std::cout << "This buffer is already created! You need to delete it before re-creating it!" << std::endl;
+		return;
+	}
+
+	// Copy target, so neither the bound array buffer nor the VAO's element buffer change
+	_buffer = GLBuffer::create();
+	glBindBuffer(GL_COPY_WRITE_BUFFER, _buffer.get());
+	glBufferData(GL_COPY_WRITE_BUFFER, sizeBytes, nullptr, usageHint);
+	TRACK_RESOURCE(BUFFER, _buffer.get(), sizeBytes, "vertex buffers");
+	if (sizeBytes > 0)
+	{
+		// Nothing can use the fresh storage yet, so there's nothing to synchronize with
+		_mappedData = static_cast<unsigned char*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, sizeBytes,
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+	}
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	_isBufferCreated = true;
+	if (_mappedData == nullptr)
+	{
+		_chunks.emplace_back();
+		_chunks.back().reserve(sizeBytes > 0 ? sizeBytes : ARENA_CHUNK_SIZE);
+		return;
+	}
+	_mappedSize = sizeBytes;
+}
+
+void VertexBufferObject::createHeapVBO(GeometryHeap& heap, uint32_t sizeBytes, uint32_t alignment)
+{
+	if (_isBufferCreated)
+	{
+		std::cout << "This buffer is already created! You need to delete it before re-creating it!" << std::endl;
+		return;
+	}
+
+	_heapHandle = heap.allocate(sizeBytes, alignment);
+	if (_heapHandle == GeometryHeap::INVALID_HANDLE) {
+		return;
+	}
+	_heap = &heap;
+
+	_isBufferCreated = true;
+	_mappedData = sizeBytes > 0 ? static_cast<unsigned char*>(heap.map(_heapHandle)) : nullptr;
+	if (_mappedData == nullptr)
+	{
+		_chunks.emplace_back();
+		_chunks.back().reserve(sizeBytes > 0 ? sizeBytes : ARENA_CHUNK_SIZE);
+		return;
+	}
+	_mappedSize = sizeBytes;
+}
+
+void VertexBufferObject::bindVBO(GLenum bufferType)
+{
+	if (!_isBufferCreated)
+	{
+		std::cout << "This buffer is not created yet! You cannot bind it before you create it!" << std::endl;
+		return;
+	}
+
+	_bufferType = bufferType;
+	glBindBuffer(_bufferType, getBufferID());
+}
+
+void VertexBufferObject::addRawData(const void* ptrData, uint32_t dataSize, int repeat)
+{
+	auto* ptrDestination = static_cast<unsigned char*>(reserveRawData(dataSize * repeat));
+	if (ptrDestination == nullptr) {
+		return;
+	}
+
+	for (int i = 0; i < repeat; i++) {
+		memcpy(ptrDestination + i * dataSize, ptrData, dataSize);
+	}
+}
+
+void* VertexBufferObject::reserveRawData(uint32_t sizeBytes)
+{
+	if (!_isBufferCreated || _isDataUploaded)
+	{
+		std::cout << "This buffer is not created yet or already uploaded! You cannot add data to it!" << std::endl;
+		return nullptr;
+	}
+
+	if (_mappedData != nullptr)
+	{
+		if (_bytesAdded + sizeBytes > _mappedSize)
+		{
+			std::cout << "This mapped buffer has " << _mappedSize - _bytesAdded << " bytes left, " << sizeBytes << " bytes don't fit!" << std::endl;
+			return nullptr;
+		}
+		auto* ptrDestination = _mappedData + _bytesAdded;
+		_bytesAdded += sizeBytes;
+		return ptrDestination;
+	}
+
+	// Data that don't fit start a new chunk, the filled ones are never moved
+	if (_chunks.back().size() + sizeBytes > _chunks.back().capacity())
+	{
+		_chunks.emplace_back();
+		_chunks.back().reserve(sizeBytes > ARENA_CHUNK_SIZE ? sizeBytes : ARENA_CHUNK_SIZE);
+	}
+
+	auto& chunk = _chunks.back();
+	chunk.resize(chunk.size() + sizeBytes);
+	_bytesAdded += sizeBytes;
+	return chunk.data() + chunk.size() - sizeBytes;
+}
+
+void* VertexBufferObject::getRawDataPointer()
+{
+	if (_mappedData != nullptr) {
+		return _mappedData;
+	}
+	return _chunks.empty() ? nullptr : _chunks.front().data();
+}
+
+void VertexBufferObject::uploadDataToGPU(GLenum usageHint)
+{
+	if (!_isBufferCreated)
+	{
+		std::cout << "This buffer is not created yet! Call createVBO before uploading data to GPU!" << std::endl;
+		return;
+	}
+
+	if (_heap != nullptr)
+	{
+		// The range has its final size already, data only get written into it
+		if (_mappedData != nullptr && !_heap->unmap(_heapHandle)) {
+			std::cout << "Contents of a mapped buffer got lost while it was mapped!" << std::endl;
+		}
+		size_t offset = 0;
+		for (const auto& chunk : _chunks)
+		{
+			_heap->upload(_heapHandle, offset, chunk.data(), chunk.size());
+			offset += chunk.size();
+		}
+		_mappedData = nullptr;
+	}
+	else if (_mappedData != nullptr)
+	{
+		glBindBuffer(GL_COPY_WRITE_BUFFER, _buffer.get());
+		if (glUnmapBuffer(GL_COPY_WRITE_BUFFER) == GL_FALSE) {
+			std::cout << "Contents of a mapped buffer got lost while it was mapped!" << std::endl;
+		}
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		_mappedData = nullptr;
+	}
+	else if (_chunks.size() == 1)
+	{
+		glBufferData(_bufferType, _bytesAdded, _chunks.front().data(), usageHint);
+	}
+	else
+	{
+		glBufferData(_bufferType, _bytesAdded, nullptr, usageHint);
+		GLintptr offset = 0;
+		for (const auto& chunk : _chunks)
+		{
+			glBufferSubData(_bufferType, offset, chunk.size(), chunk.data());
+			offset += chunk.size();
+		}
+	}
+	if (_heap == nullptr && _mappedData == nullptr) {
+		ResourceTracker::get().resize(ResourceTracker::BUFFER, _buffer.get(), _bytesAdded);
+	}
+
+	// Data live on the GPU now
+	std::vector<std::vector<unsigned char>>().swap(_chunks);
+	_isDataUploaded = true;
+	_uploadedDataSize = static_cast<uint32_t>(_bytesAdded);
+	_bytesAdded = 0;
+}
+
+void* VertexBufferObject::mapBufferToMemory(GLenum usageHint)
+{
+	if (!_isDataUploaded)
+	{
+		return nullptr;
+	}
+
+	if (_heap != nullptr)
+	{
+		std::cout << "A heap buffer is shared with other meshes, map only its range with mapSubBufferToMemory!" << std::endl;
+		return nullptr;
+	}
+
+	return glMapBuffer(_bufferType, usageHint);
+}
+
+void* VertexBufferObject::mapSubBufferToMemory(GLenum usageHint, uint32_t offset, uint32_t length)
+{
+	if (!_isDataUploaded)
+	{
+		return nullptr;
+	}
+
+	return glMapBufferRange(_bufferType, getBufferOffset() + offset, length, usageHint);
+}
+
+void VertexBufferObject::unmapBuffer()
+{
+	glUnmapBuffer(_bufferType);
+}
+
+GLuint VertexBufferObject::getBufferID() const
+{
+	return _heap != nullptr ? _heap->getBufferID(_heapHandle) : _buffer.get();
+}
+
+size_t VertexBufferObject::getBufferOffset() const
+{
+	return _heap != nullptr ? _heap->getOffset(_heapHandle) : 0;
+}
+
+const GeometryHeap* VertexBufferObject::getHeap() const
+{
+	return _heap;
+}
+
+uint32_t VertexBufferObject::getBufferSize() const
+{
+	return _isDataUploaded ? _uploadedDataSize : _bytesAdded;
+}
+
+void VertexBufferObject::deleteVBO()
+{
+	if (_isBufferCreated)
+	{
+		// Deleting a mapped buffer unmaps it, a heap range is unmapped by freeing it
+		if (_heap != nullptr)
+		{
+			_heap->free(_heapHandle);
+			_heap = nullptr;
+			_heapHandle = -1;
+		}
+		else
+		{
+			_buffer.reset();
+		}
+		std::vector<std::vector<unsigned char>>().swap(_chunks);
+		_mappedData = nullptr;
+		_mappedSize = 0;
+		_bytesAdded = 0;
+		_isDataUploaded = false;
+		_isBufferCreated = false;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,247 @@
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+// GLM
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+#include <glm/packing.hpp>
+
+#include "common/vertexCompression.h"
+
+namespace {
+
+const size_t QUANTIZED_POSITION_SIZE = 4 * sizeof(uint16_t); // 4th component pads the normal to 4 bytes
+const size_t FLOAT_POSITION_SIZE     = 3 * sizeof(float);
+const size_t PACKED_DIRECTION_SIZE   = sizeof(uint32_t);
+const size_t PACKED_TEX_COORD_SIZE   = sizeof(uint32_t);
+
+glm::vec3 readVec3(const float* ptrVertex, int offset)
+{
+	return glm::vec3(ptrVertex[offset], ptrVertex[offset + 1], ptrVertex[offset + 2]);
+}
+
+// Normalized direction, zero length ones become +z instead of NaNs
+glm::vec3 safeNormalize(const glm::vec3& v)
+{
+	const float length = glm::length(v);
+	return length > 0.0f ? v / length : glm::vec3(0.0f, 0.0f, 1.0f);
+}
+
+float angleDegrees(const glm::vec3& a, const glm::vec3& b)
+{
+	const float cosAngle = glm::clamp(glm::dot(safeNormalize(a), safeNormalize(b)), -1.0f, 1.0f);
+	return glm::degrees(std::acos(cosAngle));
+}
+
+} // namespace
+
+bool CompressedMesh::compress(const float* ptrVertices, size_t numVertices, const SourceLayout& layout, bool quantizePositions)
+{
+	if (layout.positionOffset < 0 || layout.floatsPerVertex <= 0)
+	{
+		std::cout << "Vertices without positions can't be compressed!" << std::endl;
+		return false;
+	}
+	if ((layout.tangentOffset >= 0) != (layout.bitangentOffset >= 0))
+	{
+		std::cout << "Tangents can only be compressed together with bitangents!" << std::endl;
+		return false;
+	}
+	if (layout.tangentOffset >= 0 && layout.normalOffset < 0)
+	{
+		std::cout << "Tangents can only be compressed together with normals!" << std::endl;
+		return false;
+	}
+
+	_numVertices = numVertices;
+	_sourceVertexSize = layout.floatsPerVertex * sizeof(float);
+	_hasQuantizedPositions = quantizePositions;
+	_error = ReconstructionError();
+
+	// Byte offsets of the packed streams, every one stays 4 byte aligned
+	size_t offset = quantizePositions ? QUANTIZED_POSITION_SIZE : FLOAT_POSITION_SIZE;
+	_normalOffset = layout.normalOffset >= 0 ? static_cast<int>(offset) : -1;
+	offset += layout.normalOffset >= 0 ? PACKED_DIRECTION_SIZE : 0;
+	_tangentOffset = layout.tangentOffset >= 0 ? static_cast<int>(offset) : -1;
+	offset += layout.tangentOffset >= 0 ? PACKED_DIRECTION_SIZE : 0;
+	_texCoordOffset = layout.texCoordOffset >= 0 ? static_cast<int>(offset) : -1;
+	offset += layout.texCoordOffset >= 0 ? PACKED_TEX_COORD_SIZE : 0;
+	_vertexSize = offset;
+	_data.assign(_numVertices * _vertexSize, 0);
+
+	// 16-bit positions span the bounding box
+	glm::vec3 boxMin(0.0f), boxExtent(0.0f);
+	if (quantizePositions && numVertices > 0)
+	{
+		glm::vec3 boxMax = boxMin = readVec3(ptrVertices, layout.positionOffset);
+		for (size_t i = 1; i < numVertices; i++)
+		{
+			const auto position = readVec3(ptrVertices + i * layout.floatsPerVertex, layout.positionOffset);
+			boxMin = glm::min(boxMin, position);
+			boxMax = glm::max(boxMax, position);
+		}
+		boxExtent = boxMax - boxMin;
+	}
+	_positionDecode = quantizePositions ? glm::scale(glm::translate(glm::mat4(1.0f), boxMin), boxExtent) : glm::mat4(1.0f);
+
+	for (size_t i = 0; i < numVertices; i++)
+	{
+		const float* source = ptrVertices + i * layout.floatsPerVertex;
+		unsigned char* packed = _data.data() + i * _vertexSize;
+
+		// Every stream is decoded the way the vertex fetch decodes it to measure the error
+		const auto position = readVec3(source, layout.positionOffset);
+		if (quantizePositions)
+		{
+			glm::vec3 relative(0.0f);
+			for (int axis = 0; axis < 3; axis++) {
+				relative[axis] = boxExtent[axis] > 0.0f ? (position[axis] - boxMin[axis]) / boxExtent[axis] : 0.0f;
+			}
+			const glm::uint64 bits = glm::packUnorm4x16(glm::vec4(relative, 0.0f));
+			memcpy(packed, &bits, QUANTIZED_POSITION_SIZE);
+
+			const auto decoded = boxMin + glm::vec3(glm::unpackUnorm4x16(bits)) * boxExtent;
+			for (int axis = 0; axis < 3; axis++) {
+				_error.position = std::max(_error.position, std::abs(decoded[axis] - position[axis]));
+			}
+		}
+		else {
+			memcpy(packed, &position[0], FLOAT_POSITION_SIZE);
+		}
+
+		glm::vec3 decodedNormal(0.0f);
+		if (_normalOffset >= 0)
+		{
+			const auto normal = readVec3(source, layout.normalOffset);
+			const glm::uint32 bits = glm::packSnorm3x10_1x2(glm::vec4(safeNormalize(normal), 0.0f));
+			memcpy(packed + _normalOffset, &bits, PACKED_DIRECTION_SIZE);
+
+			decodedNormal = glm::vec3(glm::unpackSnorm3x10_1x2(bits));
+			_error.normalDegrees = std::max(_error.normalDegrees, angleDegrees(decodedNormal, normal));
+		}
+
+		if (_tangentOffset >= 0)
+		{
+			const auto normal = readVec3(source, layout.normalOffset);
+			const auto tangent = readVec3(source, layout.tangentOffset);
+			const auto bitangent = readVec3(source, layout.bitangentOffset);
+			const float sign = glm::dot(glm::cross(normal, tangent), bitangent) < 0.0f ? -1.0f : 1.0f;
+			const glm::uint32 bits = glm::packSnorm3x10_1x2(glm::vec4(safeNormalize(tangent), sign));
+			memcpy(packed + _tangentOffset, &bits, PACKED_DIRECTION_SIZE);
+
+			const auto decoded = glm::unpackSnorm3x10_1x2(bits);
+			_error.tangentDegrees = std::max(_error.tangentDegrees, angleDegrees(glm::vec3(decoded), tangent));
+			if (glm::dot(glm::cross(decodedNormal, glm::vec3(decoded)) * decoded.w, bitangent) < 0.0f) {
+				_error.bitangentSignErrors++;
+			}
+		}
+
+		if (_texCoordOffset >= 0)
+		{
+			const glm::vec2 texCoord(source[layout.texCoordOffset], source[layout.texCoordOffset + 1]);
+			const glm::uint bits = glm::packHalf2x16(texCoord);
+			memcpy(packed + _texCoordOffset, &bits, PACKED_TEX_COORD_SIZE);
+
+			const auto decoded = glm::unpackHalf2x16(bits);
+			_error.texCoord = std::max(_error.texCoord, std::max(std::abs(decoded.x - texCoord.x), std::abs(decoded.y - texCoord.y)));
+		}
+	}
+
+	return true;
+}
+
+void CompressedMesh::setupAttributes(GLint positionLocation, GLint normalLocation, GLint texCoordLocation, GLint tangentLocation) const
+{
+	const auto stride = static_cast<GLsizei>(_vertexSize);
+	if (_hasQuantizedPositions) {
+		glVertexAttribPointer(positionLocation, 3, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void*)0);
+	}
+	else {
+		glVertexAttribPointer(positionLocation, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+	}
+	glEnableVertexAttribArray(positionLocation);
+
+	if (normalLocation >= 0 && _normalOffset >= 0)
+	{
+		glVertexAttribPointer(normalLocation, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, reinterpret_cast<void*>(static_cast<size_t>(_normalOffset)));
+		glEnableVertexAttribArray(normalLocation);
+	}
+	if (tangentLocation >= 0 && _tangentOffset >= 0)
+	{
+		glVertexAttribPointer(tangentLocation, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, reinterpret_cast<void*>(static_cast<size_t>(_tangentOffset)));
+		glEnableVertexAttribArray(tangentLocation);
+	}
+	if (texCoordLocation >= 0 && _texCoordOffset >= 0)
+	{
+		glVertexAttribPointer(texCoordLocation, 2, GL_HALF_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(static_cast<size_t>(_texCoordOffset)));
+		glEnableVertexAttribArray(texCoordLocation);
+	}
+}
+
+const void* CompressedMesh::getData() const
+{
+	return _data.data();
+}
+
+size_t CompressedMesh::getByteSize() const
+{
+	return _numVertices * _vertexSize;
+}
+
+size_t CompressedMesh::getVertexSize() const
+{
+	return _vertexSize;
+}
+
+size_t CompressedMesh::getSourceVertexSize() const
+{
+	return _sourceVertexSize;
+}
+
+size_t CompressedMesh::getNumVertices() const
+{
+	return _numVertices;
+}
+
+const glm::mat4& CompressedMesh::getPositionDecode() const
+{
+	return _positionDecode;
+}
+
+const CompressedMesh::ReconstructionError& CompressedMesh::getError() const
+{
+	return _error;
+}
+
+void CompressedMesh::printStats(const char* name, std::ostream& os) const
+{
+	const auto flags = os.flags();
+	const auto precision = os.precision();
+
+	os << "Vertex compression (" << name << "): " << _numVertices << " vertices, " << _sourceVertexSize << " -> " << _vertexSize
+		<< " bytes per vertex (" << _numVertices * _sourceVertexSize << " -> " << getByteSize() << " bytes), max error: position "
+		<< std::scientific << std::setprecision(1) << _error.position;
+	if (_normalOffset >= 0) {
+		os << ", normal " << std::fixed << std::setprecision(2) << _error.normalDegrees << " deg";
+	}
+	if (_tangentOffset >= 0) {
+		os << ", tangent " << std::fixed << std::setprecision(2) << _error.tangentDegrees << " deg (" << _error.bitangentSignErrors << " bitangent flips)";
+	}
+	if (_texCoordOffset >= 0) {
+		os << ", texture coordinate " << std::scientific << std::setprecision(1) << _error.texCoord;
+	}
+	os << std::endl;
+
+	os.flags(flags);
+	os.precision(precision);
+}
+
+void CompressedMesh::freeData()
+{
+	std::vector<unsigned char>().swap(_data);
+}